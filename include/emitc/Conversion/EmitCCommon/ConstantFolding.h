@@ -0,0 +1,298 @@
+//===- ConstantFolding.h - Evaluators for constant operands -----*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file provides dialect independent evaluators on dense attributes that
+// are used to fold operations with constant operands at compile time. The
+// evaluators mirror the semantics of the reference implementation.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef EMITC_CONVERSION_EMITCCOMMON_CONSTANTFOLDING_H
+#define EMITC_CONVERSION_EMITCCOMMON_CONSTANTFOLDING_H
+
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/PatternMatch.h"
+#include "llvm/ADT/SetVector.h"
+
+#include <cstring>
+
+namespace {
+
+using namespace mlir;
+
+/// Returns the number of bytes needed to store `type`.
+inline uint64_t getSizeInBytes(ShapedType type) {
+  return type.getNumElements() *
+         llvm::divideCeil(type.getElementTypeBitWidth(), 8);
+}
+
+/// Returns the constant values of all operands of `op` or failure if any
+/// operand is not a constant.
+inline FailureOr<SmallVector<DenseElementsAttr>>
+getConstantOperands(Operation *op) {
+  SmallVector<DenseElementsAttr> operands;
+  for (Value operand : op->getOperands()) {
+    DenseElementsAttr attr;
+    if (!matchPattern(operand, m_Constant(&attr)))
+      return failure();
+    operands.push_back(attr);
+  }
+  return operands;
+}
+
+/// Erases the ops defining `values` if they are constants without uses.
+inline void eraseDeadConstants(ValueRange values, RewriterBase &rewriter) {
+  llvm::SetVector<Operation *> ops;
+  for (Value value : values)
+    if (Operation *op = value.getDefiningOp())
+      ops.insert(op);
+
+  for (Operation *op : ops)
+    if (op->hasTrait<OpTrait::ConstantLike>() && op->use_empty())
+      rewriter.eraseOp(op);
+}
+
+/// Returns `attr` with its dimensions permuted by `perms`.
+inline FailureOr<DenseElementsAttr>
+transposeConstant(DenseElementsAttr attr, ArrayRef<int64_t> perms,
+                  ShapedType resultType) {
+  if (attr.isSplat())
+    return attr.resizeSplat(resultType);
+
+  ArrayRef<int64_t> shape = attr.getType().getShape();
+  int64_t rank = shape.size();
+  int64_t numElements = attr.getNumElements();
+
+  SmallVector<int64_t> strides(rank, 1);
+  for (int64_t i = rank - 2; i >= 0; i--)
+    strides[i] = strides[i + 1] * shape[i + 1];
+
+  // Maps the linear index of the result to the linear index of `attr`.
+  auto sourceIndex = [&](int64_t index) {
+    int64_t result = 0;
+    for (int64_t i = rank - 1; i >= 0; i--) {
+      int64_t dim = resultType.getDimSize(i);
+      result += (index % dim) * strides[perms[i]];
+      index /= dim;
+    }
+    return result;
+  };
+
+  // Booleans are bit-packed, all other types are stored byte aligned.
+  if (attr.getElementType().isInteger(1)) {
+    SmallVector<bool> values(attr.getValues<bool>());
+    SmallVector<bool> result(numElements);
+    for (int64_t i = 0; i < numElements; i++)
+      result[i] = values[sourceIndex(i)];
+    return DenseElementsAttr::get(resultType, result);
+  }
+
+  ArrayRef<char> data = attr.getRawData();
+  size_t elementSize = data.size() / numElements;
+  std::vector<char> result(data.size());
+  for (int64_t i = 0; i < numElements; i++)
+    std::memcpy(&result[i * elementSize],
+                &data[sourceIndex(i) * elementSize], elementSize);
+  return DenseElementsAttr::getFromRawBuffer(resultType, result);
+}
+
+/// Converts `attr` to the element type of `resultType` like a `static_cast`
+/// in the reference implementation, i.e. floating point values are truncated
+/// towards zero when converted to integers.
+inline FailureOr<DenseElementsAttr>
+convertConstant(DenseElementsAttr attr, ShapedType resultType) {
+  Type srcType = attr.getElementType();
+  Type destType = resultType.getElementType();
+
+  if (srcType.isa<IntegerType>() && destType.isa<IntegerType>()) {
+    bool isSigned = !srcType.isUnsignedInteger() && !srcType.isInteger(1);
+    unsigned width = destType.getIntOrFloatBitWidth();
+    return attr.mapValues(destType, [&](const APInt &value) {
+      if (width == 1)
+        return APInt(1, !value.isZero());
+      return isSigned ? value.sextOrTrunc(width) : value.zextOrTrunc(width);
+    });
+  }
+
+  if (srcType.isa<IntegerType>() && destType.isa<FloatType>()) {
+    bool isSigned = !srcType.isUnsignedInteger() && !srcType.isInteger(1);
+    const llvm::fltSemantics &semantics =
+        destType.cast<FloatType>().getFloatSemantics();
+    return attr.mapValues(destType, [&](const APInt &value) {
+      APFloat result(semantics);
+      result.convertFromAPInt(value, isSigned, APFloat::rmNearestTiesToEven);
+      return result.bitcastToAPInt();
+    });
+  }
+
+  if (srcType.isa<FloatType>() && destType.isa<FloatType>()) {
+    const llvm::fltSemantics &semantics =
+        destType.cast<FloatType>().getFloatSemantics();
+    return attr.mapValues(destType, [&](const APFloat &value) {
+      APFloat result = value;
+      bool losesInfo;
+      result.convert(semantics, APFloat::rmNearestTiesToEven, &losesInfo);
+      return result.bitcastToAPInt();
+    });
+  }
+
+  if (srcType.isa<FloatType>() && destType.isa<IntegerType>()) {
+    unsigned width = destType.getIntOrFloatBitWidth();
+    bool isUnsigned = destType.isUnsignedInteger();
+    return attr.mapValues(destType, [&](const APFloat &value) {
+      if (width == 1)
+        return APInt(1, !value.isZero());
+      APSInt result(width, isUnsigned);
+      bool isExact;
+      value.convertToInteger(result, APFloat::rmTowardZero, &isExact);
+      return static_cast<APInt>(result);
+    });
+  }
+
+  return failure();
+}
+
+/// Multiplies `lhs` and `rhs` elementwise. Dimensions of size one are
+/// broadcasted. For integers, the product is rounded and shifted right by
+/// `shift` like `emitc::tosa::mul`.
+inline FailureOr<DenseElementsAttr> mulConstant(DenseElementsAttr lhs,
+                                                DenseElementsAttr rhs,
+                                                ShapedType resultType,
+                                                int64_t shift = 0) {
+  Type elementType = resultType.getElementType();
+  int64_t rank = resultType.getRank();
+  if (lhs.getType().getRank() != rank || rhs.getType().getRank() != rank)
+    return failure();
+
+  // Maps the linear index of the result to the linear index of `operand`.
+  auto operandIndex = [&](DenseElementsAttr operand, int64_t index) {
+    if (operand.isSplat())
+      return int64_t(0);
+    ArrayRef<int64_t> shape = operand.getType().getShape();
+    int64_t result = 0;
+    int64_t stride = 1;
+    for (int64_t i = rank - 1; i >= 0; i--) {
+      int64_t dim = resultType.getDimSize(i);
+      if (shape[i] != 1)
+        result += (index % dim) * stride;
+      stride *= shape[i];
+      index /= dim;
+    }
+    return result;
+  };
+
+  int64_t numElements = resultType.getNumElements();
+
+  if (elementType.isa<FloatType>()) {
+    if (shift != 0)
+      return failure();
+    SmallVector<APFloat> lhsValues(lhs.getValues<APFloat>());
+    SmallVector<APFloat> rhsValues(rhs.getValues<APFloat>());
+    SmallVector<APFloat> result;
+    result.reserve(numElements);
+    for (int64_t i = 0; i < numElements; i++) {
+      APFloat value = lhsValues[operandIndex(lhs, i)];
+      value.multiply(rhsValues[operandIndex(rhs, i)],
+                     APFloat::rmNearestTiesToEven);
+      result.push_back(value);
+    }
+    return DenseElementsAttr::get(resultType, result);
+  }
+
+  if (auto intType = elementType.dyn_cast<IntegerType>()) {
+    if (shift != 0 && intType.getWidth() != 32)
+      return failure();
+    unsigned width = intType.getWidth();
+    SmallVector<APInt> lhsValues(lhs.getValues<APInt>());
+    SmallVector<APInt> rhsValues(rhs.getValues<APInt>());
+    SmallVector<APInt> result;
+    result.reserve(numElements);
+    for (int64_t i = 0; i < numElements; i++) {
+      const APInt &x = lhsValues[operandIndex(lhs, i)];
+      const APInt &y = rhsValues[operandIndex(rhs, i)];
+      if (shift > 0) {
+        int64_t round = int64_t(1) << (shift - 1);
+        int64_t value = (x.getSExtValue() * y.getSExtValue() + round) >> shift;
+        result.push_back(APInt(64, value, /*isSigned=*/true).trunc(width));
+      } else {
+        result.push_back(x * y);
+      }
+    }
+    return DenseElementsAttr::get(resultType, result);
+  }
+
+  return failure();
+}
+
+/// Returns the elementwise reciprocal of the floating point `attr`.
+inline FailureOr<DenseElementsAttr> reciprocalConstant(DenseElementsAttr attr) {
+  auto floatType = attr.getElementType().dyn_cast<FloatType>();
+  if (!floatType)
+    return failure();
+
+  auto reciprocal = [&](const APFloat &value) {
+    APFloat result(floatType.getFloatSemantics(), 1);
+    result.divide(value, APFloat::rmNearestTiesToEven);
+    return result;
+  };
+
+  if (attr.isSplat())
+    return DenseElementsAttr::get(attr.getType(),
+                                  reciprocal(attr.getSplatValue<APFloat>()));
+
+  SmallVector<APFloat> result;
+  result.reserve(attr.getNumElements());
+  for (const APFloat &value : attr.getValues<APFloat>())
+    result.push_back(reciprocal(value));
+  return DenseElementsAttr::get(attr.getType(), result);
+}
+
+/// Packs [OC, ...] weights into [ceil(OC/B), ..., B] panels, zero-filling the
+/// output channels beyond OC.
+inline FailureOr<DenseElementsAttr> packConstant(DenseElementsAttr weights,
+                                                int64_t blockSize) {
+  ShapedType type = weights.getType();
+  if (!type.hasStaticShape() || type.getElementType().isInteger(1) ||
+      !type.getElementType().isIntOrFloat())
+    return failure();
+
+  int64_t outputChannels = type.getDimSize(0);
+  int64_t panels = llvm::divideCeil(outputChannels, blockSize);
+  int64_t innerSize = type.getNumElements() / outputChannels;
+
+  SmallVector<int64_t> packedShape{panels};
+  llvm::append_range(packedShape, type.getShape().drop_front());
+  packedShape.push_back(blockSize);
+  auto packedType = RankedTensorType::get(packedShape, type.getElementType());
+
+  if (weights.isSplat() && outputChannels % blockSize == 0)
+    return weights.resizeSplat(packedType);
+
+  ArrayRef<char> data = weights.getRawData();
+  size_t elementSize = llvm::divideCeil(type.getElementTypeBitWidth(), 8);
+  std::vector<char> packed(packedType.getNumElements() * elementSize, 0);
+
+  for (int64_t oc = 0; oc < outputChannels; oc++) {
+    for (int64_t k = 0; k < innerSize; k++) {
+      int64_t src = weights.isSplat() ? 0 : oc * innerSize + k;
+      int64_t dest =
+          ((oc / blockSize) * innerSize + k) * blockSize + oc % blockSize;
+      std::memcpy(&packed[dest * elementSize], &data[src * elementSize],
+                  elementSize);
+    }
+  }
+
+  return DenseElementsAttr::getFromRawBuffer(packedType, packed);
+}
+
+} // namespace
+
+#endif // EMITC_CONVERSION_EMITCCOMMON_CONSTANTFOLDING_H
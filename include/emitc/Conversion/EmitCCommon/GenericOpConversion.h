@@ -12,12 +12,31 @@
 #include "mlir/Dialect/EmitC/IR/EmitC.h"
 #include "mlir/IR/MLIRContext.h"
 #include "mlir/Transforms/DialectConversion.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
+
+#include <string>
 
 namespace {
 
 using namespace mlir;
 using namespace mlir::emitc;
 
+/// Returns `values` as `std::integer_sequence` type, which is used to pass
+/// attributes as compile-time template arguments.
+inline Attribute getIntegerSequenceAttr(ArrayRef<int64_t> values,
+                                        MLIRContext *ctx) {
+  std::string type;
+  llvm::raw_string_ostream os(type);
+  os << "std::integer_sequence<int64_t";
+  for (int64_t value : values)
+    os << ", " << value;
+  os << ">";
+  return emitc::OpaqueAttr::get(ctx, os.str());
+}
+
 /// Convert a common operation into an `emitc.call_opaque` operation.
 template <typename SrcOp, typename Adaptor = typename SrcOp::Adaptor>
 class GenericOpConversion : public OpConversionPattern<SrcOp> {
@@ -57,20 +76,54 @@ private:
       templateArgs = ArrayAttr::get(srcOp.getContext(), templateArguments);
     }
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(srcOp, srcOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, srcOp, srcOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
 
-  StringRef funcName;
+  std::string funcName;
   // If set, use the result type of the operation as template parameter.
   bool explicitResultType;
   // If set, use the operand types as (additional) template parameters.
   bool explicitOperandTypes;
 };
 
+/// Lower `op` with operands (input, weights, bias) into an `emitc.call_opaque`
+/// operation to `funcName`, with the weights replaced by `ConstOp` constants of
+/// `weights`. The operands are passed in order unless followed by `attrArgs`.
+template <typename ConstOp>
+void replaceWithWeightsCall(Operation *op, StringRef funcName,
+                            ArrayRef<DenseElementsAttr> weights,
+                            ArrayRef<Attribute> attrArgs,
+                            ArrayRef<Attribute> templateArgs,
+                            RewriterBase &rewriter) {
+  Location loc = op->getLoc();
+  Value input = op->getOperand(0);
+  Value oldWeights = op->getOperand(1);
+  Value bias = op->getOperand(2);
+
+  rewriter.setInsertionPoint(op);
+  SmallVector<Value> operands{input};
+  for (DenseElementsAttr attr : weights)
+    operands.push_back(rewriter.create<ConstOp>(loc, attr.getType(), attr));
+  operands.push_back(bias);
+
+  ArrayAttr args;
+  if (!attrArgs.empty()) {
+    SmallVector<Attribute> arguments;
+    for (size_t i = 0; i < operands.size(); i++)
+      arguments.push_back(rewriter.getIndexAttr(i));
+    llvm::append_range(arguments, attrArgs);
+    args = rewriter.getArrayAttr(arguments);
+  }
+
+  replaceOpWithPureCall(rewriter, op, op->getResult(0).getType(),
+                        rewriter.getStringAttr(funcName), args,
+                        rewriter.getArrayAttr(templateArgs), operands);
+  eraseDeadConstants(oldWeights, rewriter);
+}
+
 } // namespace
 
 #endif // EMITC_CONVERSION_EMITCCOMMON_GENERICOPCONVERSION_H
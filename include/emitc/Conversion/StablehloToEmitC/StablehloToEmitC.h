@@ -11,6 +11,8 @@
 
 #include "mlir/Pass/Pass.h"
 
+#include <string>
+
 namespace mlir {
 class ModuleOp;
 
@@ -24,6 +26,23 @@ std::unique_ptr<OperationPass<ModuleOp>>
 createConvertStablehloRegionOpsToEmitCPass();
 std::unique_ptr<OperationPass<func::FuncOp>>
 createConvertStablehloToEmitCPass();
+/// Creates the conversion with the kernel backends selected per op kind, given
+/// as `op:backend`.
+std::unique_ptr<OperationPass<func::FuncOp>>
+createConvertStablehloToEmitCPass(ArrayRef<std::string> kernelBackends);
+std::unique_ptr<OperationPass<func::FuncOp>>
+createFoldStablehloConstantsPass();
+std::unique_ptr<OperationPass<func::FuncOp>>
+createFoldStablehloLayoutOpsPass();
+std::unique_ptr<OperationPass<func::FuncOp>> createFoldStablehloPadPass();
+std::unique_ptr<OperationPass<func::FuncOp>>
+createFoldStablehloTransposePass();
+/// Creates the fold with the kernel backends selected per op kind, given as
+/// `op:backend`.
+std::unique_ptr<OperationPass<func::FuncOp>>
+createFoldStablehloTransposePass(ArrayRef<std::string> kernelBackends);
+std::unique_ptr<OperationPass<func::FuncOp>>
+createSimplifyStablehloArithmeticPass();
 
 } // namespace emitc
 } // namespace mlir
@@ -11,6 +11,8 @@
 
 #include "mlir/Pass/Pass.h"
 
+#include <string>
+
 namespace mlir {
 namespace func {
 class FuncOp;
@@ -18,7 +20,28 @@ class FuncOp;
 
 namespace emitc {
 
+/// Version of the packed weights layout. Must match
+/// `emitc::tosa::packed_weights_layout_version` in the reference
+/// implementation.
+constexpr int64_t packedWeightsLayoutVersion = 1;
+
 std::unique_ptr<OperationPass<func::FuncOp>> createConvertTosaToEmitCPass();
+/// Creates the conversion with the kernel backends selected per op kind, given
+/// as `op:backend`.
+std::unique_ptr<OperationPass<func::FuncOp>>
+createConvertTosaToEmitCPass(ArrayRef<std::string> kernelBackends);
+std::unique_ptr<OperationPass<func::FuncOp>> createFoldTosaConstantsPass();
+std::unique_ptr<OperationPass<func::FuncOp>> createFoldTosaLayoutOpsPass();
+std::unique_ptr<OperationPass<func::FuncOp>> createFoldTosaPadPass();
+std::unique_ptr<OperationPass<func::FuncOp>> createFoldTosaTransposePass();
+/// Creates the fold with the kernel backends selected per op kind, given as
+/// `op:backend`.
+std::unique_ptr<OperationPass<func::FuncOp>>
+createFoldTosaTransposePass(ArrayRef<std::string> kernelBackends);
+std::unique_ptr<OperationPass<func::FuncOp>> createPackTosaWeightsPass();
+std::unique_ptr<OperationPass<func::FuncOp>> createSimplifyTosaArithmeticPass();
+std::unique_ptr<OperationPass<func::FuncOp>> createSparsifyTosaWeightsPass();
+std::unique_ptr<OperationPass<func::FuncOp>> createTosaBlockedLayoutPass();
 
 } // namespace emitc
 } // namespace mlir
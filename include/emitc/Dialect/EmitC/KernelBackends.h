@@ -0,0 +1,134 @@
+//===- KernelBackends.h - Per op selection of kernel backends ---*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// The reference implementation provides several kernels for some ops in the
+// namespaces `naive`, `eigen` and `blas`. The conversions select a kernel per
+// op kind by emitting the callee qualified with its backend, e.g.
+// `emitc::tosa::eigen::conv2d`. Ops without a selected backend are emitted
+// unqualified, which leaves the choice to the preprocessor definitions of the
+// reference implementation. The kernel tuning passes select the backend per
+// call from the same table.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef EMITC_DIALECT_EMITC_KERNELBACKENDS_H
+#define EMITC_DIALECT_EMITC_KERNELBACKENDS_H
+
+#include "mlir/IR/Operation.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSwitch.h"
+
+#include <string>
+
+namespace {
+
+using namespace mlir;
+
+/// Kernel backends of the reference implementation.
+enum KernelBackend : unsigned {
+  NaiveBackend = 1 << 0,
+  EigenBackend = 1 << 1,
+  BlasBackend = 1 << 2,
+};
+
+/// An op kind with selectable kernels and the backends implementing it.
+struct SelectableKernel {
+  StringRef opName;
+  unsigned backends;
+};
+
+/// Returns the op kinds with selectable kernels in the reference
+/// implementation namespace `prefix`, e.g. `emitc::tosa`, and the backends
+/// implementing them.
+inline ArrayRef<SelectableKernel> getSelectableKernels(StringRef prefix) {
+  static const SelectableKernel stablehloKernels[] = {
+      {"convolution", NaiveBackend | EigenBackend},
+      {"dot", NaiveBackend | EigenBackend | BlasBackend},
+      {"dot_general", NaiveBackend | BlasBackend},
+  };
+  static const SelectableKernel tosaKernels[] = {
+      {"avg_pool2d", NaiveBackend | EigenBackend},
+      {"conv2d", NaiveBackend | EigenBackend | BlasBackend},
+      {"depthwise_conv2d", NaiveBackend | EigenBackend},
+      {"fully_connected", NaiveBackend | EigenBackend | BlasBackend},
+      {"matmul", NaiveBackend | EigenBackend | BlasBackend},
+      {"max_pool2d", NaiveBackend | EigenBackend},
+      {"reduce_max", NaiveBackend | EigenBackend},
+      {"reduce_min", NaiveBackend | EigenBackend},
+      {"reduce_prod", NaiveBackend | EigenBackend},
+      {"reduce_sum", NaiveBackend | EigenBackend},
+  };
+  if (prefix == "emitc::stablehlo")
+    return stablehloKernels;
+  if (prefix == "emitc::tosa")
+    return tosaKernels;
+  return {};
+}
+
+/// Returns the backend named `name`, or 0 if there is none.
+inline unsigned getKernelBackend(StringRef name) {
+  return llvm::StringSwitch<unsigned>(name)
+      .Case("naive", NaiveBackend)
+      .Case("eigen", EigenBackend)
+      .Case("blas", BlasBackend)
+      .Default(0);
+}
+
+/// Returns the names of the backends in the bit set `backends`.
+inline SmallVector<StringRef> getKernelBackendNames(unsigned backends) {
+  SmallVector<StringRef> names;
+  if (backends & NaiveBackend)
+    names.push_back("naive");
+  if (backends & EigenBackend)
+    names.push_back("eigen");
+  if (backends & BlasBackend)
+    names.push_back("blas");
+  return names;
+}
+
+/// Maps op kinds to the names of their selected backends.
+using KernelBackends = llvm::StringMap<std::string>;
+
+/// Parses `options` of the form `op:backend` into `backends`. Reports options
+/// naming an op kind or backend not listed in `kernels` at `op`.
+inline LogicalResult parseKernelBackends(ArrayRef<std::string> options,
+                                         ArrayRef<SelectableKernel> kernels,
+                                         Operation *op,
+                                         KernelBackends &backends) {
+  for (StringRef option : options) {
+    auto [opName, backendName] = option.split(':');
+    const SelectableKernel *kernel =
+        llvm::find_if(kernels, [&opName = opName](const SelectableKernel &k) {
+          return k.opName == opName;
+        });
+    if (kernel == kernels.end())
+      return op->emitError("no selectable kernels for '") << opName << "'";
+
+    if (!(getKernelBackend(backendName) & kernel->backends))
+      return op->emitError("no '")
+             << backendName << "' kernel for '" << opName << "'";
+
+    backends[opName] = backendName.str();
+  }
+  return success();
+}
+
+/// Returns the callee `prefix::opName`, qualified with the backend selected
+/// for `opName` in `backends`, if any.
+inline std::string getKernelCallee(StringRef prefix, StringRef opName,
+                                   const KernelBackends &backends) {
+  auto it = backends.find(opName);
+  if (it == backends.end())
+    return (prefix + "::" + opName).str();
+  return (prefix + "::" + it->second + "::" + opName).str();
+}
+
+} // namespace
+
+#endif // EMITC_DIALECT_EMITC_KERNELBACKENDS_H
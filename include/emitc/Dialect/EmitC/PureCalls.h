@@ -0,0 +1,60 @@
+//===- PureCalls.h - Side effect free EmitC calls ---------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// `emitc.call_opaque` operations carry no side effect information. The
+// conversions mark the calls they create to functions of the reference
+// implementation that are free of side effects with the unit attribute
+// `emitc.pure`, which allows the EmitC transforms to eliminate redundant
+// calls. Calls without the attribute, e.g. to the random number generators or
+// to functions unknown to the conversions, are assumed to have side effects.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef EMITC_DIALECT_EMITC_PURECALLS_H
+#define EMITC_DIALECT_EMITC_PURECALLS_H
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/IR/PatternMatch.h"
+
+namespace {
+
+using namespace mlir;
+
+/// Returns the name of the unit attribute marking pure calls.
+inline StringRef getPureCallAttrName() { return "emitc.pure"; }
+
+/// Returns true if `callOp` is marked as free of side effects.
+inline bool isPureCall(emitc::CallOpaqueOp callOp) {
+  return callOp->hasAttr(getPureCallAttrName());
+}
+
+/// Creates an `emitc.call_opaque` operation from `args` and marks it as free
+/// of side effects.
+template <typename... Args>
+emitc::CallOpaqueOp createPureCall(OpBuilder &builder, Location loc,
+                                   Args &&...args) {
+  auto callOp =
+      builder.create<emitc::CallOpaqueOp>(loc, std::forward<Args>(args)...);
+  callOp->setAttr(getPureCallAttrName(), builder.getUnitAttr());
+  return callOp;
+}
+
+/// Replaces `op` by an `emitc.call_opaque` operation created from `args` and
+/// marked as free of side effects.
+template <typename... Args>
+emitc::CallOpaqueOp replaceOpWithPureCall(RewriterBase &rewriter,
+                                          Operation *op, Args &&...args) {
+  auto callOp = rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
+      op, std::forward<Args>(args)...);
+  callOp->setAttr(getPureCallAttrName(), rewriter.getUnitAttr());
+  return callOp;
+}
+
+} // namespace
+
+#endif // EMITC_DIALECT_EMITC_PURECALLS_H
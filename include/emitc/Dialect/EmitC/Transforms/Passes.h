@@ -20,11 +20,19 @@ class ModuleOp;
 
 namespace emitc {
 
+std::unique_ptr<OperationPass<ModuleOp>> createApplyEmitCKernelTuningPass();
+std::unique_ptr<OperationPass<ModuleOp>>
+createApplyEmitCKernelTuningPass(StringRef database);
+std::unique_ptr<OperationPass<ModuleOp>>
+createEliminateRedundantEmitCCallsPass();
+std::unique_ptr<OperationPass<ModuleOp>> createExtractEmitCKernelsPass();
 std::unique_ptr<OperationPass<ModuleOp>> createInsertEmitCArithIncludePass();
 std::unique_ptr<OperationPass<ModuleOp>>
 createInsertEmitCStablehloIncludePass();
 std::unique_ptr<OperationPass<ModuleOp>> createInsertEmitCTensorIncludePass();
 std::unique_ptr<OperationPass<ModuleOp>> createInsertEmitCTosaIncludePass();
+std::unique_ptr<OperationPass<ModuleOp>> createLowerEmitCHalfTypesPass();
+std::unique_ptr<OperationPass<ModuleOp>> createMergeEmitCDuplicatesPass();
 
 #define GEN_PASS_REGISTRATION
 #include "emitc/Dialect/EmitC/Transforms/Passes.h.inc"
@@ -37,15 +37,33 @@ inline void registerAllEmitCPasses() {
 #ifdef EMITC_BUILD_HLO
   registerConvertStablehloRegionOpsToEmitCPass();
   registerConvertStablehloToEmitCPass();
+  registerFoldStablehloConstantsPass();
+  registerFoldStablehloLayoutOpsPass();
+  registerFoldStablehloPadPass();
+  registerFoldStablehloTransposePass();
   registerInsertEmitCStablehloIncludePass();
+  registerSimplifyStablehloArithmeticPass();
   registerStablehloToEmitCPipeline();
 #endif // EMITC_BUILD_HLO
   registerConvertArithToEmitCPass();
   registerConvertTensorToEmitCPass();
   registerConvertTosaToEmitCPass();
+  registerFoldTosaConstantsPass();
+  registerFoldTosaLayoutOpsPass();
+  registerFoldTosaPadPass();
+  registerFoldTosaTransposePass();
+  registerPackTosaWeightsPass();
+  registerSimplifyTosaArithmeticPass();
+  registerSparsifyTosaWeightsPass();
+  registerTosaBlockedLayoutPass();
+  registerApplyEmitCKernelTuningPass();
+  registerEliminateRedundantEmitCCallsPass();
+  registerExtractEmitCKernelsPass();
   registerInsertEmitCArithIncludePass();
   registerInsertEmitCTensorIncludePass();
   registerInsertEmitCTosaIncludePass();
+  registerLowerEmitCHalfTypesPass();
+  registerMergeEmitCDuplicatesPass();
   registerArithToEmitCPipeline();
   registerTensorToEmitCPipeline();
   registerTosaToEmitCPipeline();
@@ -19,12 +19,227 @@
 
 #include "../PassDetail.h"
 #include "emitc/Conversion/ArithToEmitC/ArithToEmitC.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
+
+#include <algorithm>
+#include <optional>
 
 using namespace mlir;
 using namespace mlir::emitc;
 
 namespace {
 
+/// Returns true if `type` is a scalar type with native C++ operators.
+bool isScalarType(Type type) {
+  if (auto floatType = type.dyn_cast<FloatType>())
+    return floatType.isF32() || floatType.isF64();
+  return type.isIndex() || type.isSignlessInteger();
+}
+
+/// Returns the type in which a C++ operator computes an integer operation on
+/// `type` with signed semantics if `isSigned`, or with wrap around otherwise.
+/// Signless integers are emitted as signed and index as `size_t`. Overflow of
+/// signed integers is undefined behavior in C++, but wraps around in arith.
+/// C++ promotes unsigned integers narrower than `int` to `int`, so wrap around
+/// operations on them are computed in ui32 and truncated afterwards.
+Type getComputeType(Type type, bool isSigned) {
+  if (type.isIndex())
+    return isSigned ? IntegerType::get(type.getContext(), 64) : type;
+  if (type.isSignlessInteger() && !isSigned)
+    return IntegerType::get(type.getContext(),
+                            std::max(type.getIntOrFloatBitWidth(), 32u),
+                            IntegerType::Unsigned);
+  return type;
+}
+
+/// Casts `value` to `type` unless it already has that type.
+Value castIfNeeded(Value value, Type type, Location loc,
+                   ConversionPatternRewriter &rewriter) {
+  if (value.getType() == type)
+    return value;
+  return rewriter.create<emitc::CastOp>(loc, type, value);
+}
+
+// Convert scalar binary arith ops into the corresponding EmitC operator.
+template <typename ArithOp, typename EmitCOp, bool isSigned>
+class BinaryOpConversion : public OpConversionPattern<ArithOp> {
+  using OpConversionPattern<ArithOp>::OpConversionPattern;
+
+private:
+  LogicalResult
+  matchAndRewrite(ArithOp op, typename ArithOp::Adaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Type type = op.getType();
+    if (!isScalarType(type) || type.isInteger(1))
+      return rewriter.notifyMatchFailure(op, "expected a scalar operation");
+
+    Location loc = op.getLoc();
+    Type computeType = getComputeType(type, isSigned);
+    Value lhs = castIfNeeded(adaptor.getLhs(), computeType, loc, rewriter);
+    Value rhs = castIfNeeded(adaptor.getRhs(), computeType, loc, rewriter);
+    Value result = rewriter.create<EmitCOp>(loc, computeType, lhs, rhs);
+    rewriter.replaceOp(op, castIfNeeded(result, type, loc, rewriter));
+
+    return success();
+  }
+};
+
+// Convert scalar `arith.cmpi` into an `emitc.cmp` operation.
+class CmpIOpConversion : public OpConversionPattern<arith::CmpIOp> {
+  using OpConversionPattern<arith::CmpIOp>::OpConversionPattern;
+
+private:
+  LogicalResult
+  matchAndRewrite(arith::CmpIOp cmpOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Type type = adaptor.getLhs().getType();
+    if (!isScalarType(type))
+      return rewriter.notifyMatchFailure(cmpOp, "expected scalar operands");
+
+    arith::CmpIPredicate predicate = cmpOp.getPredicate();
+    bool isEquality = predicate == arith::CmpIPredicate::eq ||
+                      predicate == arith::CmpIPredicate::ne;
+    if (type.isInteger(1) && !isEquality)
+      return rewriter.notifyMatchFailure(cmpOp, "expected i1 equality");
+
+    std::optional<emitc::CmpPredicate> emitcPredicate;
+    switch (predicate) {
+    case arith::CmpIPredicate::eq:
+      emitcPredicate = emitc::CmpPredicate::eq;
+      break;
+    case arith::CmpIPredicate::ne:
+      emitcPredicate = emitc::CmpPredicate::ne;
+      break;
+    case arith::CmpIPredicate::slt:
+    case arith::CmpIPredicate::ult:
+      emitcPredicate = emitc::CmpPredicate::lt;
+      break;
+    case arith::CmpIPredicate::sle:
+    case arith::CmpIPredicate::ule:
+      emitcPredicate = emitc::CmpPredicate::le;
+      break;
+    case arith::CmpIPredicate::sgt:
+    case arith::CmpIPredicate::ugt:
+      emitcPredicate = emitc::CmpPredicate::gt;
+      break;
+    case arith::CmpIPredicate::sge:
+    case arith::CmpIPredicate::uge:
+      emitcPredicate = emitc::CmpPredicate::ge;
+      break;
+    }
+
+    // Equality does not depend on the signedness of the operands.
+    Type computeType = type;
+    if (!isEquality) {
+      bool isSigned = predicate == arith::CmpIPredicate::slt ||
+                      predicate == arith::CmpIPredicate::sle ||
+                      predicate == arith::CmpIPredicate::sgt ||
+                      predicate == arith::CmpIPredicate::sge;
+      computeType = getComputeType(type, isSigned);
+    }
+
+    Location loc = cmpOp.getLoc();
+    Value lhs = castIfNeeded(adaptor.getLhs(), computeType, loc, rewriter);
+    Value rhs = castIfNeeded(adaptor.getRhs(), computeType, loc, rewriter);
+    rewriter.replaceOpWithNewOp<emitc::CmpOp>(cmpOp, cmpOp.getType(),
+                                              *emitcPredicate, lhs, rhs);
+
+    return success();
+  }
+};
+
+// Convert scalar `arith.cmpf` into an `emitc.cmp` operation. The C++
+// comparisons are false for NaN operands except for `!=`, which matches the
+// ordered predicates and `une`.
+class CmpFOpConversion : public OpConversionPattern<arith::CmpFOp> {
+  using OpConversionPattern<arith::CmpFOp>::OpConversionPattern;
+
+private:
+  LogicalResult
+  matchAndRewrite(arith::CmpFOp cmpOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (!isScalarType(adaptor.getLhs().getType()))
+      return rewriter.notifyMatchFailure(cmpOp, "expected scalar operands");
+
+    emitc::CmpPredicate predicate;
+    switch (cmpOp.getPredicate()) {
+    case arith::CmpFPredicate::OEQ:
+      predicate = emitc::CmpPredicate::eq;
+      break;
+    case arith::CmpFPredicate::UNE:
+      predicate = emitc::CmpPredicate::ne;
+      break;
+    case arith::CmpFPredicate::OLT:
+      predicate = emitc::CmpPredicate::lt;
+      break;
+    case arith::CmpFPredicate::OLE:
+      predicate = emitc::CmpPredicate::le;
+      break;
+    case arith::CmpFPredicate::OGT:
+      predicate = emitc::CmpPredicate::gt;
+      break;
+    case arith::CmpFPredicate::OGE:
+      predicate = emitc::CmpPredicate::ge;
+      break;
+    default:
+      return rewriter.notifyMatchFailure(cmpOp, "unsupported predicate");
+    }
+
+    rewriter.replaceOpWithNewOp<emitc::CmpOp>(
+        cmpOp, cmpOp.getType(), predicate, adaptor.getLhs(), adaptor.getRhs());
+
+    return success();
+  }
+};
+
+// Convert scalar `arith.select` into an `emitc.conditional` operation.
+class SelectOpConversion : public OpConversionPattern<arith::SelectOp> {
+  using OpConversionPattern<arith::SelectOp>::OpConversionPattern;
+
+private:
+  LogicalResult
+  matchAndRewrite(arith::SelectOp selectOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (!isScalarType(selectOp.getType()) ||
+        !adaptor.getCondition().getType().isInteger(1))
+      return rewriter.notifyMatchFailure(selectOp, "expected scalar operands");
+
+    rewriter.replaceOpWithNewOp<emitc::ConditionalOp>(
+        selectOp, selectOp.getType(), adaptor.getCondition(),
+        adaptor.getTrueValue(), adaptor.getFalseValue());
+
+    return success();
+  }
+};
+
+// Convert scalar arith cast ops into an `emitc.cast` operation. Casts from
+// and to i1 are not converted, as C++ converts to bool by comparing with
+// zero and from bool without sign extension.
+template <typename ArithOp>
+class CastOpConversion : public OpConversionPattern<ArithOp> {
+  using OpConversionPattern<ArithOp>::OpConversionPattern;
+
+public:
+  CastOpConversion(MLIRContext *ctx)
+      : OpConversionPattern<ArithOp>(ctx, /*benefit=*/2) {}
+
+private:
+  LogicalResult
+  matchAndRewrite(ArithOp castOp, typename ArithOp::Adaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Type srcType = adaptor.getIn().getType();
+    Type resultType = castOp.getType();
+    if (!isScalarType(srcType) || !isScalarType(resultType) ||
+        srcType.isInteger(1) || resultType.isInteger(1))
+      return rewriter.notifyMatchFailure(castOp, "expected a scalar cast");
+
+    rewriter.replaceOpWithNewOp<emitc::CastOp>(castOp, resultType,
+                                               adaptor.getIn());
+
+    return success();
+  }
+};
+
 // Convert `arith.index_cast` into an `emitc.call_opaque` operation.
 class IndexCastOpConversion : public OpConversionPattern<arith::IndexCastOp> {
   using OpConversionPattern<arith::IndexCastOp>::OpConversionPattern;
@@ -43,9 +258,8 @@ private:
     Type resultType = indexCastOp.getResult().getType();
     ArrayAttr templateArgs = rewriter.getArrayAttr({TypeAttr::get(resultType)});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        indexCastOp, indexCastOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, indexCastOp, indexCastOp.getType(), callee,
+                          args, templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -55,6 +269,25 @@ private:
 void populateArithToEmitcPatterns(MLIRContext *ctx,
                                   RewritePatternSet &patterns) {
   patterns.add<IndexCastOpConversion>(ctx);
+
+  // Scalar ops are converted to native C++ expressions.
+  patterns.add<BinaryOpConversion<arith::AddIOp, emitc::AddOp, false>,
+               BinaryOpConversion<arith::AddFOp, emitc::AddOp, false>,
+               BinaryOpConversion<arith::SubIOp, emitc::SubOp, false>,
+               BinaryOpConversion<arith::SubFOp, emitc::SubOp, false>,
+               BinaryOpConversion<arith::MulIOp, emitc::MulOp, false>,
+               BinaryOpConversion<arith::MulFOp, emitc::MulOp, false>,
+               BinaryOpConversion<arith::DivSIOp, emitc::DivOp, true>,
+               BinaryOpConversion<arith::DivFOp, emitc::DivOp, false>,
+               BinaryOpConversion<arith::RemSIOp, emitc::RemOp, true>,
+               CmpIOpConversion, CmpFOpConversion, SelectOpConversion>(ctx);
+  patterns.add<CastOpConversion<arith::ExtFOp>,
+               CastOpConversion<arith::ExtSIOp>,
+               CastOpConversion<arith::FPToSIOp>,
+               CastOpConversion<arith::IndexCastOp>,
+               CastOpConversion<arith::SIToFPOp>,
+               CastOpConversion<arith::TruncFOp>,
+               CastOpConversion<arith::TruncIOp>>(ctx);
 }
 
 namespace {
@@ -66,8 +299,9 @@ struct ConvertArithToEmitCPass
 
     ConversionTarget target(getContext());
 
+    // Arith ops are converted where possible and kept otherwise, except for
+    // `arith.index_cast`, which is supported for all operand types.
     target.addLegalDialect<emitc::EmitCDialect>();
-    target.addLegalDialect<arith::ArithDialect>();
     target.addIllegalOp<arith::IndexCastOp>();
 
     RewritePatternSet patterns(&getContext());
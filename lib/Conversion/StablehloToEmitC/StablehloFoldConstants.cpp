@@ -0,0 +1,96 @@
+//===- StablehloFoldConstants.cpp - Fold StableHLO ops on constants -------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that evaluates StableHLO operations whose
+// operands are all constants at compile time, e.g. transposes or conversions
+// of weights.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "stablehlo/dialect/StablehloOps.h"
+#include "llvm/ADT/TypeSwitch.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/StablehloToEmitC/StablehloToEmitC.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Evaluates `op` on its constant `operands`.
+FailureOr<DenseElementsAttr> evaluate(Operation *op,
+                                      ArrayRef<DenseElementsAttr> operands,
+                                      ShapedType resultType) {
+  return llvm::TypeSwitch<Operation *, FailureOr<DenseElementsAttr>>(op)
+      .Case<stablehlo::ConvertOp>([&](auto) {
+        return convertConstant(operands[0], resultType);
+      })
+      .Case<stablehlo::MulOp>([&](auto) {
+        return mulConstant(operands[0], operands[1], resultType);
+      })
+      .Case<stablehlo::ReshapeOp>([&](auto) -> FailureOr<DenseElementsAttr> {
+        return operands[0].reshape(resultType);
+      })
+      .Case<stablehlo::TransposeOp>([&](stablehlo::TransposeOp transposeOp) {
+        return transposeConstant(operands[0], transposeOp.getPermutation(),
+                                 resultType);
+      })
+      .Default([](Operation *) { return failure(); });
+}
+
+} // namespace
+
+namespace {
+
+struct FoldStablehloConstantsPass
+    : public FoldStablehloConstantsBase<FoldStablehloConstantsPass> {
+  /// Replace StableHLO ops with constant operands by `stablehlo.constant` ops.
+  void runOnOperation() override {
+    IRRewriter rewriter(&getContext());
+
+    getOperation().walk([&](Operation *op) {
+      if (!isa<stablehlo::ConvertOp, stablehlo::MulOp, stablehlo::ReshapeOp,
+               stablehlo::TransposeOp>(op))
+        return;
+
+      auto resultType = op->getResult(0).getType().dyn_cast<RankedTensorType>();
+      if (!resultType || !resultType.hasStaticShape())
+        return;
+
+      FailureOr<SmallVector<DenseElementsAttr>> operands =
+          getConstantOperands(op);
+      if (failed(operands))
+        return;
+
+      FailureOr<DenseElementsAttr> result =
+          evaluate(op, *operands, resultType);
+      if (failed(result))
+        return;
+
+      SmallVector<Value> oldOperands(op->getOperands());
+      rewriter.setInsertionPoint(op);
+      rewriter.replaceOpWithNewOp<stablehlo::ConstantOp>(op, *result);
+      eraseDeadConstants(oldOperands, rewriter);
+
+      numRemovedOps++;
+      numRemovedBytes += getSizeInBytes(resultType);
+    });
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldStablehloConstantsPass() {
+  return std::make_unique<FoldStablehloConstantsPass>();
+}
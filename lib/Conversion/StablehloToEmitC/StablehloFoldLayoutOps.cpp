@@ -0,0 +1,202 @@
+//===- StablehloFoldLayoutOps.cpp - Compose and cancel layout ops ---------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that simplifies chains of `stablehlo.reshape`,
+// `stablehlo.transpose` and `stablehlo.broadcast_in_dim` operations. Each of
+// these ops is lowered to a full copy, hence chains are composed into a single
+// op, identities are removed and duplicated ops on the same operand are
+// merged.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "stablehlo/dialect/StablehloOps.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/StablehloToEmitC/StablehloToEmitC.h"
+
+#include <tuple>
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns true if a transpose by `permutation` of `type` keeps all non-unit
+/// dimensions in order, i.e. it does not move any data.
+bool isReshape(ShapedType type, ArrayRef<int64_t> permutation) {
+  int64_t last = -1;
+  for (int64_t dim : permutation) {
+    if (type.getDimSize(dim) == 1)
+      continue;
+    if (dim < last)
+      return false;
+    last = dim;
+  }
+  return true;
+}
+
+/// Returns true if `broadcastInDimOp` does not broadcast any data, i.e. it
+/// only inserts dimensions of size one.
+bool isReshape(stablehlo::BroadcastInDimOp broadcastInDimOp) {
+  auto operandType =
+      broadcastInDimOp.getOperand().getType().cast<ShapedType>();
+  auto resultType = broadcastInDimOp.getType().cast<ShapedType>();
+  if (!operandType.hasStaticShape() || !resultType.hasStaticShape() ||
+      operandType.getNumElements() != resultType.getNumElements())
+    return false;
+
+  ArrayRef<int64_t> dims = broadcastInDimOp.getBroadcastDimensions();
+  for (size_t i = 1; i < dims.size(); i++)
+    if (dims[i] <= dims[i - 1])
+      return false;
+  return true;
+}
+
+class LayoutOpSimplifier {
+public:
+  LayoutOpSimplifier(RewriterBase &rewriter) : rewriter(rewriter) {}
+
+  /// Composes `reshapeOp` with the reshapes defining its input.
+  void simplify(stablehlo::ReshapeOp reshapeOp) {
+    Value input = reshapeOp.getOperand();
+    while (auto inputOp = input.getDefiningOp<stablehlo::ReshapeOp>())
+      input = inputOp.getOperand();
+
+    if (input.getType() == reshapeOp.getType()) {
+      rewriter.replaceOp(reshapeOp, input);
+      return;
+    }
+
+    Operation *op = reshapeOp;
+    if (input != reshapeOp.getOperand())
+      op = createReshape(reshapeOp, input);
+    deduplicate(op, input, Attribute());
+  }
+
+  /// Replaces `broadcastInDimOp` with a reshape if no data is broadcasted.
+  void simplify(stablehlo::BroadcastInDimOp broadcastInDimOp) {
+    if (!isReshape(broadcastInDimOp))
+      return;
+
+    Operation *op =
+        createReshape(broadcastInDimOp, broadcastInDimOp.getOperand());
+    simplify(cast<stablehlo::ReshapeOp>(op));
+  }
+
+  /// Composes `transposeOp` with the transposes defining its input and
+  /// replaces it with a reshape if no data is moved.
+  void simplify(stablehlo::TransposeOp transposeOp) {
+    SmallVector<int64_t> permutation(transposeOp.getPermutation());
+    Value input = transposeOp.getOperand();
+    while (auto inputOp = input.getDefiningOp<stablehlo::TransposeOp>()) {
+      ArrayRef<int64_t> inputPermutation = inputOp.getPermutation();
+      for (int64_t &dim : permutation)
+        dim = inputPermutation[dim];
+      input = inputOp.getOperand();
+    }
+
+    auto inputType = input.getType().cast<ShapedType>();
+    if (inputType == transposeOp.getType() &&
+        llvm::equal(permutation, llvm::seq<int64_t>(0, permutation.size()))) {
+      rewriter.replaceOp(transposeOp, input);
+      return;
+    }
+
+    if (inputType.hasStaticShape() && isReshape(inputType, permutation)) {
+      Operation *op = createReshape(transposeOp, input);
+      simplify(cast<stablehlo::ReshapeOp>(op));
+      return;
+    }
+
+    DenseI64ArrayAttr permutationAttr =
+        rewriter.getDenseI64ArrayAttr(permutation);
+
+    Operation *op = transposeOp;
+    if (input != transposeOp.getOperand()) {
+      rewriter.setInsertionPoint(transposeOp);
+      op = rewriter.replaceOpWithNewOp<stablehlo::TransposeOp>(
+          transposeOp, transposeOp.getType(), input, permutationAttr);
+    }
+    deduplicate(op, input, permutationAttr);
+  }
+
+private:
+  /// Replaces `op` by a `stablehlo.reshape` of `input`.
+  Operation *createReshape(Operation *op, Value input) {
+    rewriter.setInsertionPoint(op);
+    return rewriter.replaceOpWithNewOp<stablehlo::ReshapeOp>(
+        op, op->getResult(0).getType(), input);
+  }
+
+  /// Replaces `op` with an earlier layout op in the same block computing the
+  /// same result from `input`.
+  void deduplicate(Operation *op, Value input, Attribute permutation) {
+    auto key = std::make_tuple(op->getBlock(), op->getName().getIdentifier(),
+                               input, op->getResult(0).getType(), permutation);
+    auto [it, inserted] = layoutOps.try_emplace(key, op);
+    if (!inserted)
+      rewriter.replaceOp(op, it->second->getResults());
+  }
+
+  RewriterBase &rewriter;
+  DenseMap<std::tuple<Block *, StringAttr, Value, Type, Attribute>,
+           Operation *>
+      layoutOps;
+};
+
+} // namespace
+
+namespace {
+
+struct FoldStablehloLayoutOpsPass
+    : public FoldStablehloLayoutOpsBase<FoldStablehloLayoutOpsPass> {
+  /// Compose and cancel StableHLO reshape, transpose and broadcast ops.
+  void runOnOperation() override {
+    IRRewriter rewriter(&getContext());
+    LayoutOpSimplifier simplifier(rewriter);
+
+    auto collectLayoutOps = [&]() {
+      SmallVector<Operation *> ops;
+      getOperation().walk([&](Operation *op) {
+        if (isa<stablehlo::BroadcastInDimOp, stablehlo::ReshapeOp,
+                stablehlo::TransposeOp>(op))
+          ops.push_back(op);
+      });
+      return ops;
+    };
+
+    SmallVector<Operation *> ops = collectLayoutOps();
+    int64_t numOpsBefore = ops.size();
+
+    for (Operation *op : ops) {
+      if (auto reshapeOp = dyn_cast<stablehlo::ReshapeOp>(op))
+        simplifier.simplify(reshapeOp);
+      else if (auto transposeOp = dyn_cast<stablehlo::TransposeOp>(op))
+        simplifier.simplify(transposeOp);
+      else
+        simplifier.simplify(cast<stablehlo::BroadcastInDimOp>(op));
+    }
+
+    // Erase ops of chains that are no longer used, users first.
+    for (Operation *op : llvm::reverse(collectLayoutOps()))
+      if (op->use_empty())
+        rewriter.eraseOp(op);
+
+    numRemovedOps += numOpsBefore - collectLayoutOps().size();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldStablehloLayoutOpsPass() {
+  return std::make_unique<FoldStablehloLayoutOpsPass>();
+}
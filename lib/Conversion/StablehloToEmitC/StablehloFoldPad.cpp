@@ -0,0 +1,215 @@
+//===- StablehloFoldPad.cpp - Fold stablehlo.pad into its consumers -------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that folds explicit `stablehlo.pad` operations
+// into the padding attribute of the consuming convolution or reduce window
+// operation.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "stablehlo/dialect/StablehloOps.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/StablehloToEmitC/StablehloToEmitC.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns true if `padOp` only adds non-negative edge padding.
+bool hasFoldableEdgePadding(stablehlo::PadOp padOp) {
+  auto isNegative = [](int64_t p) { return p < 0; };
+  return llvm::all_of(padOp.getInteriorPadding(),
+                      [](int64_t p) { return p == 0; }) &&
+         llvm::none_of(padOp.getEdgePaddingLow(), isNegative) &&
+         llvm::none_of(padOp.getEdgePaddingHigh(), isNegative);
+}
+
+/// Returns the `[rank, 2]` padding of `padding` or an all-zero padding.
+SmallVector<int64_t>
+getPaddingOrZero(std::optional<DenseIntElementsAttr> padding, int64_t rank) {
+  if (!padding.has_value())
+    return SmallVector<int64_t>(2 * rank, 0);
+  return llvm::to_vector(padding->getValues<int64_t>());
+}
+
+/// Erases `padOp` and its constant operands once all uses have been folded.
+void eraseIfDead(stablehlo::PadOp padOp, PatternRewriter &rewriter) {
+  if (!padOp->use_empty())
+    return;
+
+  Operation *paddingValueOp = padOp.getPaddingValue().getDefiningOp();
+  rewriter.eraseOp(padOp);
+
+  if (paddingValueOp && paddingValueOp->hasTrait<OpTrait::ConstantLike>() &&
+      paddingValueOp->use_empty())
+    rewriter.eraseOp(paddingValueOp);
+}
+
+DenseIntElementsAttr getPaddingAttr(ArrayRef<int64_t> padding,
+                                    PatternRewriter &rewriter) {
+  int64_t rank = static_cast<int64_t>(padding.size()) / 2;
+  auto type = RankedTensorType::get({rank, 2}, rewriter.getI64Type());
+  return DenseIntElementsAttr::get(type, padding);
+}
+
+/// Fold a zero-valued `stablehlo.pad` of the spatial dimensions into the
+/// `padding` attribute of `stablehlo.convolution`.
+class FoldPadIntoConvolution
+    : public OpRewritePattern<stablehlo::ConvolutionOp> {
+public:
+  using OpRewritePattern<stablehlo::ConvolutionOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(stablehlo::ConvolutionOp convOp,
+                                PatternRewriter &rewriter) const override {
+    auto padOp = convOp.getLhs().getDefiningOp<stablehlo::PadOp>();
+    if (!padOp || !hasFoldableEdgePadding(padOp))
+      return failure();
+
+    if (!matchPattern(padOp.getPaddingValue(), m_AnyZeroFloat()) &&
+        !matchPattern(padOp.getPaddingValue(), m_Zero()))
+      return failure();
+
+    // Explicit padding is applied before the input dilation.
+    std::optional<ArrayRef<int64_t>> lhsDilation = convOp.getLhsDilation();
+    if (lhsDilation.has_value() &&
+        llvm::any_of(*lhsDilation, [](int64_t d) { return d != 1; }))
+      return failure();
+
+    auto dimensionNumbers = convOp.getDimensionNumbers();
+    ArrayRef<int64_t> low = padOp.getEdgePaddingLow();
+    ArrayRef<int64_t> high = padOp.getEdgePaddingHigh();
+
+    int64_t batchDim = dimensionNumbers.getInputBatchDimension();
+    int64_t featureDim = dimensionNumbers.getInputFeatureDimension();
+    if (low[batchDim] != 0 || high[batchDim] != 0 || low[featureDim] != 0 ||
+        high[featureDim] != 0)
+      return failure();
+
+    ArrayRef<int64_t> spatialDims =
+        dimensionNumbers.getInputSpatialDimensions();
+    SmallVector<int64_t> padding =
+        getPaddingOrZero(convOp.getPadding(), spatialDims.size());
+    for (auto [i, dim] : llvm::enumerate(spatialDims)) {
+      padding[2 * i] += low[dim];
+      padding[2 * i + 1] += high[dim];
+    }
+
+    SmallVector<Value, 2> operands(convOp->getOperands());
+    operands[0] = padOp.getOperand();
+
+    auto newOp = rewriter.replaceOpWithNewOp<stablehlo::ConvolutionOp>(
+        convOp, convOp.getType(), operands, convOp->getAttrs());
+    newOp.setPaddingAttr(getPaddingAttr(padding, rewriter));
+    eraseIfDead(padOp, rewriter);
+
+    return success();
+  }
+};
+
+/// Fold a `stablehlo.pad` into the `padding` attribute of
+/// `stablehlo.reduce_window` if it pads with the init value of the reduction.
+/// The reduce window implicitly pads with its init value, e.g. -inf for a max
+/// pooling or zero for a sum pooling.
+class FoldPadIntoReduceWindow
+    : public OpRewritePattern<stablehlo::ReduceWindowOp> {
+public:
+  using OpRewritePattern<stablehlo::ReduceWindowOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(stablehlo::ReduceWindowOp reduceWindowOp,
+                                PatternRewriter &rewriter) const override {
+    if (reduceWindowOp.getInputs().size() != 1)
+      return failure();
+
+    auto padOp =
+        reduceWindowOp.getInputs().front().getDefiningOp<stablehlo::PadOp>();
+    if (!padOp || !hasFoldableEdgePadding(padOp))
+      return failure();
+
+    DenseElementsAttr padValue;
+    DenseElementsAttr initValue;
+    if (!matchPattern(padOp.getPaddingValue(), m_Constant(&padValue)) ||
+        !matchPattern(reduceWindowOp.getInitValues().front(),
+                      m_Constant(&initValue)) ||
+        padValue != initValue)
+      return failure();
+
+    // Explicit padding is applied before the base dilation.
+    std::optional<ArrayRef<int64_t>> baseDilations =
+        reduceWindowOp.getBaseDilations();
+    if (baseDilations.has_value() &&
+        llvm::any_of(*baseDilations, [](int64_t d) { return d != 1; }))
+      return failure();
+
+    ArrayRef<int64_t> low = padOp.getEdgePaddingLow();
+    ArrayRef<int64_t> high = padOp.getEdgePaddingHigh();
+
+    SmallVector<int64_t> padding =
+        getPaddingOrZero(reduceWindowOp.getPadding(), low.size());
+    for (size_t i = 0; i < low.size(); i++) {
+      padding[2 * i] += low[i];
+      padding[2 * i + 1] += high[i];
+    }
+
+    SmallVector<Value, 2> operands(reduceWindowOp->getOperands());
+    operands[0] = padOp.getOperand();
+
+    auto newOp = rewriter.create<stablehlo::ReduceWindowOp>(
+        reduceWindowOp.getLoc(), reduceWindowOp.getResultTypes(), operands,
+        reduceWindowOp->getAttrs());
+    newOp.setPaddingAttr(getPaddingAttr(padding, rewriter));
+    rewriter.inlineRegionBefore(reduceWindowOp.getRegion(), newOp.getRegion(),
+                                newOp.getRegion().end());
+    rewriter.replaceOp(reduceWindowOp, newOp.getResults());
+    eraseIfDead(padOp, rewriter);
+
+    return success();
+  }
+};
+
+} // namespace
+
+namespace {
+
+struct FoldStablehloPadPass
+    : public FoldStablehloPadBase<FoldStablehloPadPass> {
+  /// Fold stablehlo.pad ops into their consumers.
+  void runOnOperation() override {
+    MLIRContext *ctx = &getContext();
+
+    RewritePatternSet patterns(ctx);
+    patterns.add<FoldPadIntoConvolution>(ctx);
+    patterns.add<FoldPadIntoReduceWindow>(ctx);
+
+    // Only visit the consumers of stablehlo.pad such that the remaining ops
+    // are left untouched for the conversion to EmitC.
+    SmallVector<Operation *> ops;
+    getOperation().walk([&](Operation *op) {
+      if (isa<stablehlo::ConvolutionOp, stablehlo::ReduceWindowOp>(op))
+        ops.push_back(op);
+    });
+
+    GreedyRewriteConfig config;
+    config.strictMode = GreedyRewriteStrictness::ExistingOps;
+    if (failed(applyOpPatternsAndFold(ops, std::move(patterns), config)))
+      signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldStablehloPadPass() {
+  return std::make_unique<FoldStablehloPadPass>();
+}
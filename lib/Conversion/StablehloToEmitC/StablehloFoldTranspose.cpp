@@ -0,0 +1,147 @@
+//===- StablehloFoldTranspose.cpp - Fold stablehlo.transpose into dot -----===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that folds `stablehlo.transpose` operations of
+// the operands of a matrix-matrix `stablehlo.dot` into the transpose flags of
+// the dot kernel such that the transpose is never materialized. The transposed
+// kernel is selected from the same backend as the dot kernel.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "stablehlo/dialect/StablehloOps.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/StablehloToEmitC/StablehloToEmitC.h"
+#include "emitc/Dialect/EmitC/KernelBackends.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns the input of the `stablehlo.transpose` defining `value` if it
+/// transposes a matrix.
+Value getTransposeInput(Value value) {
+  auto transposeOp = value.getDefiningOp<stablehlo::TransposeOp>();
+  if (!transposeOp)
+    return {};
+
+  ArrayRef<int64_t> permutation = transposeOp.getPermutation();
+  if (permutation.size() != 2 || permutation[0] != 1 || permutation[1] != 0)
+    return {};
+
+  return transposeOp.getOperand();
+}
+
+/// Fold transposed operands of `stablehlo.dot`.
+class FoldTransposeIntoDot : public OpRewritePattern<stablehlo::DotOp> {
+public:
+  FoldTransposeIntoDot(MLIRContext *ctx, StringRef funcName)
+      : OpRewritePattern<stablehlo::DotOp>(ctx), funcName(funcName) {}
+
+  LogicalResult matchAndRewrite(stablehlo::DotOp dotOp,
+                                PatternRewriter &rewriter) const override {
+    Value lhs = dotOp.getLhs();
+    Value rhs = dotOp.getRhs();
+    Value lhsInput = getTransposeInput(lhs);
+    Value rhsInput = getTransposeInput(rhs);
+    if (!lhsInput && !rhsInput)
+      return failure();
+
+    // Matrix-vector products are not transposed by the kernel.
+    if (lhs.getType().cast<ShapedType>().getRank() != 2 ||
+        rhs.getType().cast<ShapedType>().getRank() != 2)
+      return failure();
+
+    bool transposeLhs = static_cast<bool>(lhsInput);
+    bool transposeRhs = static_cast<bool>(rhsInput);
+
+    StringAttr callee = rewriter.getStringAttr(funcName);
+
+    Type resultType = dotOp.getType();
+    ArrayAttr args;
+    ArrayAttr templateArgs = rewriter.getArrayAttr(
+        {TypeAttr::get(resultType), rewriter.getBoolAttr(transposeLhs),
+         rewriter.getBoolAttr(transposeRhs)});
+
+    replaceOpWithPureCall(rewriter, dotOp, resultType, callee, args,
+                          templateArgs,
+                          ValueRange{transposeLhs ? lhsInput : lhs,
+                                     transposeRhs ? rhsInput : rhs});
+
+    // Erase the transposes once all uses are folded.
+    Operation *lhsOp = lhs.getDefiningOp();
+    Operation *rhsOp = rhs.getDefiningOp();
+    if (transposeLhs && lhsOp->use_empty())
+      rewriter.eraseOp(lhsOp);
+    if (transposeRhs && rhsOp != lhsOp && rhsOp->use_empty())
+      rewriter.eraseOp(rhsOp);
+
+    return success();
+  }
+
+private:
+  std::string funcName;
+};
+
+} // namespace
+
+namespace {
+
+struct FoldStablehloTransposePass
+    : public FoldStablehloTransposeBase<FoldStablehloTransposePass> {
+  FoldStablehloTransposePass() = default;
+  FoldStablehloTransposePass(ArrayRef<std::string> kernelBackends) {
+    this->kernelBackends = kernelBackends;
+  }
+
+  /// Fold stablehlo.transpose ops into dot ops.
+  void runOnOperation() override {
+    MLIRContext *ctx = &getContext();
+
+    KernelBackends backends;
+    if (failed(parseKernelBackends(kernelBackends,
+                                   getSelectableKernels("emitc::stablehlo"),
+                                   getOperation(), backends)))
+      return signalPassFailure();
+
+    RewritePatternSet patterns(ctx);
+    patterns.add<FoldTransposeIntoDot>(
+        ctx, getKernelCallee("emitc::stablehlo", "dot", backends) +
+                 "_transposed");
+
+    // Only visit the dot ops such that the remaining ops are left untouched
+    // for the conversion to EmitC.
+    SmallVector<Operation *> ops;
+    getOperation().walk([&](stablehlo::DotOp op) { ops.push_back(op); });
+
+    GreedyRewriteConfig config;
+    config.strictMode = GreedyRewriteStrictness::ExistingOps;
+    if (failed(applyOpPatternsAndFold(ops, std::move(patterns), config)))
+      signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldStablehloTransposePass() {
+  return std::make_unique<FoldStablehloTransposePass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldStablehloTransposePass(
+    ArrayRef<std::string> kernelBackends) {
+  return std::make_unique<FoldStablehloTransposePass>(kernelBackends);
+}
@@ -15,11 +15,16 @@
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/IRMapping.h"
+#include "mlir/IR/TypeUtilities.h"
 #include "mlir/Pass/Pass.h"
 #include "stablehlo/dialect/StablehloOps.h"
+#include "llvm/ADT/StringRef.h"
 
 #include "../PassDetail.h"
 #include "emitc/Conversion/StablehloToEmitC/StablehloToEmitC.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
+
+#include <optional>
 
 using namespace mlir;
 using namespace mlir::emitc;
@@ -34,6 +39,115 @@ SmallVector<Attribute, 2> indexSequence(int64_t n, MLIRContext *ctx) {
       }));
 }
 
+/// Returns the direction of `op` if its comparator is a plain `LT` or `GT`
+/// comparison of the first operand, which the reference implementation sorts
+/// without calling the comparator.
+std::optional<StringRef> getNativeSortDirection(stablehlo::SortOp op) {
+  Region &comparator = op.getComparator();
+  if (!comparator.hasOneBlock())
+    return std::nullopt;
+
+  Block &block = comparator.front();
+  if (block.getOperations().size() != 2)
+    return std::nullopt;
+
+  auto compareOp = dyn_cast<stablehlo::CompareOp>(block.front());
+  auto returnOp = dyn_cast<stablehlo::ReturnOp>(block.getTerminator());
+  if (!compareOp || !returnOp || returnOp.getNumOperands() != 1 ||
+      returnOp.getOperand(0) != compareOp.getResult())
+    return std::nullopt;
+
+  // A total order or an unsigned comparison of signless integers differs from
+  // the native comparison of the element type.
+  Type elementType = getElementTypeOrSelf(op.getInputs().front().getType());
+  std::optional<stablehlo::ComparisonType> compareType =
+      compareOp.getCompareType();
+  if (compareType == stablehlo::ComparisonType::TOTALORDER ||
+      (compareType == stablehlo::ComparisonType::UNSIGNED &&
+       !elementType.isUnsignedInteger()))
+    return std::nullopt;
+
+  bool ascending;
+  switch (compareOp.getComparisonDirection()) {
+  case stablehlo::ComparisonDirection::LT:
+    ascending = true;
+    break;
+  case stablehlo::ComparisonDirection::GT:
+    ascending = false;
+    break;
+  default:
+    return std::nullopt;
+  }
+
+  Value lhs = block.getArgument(0);
+  Value rhs = block.getArgument(1);
+  if (compareOp.getLhs() == rhs && compareOp.getRhs() == lhs)
+    ascending = !ascending;
+  else if (compareOp.getLhs() != lhs || compareOp.getRhs() != rhs)
+    return std::nullopt;
+
+  return ascending ? StringRef("emitc::stablehlo::SortDirection::Ascending")
+                   : StringRef("emitc::stablehlo::SortDirection::Descending");
+}
+
+/// Returns true if the update computation of `op` adds the update to the
+/// operand, which the reference implementation does without calling it.
+bool isScatterAdd(stablehlo::ScatterOp op) {
+  Region &computation = op.getUpdateComputation();
+  if (!computation.hasOneBlock())
+    return false;
+
+  Block &block = computation.front();
+  if (block.getOperations().size() != 2)
+    return false;
+
+  auto addOp = dyn_cast<stablehlo::AddOp>(block.front());
+  auto returnOp = dyn_cast<stablehlo::ReturnOp>(block.getTerminator());
+  if (!addOp || !returnOp || returnOp.getNumOperands() != 1 ||
+      returnOp.getOperand(0) != addOp.getResult())
+    return false;
+
+  Value lhs = block.getArgument(0);
+  Value rhs = block.getArgument(1);
+  return (addOp.getLhs() == lhs && addOp.getRhs() == rhs) ||
+         (addOp.getLhs() == rhs && addOp.getRhs() == lhs);
+}
+
+/// Returns k if all uses of the results of `op` are slices to the first k
+/// elements along the sort dimension, and collects these slices.
+std::optional<int64_t>
+getTopK(stablehlo::SortOp op, SmallVectorImpl<stablehlo::SliceOp> &slices) {
+  uint64_t dimension = op.getDimension();
+  std::optional<int64_t> k;
+  for (Operation *user : op->getUsers()) {
+    auto sliceOp = dyn_cast<stablehlo::SliceOp>(user);
+    if (!sliceOp)
+      return std::nullopt;
+
+    ArrayRef<int64_t> shape =
+        sliceOp.getOperand().getType().cast<RankedTensorType>().getShape();
+    ArrayRef<int64_t> limits = sliceOp.getLimitIndices();
+    for (size_t i = 0; i < shape.size(); i++) {
+      if (sliceOp.getStartIndices()[i] != 0 || sliceOp.getStrides()[i] != 1 ||
+          (i != dimension && limits[i] != shape[i]))
+        return std::nullopt;
+    }
+    if (k.has_value() && *k != limits[dimension])
+      return std::nullopt;
+    k = limits[dimension];
+    slices.push_back(sliceOp);
+  }
+  return k;
+}
+
+/// Returns `type` with the extent of `dimension` set to `k`.
+Type getTopKType(Type type, uint64_t dimension, int64_t k) {
+  auto tensorType = type.cast<RankedTensorType>();
+  SmallVector<int64_t> shape(tensorType.getShape());
+  shape[dimension] = k;
+  return RankedTensorType::get(shape, tensorType.getElementType());
+}
+
 struct ConvertStablehloRegionOpsToEmitCPass
     : public ConvertStablehloRegionOpsToEmitCBase<
           ConvertStablehloRegionOpsToEmitCPass> {
@@ -97,6 +211,71 @@ struct ConvertStablehloRegionOpsToEmitCPass
       });
       if (funcWalkResult.wasInterrupted())
         return signalPassFailure();
+
+      // SortOp
+      // Sorts are collected first, as converting a top-k pattern also erases
+      // the slices following the sort.
+      SmallVector<stablehlo::SortOp> sortOps;
+      func.walk([&](stablehlo::SortOp op) { sortOps.push_back(op); });
+      for (stablehlo::SortOp op : sortOps) {
+        if (op.getNumResults() > 2) {
+          op.emitError("only sorts of one or two operands are supported");
+          return signalPassFailure();
+        }
+
+        if (std::optional<StringRef> direction = getNativeSortDirection(op)) {
+          convertToCall(op, *direction);
+          continue;
+        }
+
+        std::string funcName =
+            Twine(op->getParentOfType<func::FuncOp>().getName(), "_lambda_")
+                .concat(Twine(count++))
+                .str();
+
+        std::optional<func::FuncOp> outlinedFunc =
+            outlineRegionImpl(op, op.getComparator(), funcName);
+
+        if (!outlinedFunc.has_value())
+          return signalPassFailure();
+
+        symbolTable.insert(outlinedFunc.value(), insertPt);
+
+        convertToCall(op, SymbolRefAttr::get(&getContext(),
+                                             outlinedFunc.value().getName()));
+      }
+
+      // ScatterOp
+      funcWalkResult = func.walk([&](stablehlo::ScatterOp op) {
+        if (op.getInputs().size() != 1) {
+          op.emitError("only scatters of one operand are supported");
+          return WalkResult::interrupt();
+        }
+
+        if (isScatterAdd(op)) {
+          convertToCall(op, std::nullopt);
+          return WalkResult::advance();
+        }
+
+        std::string funcName =
+            Twine(op->getParentOfType<func::FuncOp>().getName(), "_lambda_")
+                .concat(Twine(count++))
+                .str();
+
+        std::optional<func::FuncOp> outlinedFunc =
+            outlineRegionImpl(op, op.getUpdateComputation(), funcName);
+
+        if (!outlinedFunc.has_value()) {
+          return WalkResult::interrupt();
+        }
+
+        symbolTable.insert(outlinedFunc.value(), insertPt);
+
+        convertToCall(op, outlinedFunc.value());
+        return WalkResult::advance();
+      });
+      if (funcWalkResult.wasInterrupted())
+        return signalPassFailure();
     }
   }
 
@@ -104,13 +283,18 @@ private:
   template <typename OpType>
   std::optional<func::FuncOp>
   outlineRegionImpl(OpType &op, const std::string &functionName) {
+    return outlineRegionImpl(op, op.getRegion(), functionName);
+  }
+
+  template <typename OpType>
+  std::optional<func::FuncOp>
+  outlineRegionImpl(OpType &op, Region &region,
+                    const std::string &functionName) {
     Location loc = op.getLoc();
     // Create a builder with no insertion point, insertion will happen
     // separately due to symbol table manipulation.
     OpBuilder builder(op.getContext());
 
-    Region &region = op.getRegion();
-
     auto &blocks = region.getBlocks();
 
     if (blocks.size() > 1) {
@@ -129,6 +313,8 @@ private:
 
     FunctionType type = FunctionType::get(op.getContext(), inputs, results);
     auto outlinedFunc = builder.create<func::FuncOp>(loc, functionName, type);
+    // Outlined functions are only referenced from within the module.
+    outlinedFunc.setPrivate();
 
     Region &outlinedRegion = outlinedFunc.getRegion();
 
@@ -172,8 +358,9 @@ private:
 
     ArrayAttr templateArgs = ArrayAttr::get(ctx, templateArguments);
 
-    emitc::CallOpaqueOp callOpaqueOp = builder.create<emitc::CallOpaqueOp>(
-        op.getLoc(), op.getResultTypes(), callee, args, templateArgs, operands);
+    emitc::CallOpaqueOp callOpaqueOp = createPureCall(
+        builder, op.getLoc(), op.getResultTypes(), callee, args, templateArgs,
+        operands);
     op.replaceAllUsesWith(callOpaqueOp);
     op.erase();
     return success();
@@ -208,12 +395,118 @@ private:
     ArrayAttr templateArgs =
         ArrayAttr::get(ctx, {TypeAttr::get(op.getResult(0).getType())});
 
-    emitc::CallOpaqueOp callOpaqueOp = builder.create<emitc::CallOpaqueOp>(
-        op.getLoc(), op.getType(0), callee, args, templateArgs, operands);
+    emitc::CallOpaqueOp callOpaqueOp = createPureCall(
+        builder, op.getLoc(), op.getType(0), callee, args, templateArgs,
+        operands);
     op.replaceAllUsesWith(callOpaqueOp);
     op.erase();
     return success();
   }
+
+  /// Converts `op` into a call of `emitc::stablehlo::sort`, which orders by
+  /// `comparator`. This is either a sort direction or an outlined comparator
+  /// function. A sort whose results are only sliced to the first k elements
+  /// along the sort dimension is converted into a call of
+  /// `emitc::stablehlo::top_k` instead, if it sorts in a native direction.
+  void convertToCall(stablehlo::SortOp &op, Attribute comparator) {
+    OpBuilder builder(op);
+    auto *ctx = op.getContext();
+
+    auto operands = op.getOperands();
+    uint64_t dimension = op.getDimension();
+
+    SmallVector<stablehlo::SliceOp> slices;
+    std::optional<int64_t> k;
+    if (comparator.isa<emitc::OpaqueAttr>())
+      k = getTopK(op, slices);
+
+    SmallVector<Type> resultTypes(op.getResultTypes());
+    if (k.has_value()) {
+      for (Type &type : resultTypes)
+        type = getTopKType(type, dimension, *k);
+    }
+
+    SmallVector<Attribute, 2> arguments = indexSequence(operands.size(), ctx);
+    arguments.push_back(builder.getI64IntegerAttr(dimension));
+    if (!k.has_value())
+      arguments.push_back(builder.getBoolAttr(op.getIsStable()));
+    arguments.push_back(comparator);
+
+    ArrayAttr args = ArrayAttr::get(ctx, arguments);
+
+    SmallVector<Attribute, 2> templateArguments = llvm::to_vector<2>(
+        llvm::map_range(resultTypes, [](Type type) -> Attribute {
+          return TypeAttr::get(type);
+        }));
+
+    ArrayAttr templateArgs = ArrayAttr::get(ctx, templateArguments);
+
+    StringRef funcName =
+        k.has_value() ? "emitc::stablehlo::top_k" : "emitc::stablehlo::sort";
+    StringAttr callee = StringAttr::get(ctx, funcName);
+
+    emitc::CallOpaqueOp callOpaqueOp = createPureCall(builder, op.getLoc(),
+                                                      resultTypes, callee, args,
+                                                      templateArgs, operands);
+    if (k.has_value()) {
+      for (stablehlo::SliceOp sliceOp : slices) {
+        auto result = sliceOp.getOperand().cast<OpResult>();
+        sliceOp.replaceAllUsesWith(
+            callOpaqueOp.getResult(result.getResultNumber()));
+        sliceOp.erase();
+      }
+    } else {
+      op.replaceAllUsesWith(callOpaqueOp);
+    }
+    op.erase();
+  }
+
+  /// Converts `op` into a call of `emitc::stablehlo::scatter` with the
+  /// outlined update computation `funcOp`, or into a call of
+  /// `emitc::stablehlo::scatter_add` if there is none.
+  void convertToCall(stablehlo::ScatterOp &op,
+                     std::optional<func::FuncOp> funcOp) {
+    OpBuilder builder(op);
+    auto *ctx = op.getContext();
+
+    auto operands = op.getOperands();
+    stablehlo::ScatterDimensionNumbersAttr dimensionNumbers =
+        op.getScatterDimensionNumbers();
+
+    StringRef funcName = funcOp.has_value() ? "emitc::stablehlo::scatter"
+                                            : "emitc::stablehlo::scatter_add";
+    StringAttr callee = StringAttr::get(ctx, funcName);
+
+    SmallVector<Attribute, 2> arguments = indexSequence(operands.size(), ctx);
+
+    arguments.push_back(
+        builder.getI64TensorAttr(dimensionNumbers.getUpdateWindowDims()));
+    arguments.push_back(
+        builder.getI64TensorAttr(dimensionNumbers.getInsertedWindowDims()));
+    arguments.push_back(builder.getI64TensorAttr(
+        dimensionNumbers.getScatterDimsToOperandDims()));
+    arguments.push_back(
+        builder.getI64IntegerAttr(dimensionNumbers.getIndexVectorDim()));
+    arguments.push_back(builder.getBoolAttr(op.getIndicesAreSorted()));
+    arguments.push_back(builder.getBoolAttr(op.getUniqueIndices()));
+    if (funcOp.has_value())
+      arguments.push_back(SymbolRefAttr::get(ctx, funcOp->getName()));
+
+    ArrayAttr args = ArrayAttr::get(ctx, arguments);
+
+    ArrayAttr templateArgs =
+        ArrayAttr::get(ctx, {TypeAttr::get(op.getResult(0).getType())});
+
+    emitc::CallOpaqueOp callOpaqueOp = createPureCall(
+        builder, op.getLoc(), op.getResultTypes(), callee, args, templateArgs,
+        operands);
+    op.replaceAllUsesWith(callOpaqueOp);
+    op.erase();
+  }
+
+  void convertToCall(stablehlo::SortOp &op, StringRef direction) {
+    convertToCall(op, emitc::OpaqueAttr::get(op.getContext(), direction));
+  }
 };
 
 } // namespace
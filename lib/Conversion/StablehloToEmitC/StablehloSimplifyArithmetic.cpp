@@ -0,0 +1,199 @@
+//===- StablehloSimplifyArithmetic.cpp - Algebraic simplification ---------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that applies algebraic simplifications to
+// StableHLO operations with constant operands, e.g. `pow(x, 2)` is rewritten
+// to `x * x` and additions of -0.0 are removed.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "stablehlo/dialect/StablehloOps.h"
+#include "llvm/ADT/TypeSwitch.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/StablehloToEmitC/StablehloToEmitC.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns true if `value` is a constant splat of zero.
+bool isZero(Value value) {
+  return matchPattern(value, m_AnyZeroFloat()) ||
+         matchPattern(value, m_Zero());
+}
+
+/// Returns true if `value` is a constant splat of zero that is an exact
+/// identity of addition. For floats, only -0.0 is, as -0.0 + 0.0 is +0.0.
+bool isAddIdentity(Value value) {
+  return matchPattern(value, m_NegZeroFloat()) ||
+         matchPattern(value, m_Zero());
+}
+
+/// Returns true if `value` is a constant splat of zero that is an exact
+/// identity of subtraction. For floats, only +0.0 is, as -0.0 - -0.0 is +0.0.
+bool isSubIdentity(Value value) {
+  return matchPattern(value, m_PosZeroFloat()) ||
+         matchPattern(value, m_Zero());
+}
+
+/// Returns true if `value` is a constant splat of one.
+bool isOne(Value value) {
+  return matchPattern(value, m_OneFloat()) || matchPattern(value, m_One());
+}
+
+class ArithmeticSimplifier {
+public:
+  ArithmeticSimplifier(bool fastMath, RewriterBase &rewriter)
+      : fastMath(fastMath), rewriter(rewriter) {}
+
+  /// Simplifies `op` and returns success if it was rewritten.
+  LogicalResult simplify(Operation *op) {
+    SmallVector<Value> operands(op->getOperands());
+    LogicalResult result =
+        llvm::TypeSwitch<Operation *, LogicalResult>(op)
+            .Case<stablehlo::AddOp>([&](auto) {
+              return removeIdentity(op, fastMath ? isZero : isAddIdentity,
+                                    /*commutative=*/true);
+            })
+            .Case<stablehlo::SubtractOp>([&](auto) {
+              return removeIdentity(op, fastMath ? isZero : isSubIdentity,
+                                    /*commutative=*/false);
+            })
+            .Case<stablehlo::MulOp>([&](auto) {
+              return removeIdentity(op, isOne, /*commutative=*/true);
+            })
+            .Case<stablehlo::DivOp>(
+                [&](stablehlo::DivOp divOp) { return simplifyDiv(divOp); })
+            .Case<stablehlo::PowOp>(
+                [&](stablehlo::PowOp powOp) { return simplifyPow(powOp); })
+            .Default([](Operation *) { return failure(); });
+
+    if (succeeded(result))
+      eraseDeadConstants(operands, rewriter);
+    return result;
+  }
+
+private:
+  /// Replaces the binary `op` by one of its operands if the other operand is
+  /// an identity element.
+  LogicalResult removeIdentity(Operation *op,
+                               function_ref<bool(Value)> isIdentity,
+                               bool commutative) {
+    Value lhs = op->getOperand(0);
+    Value rhs = op->getOperand(1);
+    Type resultType = op->getResult(0).getType();
+
+    if (lhs.getType() == resultType && isIdentity(rhs)) {
+      rewriter.replaceOp(op, lhs);
+      return success();
+    }
+    if (commutative && rhs.getType() == resultType && isIdentity(lhs)) {
+      rewriter.replaceOp(op, rhs);
+      return success();
+    }
+    return failure();
+  }
+
+  /// Removes divisions by one and, with fast-math only, replaces floating
+  /// point divisions by a constant with multiplications by its reciprocal.
+  LogicalResult simplifyDiv(stablehlo::DivOp divOp) {
+    if (succeeded(removeIdentity(divOp, isOne, /*commutative=*/false)))
+      return success();
+
+    DenseElementsAttr divisor;
+    if (!fastMath || !matchPattern(divOp.getRhs(), m_Constant(&divisor)))
+      return failure();
+
+    FailureOr<DenseElementsAttr> reciprocal = reciprocalConstant(divisor);
+    if (failed(reciprocal))
+      return failure();
+
+    rewriter.setInsertionPoint(divOp);
+    auto constOp =
+        rewriter.create<stablehlo::ConstantOp>(divOp.getLoc(), *reciprocal);
+    rewriter.replaceOpWithNewOp<stablehlo::MulOp>(divOp, divOp.getType(),
+                                                  divOp.getLhs(), constOp);
+    return success();
+  }
+
+  /// Replaces `pow(x, c)` for a constant splat `c` of 1 or 2 by cheaper ops.
+  /// With fast-math only, floating point `pow(x, 0.5)` is replaced by
+  /// `sqrt(x)`, which differs for -0.0 and -inf, and `pow(x, -0.5)` by
+  /// `rsqrt(x)`, which rounds differently.
+  LogicalResult simplifyPow(stablehlo::PowOp powOp) {
+    Value x = powOp.getLhs();
+    Value exponent = powOp.getRhs();
+    Type resultType = powOp.getType();
+
+    APFloat floatExponent(0.0);
+    APInt intExponent;
+    bool isFloat = matchPattern(exponent, m_ConstantFloat(&floatExponent));
+    if (!isFloat && !matchPattern(exponent, m_ConstantInt(&intExponent)))
+      return failure();
+
+    auto isExponent = [&](int64_t value) {
+      return isFloat ? floatExponent.isExactlyValue(value)
+                     : intExponent.getSExtValue() == value;
+    };
+
+    rewriter.setInsertionPoint(powOp);
+    if (isExponent(1)) {
+      rewriter.replaceOp(powOp, x);
+    } else if (isExponent(2)) {
+      rewriter.replaceOpWithNewOp<stablehlo::MulOp>(powOp, resultType, x, x);
+    } else if (isFloat && floatExponent.isExactlyValue(0.5) && fastMath) {
+      rewriter.replaceOpWithNewOp<stablehlo::SqrtOp>(powOp, resultType, x);
+    } else if (isFloat && floatExponent.isExactlyValue(-0.5) && fastMath) {
+      rewriter.replaceOpWithNewOp<stablehlo::RsqrtOp>(powOp, resultType, x);
+    } else {
+      return failure();
+    }
+    return success();
+  }
+
+  bool fastMath;
+  RewriterBase &rewriter;
+};
+
+} // namespace
+
+namespace {
+
+struct SimplifyStablehloArithmeticPass
+    : public SimplifyStablehloArithmeticBase<SimplifyStablehloArithmeticPass> {
+  /// Apply algebraic simplifications to StableHLO ops.
+  void runOnOperation() override {
+    IRRewriter rewriter(&getContext());
+    ArithmeticSimplifier simplifier(fastMath, rewriter);
+
+    SmallVector<Operation *> ops;
+    getOperation().walk([&](Operation *op) {
+      if (isa<stablehlo::AddOp, stablehlo::DivOp, stablehlo::MulOp,
+              stablehlo::PowOp, stablehlo::SubtractOp>(op))
+        ops.push_back(op);
+    });
+
+    for (Operation *op : ops)
+      if (succeeded(simplifier.simplify(op)))
+        numSimplifiedOps++;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createSimplifyStablehloArithmeticPass() {
+  return std::make_unique<SimplifyStablehloArithmeticPass>();
+}
@@ -20,6 +20,8 @@
 #include "../PassDetail.h"
 #include "emitc/Conversion/EmitCCommon/GenericOpConversion.h"
 #include "emitc/Conversion/StablehloToEmitC/StablehloToEmitC.h"
+#include "emitc/Dialect/EmitC/KernelBackends.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
 
 using namespace mlir;
 using namespace mlir::emitc;
@@ -75,9 +77,9 @@ private:
         {TypeAttr::get(batchNormInferenceOp.getResult().getType()),
          TypeAttr::get(adaptor.getScale().getType())});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        batchNormInferenceOp, batchNormInferenceOp.getType(), callee, args,
-        templateArgs, adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, batchNormInferenceOp,
+                          batchNormInferenceOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -88,7 +90,9 @@ class BroadcastInDimOpConversion
     : public OpConversionPattern<stablehlo::BroadcastInDimOp> {
 
 public:
-  BroadcastInDimOpConversion(MLIRContext *ctx) : OpConversionPattern(ctx) {}
+  BroadcastInDimOpConversion(MLIRContext *ctx, bool attributesAsTemplateArgs)
+      : OpConversionPattern(ctx),
+        attributesAsTemplateArgs(attributesAsTemplateArgs) {}
 
 private:
   LogicalResult
@@ -97,24 +101,34 @@ private:
                   ConversionPatternRewriter &rewriter) const override {
     StringRef funcName = "emitc::stablehlo::broadcast_in_dim";
     StringAttr callee = rewriter.getStringAttr(funcName);
+    MLIRContext *ctx = broadcastInDimOp.getContext();
 
-    SmallVector<Attribute, 2> arguments = indexSequence(
-        adaptor.getOperands().size(), broadcastInDimOp.getContext());
-
-    arguments.push_back(
-        rewriter.getI64TensorAttr(broadcastInDimOp.getBroadcastDimensions()));
-
-    ArrayAttr args = rewriter.getArrayAttr(arguments);
+    ArrayAttr args;
+    SmallVector<Attribute, 2> templateArguments{
+        TypeAttr::get(broadcastInDimOp.getResult().getType())};
+
+    if (attributesAsTemplateArgs) {
+      templateArguments.push_back(getIntegerSequenceAttr(
+          broadcastInDimOp.getBroadcastDimensions(), ctx));
+    } else {
+      SmallVector<Attribute, 2> arguments =
+          indexSequence(adaptor.getOperands().size(), ctx);
+      arguments.push_back(rewriter.getI64TensorAttr(
+          broadcastInDimOp.getBroadcastDimensions()));
+      args = rewriter.getArrayAttr(arguments);
+    }
 
-    ArrayAttr templateArgs = rewriter.getArrayAttr(
-        {TypeAttr::get(broadcastInDimOp.getResult().getType())});
+    ArrayAttr templateArgs = rewriter.getArrayAttr(templateArguments);
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        broadcastInDimOp, broadcastInDimOp.getType(), callee, args,
-        templateArgs, adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, broadcastInDimOp,
+                          broadcastInDimOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
+
+  // If set, pass the broadcast dimensions as template argument.
+  bool attributesAsTemplateArgs;
 };
 
 /// Convert `stablehlo.concatenate` into an `emitc.call_opaque` operation.
@@ -137,9 +151,8 @@ private:
         {rewriter.getI64IntegerAttr(concatenateOp.getDimension()),
          TypeAttr::get(concatenateOp.getResult().getType())});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        concatenateOp, concatenateOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, concatenateOp, concatenateOp.getType(),
+                          callee, args, templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -149,14 +162,14 @@ private:
 class ConvOpConversion : public OpConversionPattern<stablehlo::ConvolutionOp> {
 
 public:
-  ConvOpConversion(MLIRContext *ctx) : OpConversionPattern(ctx) {}
+  ConvOpConversion(MLIRContext *ctx, StringRef funcName)
+      : OpConversionPattern(ctx), funcName(funcName) {}
 
 private:
   LogicalResult
   matchAndRewrite(stablehlo::ConvolutionOp convOp, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
 
-    StringRef funcName = "emitc::stablehlo::convolution";
     StringAttr callee = rewriter.getStringAttr(funcName);
 
     SmallVector<Attribute, 2> arguments =
@@ -197,12 +210,55 @@ private:
                                TypeAttr::get(adaptor.getLhs().getType()),
                                TypeAttr::get(adaptor.getRhs().getType())});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(convOp, convOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, convOp, convOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
+
+    return success();
+  }
+
+  std::string funcName;
+};
+
+/// Convert `stablehlo.dot_general` into an `emitc.call_opaque` operation.
+class DotGeneralOpConversion
+    : public OpConversionPattern<stablehlo::DotGeneralOp> {
+
+public:
+  DotGeneralOpConversion(MLIRContext *ctx, StringRef funcName)
+      : OpConversionPattern(ctx), funcName(funcName) {}
+
+private:
+  LogicalResult
+  matchAndRewrite(stablehlo::DotGeneralOp dotGeneralOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    StringAttr callee = rewriter.getStringAttr(funcName);
+
+    stablehlo::DotDimensionNumbersAttr dimensionNumbers =
+        dotGeneralOp.getDotDimensionNumbers();
+
+    SmallVector<Attribute, 2> arguments =
+        indexSequence(adaptor.getOperands().size(), dotGeneralOp.getContext());
+
+    arguments.push_back(
+        rewriter.getI64TensorAttr(dimensionNumbers.getLhsBatchingDimensions()));
+    arguments.push_back(
+        rewriter.getI64TensorAttr(dimensionNumbers.getRhsBatchingDimensions()));
+    arguments.push_back(rewriter.getI64TensorAttr(
+        dimensionNumbers.getLhsContractingDimensions()));
+    arguments.push_back(rewriter.getI64TensorAttr(
+        dimensionNumbers.getRhsContractingDimensions()));
+
+    ArrayAttr args = rewriter.getArrayAttr(arguments);
+    ArrayAttr templateArgs = rewriter.getArrayAttr(
+        {TypeAttr::get(dotGeneralOp.getResult().getType())});
+
+    replaceOpWithPureCall(rewriter, dotGeneralOp, dotGeneralOp.getType(),
+                          callee, args, templateArgs, adaptor.getOperands());
 
     return success();
   }
+
+  std::string funcName;
 };
 
 /// Convert `stablehlo.compare` into an `emitc.call_opaque` operation.
@@ -243,9 +299,8 @@ private:
         {TypeAttr::get(elementType),
          emitc::OpaqueAttr::get(ctx, functionName.value())});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        compareOp, compareOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, compareOp, compareOp.getType(), callee,
+                          args, templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -273,9 +328,9 @@ private:
     ArrayAttr templateArgs = rewriter.getArrayAttr(
         {IntegerAttr::get(rewriter.getIntegerType(32), index)});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        getTupleElementOp, getTupleElementOp.getType(), callee, args,
-        templateArgs, adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, getTupleElementOp,
+                          getTupleElementOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -286,8 +341,9 @@ class SliceOpConversion : public OpConversionPattern<stablehlo::SliceOp> {
   using OpConversionPattern<stablehlo::SliceOp>::OpConversionPattern;
 
 public:
-  SliceOpConversion(MLIRContext *ctx)
-      : OpConversionPattern<stablehlo::SliceOp>(ctx) {}
+  SliceOpConversion(MLIRContext *ctx, bool attributesAsTemplateArgs)
+      : OpConversionPattern<stablehlo::SliceOp>(ctx),
+        attributesAsTemplateArgs(attributesAsTemplateArgs) {}
 
 private:
   LogicalResult
@@ -295,27 +351,40 @@ private:
                   ConversionPatternRewriter &rewriter) const override {
     StringRef funcName = "emitc::stablehlo::slice";
     StringAttr callee = rewriter.getStringAttr(funcName);
+    MLIRContext *ctx = sliceOp.getContext();
 
-    SmallVector<Attribute, 2> arguments =
-        indexSequence(adaptor.getOperands().size(), sliceOp.getContext());
-
-    arguments.push_back(
-        rewriter.getI64TensorAttr(sliceOp.getStartIndicesAttr()));
-    arguments.push_back(
-        rewriter.getI64TensorAttr(sliceOp.getLimitIndicesAttr()));
-    arguments.push_back(rewriter.getI64TensorAttr(sliceOp.getStridesAttr()));
-
-    ArrayAttr args = rewriter.getArrayAttr(arguments);
+    ArrayAttr args;
+    SmallVector<Attribute, 4> templateArguments{
+        TypeAttr::get(sliceOp.getResult().getType())};
+
+    if (attributesAsTemplateArgs) {
+      templateArguments.push_back(
+          getIntegerSequenceAttr(sliceOp.getStartIndices(), ctx));
+      templateArguments.push_back(
+          getIntegerSequenceAttr(sliceOp.getLimitIndices(), ctx));
+      templateArguments.push_back(
+          getIntegerSequenceAttr(sliceOp.getStrides(), ctx));
+    } else {
+      SmallVector<Attribute, 2> arguments =
+          indexSequence(adaptor.getOperands().size(), ctx);
+      arguments.push_back(
+          rewriter.getI64TensorAttr(sliceOp.getStartIndicesAttr()));
+      arguments.push_back(
+          rewriter.getI64TensorAttr(sliceOp.getLimitIndicesAttr()));
+      arguments.push_back(rewriter.getI64TensorAttr(sliceOp.getStridesAttr()));
+      args = rewriter.getArrayAttr(arguments);
+    }
 
-    ArrayAttr templateArgs =
-        rewriter.getArrayAttr({TypeAttr::get(sliceOp.getResult().getType())});
+    ArrayAttr templateArgs = rewriter.getArrayAttr(templateArguments);
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(sliceOp, sliceOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, sliceOp, sliceOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
+
+  // If set, pass the indices as template arguments.
+  bool attributesAsTemplateArgs;
 };
 
 /// Convert `stablehlo.dynamic_slice` into an `emitc.call_opaque` operation.
@@ -345,9 +414,8 @@ private:
     ArrayAttr templateArgs = rewriter.getArrayAttr(
         {TypeAttr::get(dynamicSliceOp.getResult().getType())});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        dynamicSliceOp, dynamicSliceOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, dynamicSliceOp, dynamicSliceOp.getType(),
+                          callee, args, templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -377,49 +445,106 @@ private:
     ArrayAttr templateArgs =
         rewriter.getArrayAttr({TypeAttr::get(adaptor.getUpdate().getType())});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        dynamicUpdateSliceOp, dynamicUpdateSliceOp.getType(), callee, args,
-        templateArgs, adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, dynamicUpdateSliceOp,
+                          dynamicUpdateSliceOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
 };
 
-/// Convert `stablehlo.pad` into an `emitc.call_opaque` operation.
-class PadOpConversion : public OpConversionPattern<stablehlo::PadOp> {
-  using OpConversionPattern<stablehlo::PadOp>::OpConversionPattern;
+/// Convert `stablehlo.gather` into an `emitc.call_opaque` operation.
+class GatherOpConversion : public OpConversionPattern<stablehlo::GatherOp> {
+  using OpConversionPattern<stablehlo::GatherOp>::OpConversionPattern;
 
 public:
-  PadOpConversion(MLIRContext *ctx)
-      : OpConversionPattern<stablehlo::PadOp>(ctx) {}
+  GatherOpConversion(MLIRContext *ctx)
+      : OpConversionPattern<stablehlo::GatherOp>(ctx) {}
 
 private:
   LogicalResult
-  matchAndRewrite(stablehlo::PadOp padOp, OpAdaptor adaptor,
+  matchAndRewrite(stablehlo::GatherOp gatherOp, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    StringAttr callee = rewriter.getStringAttr("emitc::stablehlo::pad");
+    StringRef funcName = "emitc::stablehlo::gather";
+    StringAttr callee = rewriter.getStringAttr(funcName);
+
+    stablehlo::GatherDimensionNumbersAttr dimensionNumbers =
+        gatherOp.getDimensionNumbers();
 
     SmallVector<Attribute, 2> arguments =
-        indexSequence(adaptor.getOperands().size(), padOp.getContext());
+        indexSequence(adaptor.getOperands().size(), gatherOp.getContext());
 
     arguments.push_back(
-        rewriter.getI64TensorAttr(padOp.getEdgePaddingLowAttr()));
+        rewriter.getI64TensorAttr(dimensionNumbers.getOffsetDims()));
+    arguments.push_back(
+        rewriter.getI64TensorAttr(dimensionNumbers.getCollapsedSliceDims()));
     arguments.push_back(
-        rewriter.getI64TensorAttr(padOp.getEdgePaddingHighAttr()));
+        rewriter.getI64TensorAttr(dimensionNumbers.getStartIndexMap()));
     arguments.push_back(
-        rewriter.getI64TensorAttr(padOp.getInteriorPaddingAttr()));
+        rewriter.getI64IntegerAttr(dimensionNumbers.getIndexVectorDim()));
+    arguments.push_back(rewriter.getI64TensorAttr(gatherOp.getSliceSizes()));
 
     ArrayAttr args = rewriter.getArrayAttr(arguments);
 
+    ArrayAttr templateArgs = rewriter.getArrayAttr(
+        {TypeAttr::get(gatherOp.getResult().getType())});
+
+    replaceOpWithPureCall(rewriter, gatherOp, gatherOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
+
+    return success();
+  }
+};
+
+/// Convert `stablehlo.pad` into an `emitc.call_opaque` operation.
+class PadOpConversion : public OpConversionPattern<stablehlo::PadOp> {
+  using OpConversionPattern<stablehlo::PadOp>::OpConversionPattern;
+
+public:
+  PadOpConversion(MLIRContext *ctx, bool attributesAsTemplateArgs)
+      : OpConversionPattern<stablehlo::PadOp>(ctx),
+        attributesAsTemplateArgs(attributesAsTemplateArgs) {}
+
+private:
+  LogicalResult
+  matchAndRewrite(stablehlo::PadOp padOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    StringAttr callee = rewriter.getStringAttr("emitc::stablehlo::pad");
+    MLIRContext *ctx = padOp.getContext();
+
+    ArrayAttr args;
     Type resultType = padOp.getResult().getType();
-    ArrayAttr templateArgs = rewriter.getArrayAttr({TypeAttr::get(resultType)});
+    SmallVector<Attribute, 4> templateArguments{TypeAttr::get(resultType)};
+
+    if (attributesAsTemplateArgs) {
+      templateArguments.push_back(
+          getIntegerSequenceAttr(padOp.getEdgePaddingLow(), ctx));
+      templateArguments.push_back(
+          getIntegerSequenceAttr(padOp.getEdgePaddingHigh(), ctx));
+      templateArguments.push_back(
+          getIntegerSequenceAttr(padOp.getInteriorPadding(), ctx));
+    } else {
+      SmallVector<Attribute, 2> arguments =
+          indexSequence(adaptor.getOperands().size(), ctx);
+      arguments.push_back(
+          rewriter.getI64TensorAttr(padOp.getEdgePaddingLowAttr()));
+      arguments.push_back(
+          rewriter.getI64TensorAttr(padOp.getEdgePaddingHighAttr()));
+      arguments.push_back(
+          rewriter.getI64TensorAttr(padOp.getInteriorPaddingAttr()));
+      args = rewriter.getArrayAttr(arguments);
+    }
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(padOp, padOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    ArrayAttr templateArgs = rewriter.getArrayAttr(templateArguments);
+
+    replaceOpWithPureCall(rewriter, padOp, padOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
+
+  // If set, pass the paddings as template arguments.
+  bool attributesAsTemplateArgs;
 };
 
 /// Convert `stablehlo.transpose` into an `emitc.call_opaque` operation.
@@ -428,31 +553,42 @@ class TransposeOpConversion
   using OpConversionPattern<stablehlo::TransposeOp>::OpConversionPattern;
 
 public:
-  TransposeOpConversion(MLIRContext *ctx)
-      : OpConversionPattern<stablehlo::TransposeOp>(ctx) {}
+  TransposeOpConversion(MLIRContext *ctx, bool attributesAsTemplateArgs)
+      : OpConversionPattern<stablehlo::TransposeOp>(ctx),
+        attributesAsTemplateArgs(attributesAsTemplateArgs) {}
 
 private:
   LogicalResult
   matchAndRewrite(stablehlo::TransposeOp transposeOp, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
     StringAttr callee = rewriter.getStringAttr("emitc::stablehlo::transpose");
+    MLIRContext *ctx = transposeOp.getContext();
 
-    SmallVector<Attribute> arguments =
-        indexSequence(adaptor.getOperands().size(), transposeOp.getContext());
-
-    arguments.push_back(
-        rewriter.getI64TensorAttr(transposeOp.getPermutationAttr()));
-    ArrayAttr args = rewriter.getArrayAttr(arguments);
-
+    ArrayAttr args;
     Type resultType = transposeOp.getResult().getType();
-    ArrayAttr templateArgs = rewriter.getArrayAttr({TypeAttr::get(resultType)});
+    SmallVector<Attribute, 2> templateArguments{TypeAttr::get(resultType)};
+
+    if (attributesAsTemplateArgs) {
+      templateArguments.push_back(
+          getIntegerSequenceAttr(transposeOp.getPermutation(), ctx));
+    } else {
+      SmallVector<Attribute> arguments =
+          indexSequence(adaptor.getOperands().size(), ctx);
+      arguments.push_back(
+          rewriter.getI64TensorAttr(transposeOp.getPermutationAttr()));
+      args = rewriter.getArrayAttr(arguments);
+    }
+
+    ArrayAttr templateArgs = rewriter.getArrayAttr(templateArguments);
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        transposeOp, transposeOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, transposeOp, transposeOp.getType(), callee,
+                          args, templateArgs, adaptor.getOperands());
 
     return success();
   }
+
+  // If set, pass the permutation as template argument.
+  bool attributesAsTemplateArgs;
 };
 
 /// Convert `stablehlo.rng` into an `emitc.call_opaque` operation.
@@ -489,7 +625,13 @@ private:
 } // namespace
 
 void populateStablehloToEmitcPatterns(MLIRContext *ctx,
-                                      RewritePatternSet &patterns) {
+                                      RewritePatternSet &patterns,
+                                      bool attributesAsTemplateArgs,
+                                      const KernelBackends &backends) {
+  auto callee = [&](StringRef opName) {
+    return getKernelCallee("emitc::stablehlo", opName, backends);
+  };
+
   // Insert patterns for StableHLO nullary ops.
   patterns.add<ConstOpConversion>(ctx);
 
@@ -519,6 +661,8 @@ void populateStablehloToEmitcPatterns(MLIRContext *ctx,
       ctx, "emitc::stablehlo::negate");
   patterns.add<GenericOpConversion<stablehlo::RoundOp>>(
       ctx, "emitc::stablehlo::round");
+  patterns.add<GenericOpConversion<stablehlo::RsqrtOp>>(
+      ctx, "emitc::stablehlo::rsqrt");
   patterns.add<GenericOpConversion<stablehlo::SineOp>>(ctx,
                                                        "emitc::stablehlo::sin");
   patterns.add<GenericOpConversion<stablehlo::SqrtOp>>(
@@ -560,31 +704,33 @@ void populateStablehloToEmitcPatterns(MLIRContext *ctx,
   patterns.add<GetTupleElementOpConversion>(ctx);
 
   // Insert patterns for StableHLO slice ops.
-  patterns.add<SliceOpConversion>(ctx);
+  patterns.add<SliceOpConversion>(ctx, attributesAsTemplateArgs);
   patterns.add<DynamicSliceOpConversion>(ctx);
   patterns.add<DynamicUpdateSliceOpConversion>(ctx);
+  patterns.add<GatherOpConversion>(ctx);
 
   // Insert patterns for other StableHLO ops.
   patterns.add<BatchNormInferenceOpConversion>(ctx);
   patterns.add<GenericOpConversion<stablehlo::BitcastConvertOp>>(
       ctx, "emitc::stablehlo::bitcast_convert", /*explicitResultType=*/true);
-  patterns.add<BroadcastInDimOpConversion>(ctx);
+  patterns.add<BroadcastInDimOpConversion>(ctx, attributesAsTemplateArgs);
   patterns.add<GenericOpConversion<stablehlo::ClampOp>>(
       ctx, "emitc::stablehlo::clamp",
       /*explicitResultType=*/false,
       /*explicitOperandTypes=*/true);
   patterns.add<ConcatenateOpConversion>(ctx);
-  patterns.add<ConvOpConversion>(ctx);
+  patterns.add<ConvOpConversion>(ctx, callee("convolution"));
   patterns.add<GenericOpConversion<stablehlo::DotOp>>(
-      ctx, "emitc::stablehlo::dot",
+      ctx, callee("dot"),
       /*explicitResultType=*/true);
-  patterns.add<PadOpConversion>(ctx);
+  patterns.add<DotGeneralOpConversion>(ctx, callee("dot_general"));
+  patterns.add<PadOpConversion>(ctx, attributesAsTemplateArgs);
   patterns.add<GenericOpConversion<stablehlo::ReshapeOp>>(
       ctx, "emitc::stablehlo::reshape",
       /*explicitResultType=*/true);
   patterns.add<GenericOpConversion<stablehlo::SelectOp>>(
       ctx, "emitc::stablehlo::select");
-  patterns.add<TransposeOpConversion>(ctx);
+  patterns.add<TransposeOpConversion>(ctx, attributesAsTemplateArgs);
 
   // Insert patterns for StableHLO RNG ops.
   patterns.add<RngOpConversion>(ctx);
@@ -594,8 +740,18 @@ namespace {
 
 struct ConvertStablehloToEmitCPass
     : public ConvertStablehloToEmitCBase<ConvertStablehloToEmitCPass> {
+  ConvertStablehloToEmitCPass() = default;
+  ConvertStablehloToEmitCPass(ArrayRef<std::string> kernelBackends) {
+    this->kernelBackends = kernelBackends;
+  }
+
   /// Perform the lowering to EmitC dialect.
   void runOnOperation() override {
+    KernelBackends backends;
+    if (failed(parseKernelBackends(kernelBackends,
+                                   getSelectableKernels("emitc::stablehlo"),
+                                   getOperation(), backends)))
+      return signalPassFailure();
 
     ConversionTarget target(getContext());
 
@@ -619,6 +775,7 @@ struct ConvertStablehloToEmitCPass
                         stablehlo::Log1pOp,
                         stablehlo::NegOp,
                         stablehlo::RoundOp,
+                        stablehlo::RsqrtOp,
                         stablehlo::SineOp,
                         stablehlo::SqrtOp,
                         stablehlo::TanhOp>();
@@ -647,6 +804,7 @@ struct ConvertStablehloToEmitCPass
     // StableHLO slice ops.
     target.addIllegalOp<stablehlo::DynamicSliceOp,
                         stablehlo::DynamicUpdateSliceOp,
+                        stablehlo::GatherOp,
                         stablehlo::SliceOp>();
 
     // StableHLO region ops.
@@ -661,6 +819,7 @@ struct ConvertStablehloToEmitCPass
                         stablehlo::ConcatenateOp,
                         stablehlo::ConvolutionOp,
                         stablehlo::DotOp,
+                        stablehlo::DotGeneralOp,
                         stablehlo::PadOp,
                         stablehlo::ReshapeOp,
                         stablehlo::SelectOp,
@@ -671,7 +830,8 @@ struct ConvertStablehloToEmitCPass
     // clang-format on
 
     RewritePatternSet patterns(&getContext());
-    populateStablehloToEmitcPatterns(&getContext(), patterns);
+    populateStablehloToEmitcPatterns(&getContext(), patterns,
+                                     attributesAsTemplateArgs, backends);
 
     if (failed(applyPartialConversion(getOperation(), target,
                                       std::move(patterns))))
@@ -685,3 +845,9 @@ std::unique_ptr<OperationPass<func::FuncOp>>
 mlir::emitc::createConvertStablehloToEmitCPass() {
   return std::make_unique<ConvertStablehloToEmitCPass>();
 }
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createConvertStablehloToEmitCPass(
+    ArrayRef<std::string> kernelBackends) {
+  return std::make_unique<ConvertStablehloToEmitCPass>(kernelBackends);
+}
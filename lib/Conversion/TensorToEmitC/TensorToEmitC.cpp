@@ -19,6 +19,7 @@
 
 #include "../PassDetail.h"
 #include "emitc/Conversion/TensorToEmitC/TensorToEmitC.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
 
 using namespace mlir;
 using namespace mlir::emitc;
@@ -47,9 +48,8 @@ private:
     ArrayAttr args;
     ArrayAttr templateArgs;
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        indexCastOp, indexCastOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, indexCastOp, indexCastOp.getType(), callee,
+                          args, templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -73,9 +73,8 @@ private:
     Type resultType = splatOp.getResult().getType();
     ArrayAttr templateArgs = rewriter.getArrayAttr({TypeAttr::get(resultType)});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(splatOp, splatOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, splatOp, splatOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
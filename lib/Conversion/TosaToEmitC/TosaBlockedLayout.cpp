@@ -0,0 +1,267 @@
+//===- TosaBlockedLayout.cpp - Assign a blocked layout to TOSA chains -----===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that assigns a channel-blocked NCHWc layout to
+// chains of `tosa.conv2d`, `tosa.max_pool2d` and elementwise operations.
+// Reorders from and to the plain NHWC layout are only inserted at the
+// boundaries of a chain.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns the [N, ceil(C/B), H, W, B] type of a [N, H, W, C] `type`.
+RankedTensorType getBlockedType(ShapedType type, int64_t blockSize) {
+  ArrayRef<int64_t> shape = type.getShape();
+  return RankedTensorType::get({shape[0],
+                                llvm::divideCeil(shape[3], blockSize),
+                                shape[1], shape[2], blockSize},
+                               type.getElementType());
+}
+
+/// Returns true if `type` is a static NHWC floating point activation.
+bool isBlockableType(Type type) {
+  auto shapedType = type.dyn_cast<RankedTensorType>();
+  return shapedType && shapedType.hasStaticShape() &&
+         shapedType.getRank() == 4 &&
+         shapedType.getElementType().isa<FloatType>();
+}
+
+/// Returns an `emitc.call_opaque` operation to `funcName` with the result type
+/// as first template argument.
+Value createCall(Location loc, StringRef funcName, Type resultType,
+                 ValueRange operands, ArrayAttr args,
+                 ArrayRef<Attribute> extraTemplateArgs,
+                 RewriterBase &rewriter) {
+  SmallVector<Attribute> templateArgs{TypeAttr::get(resultType)};
+  llvm::append_range(templateArgs, extraTemplateArgs);
+  return createPureCall(rewriter, loc, resultType,
+                        rewriter.getStringAttr(funcName), args,
+                        rewriter.getArrayAttr(templateArgs), operands)
+      .getResult(0);
+}
+
+class BlockedLayoutAssignment {
+public:
+  BlockedLayoutAssignment(int64_t blockSize, RewriterBase &rewriter)
+      : blockSize(blockSize), rewriter(rewriter) {}
+
+  /// Assigns the blocked layout to `op` if possible.
+  void visit(Operation *op) {
+    if (auto convOp = dyn_cast<tosa::Conv2DOp>(op))
+      visitConv2D(convOp);
+    else if (auto poolOp = dyn_cast<tosa::MaxPool2dOp>(op))
+      visitMaxPool2d(poolOp);
+    else if (isa<tosa::AbsOp, tosa::AddOp, tosa::ClampOp, tosa::ExpOp,
+                 tosa::MaximumOp, tosa::MinimumOp, tosa::NegateOp,
+                 tosa::ReciprocalOp, tosa::SubOp, tosa::TanhOp>(op))
+      visitElementwise(op);
+  }
+
+  /// Reorders the values that are still used in the NHWC layout and erases the
+  /// replaced ops as well as weights that have been packed at compile time.
+  void finalize() {
+    for (auto &[op, blocked] : llvm::reverse(replaced)) {
+      Value result = op->getResult(0);
+      if (!result.use_empty()) {
+        rewriter.setInsertionPointAfterValue(blocked);
+        Value reordered =
+            createCall(op->getLoc(), "emitc::tosa::from_nchwc",
+                       result.getType(), blocked, ArrayAttr(), {}, rewriter);
+        rewriter.replaceAllUsesWith(result, reordered);
+        numReorders++;
+      }
+      rewriter.eraseOp(op);
+    }
+
+    for (Operation *op : packedConstants)
+      if (op->use_empty())
+        rewriter.eraseOp(op);
+  }
+
+  unsigned numBlockedOps = 0;
+  unsigned numReorders = 0;
+
+private:
+  /// Starts or continues a chain at a convolution.
+  void visitConv2D(tosa::Conv2DOp convOp) {
+    if (convOp.getQuantizationInfo().has_value() ||
+        !isBlockableType(convOp.getInput().getType()) ||
+        !isBlockableType(convOp.getType()))
+      return;
+
+    auto weightsType = convOp.getWeight().getType().cast<ShapedType>();
+    if (!weightsType.hasStaticShape())
+      return;
+
+    Location loc = convOp.getLoc();
+    rewriter.setInsertionPoint(convOp);
+
+    // Constant weights are packed at compile time, all others at runtime.
+    Value weights;
+    DenseElementsAttr weightsAttr;
+    FailureOr<DenseElementsAttr> packed = failure();
+    if (matchPattern(convOp.getWeight(), m_Constant(&weightsAttr)))
+      packed = packConstant(weightsAttr, blockSize);
+    if (succeeded(packed)) {
+      weights =
+          rewriter.create<tosa::ConstOp>(loc, packed->getType(), *packed);
+    } else {
+      SmallVector<int64_t> packedShape{
+          llvm::divideCeil(weightsType.getDimSize(0), blockSize)};
+      llvm::append_range(packedShape, weightsType.getShape().drop_front());
+      packedShape.push_back(blockSize);
+      weights = createCall(
+          loc, "emitc::tosa::pack_weights",
+          RankedTensorType::get(packedShape, weightsType.getElementType()),
+          convOp.getWeight(), ArrayAttr(), {}, rewriter);
+    }
+
+    // clang-format off
+    ArrayAttr args = rewriter.getArrayAttr({
+      rewriter.getIndexAttr(0),
+      rewriter.getIndexAttr(1),
+      rewriter.getIndexAttr(2),
+      rewriter.getI64TensorAttr(convOp.getPad()),
+      rewriter.getI64TensorAttr(convOp.getStride()),
+      rewriter.getI64TensorAttr(convOp.getDilation()),
+    });
+    // clang-format on
+
+    Value input = getOrCreateBlocked(convOp.getInput());
+    Value blocked = createCall(
+        loc, "emitc::tosa::conv2d_nchwc",
+        getBlockedType(convOp.getType(), blockSize),
+        ValueRange{input, weights, convOp.getBias()}, args,
+        {rewriter.getI64IntegerAttr(packedWeightsLayoutVersion)}, rewriter);
+    setBlocked(convOp, blocked);
+
+    if (succeeded(packed))
+      packedConstants.insert(convOp.getWeight().getDefiningOp());
+  }
+
+  /// Continues a chain at a max pooling.
+  void visitMaxPool2d(tosa::MaxPool2dOp poolOp) {
+    Value input = blockedValues.lookup(poolOp.getInput());
+    if (!input || !isBlockableType(poolOp.getType()))
+      return;
+
+    // clang-format off
+    ArrayAttr args = rewriter.getArrayAttr({
+      rewriter.getIndexAttr(0),
+      rewriter.getI64TensorAttr(poolOp.getPad()),
+      rewriter.getI64TensorAttr(poolOp.getStride()),
+      rewriter.getI64TensorAttr(poolOp.getKernel()),
+    });
+    // clang-format on
+
+    rewriter.setInsertionPoint(poolOp);
+    Value blocked = createCall(poolOp.getLoc(), "emitc::tosa::max_pool2d_nchwc",
+                               getBlockedType(poolOp.getType(), blockSize),
+                               input, args, {}, rewriter);
+    setBlocked(poolOp, blocked);
+  }
+
+  /// Continues a chain at an elementwise op if all tensor operands are blocked
+  /// and no broadcasting is involved. The op is cloned with blocked types.
+  void visitElementwise(Operation *op) {
+    Type resultType = op->getResult(0).getType();
+    if (!isBlockableType(resultType))
+      return;
+
+    SmallVector<Value> operands;
+    for (Value operand : op->getOperands()) {
+      Value blocked = blockedValues.lookup(operand);
+      if (!blocked || operand.getType() != resultType)
+        return;
+      operands.push_back(blocked);
+    }
+
+    rewriter.setInsertionPoint(op);
+    Operation *newOp = rewriter.create(
+        op->getLoc(), op->getName().getIdentifier(), operands,
+        {getBlockedType(resultType.cast<ShapedType>(), blockSize)},
+        op->getAttrs());
+    setBlocked(op, newOp->getResult(0));
+  }
+
+  /// Returns the blocked value of `value`, reordering it if needed.
+  Value getOrCreateBlocked(Value value) {
+    if (Value blocked = blockedValues.lookup(value))
+      return blocked;
+
+    Value blocked = createCall(
+        value.getLoc(), "emitc::tosa::to_nchwc",
+        getBlockedType(value.getType().cast<ShapedType>(), blockSize), value,
+        ArrayAttr(), {}, rewriter);
+    blockedValues[value] = blocked;
+    numReorders++;
+    return blocked;
+  }
+
+  void setBlocked(Operation *op, Value blocked) {
+    blockedValues[op->getResult(0)] = blocked;
+    replaced.push_back({op, blocked});
+    numBlockedOps++;
+  }
+
+  int64_t blockSize;
+  RewriterBase &rewriter;
+  DenseMap<Value, Value> blockedValues;
+  SmallVector<std::pair<Operation *, Value>> replaced;
+  llvm::SetVector<Operation *> packedConstants;
+};
+
+} // namespace
+
+namespace {
+
+struct TosaBlockedLayoutPass
+    : public TosaBlockedLayoutBase<TosaBlockedLayoutPass> {
+  /// Assign the blocked layout to chains of TOSA ops.
+  void runOnOperation() override {
+    if (blockSize <= 0) {
+      getOperation().emitError("block-size must be positive.");
+      return signalPassFailure();
+    }
+
+    IRRewriter rewriter(&getContext());
+    BlockedLayoutAssignment assignment(blockSize, rewriter);
+
+    SmallVector<Operation *> ops;
+    getOperation().walk([&](Operation *op) { ops.push_back(op); });
+    for (Operation *op : ops)
+      assignment.visit(op);
+    assignment.finalize();
+
+    numBlockedOps += assignment.numBlockedOps;
+    numReorders += assignment.numReorders;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createTosaBlockedLayoutPass() {
+  return std::make_unique<TosaBlockedLayoutPass>();
+}
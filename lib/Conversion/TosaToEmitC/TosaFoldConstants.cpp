@@ -0,0 +1,155 @@
+//===- TosaFoldConstants.cpp - Fold TOSA ops on constants -----------------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that evaluates TOSA operations whose operands
+// are all constants at compile time, e.g. transposes or casts of weights.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "llvm/ADT/TypeSwitch.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+
+#include <algorithm>
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Evaluates `tosa.rescale` like `emitc::tosa::rescale`.
+FailureOr<DenseElementsAttr> rescaleConstant(tosa::RescaleOp rescaleOp,
+                                             DenseElementsAttr input,
+                                             ShapedType resultType) {
+  Type srcType = input.getElementType();
+  Type destType = resultType.getElementType();
+  if (!srcType.isa<IntegerType>() || !destType.isa<IntegerType>())
+    return failure();
+
+  bool doubleRound = rescaleOp.getDoubleRound();
+  bool perChannel = rescaleOp.getPerChannel();
+  int64_t inputZp = rescaleOp.getInputZp();
+  int64_t outputZp = rescaleOp.getOutputZp();
+  SmallVector<int64_t> multiplier(rescaleOp.getMultiplier().begin(),
+                                  rescaleOp.getMultiplier().end());
+  SmallVector<int64_t> shift(rescaleOp.getShift().begin(),
+                             rescaleOp.getShift().end());
+
+  unsigned width = destType.getIntOrFloatBitWidth();
+  bool isSrcUnsigned = srcType.isUnsignedInteger();
+  bool isDestUnsigned = destType.isUnsignedInteger();
+  int64_t min =
+      isDestUnsigned ? 0 : APInt::getSignedMinValue(width).getSExtValue();
+  int64_t max = isDestUnsigned
+                    ? APInt::getMaxValue(width).getZExtValue()
+                    : APInt::getSignedMaxValue(width).getSExtValue();
+
+  int64_t channels = resultType.getDimSize(resultType.getRank() - 1);
+
+  SmallVector<APInt> result;
+  result.reserve(resultType.getNumElements());
+  for (auto [i, value] : llvm::enumerate(input.getValues<APInt>())) {
+    size_t index = perChannel ? i % channels : 0;
+    int64_t element =
+        (isSrcUnsigned ? value.getZExtValue() : value.getSExtValue()) - inputZp;
+
+    int64_t round = int64_t(1) << (shift[index] - 1);
+    if (doubleRound && shift[index] > 31)
+      round += element >= 0 ? (1 << 30) : -(1 << 30);
+    int32_t scaled = static_cast<int32_t>(
+        (element * multiplier[index] + round) >> shift[index]);
+
+    int64_t clamped = std::clamp<int64_t>(scaled + outputZp, min, max);
+    result.push_back(APInt(64, clamped, /*isSigned=*/true).trunc(width));
+  }
+
+  return DenseElementsAttr::get(resultType, result);
+}
+
+/// Evaluates `op` on its constant `operands`.
+FailureOr<DenseElementsAttr> evaluate(Operation *op,
+                                      ArrayRef<DenseElementsAttr> operands,
+                                      ShapedType resultType) {
+  return llvm::TypeSwitch<Operation *, FailureOr<DenseElementsAttr>>(op)
+      .Case<tosa::CastOp>([&](auto) {
+        return convertConstant(operands[0], resultType);
+      })
+      .Case<tosa::MulOp>([&](tosa::MulOp mulOp) {
+        return mulConstant(operands[0], operands[1], resultType,
+                           mulOp.getShift());
+      })
+      .Case<tosa::ReciprocalOp>([&](auto) {
+        return reciprocalConstant(operands[0]);
+      })
+      .Case<tosa::RescaleOp>([&](tosa::RescaleOp rescaleOp) {
+        return rescaleConstant(rescaleOp, operands[0], resultType);
+      })
+      .Case<tosa::ReshapeOp>([&](auto) -> FailureOr<DenseElementsAttr> {
+        return operands[0].reshape(resultType);
+      })
+      .Case<tosa::TransposeOp>([&](auto) {
+        SmallVector<int64_t> perms = llvm::to_vector(llvm::map_range(
+            operands[1].getValues<APInt>(),
+            [](const APInt &value) { return value.getSExtValue(); }));
+        return transposeConstant(operands[0], perms, resultType);
+      })
+      .Default([](Operation *) { return failure(); });
+}
+
+} // namespace
+
+namespace {
+
+struct FoldTosaConstantsPass
+    : public FoldTosaConstantsBase<FoldTosaConstantsPass> {
+  /// Replace TOSA ops with constant operands by `tosa.const` ops.
+  void runOnOperation() override {
+    IRRewriter rewriter(&getContext());
+
+    getOperation().walk([&](Operation *op) {
+      if (!isa<tosa::CastOp, tosa::MulOp, tosa::ReciprocalOp, tosa::RescaleOp,
+               tosa::ReshapeOp, tosa::TransposeOp>(op))
+        return;
+
+      auto resultType = op->getResult(0).getType().dyn_cast<RankedTensorType>();
+      if (!resultType || !resultType.hasStaticShape())
+        return;
+
+      FailureOr<SmallVector<DenseElementsAttr>> operands =
+          getConstantOperands(op);
+      if (failed(operands))
+        return;
+
+      FailureOr<DenseElementsAttr> result =
+          evaluate(op, *operands, resultType);
+      if (failed(result))
+        return;
+
+      SmallVector<Value> oldOperands(op->getOperands());
+      rewriter.setInsertionPoint(op);
+      rewriter.replaceOpWithNewOp<tosa::ConstOp>(op, resultType, *result);
+      eraseDeadConstants(oldOperands, rewriter);
+
+      numRemovedOps++;
+      numRemovedBytes += getSizeInBytes(resultType);
+    });
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldTosaConstantsPass() {
+  return std::make_unique<FoldTosaConstantsPass>();
+}
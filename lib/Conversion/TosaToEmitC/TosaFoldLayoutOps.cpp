@@ -0,0 +1,205 @@
+//===- TosaFoldLayoutOps.cpp - Compose and cancel TOSA layout ops ---------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that simplifies chains of `tosa.reshape` and
+// `tosa.transpose` operations. Each of these ops is lowered to a full copy,
+// hence chains are composed into a single op, identities are removed and
+// duplicated ops on the same operand are merged.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+
+#include <tuple>
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns the constant permutation of `transposeOp` or failure.
+FailureOr<SmallVector<int64_t>> getPerms(tosa::TransposeOp transposeOp) {
+  DenseIntElementsAttr permsAttr;
+  if (!matchPattern(transposeOp.getPerms(), m_Constant(&permsAttr)))
+    return failure();
+
+  return llvm::to_vector(
+      llvm::map_range(permsAttr.getValues<APInt>(),
+                      [](const APInt &value) { return value.getSExtValue(); }));
+}
+
+/// Returns true if a transpose by `perms` of `type` keeps all non-unit
+/// dimensions in order, i.e. it does not move any data.
+bool isReshape(ShapedType type, ArrayRef<int64_t> perms) {
+  int64_t last = -1;
+  for (int64_t dim : perms) {
+    if (type.getDimSize(dim) == 1)
+      continue;
+    if (dim < last)
+      return false;
+    last = dim;
+  }
+  return true;
+}
+
+class LayoutOpSimplifier {
+public:
+  LayoutOpSimplifier(RewriterBase &rewriter) : rewriter(rewriter) {}
+
+  /// Composes `reshapeOp` with the reshapes defining its input.
+  void simplify(tosa::ReshapeOp reshapeOp) {
+    Value input = reshapeOp.getInput1();
+    while (auto inputOp = input.getDefiningOp<tosa::ReshapeOp>())
+      input = inputOp.getInput1();
+
+    if (input.getType() == reshapeOp.getType()) {
+      rewriter.replaceOp(reshapeOp, input);
+      return;
+    }
+
+    Operation *op = reshapeOp;
+    if (input != reshapeOp.getInput1())
+      op = createReshape(reshapeOp, input);
+    deduplicate(op, input, Attribute());
+  }
+
+  /// Composes `transposeOp` with the transposes defining its input and
+  /// replaces it with a reshape if no data is moved.
+  void simplify(tosa::TransposeOp transposeOp) {
+    FailureOr<SmallVector<int64_t>> maybePerms = getPerms(transposeOp);
+    if (failed(maybePerms))
+      return;
+
+    SmallVector<int64_t> perms = *maybePerms;
+    Value input = transposeOp.getInput1();
+    while (auto inputOp = input.getDefiningOp<tosa::TransposeOp>()) {
+      FailureOr<SmallVector<int64_t>> inputPerms = getPerms(inputOp);
+      if (failed(inputPerms))
+        break;
+      for (int64_t &dim : perms)
+        dim = (*inputPerms)[dim];
+      input = inputOp.getInput1();
+    }
+
+    auto inputType = input.getType().cast<ShapedType>();
+    if (inputType == transposeOp.getType() &&
+        llvm::equal(perms, llvm::seq<int64_t>(0, perms.size()))) {
+      rewriter.replaceOp(transposeOp, input);
+      return;
+    }
+
+    if (inputType.hasStaticShape() && isReshape(inputType, perms)) {
+      Operation *op = createReshape(transposeOp, input);
+      simplify(cast<tosa::ReshapeOp>(op));
+      return;
+    }
+
+    auto permsType = RankedTensorType::get(
+        {static_cast<int64_t>(perms.size())}, rewriter.getI32Type());
+    auto permsAttr = DenseIntElementsAttr::get(
+        permsType, llvm::to_vector(llvm::map_range(perms, [](int64_t dim) {
+          return static_cast<int32_t>(dim);
+        })));
+
+    Operation *op = transposeOp;
+    if (input != transposeOp.getInput1()) {
+      rewriter.setInsertionPoint(transposeOp);
+      auto permsOp =
+          rewriter.create<tosa::ConstOp>(transposeOp.getLoc(), permsType,
+                                         permsAttr);
+      op = rewriter.replaceOpWithNewOp<tosa::TransposeOp>(
+          transposeOp, transposeOp.getType(), input, permsOp);
+    }
+    deduplicate(op, input, permsAttr);
+  }
+
+private:
+  /// Replaces `op` by a `tosa.reshape` of `input`.
+  Operation *createReshape(Operation *op, Value input) {
+    auto resultType = op->getResult(0).getType().cast<ShapedType>();
+    rewriter.setInsertionPoint(op);
+    return rewriter.replaceOpWithNewOp<tosa::ReshapeOp>(
+        op, resultType, input,
+        rewriter.getDenseI64ArrayAttr(resultType.getShape()));
+  }
+
+  /// Replaces `op` with an earlier layout op in the same block computing the
+  /// same result from `input`.
+  void deduplicate(Operation *op, Value input, Attribute perms) {
+    auto key = std::make_tuple(op->getBlock(), op->getName().getIdentifier(),
+                               input, op->getResult(0).getType(), perms);
+    auto [it, inserted] = layoutOps.try_emplace(key, op);
+    if (!inserted)
+      rewriter.replaceOp(op, it->second->getResults());
+  }
+
+  RewriterBase &rewriter;
+  DenseMap<std::tuple<Block *, StringAttr, Value, Type, Attribute>,
+           Operation *>
+      layoutOps;
+};
+
+} // namespace
+
+namespace {
+
+struct FoldTosaLayoutOpsPass
+    : public FoldTosaLayoutOpsBase<FoldTosaLayoutOpsPass> {
+  /// Compose and cancel tosa.reshape and tosa.transpose ops.
+  void runOnOperation() override {
+    IRRewriter rewriter(&getContext());
+    LayoutOpSimplifier simplifier(rewriter);
+
+    auto collectLayoutOps = [&]() {
+      SmallVector<Operation *> ops;
+      getOperation().walk([&](Operation *op) {
+        if (isa<tosa::ReshapeOp, tosa::TransposeOp>(op))
+          ops.push_back(op);
+      });
+      return ops;
+    };
+
+    SmallVector<Operation *> ops = collectLayoutOps();
+    int64_t numOpsBefore = ops.size();
+
+    SmallVector<Value> perms;
+    for (Operation *op : ops) {
+      if (auto reshapeOp = dyn_cast<tosa::ReshapeOp>(op)) {
+        simplifier.simplify(reshapeOp);
+      } else {
+        auto transposeOp = cast<tosa::TransposeOp>(op);
+        perms.push_back(transposeOp.getPerms());
+        simplifier.simplify(transposeOp);
+      }
+    }
+
+    // Erase ops of chains that are no longer used, users first, and the
+    // permutations of the replaced transposes.
+    for (Operation *op : llvm::reverse(collectLayoutOps()))
+      if (op->use_empty())
+        rewriter.eraseOp(op);
+    eraseDeadConstants(perms, rewriter);
+
+    numRemovedOps += numOpsBefore - collectLayoutOps().size();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldTosaLayoutOpsPass() {
+  return std::make_unique<FoldTosaLayoutOpsPass>();
+}
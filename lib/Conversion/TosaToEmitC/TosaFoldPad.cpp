@@ -0,0 +1,230 @@
+//===- TosaFoldPad.cpp - Fold tosa.pad into conv and pool ops -------------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that folds explicit `tosa.pad` operations into
+// the padding attribute of the consuming convolution or pooling operation.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns the explicit edge padding of the spatial dimensions of an NHWC
+/// `tosa.pad` in the `[top, bottom, left, right]` order used by the TOSA conv
+/// and pool ops. Fails if the padding is not constant or touches the batch or
+/// channel dimension.
+FailureOr<SmallVector<int64_t, 4>> getSpatialPadding(tosa::PadOp padOp) {
+  if (padOp.getQuantizationInfo().has_value())
+    return failure();
+
+  DenseIntElementsAttr paddingAttr;
+  if (!matchPattern(padOp.getPadding(), m_Constant(&paddingAttr)))
+    return failure();
+
+  SmallVector<int64_t, 8> padding = llvm::to_vector<8>(
+      llvm::map_range(paddingAttr.getValues<APInt>(),
+                      [](const APInt &value) { return value.getSExtValue(); }));
+
+  // Padding is [[n_lo, n_hi], [h_lo, h_hi], [w_lo, w_hi], [c_lo, c_hi]].
+  if (padding.size() != 8)
+    return failure();
+  if (padding[0] != 0 || padding[1] != 0 || padding[6] != 0 ||
+      padding[7] != 0)
+    return failure();
+  if (llvm::any_of(padding, [](int64_t p) { return p < 0; }))
+    return failure();
+
+  return SmallVector<int64_t, 4>{padding[2], padding[3], padding[4],
+                                 padding[5]};
+}
+
+/// Returns the scalar value `tosa.pad` fills the padded area with. A missing
+/// `pad_const` operand pads with zero.
+FailureOr<Attribute> getPadValue(tosa::PadOp padOp) {
+  Value padConst = padOp.getPadConst();
+  if (!padConst) {
+    Type elementType = getElementTypeOrSelf(padOp.getInput1().getType());
+    return Builder(padOp.getContext()).getZeroAttr(elementType);
+  }
+
+  DenseElementsAttr padConstAttr;
+  if (!matchPattern(padConst, m_Constant(&padConstAttr)) ||
+      !padConstAttr.isSplat())
+    return failure();
+
+  return padConstAttr.getSplatValue<Attribute>();
+}
+
+/// Erases `padOp` and its constant operands once all uses have been folded.
+void eraseIfDead(tosa::PadOp padOp, PatternRewriter &rewriter) {
+  if (!padOp->use_empty())
+    return;
+
+  SmallVector<Operation *, 2> operandOps;
+  for (Value operand : padOp->getOperands())
+    if (Operation *op = operand.getDefiningOp())
+      operandOps.push_back(op);
+  rewriter.eraseOp(padOp);
+
+  for (Operation *op : operandOps)
+    if (op->hasTrait<OpTrait::ConstantLike>() && op->use_empty())
+      rewriter.eraseOp(op);
+}
+
+bool isZero(Attribute value) {
+  if (auto floatAttr = value.dyn_cast<FloatAttr>())
+    return floatAttr.getValue().isZero();
+  if (auto intAttr = value.dyn_cast<IntegerAttr>())
+    return intAttr.getValue().isZero();
+  return false;
+}
+
+/// Returns true if `value` is not greater than any value of its type, i.e. it
+/// never wins a max reduction.
+bool isLowest(Attribute value) {
+  if (auto floatAttr = value.dyn_cast<FloatAttr>()) {
+    const APFloat &f = floatAttr.getValue();
+    return (f.isInfinity() && f.isNegative()) ||
+           f == APFloat::getLargest(f.getSemantics(), /*Negative=*/true);
+  }
+  if (auto intAttr = value.dyn_cast<IntegerAttr>())
+    return intAttr.getValue().isMinSignedValue();
+  return false;
+}
+
+/// Fold a zero-valued `tosa.pad` into the `pad` attribute of `tosa.conv2d` and
+/// `tosa.depthwise_conv2d`.
+template <typename ConvOp>
+class FoldPadIntoConv : public OpRewritePattern<ConvOp> {
+public:
+  using OpRewritePattern<ConvOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(ConvOp convOp,
+                                PatternRewriter &rewriter) const override {
+    // Quantized convolutions pad with the input zero point instead of zero.
+    if (convOp.getQuantizationInfo().has_value())
+      return failure();
+
+    auto padOp = convOp.getInput().template getDefiningOp<tosa::PadOp>();
+    if (!padOp)
+      return failure();
+
+    FailureOr<Attribute> padValue = getPadValue(padOp);
+    if (failed(padValue) || !isZero(*padValue))
+      return failure();
+
+    FailureOr<SmallVector<int64_t, 4>> padding = getSpatialPadding(padOp);
+    if (failed(padding))
+      return failure();
+
+    SmallVector<int64_t, 4> pad(convOp.getPad());
+    for (auto [p, q] : llvm::zip(pad, *padding))
+      p += q;
+
+    SmallVector<Value, 3> operands(convOp->getOperands());
+    operands[0] = padOp.getInput1();
+
+    auto newOp = rewriter.replaceOpWithNewOp<ConvOp>(
+        convOp, convOp.getType(), operands, convOp->getAttrs());
+    newOp.setPadAttr(rewriter.getDenseI64ArrayAttr(pad));
+    eraseIfDead(padOp, rewriter);
+
+    return success();
+  }
+};
+
+/// Fold a `tosa.pad` with the lowest value of the element type into the `pad`
+/// attribute of `tosa.max_pool2d`.
+///
+/// `tosa.avg_pool2d` is intentionally not handled: its implicit padding is
+/// excluded from the divisor, whereas explicitly padded zeros are counted.
+class FoldPadIntoMaxPool : public OpRewritePattern<tosa::MaxPool2dOp> {
+public:
+  using OpRewritePattern<tosa::MaxPool2dOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(tosa::MaxPool2dOp poolOp,
+                                PatternRewriter &rewriter) const override {
+    auto padOp = poolOp.getInput().getDefiningOp<tosa::PadOp>();
+    if (!padOp)
+      return failure();
+
+    FailureOr<Attribute> padValue = getPadValue(padOp);
+    if (failed(padValue) || !isLowest(*padValue))
+      return failure();
+
+    FailureOr<SmallVector<int64_t, 4>> padding = getSpatialPadding(padOp);
+    if (failed(padding))
+      return failure();
+
+    SmallVector<int64_t, 4> pad(poolOp.getPad());
+    for (auto [p, q] : llvm::zip(pad, *padding))
+      p += q;
+
+    // TOSA requires the padding to be smaller than the kernel.
+    ArrayRef<int64_t> kernel = poolOp.getKernel();
+    if (pad[0] >= kernel[0] || pad[1] >= kernel[0] || pad[2] >= kernel[1] ||
+        pad[3] >= kernel[1])
+      return failure();
+
+    auto newOp = rewriter.replaceOpWithNewOp<tosa::MaxPool2dOp>(
+        poolOp, poolOp.getType(), ValueRange{padOp.getInput1()},
+        poolOp->getAttrs());
+    newOp.setPadAttr(rewriter.getDenseI64ArrayAttr(pad));
+    eraseIfDead(padOp, rewriter);
+
+    return success();
+  }
+};
+
+} // namespace
+
+namespace {
+
+struct FoldTosaPadPass : public FoldTosaPadBase<FoldTosaPadPass> {
+  /// Fold tosa.pad ops into their consumers.
+  void runOnOperation() override {
+    MLIRContext *ctx = &getContext();
+
+    RewritePatternSet patterns(ctx);
+    patterns.add<FoldPadIntoConv<tosa::Conv2DOp>>(ctx);
+    patterns.add<FoldPadIntoConv<tosa::DepthwiseConv2DOp>>(ctx);
+    patterns.add<FoldPadIntoMaxPool>(ctx);
+
+    // Only visit the consumers of tosa.pad such that the remaining ops are
+    // left untouched for the conversion to EmitC.
+    SmallVector<Operation *> ops;
+    getOperation().walk([&](Operation *op) {
+      if (isa<tosa::Conv2DOp, tosa::DepthwiseConv2DOp, tosa::MaxPool2dOp>(op))
+        ops.push_back(op);
+    });
+
+    GreedyRewriteConfig config;
+    config.strictMode = GreedyRewriteStrictness::ExistingOps;
+    if (failed(applyOpPatternsAndFold(ops, std::move(patterns), config)))
+      signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldTosaPadPass() {
+  return std::make_unique<FoldTosaPadPass>();
+}
@@ -0,0 +1,204 @@
+//===- TosaFoldTranspose.cpp - Fold tosa.transpose into matmul ops --------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that folds `tosa.transpose` operations swapping
+// the two innermost dimensions of an operand of `tosa.matmul` or
+// `tosa.fully_connected` into the transpose flags of the matmul kernels such
+// that the transpose is never materialized. The transposed kernels are
+// selected from the same backend as the kernels of the folded ops.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+#include "emitc/Dialect/EmitC/KernelBackends.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns the input of the `tosa.transpose` defining `value` if it swaps the
+/// two innermost dimensions and leaves all other dimensions in place.
+Value getTransposeInput(Value value) {
+  auto transposeOp = value.getDefiningOp<tosa::TransposeOp>();
+  if (!transposeOp)
+    return {};
+
+  DenseIntElementsAttr permsAttr;
+  if (!matchPattern(transposeOp.getPerms(), m_Constant(&permsAttr)))
+    return {};
+
+  SmallVector<int64_t> perms = llvm::to_vector(
+      llvm::map_range(permsAttr.getValues<APInt>(),
+                      [](const APInt &value) { return value.getSExtValue(); }));
+
+  int64_t rank = perms.size();
+  if (rank < 2)
+    return {};
+
+  SmallVector<int64_t> swapped = llvm::to_vector(llvm::seq<int64_t>(0, rank));
+  std::swap(swapped[rank - 2], swapped[rank - 1]);
+  if (perms != swapped)
+    return {};
+
+  return transposeOp.getInput1();
+}
+
+/// Replaces the first two operands of `op` by the inputs of the transposes
+/// defining them and lowers `op` into an `emitc.call_opaque` operation to
+/// `funcName` with the transpose flags as template arguments.
+LogicalResult foldTransposes(Operation *op, StringRef funcName,
+                             PatternRewriter &rewriter) {
+  Value lhs = op->getOperand(0);
+  Value rhs = op->getOperand(1);
+  Value lhsInput = getTransposeInput(lhs);
+  Value rhsInput = getTransposeInput(rhs);
+  if (!lhsInput && !rhsInput)
+    return failure();
+
+  SmallVector<Value> operands(op->getOperands());
+  if (lhsInput)
+    operands[0] = lhsInput;
+  if (rhsInput)
+    operands[1] = rhsInput;
+
+  bool transposeLhs = static_cast<bool>(lhsInput);
+  bool transposeRhs = static_cast<bool>(rhsInput);
+
+  Type resultType = op->getResult(0).getType();
+  ArrayAttr args;
+  ArrayAttr templateArgs = rewriter.getArrayAttr(
+      {TypeAttr::get(resultType), rewriter.getBoolAttr(transposeLhs),
+       rewriter.getBoolAttr(transposeRhs)});
+
+  replaceOpWithPureCall(rewriter, op, resultType,
+                        rewriter.getStringAttr(funcName), args, templateArgs,
+                        operands);
+
+  // Erase the transposes and their permutations once all uses are folded.
+  llvm::SetVector<Operation *> transposeOps;
+  for (Value value : {lhs, rhs})
+    if (auto transposeOp = value.getDefiningOp<tosa::TransposeOp>())
+      transposeOps.insert(transposeOp);
+  for (Operation *transposeOp : transposeOps) {
+    if (!transposeOp->use_empty())
+      continue;
+    Value perms = transposeOp->getOperand(1);
+    rewriter.eraseOp(transposeOp);
+    eraseDeadConstants(perms, rewriter);
+  }
+
+  return success();
+}
+
+/// Fold transposed operands of `tosa.matmul`.
+class FoldTransposeIntoMatMul : public OpRewritePattern<tosa::MatMulOp> {
+public:
+  FoldTransposeIntoMatMul(MLIRContext *ctx, StringRef funcName)
+      : OpRewritePattern<tosa::MatMulOp>(ctx), funcName(funcName) {}
+
+  LogicalResult matchAndRewrite(tosa::MatMulOp matMulOp,
+                                PatternRewriter &rewriter) const override {
+    if (matMulOp.getQuantizationInfo().has_value())
+      return failure();
+
+    return foldTransposes(matMulOp, funcName, rewriter);
+  }
+
+private:
+  std::string funcName;
+};
+
+/// Fold transposed operands of `tosa.fully_connected`. The weights of
+/// `tosa.fully_connected` are stored as [OC,IC], i.e. a transpose of [IC,OC]
+/// weights is folded.
+class FoldTransposeIntoFullyConnected
+    : public OpRewritePattern<tosa::FullyConnectedOp> {
+public:
+  FoldTransposeIntoFullyConnected(MLIRContext *ctx, StringRef funcName)
+      : OpRewritePattern<tosa::FullyConnectedOp>(ctx), funcName(funcName) {}
+
+  LogicalResult matchAndRewrite(tosa::FullyConnectedOp fullyConnectedOp,
+                                PatternRewriter &rewriter) const override {
+    if (fullyConnectedOp.getQuantizationInfo().has_value())
+      return failure();
+
+    return foldTransposes(fullyConnectedOp, funcName, rewriter);
+  }
+
+private:
+  std::string funcName;
+};
+
+} // namespace
+
+namespace {
+
+struct FoldTosaTransposePass
+    : public FoldTosaTransposeBase<FoldTosaTransposePass> {
+  FoldTosaTransposePass() = default;
+  FoldTosaTransposePass(ArrayRef<std::string> kernelBackends) {
+    this->kernelBackends = kernelBackends;
+  }
+
+  /// Fold tosa.transpose ops into matmul ops.
+  void runOnOperation() override {
+    MLIRContext *ctx = &getContext();
+
+    KernelBackends backends;
+    if (failed(parseKernelBackends(kernelBackends,
+                                   getSelectableKernels("emitc::tosa"),
+                                   getOperation(), backends)))
+      return signalPassFailure();
+
+    auto callee = [&](StringRef opName) {
+      return getKernelCallee("emitc::tosa", opName, backends) + "_transposed";
+    };
+
+    RewritePatternSet patterns(ctx);
+    patterns.add<FoldTransposeIntoMatMul>(ctx, callee("matmul"));
+    patterns.add<FoldTransposeIntoFullyConnected>(ctx,
+                                                  callee("fully_connected"));
+
+    // Only visit the matmul ops such that the remaining ops are left untouched
+    // for the conversion to EmitC.
+    SmallVector<Operation *> ops;
+    getOperation().walk([&](Operation *op) {
+      if (isa<tosa::MatMulOp, tosa::FullyConnectedOp>(op))
+        ops.push_back(op);
+    });
+
+    GreedyRewriteConfig config;
+    config.strictMode = GreedyRewriteStrictness::ExistingOps;
+    if (failed(applyOpPatternsAndFold(ops, std::move(patterns), config)))
+      signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldTosaTransposePass() {
+  return std::make_unique<FoldTosaTransposePass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createFoldTosaTransposePass(ArrayRef<std::string> kernelBackends) {
+  return std::make_unique<FoldTosaTransposePass>(kernelBackends);
+}
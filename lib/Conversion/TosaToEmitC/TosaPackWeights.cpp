@@ -0,0 +1,215 @@
+//===- TosaPackWeights.cpp - Pre-pack constant TOSA weights ---------------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that packs constant weights of `tosa.conv2d`
+// and `tosa.fully_connected` into panels of output channels at compile time
+// and lowers the ops to the corresponding `*_prepacked` kernels. Large f32
+// weights can be stored compressed as f16, bf16 or int8 with a scale per
+// output channel, which the kernels dequantize while reading the panels.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/EmitCCommon/GenericOpConversion.h"
+#include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Constant weights in the packed layout and, for int8 weights, the scales of
+/// the output channels.
+struct PackedWeights {
+  DenseElementsAttr weights;
+  DenseElementsAttr scales;
+};
+
+/// Returns the f32 `weights` rounded to the f16 or bf16 `elementType`.
+DenseElementsAttr truncateWeights(DenseFPElementsAttr weights,
+                                  FloatType elementType) {
+  return weights.mapValues(elementType, [&](const APFloat &value) {
+    APFloat truncated = value;
+    bool losesInfo;
+    truncated.convert(elementType.getFloatSemantics(),
+                      APFloat::rmNearestTiesToEven, &losesInfo);
+    return truncated.bitcastToAPInt();
+  });
+}
+
+/// Quantizes the f32 `weights` to int8 with the symmetric scale
+/// max(abs(w)) / 127 per output channel. Fails for non-finite weights.
+FailureOr<PackedWeights> quantizeWeights(DenseFPElementsAttr weights) {
+  ShapedType type = weights.getType();
+  int64_t outputChannels = type.getDimSize(0);
+  int64_t innerSize = type.getNumElements() / outputChannels;
+  SmallVector<float> values = llvm::to_vector(weights.getValues<float>());
+
+  SmallVector<int8_t> quantized(values.size());
+  SmallVector<float> scales(outputChannels);
+  for (int64_t oc = 0; oc < outputChannels; oc++) {
+    ArrayRef<float> channel =
+        ArrayRef<float>(values).slice(oc * innerSize, innerSize);
+    float maxAbs = 0.0f;
+    for (float value : channel)
+      maxAbs = std::max(maxAbs, std::abs(value));
+    if (!std::isfinite(maxAbs))
+      return failure();
+
+    scales[oc] = maxAbs > 0.0f ? maxAbs / 127.0f : 1.0f;
+    for (int64_t k = 0; k < innerSize; k++) {
+      float q = std::round(channel[k] / scales[oc]);
+      quantized[oc * innerSize + k] =
+          static_cast<int8_t>(std::clamp(q, -127.0f, 127.0f));
+    }
+  }
+
+  MLIRContext *ctx = weights.getContext();
+  auto quantizedType =
+      RankedTensorType::get(type.getShape(), IntegerType::get(ctx, 8));
+  auto scalesType =
+      RankedTensorType::get({outputChannels}, Float32Type::get(ctx));
+  return PackedWeights{
+      DenseElementsAttr::get(quantizedType, ArrayRef<int8_t>(quantized)),
+      DenseElementsAttr::get(scalesType, ArrayRef<float>(scales))};
+}
+
+/// Returns the packed constant weights of `op` or failure if the weights are
+/// not constant. F32 weights of at least `minElements` elements are stored
+/// as `weightType`, if it is f16, bf16 or i8.
+template <typename SrcOp>
+FailureOr<PackedWeights> getPackedWeights(SrcOp op, int64_t blockSize,
+                                          StringRef weightType,
+                                          int64_t minElements) {
+  // Quantized ops are not supported by the prepacked kernels.
+  if (op.getQuantizationInfo().has_value())
+    return failure();
+
+  DenseElementsAttr weights;
+  if (!matchPattern(op.getWeight(), m_Constant(&weights)))
+    return failure();
+
+  PackedWeights compressed{weights, {}};
+  auto fpWeights = weights.dyn_cast<DenseFPElementsAttr>();
+  if (fpWeights && fpWeights.getElementType().isF32() &&
+      fpWeights.getNumElements() >= minElements) {
+    MLIRContext *ctx = op.getContext();
+    if (weightType == "f16") {
+      compressed.weights = truncateWeights(fpWeights, FloatType::getF16(ctx));
+    } else if (weightType == "bf16") {
+      compressed.weights = truncateWeights(fpWeights, FloatType::getBF16(ctx));
+    } else if (weightType == "i8") {
+      FailureOr<PackedWeights> quantized = quantizeWeights(fpWeights);
+      if (succeeded(quantized))
+        compressed = *quantized;
+    }
+  }
+
+  FailureOr<DenseElementsAttr> packed =
+      packConstant(compressed.weights, blockSize);
+  if (failed(packed))
+    return failure();
+  return PackedWeights{*packed, compressed.scales};
+}
+
+/// Lower `op` into an `emitc.call_opaque` operation to `funcName` with the
+/// packed weights as second operand, followed by their scales, if any.
+void replaceWithPrepackedCall(Operation *op, StringRef funcName,
+                              const PackedWeights &packedWeights,
+                              ArrayRef<Attribute> attrArgs,
+                              RewriterBase &rewriter) {
+  SmallVector<DenseElementsAttr> weights{packedWeights.weights};
+  if (packedWeights.scales)
+    weights.push_back(packedWeights.scales);
+
+  Attribute templateArgs[] = {
+      TypeAttr::get(op->getResult(0).getType()),
+      rewriter.getI64IntegerAttr(packedWeightsLayoutVersion)};
+  replaceWithWeightsCall<tosa::ConstOp>(op, funcName, weights, attrArgs,
+                                        templateArgs, rewriter);
+}
+
+struct PackTosaWeightsPass : public PackTosaWeightsBase<PackTosaWeightsPass> {
+  /// Pack constant weights and lower to the prepacked kernels.
+  void runOnOperation() override {
+    if (blockSize <= 0) {
+      getOperation().emitError("block-size must be positive.");
+      return signalPassFailure();
+    }
+    if (!llvm::is_contained({"f32", "f16", "bf16", "i8"},
+                            StringRef(weightType))) {
+      getOperation().emitError("weight-type must be f32, f16, bf16 or i8.");
+      return signalPassFailure();
+    }
+
+    IRRewriter rewriter(&getContext());
+
+    getOperation().walk([&](tosa::Conv2DOp convOp) {
+      FailureOr<PackedWeights> packed = getPackedWeights(
+          convOp, blockSize, weightType, minCompressedElements);
+      if (failed(packed))
+        return;
+      countCompression(convOp.getWeight(), *packed);
+
+      Attribute attrArgs[] = {rewriter.getI64TensorAttr(convOp.getPad()),
+                              rewriter.getI64TensorAttr(convOp.getStride()),
+                              rewriter.getI64TensorAttr(convOp.getDilation())};
+      replaceWithPrepackedCall(convOp, "emitc::tosa::conv2d_prepacked", *packed,
+                               attrArgs, rewriter);
+    });
+
+    getOperation().walk([&](tosa::FullyConnectedOp fullyConnectedOp) {
+      FailureOr<PackedWeights> packed = getPackedWeights(
+          fullyConnectedOp, blockSize, weightType, minCompressedElements);
+      if (failed(packed))
+        return;
+      countCompression(fullyConnectedOp.getWeight(), *packed);
+
+      replaceWithPrepackedCall(fullyConnectedOp,
+                               "emitc::tosa::fully_connected_prepacked",
+                               *packed, {}, rewriter);
+    });
+  }
+
+private:
+  /// Updates the statistics if `packed` compresses `weights`.
+  void countCompression(Value weights, const PackedWeights &packed) {
+    auto type = weights.getType().cast<ShapedType>();
+    Type elementType = packed.weights.getElementType();
+    if (elementType == type.getElementType())
+      return;
+
+    numCompressedWeights++;
+    // Padded output channels are not counted.
+    int64_t bytes = type.getNumElements() *
+                    (type.getElementTypeBitWidth() -
+                     elementType.getIntOrFloatBitWidth()) /
+                    8;
+    if (packed.scales)
+      bytes -= packed.scales.getNumElements() * 4;
+    numSavedBytes += bytes;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createPackTosaWeightsPass() {
+  return std::make_unique<PackTosaWeightsPass>();
+}
@@ -0,0 +1,179 @@
+//===- TosaSimplifyArithmetic.cpp - Algebraic simplification of TOSA ------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that applies algebraic simplifications to TOSA
+// operations with constant operands, e.g. `pow(x, 2)` is rewritten to `x * x`
+// and additions of -0.0 are removed.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "llvm/ADT/TypeSwitch.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Returns true if `value` is a constant splat of zero.
+bool isZero(Value value) {
+  return matchPattern(value, m_AnyZeroFloat()) ||
+         matchPattern(value, m_Zero());
+}
+
+/// Returns true if `value` is a constant splat of zero that is an exact
+/// identity of addition. For floats, only -0.0 is, as -0.0 + 0.0 is +0.0.
+bool isAddIdentity(Value value) {
+  return matchPattern(value, m_NegZeroFloat()) ||
+         matchPattern(value, m_Zero());
+}
+
+/// Returns true if `value` is a constant splat of zero that is an exact
+/// identity of subtraction. For floats, only +0.0 is, as -0.0 - -0.0 is +0.0.
+bool isSubIdentity(Value value) {
+  return matchPattern(value, m_PosZeroFloat()) ||
+         matchPattern(value, m_Zero());
+}
+
+/// Returns true if `value` is a constant splat of one.
+bool isOne(Value value) {
+  return matchPattern(value, m_OneFloat()) || matchPattern(value, m_One());
+}
+
+class ArithmeticSimplifier {
+public:
+  ArithmeticSimplifier(bool fastMath, RewriterBase &rewriter)
+      : fastMath(fastMath), rewriter(rewriter) {}
+
+  /// Simplifies `op` and returns success if it was rewritten.
+  LogicalResult simplify(Operation *op) {
+    SmallVector<Value> operands(op->getOperands());
+    LogicalResult result =
+        llvm::TypeSwitch<Operation *, LogicalResult>(op)
+            .Case<tosa::AddOp>([&](auto) {
+              return removeIdentity(op, fastMath ? isZero : isAddIdentity,
+                                    /*commutative=*/true);
+            })
+            .Case<tosa::SubOp>([&](auto) {
+              return removeIdentity(op, fastMath ? isZero : isSubIdentity,
+                                    /*commutative=*/false);
+            })
+            .Case<tosa::MulOp>([&](tosa::MulOp mulOp) {
+              if (mulOp.getShift() != 0)
+                return failure();
+              return removeIdentity(op, isOne, /*commutative=*/true);
+            })
+            .Case<tosa::PowOp>(
+                [&](tosa::PowOp powOp) { return simplifyPow(powOp); })
+            .Default([](Operation *) { return failure(); });
+
+    if (succeeded(result))
+      eraseDeadConstants(operands, rewriter);
+    return result;
+  }
+
+private:
+  /// Replaces the binary `op` by one of its operands if the other operand is
+  /// an identity element and no broadcasting is involved.
+  LogicalResult removeIdentity(Operation *op,
+                               function_ref<bool(Value)> isIdentity,
+                               bool commutative) {
+    Value lhs = op->getOperand(0);
+    Value rhs = op->getOperand(1);
+    Type resultType = op->getResult(0).getType();
+
+    if (lhs.getType() == resultType && isIdentity(rhs)) {
+      rewriter.replaceOp(op, lhs);
+      return success();
+    }
+    if (commutative && rhs.getType() == resultType && isIdentity(lhs)) {
+      rewriter.replaceOp(op, rhs);
+      return success();
+    }
+    return failure();
+  }
+
+  /// Replaces `pow(x, c)` for a constant splat `c` of 1, 2 or -1 by cheaper
+  /// ops. With fast-math only, `pow(x, 0.5)` is replaced by `sqrt(x)`, which
+  /// differs for -0.0 and -inf, and `pow(x, -0.5)` by `rsqrt(x)`, which the
+  /// reference implementation computes as `1 / sqrt(x)` and hence rounds
+  /// twice.
+  LogicalResult simplifyPow(tosa::PowOp powOp) {
+    Value x = powOp.getInput1();
+    Type resultType = powOp.getType();
+    if (x.getType() != resultType)
+      return failure();
+
+    APFloat exponent(0.0);
+    if (!matchPattern(powOp.getInput2(), m_ConstantFloat(&exponent)))
+      return failure();
+
+    rewriter.setInsertionPoint(powOp);
+    if (exponent.isExactlyValue(1.0)) {
+      rewriter.replaceOp(powOp, x);
+    } else if (exponent.isExactlyValue(2.0)) {
+      rewriter.replaceOpWithNewOp<tosa::MulOp>(powOp, resultType, x, x,
+                                               rewriter.getI8IntegerAttr(0));
+    } else if (exponent.isExactlyValue(0.5) && fastMath) {
+      // TOSA has no square root op, hence call the core op directly.
+      replaceOpWithPureCall(rewriter, powOp, resultType,
+                            rewriter.getStringAttr("emitc::sqrt"), ArrayAttr(),
+                            ArrayAttr(), x);
+    } else if (exponent.isExactlyValue(-1.0)) {
+      rewriter.replaceOpWithNewOp<tosa::ReciprocalOp>(powOp, resultType, x);
+    } else if (exponent.isExactlyValue(-0.5) && fastMath) {
+      rewriter.replaceOpWithNewOp<tosa::RsqrtOp>(powOp, resultType, x);
+    } else {
+      return failure();
+    }
+    return success();
+  }
+
+  bool fastMath;
+  RewriterBase &rewriter;
+};
+
+} // namespace
+
+namespace {
+
+struct SimplifyTosaArithmeticPass
+    : public SimplifyTosaArithmeticBase<SimplifyTosaArithmeticPass> {
+  /// Apply algebraic simplifications to TOSA ops.
+  void runOnOperation() override {
+    IRRewriter rewriter(&getContext());
+    ArithmeticSimplifier simplifier(fastMath, rewriter);
+
+    SmallVector<Operation *> ops;
+    getOperation().walk([&](Operation *op) {
+      if (isa<tosa::AddOp, tosa::MulOp, tosa::PowOp, tosa::SubOp>(op))
+        ops.push_back(op);
+    });
+
+    for (Operation *op : ops)
+      if (succeeded(simplifier.simplify(op)))
+        numSimplifiedOps++;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createSimplifyTosaArithmeticPass() {
+  return std::make_unique<SimplifyTosaArithmeticPass>();
+}
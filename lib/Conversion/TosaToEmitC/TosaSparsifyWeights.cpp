@@ -0,0 +1,204 @@
+//===- TosaSparsifyWeights.cpp - Encode sparse constant TOSA weights ------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that encodes constant weights of
+// `tosa.fully_connected` and 1x1 `tosa.conv2d` with a fraction of zeros of at
+// least `min-sparsity` in compressed sparse row (CSR) format and lowers the
+// ops to the corresponding `*_sparse` kernels, which skip the zero weights.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+
+#include "../PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Conversion/EmitCCommon/GenericOpConversion.h"
+#include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+#include "emitc/Dialect/EmitC/KernelBackends.h"
+
+using namespace mlir;
+using namespace mlir::emitc;
+
+namespace {
+
+/// Constant weights of shape [OC,IC] in CSR format. The nonzero weights of
+/// output channel oc are `values[rowOffsets[oc]:rowOffsets[oc + 1]]` at the
+/// input channels `colIndices[rowOffsets[oc]:rowOffsets[oc + 1]]`.
+struct SparseWeights {
+  DenseElementsAttr values;
+  DenseElementsAttr colIndices;
+  DenseElementsAttr rowOffsets;
+};
+
+/// Returns the constant weights of `op` in CSR format or failure if the
+/// weights are not constant floats, have less than `minElements` elements or
+/// a fraction of zeros below `minSparsity`.
+template <typename SrcOp>
+FailureOr<SparseWeights> getSparseWeights(SrcOp op, double minSparsity,
+                                          int64_t minElements) {
+  // Quantized ops are not supported by the sparse kernels.
+  if (op.getQuantizationInfo().has_value())
+    return failure();
+
+  DenseFPElementsAttr weights;
+  if (!matchPattern(op.getWeight(), m_Constant(&weights)))
+    return failure();
+
+  ShapedType type = weights.getType();
+  int64_t numElements = type.getNumElements();
+  if (numElements == 0 || numElements < minElements)
+    return failure();
+
+  int64_t outputChannels = type.getDimSize(0);
+  int64_t inputChannels = numElements / outputChannels;
+
+  SmallVector<APFloat> values;
+  SmallVector<int32_t> colIndices;
+  SmallVector<int32_t> rowOffsets{0};
+  auto it = weights.value_begin<APFloat>();
+  for (int64_t oc = 0; oc < outputChannels; oc++) {
+    for (int64_t ic = 0; ic < inputChannels; ic++, ++it) {
+      APFloat value = *it;
+      if (value.isZero())
+        continue;
+      values.push_back(value);
+      colIndices.push_back(ic);
+    }
+    rowOffsets.push_back(values.size());
+  }
+
+  // Empty tensors are not supported by the reference implementation.
+  int64_t nnz = values.size();
+  if (nnz == 0 || 1.0 - static_cast<double>(nnz) / numElements < minSparsity)
+    return failure();
+
+  MLIRContext *ctx = op.getContext();
+  Type i32 = IntegerType::get(ctx, 32);
+  return SparseWeights{
+      DenseElementsAttr::get(
+          RankedTensorType::get({nnz}, type.getElementType()), values),
+      DenseElementsAttr::get(RankedTensorType::get({nnz}, i32),
+                             ArrayRef<int32_t>(colIndices)),
+      DenseElementsAttr::get(RankedTensorType::get({outputChannels + 1}, i32),
+                             ArrayRef<int32_t>(rowOffsets))};
+}
+
+/// Lower `op` into an `emitc.call_opaque` operation to `funcName` with the
+/// CSR encoded weights replacing the second operand.
+void replaceWithSparseCall(Operation *op, StringRef funcName,
+                           const SparseWeights &sparseWeights,
+                           ArrayRef<Attribute> attrArgs,
+                           RewriterBase &rewriter) {
+  DenseElementsAttr weights[] = {sparseWeights.values,
+                                 sparseWeights.colIndices,
+                                 sparseWeights.rowOffsets};
+  Attribute templateArgs[] = {TypeAttr::get(op->getResult(0).getType())};
+  replaceWithWeightsCall<tosa::ConstOp>(op, funcName, weights, attrArgs,
+                                        templateArgs, rewriter);
+}
+
+/// Default minimum sparsities for ops computed by the naive dense kernels and
+/// by the optimized Eigen and BLAS kernels, see `conv2d_1x1_sparse_benchmark`.
+constexpr double naiveMinSparsity = 0.8;
+constexpr double optimizedMinSparsity = 0.95;
+
+struct SparsifyTosaWeightsPass
+    : public SparsifyTosaWeightsBase<SparsifyTosaWeightsPass> {
+  /// Encode sparse constant weights and lower to the sparse kernels.
+  void runOnOperation() override {
+    if (minSparsity > 1.0) {
+      getOperation().emitError("min-sparsity must be at most 1.");
+      return signalPassFailure();
+    }
+
+    if (!getKernelBackend(defaultBackend)) {
+      getOperation().emitError("default-backend must be naive, eigen or blas.");
+      return signalPassFailure();
+    }
+
+    KernelBackends backends;
+    if (failed(parseKernelBackends(kernelBackends,
+                                   getSelectableKernels("emitc::tosa"),
+                                   getOperation(), backends)))
+      return signalPassFailure();
+
+    IRRewriter rewriter(&getContext());
+
+    getOperation().walk([&](tosa::Conv2DOp convOp) {
+      // Only 1x1 convolutions without padding read a single input pixel per
+      // output pixel, which makes dilation irrelevant.
+      auto weightType = convOp.getWeight().getType().cast<ShapedType>();
+      if (!weightType.hasStaticShape() || weightType.getDimSize(1) != 1 ||
+          weightType.getDimSize(2) != 1 ||
+          llvm::any_of(convOp.getPad(), [](int64_t p) { return p != 0; }))
+        return;
+
+      FailureOr<SparseWeights> sparse =
+          getSparseWeights(convOp, getMinSparsity("conv2d", backends),
+                           minElements);
+      if (failed(sparse))
+        return;
+      countSparsification(convOp.getWeight(), *sparse);
+
+      Attribute attrArgs[] = {rewriter.getI64TensorAttr(convOp.getStride())};
+      replaceWithSparseCall(convOp, "emitc::tosa::conv2d_1x1_sparse", *sparse,
+                            attrArgs, rewriter);
+    });
+
+    getOperation().walk([&](tosa::FullyConnectedOp fullyConnectedOp) {
+      FailureOr<SparseWeights> sparse = getSparseWeights(
+          fullyConnectedOp, getMinSparsity("fully_connected", backends),
+          minElements);
+      if (failed(sparse))
+        return;
+      countSparsification(fullyConnectedOp.getWeight(), *sparse);
+
+      replaceWithSparseCall(fullyConnectedOp,
+                            "emitc::tosa::fully_connected_sparse", *sparse, {},
+                            rewriter);
+    });
+  }
+
+private:
+  /// Returns `min-sparsity` or, if it is negative, the default for the backend
+  /// of the dense `opName` kernel. Ops without a selected backend use
+  /// `default-backend`.
+  double getMinSparsity(StringRef opName, const KernelBackends &backends) {
+    if (minSparsity >= 0.0)
+      return minSparsity;
+    auto it = backends.find(opName);
+    StringRef backend = it != backends.end() ? StringRef(it->second)
+                                             : StringRef(defaultBackend);
+    return backend == "naive" ? naiveMinSparsity : optimizedMinSparsity;
+  }
+
+  /// Updates the statistics for replacing `weights` by `sparse`.
+  void countSparsification(Value weights, const SparseWeights &sparse) {
+    auto type = weights.getType().cast<ShapedType>();
+    int64_t elementBytes = type.getElementTypeBitWidth() / 8;
+    int64_t denseBytes = type.getNumElements() * elementBytes;
+    int64_t sparseBytes = sparse.values.getNumElements() * (elementBytes + 4) +
+                          sparse.rowOffsets.getNumElements() * 4;
+
+    numSparsifiedOps++;
+    if (sparseBytes < denseBytes)
+      numSavedBytes += denseBytes - sparseBytes;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createSparsifyTosaWeightsPass() {
+  return std::make_unique<SparsifyTosaWeightsPass>();
+}
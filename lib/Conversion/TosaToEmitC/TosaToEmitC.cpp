@@ -16,10 +16,13 @@
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/DialectConversion.h"
+#include "llvm/ADT/StringSwitch.h"
 
 #include "../PassDetail.h"
 #include "emitc/Conversion/EmitCCommon/GenericOpConversion.h"
 #include "emitc/Conversion/TosaToEmitC/TosaToEmitC.h"
+#include "emitc/Dialect/EmitC/KernelBackends.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
 
 using namespace mlir;
 using namespace mlir::emitc;
@@ -53,9 +56,8 @@ private:
         rewriter.getArrayAttr({concatOp.getAxisAttr(),
                                TypeAttr::get(concatOp.getResult().getType())});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        concatOp, concatOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, concatOp, concatOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -81,8 +83,10 @@ class GenericConvOpConversion : public OpConversionPattern<SrcOp> {
   using OpConversionPattern<SrcOp>::OpConversionPattern;
 
 public:
-  GenericConvOpConversion(MLIRContext *ctx, StringRef funcName)
-      : OpConversionPattern<SrcOp>(ctx), funcName(funcName) {}
+  GenericConvOpConversion(MLIRContext *ctx, StringRef funcName,
+                          bool attributesAsTemplateArgs)
+      : OpConversionPattern<SrcOp>(ctx), funcName(funcName),
+        attributesAsTemplateArgs(attributesAsTemplateArgs) {}
 
 private:
   LogicalResult
@@ -102,24 +106,89 @@ private:
     operands = operands.drop_back();
 
     StringAttr callee = rewriter.getStringAttr(funcName);
+    MLIRContext *ctx = convOp.getContext();
+
+    ArrayAttr args;
+    ArrayAttr templateArgs;
+    if (attributesAsTemplateArgs) {
+      // clang-format off
+      templateArgs = rewriter.getArrayAttr({
+        TypeAttr::get(convOp.getResult().getType()),
+        getIntegerSequenceAttr(convOp.getPad(), ctx),
+        getIntegerSequenceAttr(convOp.getStride(), ctx),
+        getIntegerSequenceAttr(convOp.getDilation(), ctx),
+      });
+      // clang-format on
+    } else {
+      // clang-format off
+      args = rewriter.getArrayAttr({
+        rewriter.getIndexAttr(0),
+        rewriter.getIndexAttr(1),
+        rewriter.getI64TensorAttr(convOp.getPad()),
+        rewriter.getI64TensorAttr(convOp.getStride()),
+        rewriter.getI64TensorAttr(convOp.getDilation()),
+      });
+      // clang-format on
+      templateArgs =
+          rewriter.getArrayAttr({TypeAttr::get(convOp.getResult().getType())});
+    }
+
+    // Create conv op.
+    auto emitcConvOp = createPureCall(rewriter, convOp->getLoc(),
+                                      convOp.getType(), callee, args,
+                                      templateArgs, operands);
+
+    auto output = emitcConvOp.getResult(0);
+    auto tosaAddOp = rewriter.create<tosa::AddOp>(
+        convOp.getLoc(), output.getType(), output, convOp.getBias());
+
+    rewriter.replaceOp(convOp, {tosaAddOp.getResult()});
+
+    return success();
+  }
+
+  std::string funcName;
+  // If set, pass padding, stride and dilation as template arguments.
+  bool attributesAsTemplateArgs;
+};
+
+/// Convert `tosa.transpose_conv2d` into an `emitc.call_opaque` operation.
+class TransposeConv2DOpConversion
+    : public OpConversionPattern<tosa::TransposeConv2DOp> {
+  using OpConversionPattern<tosa::TransposeConv2DOp>::OpConversionPattern;
+
+public:
+  TransposeConv2DOpConversion(MLIRContext *ctx)
+      : OpConversionPattern<tosa::TransposeConv2DOp>(ctx) {}
+
+private:
+  LogicalResult
+  matchAndRewrite(tosa::TransposeConv2DOp convOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    // Fail if quantization is requested.
+    if (convOp.getQuantizationInfo().has_value()) {
+      return convOp.emitError("Quantization for " + convOp.getOperationName() +
+                              " is currently not supported.");
+    }
+
+    // Like for the other convolutions, the bias is added by a separate
+    // tosa.add op.
+    StringAttr callee = rewriter.getStringAttr("emitc::tosa::transpose_conv2d");
 
     // clang-format off
     ArrayAttr args = rewriter.getArrayAttr({
       rewriter.getIndexAttr(0),
       rewriter.getIndexAttr(1),
-      rewriter.getI64TensorAttr(convOp.getPad()),
+      rewriter.getI64TensorAttr(convOp.getOutPad()),
       rewriter.getI64TensorAttr(convOp.getStride()),
-      rewriter.getI64TensorAttr(convOp.getDilation()),
     });
     // clang-format on
-
     ArrayAttr templateArgs =
         rewriter.getArrayAttr({TypeAttr::get(convOp.getResult().getType())});
 
-    // Create conv op.
-    auto emitcConvOp = rewriter.create<emitc::CallOpaqueOp>(
-        convOp->getLoc(), convOp.getType(), callee, args, templateArgs,
-        operands);
+    auto emitcConvOp = createPureCall(
+        rewriter, convOp->getLoc(), convOp.getType(), callee, args,
+        templateArgs, ValueRange{adaptor.getInput(), adaptor.getFilter()});
 
     auto output = emitcConvOp.getResult(0);
     auto tosaAddOp = rewriter.create<tosa::AddOp>(
@@ -129,8 +198,6 @@ private:
 
     return success();
   }
-
-  StringRef funcName;
 };
 
 /// Convert a common `tosa` pooling operation into an `emitc.call_opaque`
@@ -163,14 +230,13 @@ private:
         rewriter.getArrayAttr({TypeAttr::get(poolOp.getResult().getType())});
 
     // Create pool op.
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(poolOp, poolOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, poolOp, poolOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
 
-  StringRef funcName;
+  std::string funcName;
 };
 
 /// Convert `tosa.fully_connected` into an `emitc.call_opaque` operation.
@@ -180,7 +246,8 @@ class FullyConnectedOpConversion
 
 public:
   FullyConnectedOpConversion(MLIRContext *ctx, StringRef funcName)
-      : OpConversionPattern<tosa::FullyConnectedOp>(ctx) {}
+      : OpConversionPattern<tosa::FullyConnectedOp>(ctx),
+        funcName(funcName) {}
 
 private:
   LogicalResult
@@ -191,7 +258,6 @@ private:
           "Quantization of tosa.fully_connected is currently not supported.");
     }
 
-    StringRef funcName = "emitc::tosa::fully_connected";
     StringAttr callee = rewriter.getStringAttr(funcName);
 
     Type type = fullyConnectedOp.getType();
@@ -200,11 +266,12 @@ private:
     ArrayAttr templateArgs =
         ArrayAttr::get(fullyConnectedOp.getContext(), {TypeAttr::get(type)});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(fullyConnectedOp, type,
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, fullyConnectedOp, type, callee, args,
+                          templateArgs, adaptor.getOperands());
     return success();
   }
+
+  std::string funcName;
 };
 
 /// Convert `tosa.matmul` into an `emitc.call_opaque` operation.
@@ -212,8 +279,8 @@ class MatMulOpConversion : public OpConversionPattern<tosa::MatMulOp> {
   using OpConversionPattern<tosa::MatMulOp>::OpConversionPattern;
 
 public:
-  MatMulOpConversion(MLIRContext *ctx)
-      : OpConversionPattern<tosa::MatMulOp>(ctx) {}
+  MatMulOpConversion(MLIRContext *ctx, StringRef funcName)
+      : OpConversionPattern<tosa::MatMulOp>(ctx), funcName(funcName) {}
 
 private:
   LogicalResult
@@ -224,17 +291,17 @@ private:
           "Quantization of tosa.matmul is currently not supported.");
     }
 
-    StringRef funcName = "emitc::tosa::matmul";
     StringAttr callee = rewriter.getStringAttr(funcName);
 
     ArrayAttr args;
     ArrayAttr templateArgs;
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        matMulOp, matMulOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, matMulOp, matMulOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
     return success();
   }
+
+  std::string funcName;
 };
 
 /// Convert `tosa.clamp` into an `emitc.call_opaque` operation.
@@ -281,9 +348,8 @@ private:
     ArrayAttr args = rewriter.getArrayAttr(arguments);
     ArrayAttr templateArgs;
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(clampOp, clampOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, clampOp, clampOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -312,9 +378,8 @@ private:
     ArrayAttr args;
     ArrayAttr templateArgs;
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        negateOp, negateOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, negateOp, negateOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
     return success();
   }
 };
@@ -352,46 +417,8 @@ private:
         rewriter.getI32IntegerAttr(rescaleOp.getMultiplierAttr().size());
     ArrayAttr templateArgs = rewriter.getArrayAttr({resultType, arraySize});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        rescaleOp, rescaleOp.getType(), callee, args, templateArgs,
-        adaptor.getOperands());
-
-    return success();
-  }
-};
-
-/// Convert `tosa.rsqrt` into an `emitc.call_opaque` operation.
-class RsqrtOpConversion : public OpConversionPattern<tosa::RsqrtOp> {
-  using OpConversionPattern<tosa::RsqrtOp>::OpConversionPattern;
-
-public:
-  RsqrtOpConversion(MLIRContext *ctx)
-      : OpConversionPattern<tosa::RsqrtOp>(ctx) {}
-
-private:
-  LogicalResult
-  matchAndRewrite(tosa::RsqrtOp rsqrtOp, OpAdaptor adaptor,
-                  ConversionPatternRewriter &rewriter) const override {
-    ArrayAttr args;
-    ArrayAttr templateArgs;
-
-    // Create sqrt op.
-    StringRef sqrtFuncName = "emitc::sqrt";
-    StringAttr sqrtCallee = rewriter.getStringAttr(sqrtFuncName);
-
-    auto sqrtEmitCOp = rewriter.create<emitc::CallOpaqueOp>(
-        rsqrtOp.getLoc(), rsqrtOp.getType(), sqrtCallee, args, templateArgs,
-        adaptor.getOperands());
-
-    // Create reciprocal op.
-    StringRef reciprocalFuncName = "emitc::tosa::reciprocal";
-    StringAttr reciprocalCallee = rewriter.getStringAttr(reciprocalFuncName);
-
-    auto reciprocalOp = rewriter.create<emitc::CallOpaqueOp>(
-        sqrtEmitCOp.getLoc(), rsqrtOp.getType(), reciprocalCallee, args,
-        templateArgs, sqrtEmitCOp.getResults());
-
-    rewriter.replaceOp(rsqrtOp, reciprocalOp.getResults());
+    replaceOpWithPureCall(rewriter, rescaleOp, rescaleOp.getType(), callee,
+                          args, templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -444,9 +471,9 @@ createBroadcastOpIfNeeded(SrcOp &srcOp, Adaptor adaptor,
       ArrayAttr templateBroadcastArgs =
           rewriter.getArrayAttr({TypeAttr::get(newBroadcastType)});
 
-      auto broadcastArg = rewriter.create<emitc::CallOpaqueOp>(
-          srcOp->getLoc(), newBroadcastType, broadcastCallee, broadcastArgs,
-          templateBroadcastArgs, operand);
+      auto broadcastArg = createPureCall(
+          rewriter, srcOp->getLoc(), newBroadcastType, broadcastCallee,
+          broadcastArgs, templateBroadcastArgs, operand);
       // Replace the original operand with the result of the broadcast_in_dim
       // operation.
       broadcastedOperands.push_back(broadcastArg.getResult(0));
@@ -501,8 +528,8 @@ private:
     SmallVector<Value, 2> broadcastedOperands =
         createBroadcastOpIfNeeded(srcOp, adaptor, rewriter);
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        srcOp, srcOp.getType(), callee, args, templateArgs,
+    replaceOpWithPureCall(
+        rewriter, srcOp, srcOp.getType(), callee, args, templateArgs,
         ValueRange({broadcastedOperands[0], broadcastedOperands[1]}));
 
     return success();
@@ -547,8 +574,8 @@ private:
     SmallVector<Value, 2> broadcastedOperands =
         createBroadcastOpIfNeeded(mulOp, adaptor, rewriter);
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        mulOp, mulOp.getType(), callee, args, templateArgs,
+    replaceOpWithPureCall(
+        rewriter, mulOp, mulOp.getType(), callee, args, templateArgs,
         ValueRange({broadcastedOperands[0], broadcastedOperands[1]}));
 
     return success();
@@ -587,9 +614,9 @@ private:
     SmallVector<Value, 2> broadcastedOperands =
         createBroadcastOpIfNeeded(arithmeticRightShiftOp, adaptor, rewriter);
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        arithmeticRightShiftOp, arithmeticRightShiftOp.getType(), callee, args,
-        templateArgs,
+    replaceOpWithPureCall(
+        rewriter, arithmeticRightShiftOp, arithmeticRightShiftOp.getType(),
+        callee, args, templateArgs,
         ValueRange({broadcastedOperands[0], broadcastedOperands[1]}));
 
     return success();
@@ -617,9 +644,8 @@ private:
     SmallVector<Value, 3> broadcastedOperands =
         createBroadcastOpIfNeeded(selectOp, adaptor, rewriter);
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-        selectOp, selectOp.getType(), callee, args, templateArgs,
-        broadcastedOperands);
+    replaceOpWithPureCall(rewriter, selectOp, selectOp.getType(), callee, args,
+                          templateArgs, broadcastedOperands);
 
     return success();
   }
@@ -672,9 +698,9 @@ private:
           rewriter.getArrayAttr({TypeAttr::get(newOutputType),
                                  TypeAttr::get(reduceOp.getInput().getType())});
 
-      auto emitcReduceOp = rewriter.create<emitc::CallOpaqueOp>(
-          reduceOp.getLoc(), newOutputType, callee, args, templateArgs,
-          adaptor.getOperands());
+      auto emitcReduceOp = createPureCall(rewriter, reduceOp.getLoc(),
+                                          newOutputType, callee, args,
+                                          templateArgs, adaptor.getOperands());
 
       // Create tosa.reshape op.
       SmallVector<int64_t> newShapeAttr_;
@@ -691,15 +717,14 @@ private:
       ArrayAttr templateArgs =
           rewriter.getArrayAttr({TypeAttr::get(reduceOp.getType()),
                                  TypeAttr::get(reduceOp.getInput().getType())});
-      rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
-          reduceOp, reduceOp.getType(), callee, args, templateArgs,
-          adaptor.getOperands());
+      replaceOpWithPureCall(rewriter, reduceOp, reduceOp.getType(), callee,
+                            args, templateArgs, adaptor.getOperands());
     }
 
     return success();
   }
 
-  StringRef funcName;
+  std::string funcName;
   bool keepDims;
 };
 
@@ -728,9 +753,51 @@ private:
     Type resultType = padOp.getOutput().getType();
     ArrayAttr templateArgs = rewriter.getArrayAttr({TypeAttr::get(resultType)});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(padOp, padOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, padOp, padOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
+
+    return success();
+  }
+};
+
+/// Convert `tosa.resize` into an `emitc.call_opaque` operation.
+class ResizeOpConversion : public OpConversionPattern<tosa::ResizeOp> {
+  using OpConversionPattern<tosa::ResizeOp>::OpConversionPattern;
+
+public:
+  ResizeOpConversion(MLIRContext *ctx)
+      : OpConversionPattern<tosa::ResizeOp>(ctx) {}
+
+private:
+  LogicalResult
+  matchAndRewrite(tosa::ResizeOp resizeOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    StringRef mode = llvm::StringSwitch<StringRef>(resizeOp.getMode())
+                         .Case("NEAREST_NEIGHBOR", "NearestNeighbor")
+                         .Case("BILINEAR", "Bilinear")
+                         .Default("");
+    if (mode.empty()) {
+      return resizeOp.emitError("Unsupported resize mode ")
+             << resizeOp.getMode();
+    }
+
+    StringAttr callee = rewriter.getStringAttr("emitc::tosa::resize");
+
+    // clang-format off
+    ArrayAttr args = rewriter.getArrayAttr({
+      rewriter.getIndexAttr(0),
+      rewriter.getI64TensorAttr(resizeOp.getScale()),
+      rewriter.getI64TensorAttr(resizeOp.getOffset()),
+      rewriter.getI64TensorAttr(resizeOp.getBorder()),
+      emitc::OpaqueAttr::get(resizeOp.getContext(),
+                             ("emitc::tosa::ResizeMode::" + mode).str()),
+    });
+    // clang-format on
+    ArrayAttr templateArgs =
+        rewriter.getArrayAttr({TypeAttr::get(resizeOp.getResult().getType())});
+
+    replaceOpWithPureCall(rewriter, resizeOp, resizeOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -761,9 +828,8 @@ private:
     Type resultType = sliceOp.getOutput().getType();
     ArrayAttr templateArgs = rewriter.getArrayAttr({TypeAttr::get(resultType)});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(sliceOp, sliceOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, sliceOp, sliceOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
 
     return success();
   }
@@ -800,9 +866,8 @@ private:
     Type resultType = tileOp.getOutput().getType();
     ArrayAttr templateArgs = rewriter.getArrayAttr({TypeAttr::get(resultType)});
 
-    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(tileOp, tileOp.getType(),
-                                                     callee, args, templateArgs,
-                                                     adaptor.getOperands());
+    replaceOpWithPureCall(rewriter, tileOp, tileOp.getType(), callee, args,
+                          templateArgs, adaptor.getOperands());
     return success();
   }
 };
@@ -810,7 +875,13 @@ private:
 } // namespace
 
 void populateTosaToEmitcPatterns(MLIRContext *ctx,
-                                 RewritePatternSet &patterns) {
+                                 RewritePatternSet &patterns,
+                                 bool attributesAsTemplateArgs,
+                                 const KernelBackends &backends) {
+  auto callee = [&](StringRef opName) {
+    return getKernelCallee("emitc::tosa", opName, backends);
+  };
+
   // Insert patterns for TOSA data node ops.
   patterns.add<ConstOpConversion>(ctx);
 
@@ -828,7 +899,7 @@ void populateTosaToEmitcPatterns(MLIRContext *ctx,
   patterns.add<GenericOpConversion<tosa::ReciprocalOp>>(
       ctx, "emitc::tosa::reciprocal");
   patterns.add<RescaleOpConversion>(ctx);
-  patterns.add<RsqrtOpConversion>(ctx);
+  patterns.add<GenericOpConversion<tosa::RsqrtOp>>(ctx, "emitc::tosa::rsqrt");
   patterns.add<GenericOpConversion<tosa::TanhOp>>(ctx, "emitc::tosa::tanh");
 
   // Insert patterns for TOSA binary elementwise ops.
@@ -858,19 +929,23 @@ void populateTosaToEmitcPatterns(MLIRContext *ctx,
 
   // Insert patterns for other TOSA ops.
   patterns.add<ConcatOpConversion>(ctx);
-  patterns.add<GenericConvOpConversion<tosa::Conv2DOp>>(ctx,
-                                                        "emitc::tosa::conv2d");
+  // Only the unqualified convolutions accept attributes as template arguments.
+  patterns.add<GenericConvOpConversion<tosa::Conv2DOp>>(
+      ctx, callee("conv2d"),
+      attributesAsTemplateArgs && !backends.count("conv2d"));
   patterns.add<GenericConvOpConversion<tosa::DepthwiseConv2DOp>>(
-      ctx, "emitc::tosa::depthwise_conv2d");
+      ctx, callee("depthwise_conv2d"),
+      attributesAsTemplateArgs && !backends.count("depthwise_conv2d"));
+  patterns.add<TransposeConv2DOpConversion>(ctx);
   patterns.add<GenericPoolOpConversion<tosa::AvgPool2dOp>>(
-      ctx, "emitc::tosa::avg_pool2d");
+      ctx, callee("avg_pool2d"));
   patterns.add<GenericPoolOpConversion<tosa::MaxPool2dOp>>(
-      ctx, "emitc::tosa::max_pool2d");
-  patterns.add<FullyConnectedOpConversion>(ctx, "emitc::tosa::fully_connected");
+      ctx, callee("max_pool2d"));
+  patterns.add<FullyConnectedOpConversion>(ctx, callee("fully_connected"));
   patterns.add<GenericOpConversion<tosa::GatherOp>>(
       ctx, "emitc::tosa::gather",
       /*explicitResultType=*/true);
-  patterns.add<MatMulOpConversion>(ctx);
+  patterns.add<MatMulOpConversion>(ctx, callee("matmul"));
   patterns.add<TileOpConversion>(ctx);
   patterns.add<ReduceOpConversion<tosa::ArgMaxOp>>(ctx, "emitc::tosa::argmax",
                                                    false);
@@ -879,16 +954,17 @@ void populateTosaToEmitcPatterns(MLIRContext *ctx,
   patterns.add<ReduceOpConversion<tosa::ReduceAnyOp>>(
       ctx, "emitc::tosa::reduce_any", true);
   patterns.add<ReduceOpConversion<tosa::ReduceMaxOp>>(
-      ctx, "emitc::tosa::reduce_max", true);
+      ctx, callee("reduce_max"), true);
   patterns.add<ReduceOpConversion<tosa::ReduceMinOp>>(
-      ctx, "emitc::tosa::reduce_min", true);
+      ctx, callee("reduce_min"), true);
   patterns.add<ReduceOpConversion<tosa::ReduceProdOp>>(
-      ctx, "emitc::tosa::reduce_prod", true);
+      ctx, callee("reduce_prod"), true);
   patterns.add<ReduceOpConversion<tosa::ReduceSumOp>>(
-      ctx, "emitc::tosa::reduce_sum", true);
+      ctx, callee("reduce_sum"), true);
   patterns.add<GenericOpConversion<tosa::ReshapeOp>>(
       ctx, "emitc::tosa::reshape",
       /*explicitResultType=*/true);
+  patterns.add<ResizeOpConversion>(ctx);
   patterns.add<SliceOpConversion>(ctx);
   patterns.add<PadOpConversion>(ctx);
   patterns.add<GenericOpConversion<tosa::TransposeOp>>(
@@ -899,8 +975,18 @@ namespace {
 
 struct ConvertTosaToEmitCPass
     : public ConvertTosaToEmitCBase<ConvertTosaToEmitCPass> {
+  ConvertTosaToEmitCPass() = default;
+  ConvertTosaToEmitCPass(ArrayRef<std::string> kernelBackends) {
+    this->kernelBackends = kernelBackends;
+  }
+
   /// Perform the lowering to EmitC dialect.
   void runOnOperation() override {
+    KernelBackends backends;
+    if (failed(parseKernelBackends(kernelBackends,
+                                   getSelectableKernels("emitc::tosa"),
+                                   getOperation(), backends)))
+      return signalPassFailure();
 
     ConversionTarget target(getContext());
 
@@ -959,14 +1045,17 @@ struct ConvertTosaToEmitCPass
                         tosa::ReduceProdOp,
                         tosa::ReduceSumOp,
                         tosa::ReshapeOp,
+                        tosa::ResizeOp,
                         tosa::SliceOp,
                         tosa::PadOp,
                         tosa::TileOp,
+                        tosa::TransposeConv2DOp,
                         tosa::TransposeOp>();
     // clang-format on
 
     RewritePatternSet patterns(&getContext());
-    populateTosaToEmitcPatterns(&getContext(), patterns);
+    populateTosaToEmitcPatterns(&getContext(), patterns,
+                                attributesAsTemplateArgs, backends);
 
     if (failed(applyPartialConversion(getOperation(), target,
                                       std::move(patterns))))
@@ -980,3 +1069,9 @@ std::unique_ptr<OperationPass<func::FuncOp>>
 mlir::emitc::createConvertTosaToEmitCPass() {
   return std::make_unique<ConvertTosaToEmitCPass>();
 }
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::emitc::createConvertTosaToEmitCPass(
+    ArrayRef<std::string> kernelBackends) {
+  return std::make_unique<ConvertTosaToEmitCPass>(kernelBackends);
+}
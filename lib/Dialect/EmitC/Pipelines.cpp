@@ -16,36 +16,76 @@ namespace mlir {
 namespace emitc {
 namespace {
 
+/// Options of the StableHLO and TOSA to EmitC pipelines.
+struct EmitCPipelineOptions : public PassPipelineOptions<EmitCPipelineOptions> {
+  ListOption<std::string> kernelBackends{
+      *this, "kernel-backends",
+      llvm::cl::desc("Kernel backends per op kind, given as op:backend with "
+                     "backend naive, eigen or blas")};
+  Option<std::string> tuningDatabase{
+      *this, "tuning-database",
+      llvm::cl::desc("Tuning database selecting the kernel backend per call, "
+                     "as written by scripts/tune_kernels.py")};
+};
+
+/// Adds the pass selecting kernels from the tuning database, if any.
+void addKernelTuning(OpPassManager &pm, const EmitCPipelineOptions &options) {
+  if (!options.tuningDatabase.empty())
+    pm.addPass(createApplyEmitCKernelTuningPass(options.tuningDatabase));
+}
+
 #ifdef EMITC_BUILD_HLO
-void buildStablehloToEmitCPipeline(OpPassManager &pm) {
+void buildStablehloToEmitCPipeline(OpPassManager &pm,
+                                   const EmitCPipelineOptions &options) {
+  pm.addPass(createFoldStablehloLayoutOpsPass());
+  pm.addPass(createFoldStablehloConstantsPass());
+  pm.addPass(createSimplifyStablehloArithmeticPass());
+  pm.addPass(createFoldStablehloPadPass());
+  pm.addPass(createFoldStablehloTransposePass(options.kernelBackends));
   pm.addPass(createInsertEmitCStablehloIncludePass());
   pm.addPass(createConvertStablehloRegionOpsToEmitCPass());
-  pm.addPass(createConvertStablehloToEmitCPass());
+  pm.addPass(createConvertStablehloToEmitCPass(options.kernelBackends));
+  addKernelTuning(pm, options);
+  pm.addPass(createMergeEmitCDuplicatesPass());
+  pm.addPass(createEliminateRedundantEmitCCallsPass());
+  pm.addPass(createLowerEmitCHalfTypesPass());
 }
 #endif // EMITC_BUILD_HLO
 
 void buildArithToEmitCPipeline(OpPassManager &pm) {
   pm.addPass(createInsertEmitCArithIncludePass());
   pm.addPass(createConvertArithToEmitCPass());
+  pm.addPass(createLowerEmitCHalfTypesPass());
 }
 
 void buildTensorToEmitCPipeline(OpPassManager &pm) {
   pm.addPass(createInsertEmitCTensorIncludePass());
   pm.addPass(createConvertTensorToEmitCPass());
+  pm.addPass(createLowerEmitCHalfTypesPass());
 }
 
-void buildTosaToEmitCPipeline(OpPassManager &pm) {
+void buildTosaToEmitCPipeline(OpPassManager &pm,
+                              const EmitCPipelineOptions &options) {
+  pm.addPass(createFoldTosaLayoutOpsPass());
+  pm.addPass(createFoldTosaConstantsPass());
+  pm.addPass(createSimplifyTosaArithmeticPass());
+  pm.addPass(createFoldTosaPadPass());
+  pm.addPass(createFoldTosaTransposePass(options.kernelBackends));
   pm.addPass(createInsertEmitCTosaIncludePass());
-  pm.addPass(createConvertTosaToEmitCPass());
+  pm.addPass(createConvertTosaToEmitCPass(options.kernelBackends));
+  addKernelTuning(pm, options);
+  pm.addPass(createMergeEmitCDuplicatesPass());
+  pm.addPass(createEliminateRedundantEmitCCallsPass());
+  pm.addPass(createLowerEmitCHalfTypesPass());
 }
 
 } // namespace
 
 #ifdef EMITC_BUILD_HLO
 void registerStablehloToEmitCPipeline() {
-  PassPipelineRegistration<>("stablehlo-to-emitc-pipeline",
-                             "Run the StableHLO to EmitC pipeline.",
-                             buildStablehloToEmitCPipeline);
+  PassPipelineRegistration<EmitCPipelineOptions>(
+      "stablehlo-to-emitc-pipeline", "Run the StableHLO to EmitC pipeline.",
+      buildStablehloToEmitCPipeline);
 }
 #endif // EMITC_BUILD_HLO
 
@@ -62,9 +102,9 @@ void registerTensorToEmitCPipeline() {
 }
 
 void registerTosaToEmitCPipeline() {
-  PassPipelineRegistration<>("tosa-to-emitc-pipeline",
-                             "Run the TOSA to EmitC pipeline.",
-                             buildTosaToEmitCPipeline);
+  PassPipelineRegistration<EmitCPipelineOptions>(
+      "tosa-to-emitc-pipeline", "Run the TOSA to EmitC pipeline.",
+      buildTosaToEmitCPipeline);
 }
 
 } // namespace emitc
@@ -0,0 +1,93 @@
+//===- EliminateRedundantCalls.cpp - Eliminate redundant EmitC calls ------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements common subexpression and dead code elimination of
+// `emitc.call_opaque` operations marked as pure by the conversions. These
+// calls carry no side effect information, hence MLIR's generic CSE and
+// canonicalization passes treat them as side effecting.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+
+#include "PassDetail.h"
+#include "emitc/Dialect/EmitC/PureCalls.h"
+#include "emitc/Dialect/EmitC/Transforms/Passes.h"
+
+namespace mlir {
+namespace emitc {
+
+namespace {
+
+/// Hashes and compares calls by callee, attributes and operands.
+struct CallInfo : public llvm::DenseMapInfo<Operation *> {
+  static unsigned getHashValue(const Operation *op) {
+    return OperationEquivalence::computeHash(
+        const_cast<Operation *>(op), OperationEquivalence::directHashValue,
+        OperationEquivalence::ignoreHashValue,
+        OperationEquivalence::IgnoreLocations);
+  }
+
+  static bool isEqual(const Operation *lhs, const Operation *rhs) {
+    if (lhs == rhs)
+      return true;
+    if (lhs == getEmptyKey() || lhs == getTombstoneKey() ||
+        rhs == getEmptyKey() || rhs == getTombstoneKey())
+      return false;
+    return OperationEquivalence::isEquivalentTo(
+        const_cast<Operation *>(lhs), const_cast<Operation *>(rhs),
+        OperationEquivalence::IgnoreLocations);
+  }
+};
+
+struct EliminateRedundantEmitCCallsPass
+    : public EliminateRedundantEmitCCallsBase<
+          EliminateRedundantEmitCCallsPass> {
+  void runOnOperation() override {
+    IRRewriter rewriter(&getContext());
+    getOperation().walk([&](Block *block) {
+      // Replace calls by an equivalent call earlier in the same block.
+      DenseMap<Operation *, Operation *, CallInfo> knownCalls;
+      for (Operation &op : llvm::make_early_inc_range(*block)) {
+        auto callOp = dyn_cast<CallOpaqueOp>(op);
+        if (!callOp || !isPureCall(callOp))
+          continue;
+
+        auto [it, inserted] = knownCalls.try_emplace(&op, &op);
+        if (inserted)
+          continue;
+        rewriter.replaceOp(&op, it->second->getResults());
+        numReplacedCalls++;
+      }
+
+      // Erase calls with unused results, users first.
+      for (Operation &op :
+           llvm::make_early_inc_range(llvm::reverse(*block))) {
+        auto callOp = dyn_cast<CallOpaqueOp>(op);
+        if (!callOp || !isPureCall(callOp) || !op.use_empty())
+          continue;
+        rewriter.eraseOp(&op);
+        numErasedCalls++;
+      }
+    });
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::ModuleOp>>
+createEliminateRedundantEmitCCallsPass() {
+  return std::make_unique<EliminateRedundantEmitCCallsPass>();
+}
+
+} // namespace emitc
+} // namespace mlir
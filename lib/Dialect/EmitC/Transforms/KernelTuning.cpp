@@ -0,0 +1,248 @@
+//===- KernelTuning.cpp - Tune the kernels of reference calls -------------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the passes of the kernel autotuner. The extraction
+// pass reduces a module to one function per unique tunable call, which
+// `scripts/tune_kernels.py` compiles and benchmarks with each kernel backend.
+// The fastest backends are written to a tuning database, which the apply pass
+// uses to select the kernel of each call. Calls are keyed by a signature made
+// of the callee, its attributes and its operand and result types.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/Pass/Pass.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "PassDetail.h"
+#include "emitc/Dialect/EmitC/KernelBackends.h"
+#include "emitc/Dialect/EmitC/Transforms/Passes.h"
+
+#include <optional>
+
+namespace mlir {
+namespace emitc {
+
+namespace {
+
+/// A call of a reference implementation op with selectable kernels.
+struct TunableCall {
+  StringRef prefix;
+  StringRef opName;
+  unsigned backends;
+  std::string signature;
+};
+
+/// Returns the tunable call described by `callOp`, if its callee is an
+/// unqualified op with selectable kernels or the transposed variant of one.
+/// Calls passing attributes as template arguments are not tunable, as only the
+/// default kernels accept them. The transpose flags of the transposed kernels
+/// are accepted by all backends.
+std::optional<TunableCall> getTunableCall(CallOpaqueOp callOp) {
+  auto [prefix, opName] = callOp.getCallee().rsplit("::");
+  StringRef kernelName = opName;
+  bool transposed = kernelName.consume_back("_transposed");
+  const SelectableKernel *kernel = llvm::find_if(
+      getSelectableKernels(prefix),
+      [&](const SelectableKernel &k) { return k.opName == kernelName; });
+  if (kernel == getSelectableKernels(prefix).end() ||
+      callOp.getNumResults() != 1)
+    return std::nullopt;
+
+  ArrayAttr templateArgs = callOp.getTemplateArgsAttr();
+  if (templateArgs && !llvm::all_of(templateArgs, [&](Attribute attr) {
+        return attr.isa<TypeAttr>() || (transposed && attr.isa<BoolAttr>());
+      }))
+    return std::nullopt;
+
+  TunableCall call{prefix, opName, kernel->backends, ""};
+  llvm::raw_string_ostream os(call.signature);
+  os << callOp.getCallee();
+  if (ArrayAttr args = callOp.getArgsAttr())
+    os << " args " << args;
+  if (templateArgs)
+    os << " template_args " << templateArgs;
+  os << " : "
+     << FunctionType::get(callOp.getContext(), callOp.getOperandTypes(),
+                          callOp.getResultTypes());
+  os.flush();
+  return call;
+}
+
+/// Returns the callee of `call` qualified with `backend`.
+std::string getTunedCallee(const TunableCall &call, StringRef backend) {
+  return (call.prefix + "::" + backend + "::" + call.opName).str();
+}
+
+struct ExtractEmitCKernelsPass
+    : public ExtractEmitCKernelsBase<ExtractEmitCKernelsPass> {
+  void runOnOperation() override {
+    ModuleOp moduleOp = getOperation();
+
+    unsigned selectedBackend = 0;
+    if (!backend.empty()) {
+      selectedBackend = getKernelBackend(backend);
+      if (!selectedBackend) {
+        moduleOp.emitError("unknown kernel backend '") << backend << "'";
+        return signalPassFailure();
+      }
+    }
+
+    // Collect the first call of each signature. Kernels are numbered across
+    // all backends, such that a kernel has the same name in each extraction.
+    llvm::StringMap<unsigned> indices;
+    SmallVector<std::pair<CallOpaqueOp, TunableCall>> kernels;
+    moduleOp.walk([&](CallOpaqueOp callOp) {
+      std::optional<TunableCall> call = getTunableCall(callOp);
+      if (!call || !indices.try_emplace(call->signature, indices.size()).second)
+        return;
+      kernels.emplace_back(callOp, std::move(*call));
+    });
+
+    // Keep the includes, such that the kernels translate to a complete C++
+    // file.
+    SmallVector<Operation *> erased;
+    for (Operation &op : moduleOp.getBody()->getOperations()) {
+      if (!isa<IncludeOp>(op))
+        erased.push_back(&op);
+    }
+
+    OpBuilder builder = OpBuilder::atBlockEnd(moduleOp.getBody());
+    for (auto &[callOp, call] : kernels) {
+      if (selectedBackend && !(call.backends & selectedBackend))
+        continue;
+
+      auto funcOp = builder.create<func::FuncOp>(
+          callOp.getLoc(), "kernel_" + std::to_string(indices[call.signature]),
+          builder.getFunctionType(callOp.getOperandTypes(),
+                                  callOp.getResultTypes()));
+      funcOp->setAttr("emitc.kernel_signature",
+                      builder.getStringAttr(call.signature));
+      funcOp->setAttr(
+          "emitc.kernel_backends",
+          builder.getStrArrayAttr(getKernelBackendNames(call.backends)));
+
+      Block *entryBlock = funcOp.addEntryBlock();
+      OpBuilder bodyBuilder = OpBuilder::atBlockEnd(entryBlock);
+      IRMapping mapping;
+      mapping.map(callOp.getOperands(), entryBlock->getArguments());
+      auto kernelOp = cast<CallOpaqueOp>(bodyBuilder.clone(*callOp, mapping));
+      if (selectedBackend)
+        kernelOp.setCallee(getTunedCallee(call, backend));
+      bodyBuilder.create<func::ReturnOp>(callOp.getLoc(),
+                                         kernelOp->getResults());
+    }
+
+    for (Operation *op : erased)
+      op->erase();
+  }
+};
+
+struct ApplyEmitCKernelTuningPass
+    : public ApplyEmitCKernelTuningBase<ApplyEmitCKernelTuningPass> {
+  ApplyEmitCKernelTuningPass() = default;
+  ApplyEmitCKernelTuningPass(StringRef database) {
+    this->database = database.str();
+  }
+
+  void runOnOperation() override {
+    ModuleOp moduleOp = getOperation();
+
+    llvm::StringMap<std::string> selection;
+    if (failed(loadDatabase(moduleOp, selection)))
+      return signalPassFailure();
+
+    WalkResult result = moduleOp.walk([&](CallOpaqueOp callOp) {
+      std::optional<TunableCall> call = getTunableCall(callOp);
+      if (!call)
+        return WalkResult::advance();
+
+      auto it = selection.find(call->signature);
+      if (it == selection.end()) {
+        numUntunedCalls++;
+        return WalkResult::advance();
+      }
+
+      if (!(getKernelBackend(it->second) & call->backends)) {
+        callOp.emitError("tuning database selects unavailable '")
+            << it->second << "' kernel";
+        return WalkResult::interrupt();
+      }
+
+      callOp.setCallee(getTunedCallee(*call, it->second));
+      numTunedCalls++;
+      return WalkResult::advance();
+    });
+
+    if (result.wasInterrupted())
+      signalPassFailure();
+  }
+
+private:
+  /// Reads the backend selected for each signature from the database.
+  LogicalResult loadDatabase(ModuleOp moduleOp,
+                             llvm::StringMap<std::string> &selection) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(database);
+    if (!buffer)
+      return moduleOp.emitError("cannot open tuning database '")
+             << database << "': " << buffer.getError().message();
+
+    llvm::Expected<llvm::json::Value> json =
+        llvm::json::parse((*buffer)->getBuffer());
+    if (!json)
+      return moduleOp.emitError("cannot parse tuning database: ")
+             << llvm::toString(json.takeError());
+
+    const llvm::json::Object *root = json->getAsObject();
+    if (!root || root->getInteger("version") != 1)
+      return moduleOp.emitError("expected a tuning database of version 1");
+
+    const llvm::json::Array *kernels = root->getArray("kernels");
+    if (!kernels)
+      return moduleOp.emitError("expected an array of tuned kernels");
+
+    for (const llvm::json::Value &value : *kernels) {
+      const llvm::json::Object *kernel = value.getAsObject();
+      std::optional<StringRef> signature =
+          kernel ? kernel->getString("signature") : std::nullopt;
+      std::optional<StringRef> backend =
+          kernel ? kernel->getString("backend") : std::nullopt;
+      if (!signature || !backend)
+        return moduleOp.emitError(
+            "expected a signature and a backend for each tuned kernel");
+      selection[*signature] = backend->str();
+    }
+    return success();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::ModuleOp>> createExtractEmitCKernelsPass() {
+  return std::make_unique<ExtractEmitCKernelsPass>();
+}
+
+std::unique_ptr<OperationPass<mlir::ModuleOp>>
+createApplyEmitCKernelTuningPass() {
+  return std::make_unique<ApplyEmitCKernelTuningPass>();
+}
+
+std::unique_ptr<OperationPass<mlir::ModuleOp>>
+createApplyEmitCKernelTuningPass(StringRef database) {
+  return std::make_unique<ApplyEmitCKernelTuningPass>(database);
+}
+
+} // namespace emitc
+} // namespace mlir
@@ -0,0 +1,108 @@
+//===- LowerHalfTypes.cpp - Lower f16 and bf16 to reference types ---------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that replaces the f16 and bf16 types by the
+// opaque types `emitc::half` and `emitc::bfloat16` of the reference
+// implementation, as the C++ emitter only supports f32 and f64 floats.
+// Constants of these types are replaced by opaque initializers, which convert
+// the values from float.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/IR/AttrTypeSubElements.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/Pass/Pass.h"
+#include "llvm/ADT/SmallString.h"
+
+#include "PassDetail.h"
+#include "emitc/Dialect/EmitC/Transforms/Passes.h"
+
+#include <optional>
+
+namespace mlir {
+namespace emitc {
+
+namespace {
+
+/// Returns the reference implementation type of the f16 or bf16 `type`.
+std::optional<Type> getHalfType(Type type) {
+  if (type.isF16())
+    return emitc::OpaqueType::get(type.getContext(), "emitc::half");
+  if (type.isBF16())
+    return emitc::OpaqueType::get(type.getContext(), "emitc::bfloat16");
+  return std::nullopt;
+}
+
+/// Prints `value` as a float literal in the format of the C++ emitter.
+void printFloat(raw_ostream &os, APFloat value) {
+  if (value.isNaN()) {
+    os << "NAN";
+    return;
+  }
+  if (value.isInfinity()) {
+    os << (value.isNegative() ? "-INFINITY" : "INFINITY");
+    return;
+  }
+
+  // Every f16 and bf16 value is exactly representable as f32.
+  bool losesInfo;
+  value.convert(APFloat::IEEEsingle(), APFloat::rmNearestTiesToEven,
+                &losesInfo);
+  SmallString<128> string;
+  value.toString(string, /*FormatPrecision=*/0, /*FormatMaxPadding=*/0,
+                 /*TruncateZero=*/false);
+  os << "(float)" << string;
+}
+
+struct LowerEmitCHalfTypesPass
+    : public LowerEmitCHalfTypesBase<LowerEmitCHalfTypesPass> {
+  void runOnOperation() override {
+    MLIRContext *context = &getContext();
+
+    AttrTypeReplacer replacer;
+    replacer.addReplacement([](FloatType type) { return getHalfType(type); });
+    replacer.addReplacement(
+        [&](FloatAttr attr) -> std::optional<Attribute> {
+          if (!getHalfType(attr.getType()))
+            return std::nullopt;
+          std::string value;
+          llvm::raw_string_ostream os(value);
+          printFloat(os, attr.getValue());
+          return emitc::OpaqueAttr::get(context, os.str());
+        });
+    replacer.addReplacement(
+        [&](DenseFPElementsAttr attr) -> std::optional<Attribute> {
+          if (!getHalfType(attr.getElementType()))
+            return std::nullopt;
+          std::string value;
+          llvm::raw_string_ostream os(value);
+          os << "{";
+          llvm::interleaveComma(attr.getValues<APFloat>(), os,
+                                [&](APFloat v) { printFloat(os, v); });
+          os << "}";
+          return emitc::OpaqueAttr::get(context, os.str());
+        });
+
+    replacer.recursivelyReplaceElementsIn(getOperation(),
+                                          /*replaceAttrs=*/true,
+                                          /*replaceLocs=*/false,
+                                          /*replaceTypes=*/true);
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::ModuleOp>> createLowerEmitCHalfTypesPass() {
+  return std::make_unique<LowerEmitCHalfTypesPass>();
+}
+
+} // namespace emitc
+} // namespace mlir
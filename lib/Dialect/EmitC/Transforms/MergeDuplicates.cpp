@@ -0,0 +1,173 @@
+//===- MergeDuplicates.cpp - Merge duplicate constants and functions ------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass that merges byte-identical `emitc.constant`
+// operations and structurally identical private functions, e.g. the functions
+// outlined from the regions of reduce operations. Each of them is otherwise
+// emitted, compiled and stored separately.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/EmitC/IR/EmitC.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+
+#include "PassDetail.h"
+#include "emitc/Conversion/EmitCCommon/ConstantFolding.h"
+#include "emitc/Dialect/EmitC/Transforms/Passes.h"
+
+namespace mlir {
+namespace emitc {
+
+namespace {
+
+/// Hashes the signature and the body of `funcOp`, ignoring its name.
+llvm::hash_code hashFunction(func::FuncOp funcOp) {
+  llvm::hash_code hash = hash_value(funcOp.getFunctionType());
+  funcOp.walk([&](Operation *op) {
+    if (op == funcOp)
+      return;
+    hash = llvm::hash_combine(
+        hash, OperationEquivalence::computeHash(
+                  op, OperationEquivalence::ignoreHashValue,
+                  OperationEquivalence::ignoreHashValue,
+                  OperationEquivalence::IgnoreLocations));
+  });
+  return hash;
+}
+
+/// Returns true if `lhs` and `rhs` have the same signature and their bodies
+/// only differ in the names of values and in locations.
+bool isEquivalentFunction(func::FuncOp lhs, func::FuncOp rhs) {
+  if (lhs.getFunctionType() != rhs.getFunctionType() ||
+      lhs.getAllArgAttrs() != rhs.getAllArgAttrs() ||
+      lhs.getAllResultAttrs() != rhs.getAllResultAttrs())
+    return false;
+
+  Region &lhsBody = lhs.getBody();
+  Region &rhsBody = rhs.getBody();
+  if (!lhsBody.hasOneBlock() || !rhsBody.hasOneBlock())
+    return false;
+
+  Block &lhsBlock = lhsBody.front();
+  Block &rhsBlock = rhsBody.front();
+  if (lhsBlock.getOperations().size() != rhsBlock.getOperations().size())
+    return false;
+
+  IRMapping mapping;
+  mapping.map(lhsBlock.getArguments(), rhsBlock.getArguments());
+  auto checkEquivalent = [&](Value lhsValue, Value rhsValue) {
+    return success(mapping.lookupOrNull(lhsValue) == rhsValue);
+  };
+  auto markEquivalent = [&](Value lhsValue, Value rhsValue) {
+    mapping.map(lhsValue, rhsValue);
+  };
+
+  for (auto [lhsOp, rhsOp] : llvm::zip(lhsBlock, rhsBlock))
+    if (!OperationEquivalence::isEquivalentTo(
+            &lhsOp, &rhsOp, checkEquivalent, markEquivalent,
+            OperationEquivalence::IgnoreLocations))
+      return false;
+  return true;
+}
+
+struct MergeEmitCDuplicatesPass
+    : public MergeEmitCDuplicatesBase<MergeEmitCDuplicatesPass> {
+  void runOnOperation() override {
+    IRRewriter rewriter(&getContext());
+    getOperation().walk(
+        [&](func::FuncOp funcOp) { mergeConstants(funcOp, rewriter); });
+
+    // Merging functions may make their callers identical, hence iterate.
+    while (mergeFunctions())
+      ;
+  }
+
+private:
+  /// Replaces constants in `funcOp` by an identical constant dominating them.
+  void mergeConstants(func::FuncOp funcOp, RewriterBase &rewriter) {
+    DominanceInfo domInfo(funcOp);
+    DenseMap<std::pair<Attribute, Type>, SmallVector<ConstantOp>> constants;
+
+    SmallVector<ConstantOp> constantOps;
+    funcOp.walk(
+        [&](ConstantOp constantOp) { constantOps.push_back(constantOp); });
+
+    for (ConstantOp constantOp : constantOps) {
+      auto key = std::make_pair(constantOp.getValue(), constantOp.getType());
+      SmallVector<ConstantOp> &candidates = constants[key];
+      auto it = llvm::find_if(candidates, [&](ConstantOp candidate) {
+        return domInfo.properlyDominates(candidate, constantOp);
+      });
+      if (it == candidates.end()) {
+        candidates.push_back(constantOp);
+        continue;
+      }
+      auto type = constantOp.getType().dyn_cast<ShapedType>();
+      if (type && type.hasStaticShape() && type.getElementType().isIntOrFloat())
+        numSavedBytes += getSizeInBytes(type);
+      rewriter.replaceOp(constantOp, it->getResult());
+      numMergedConstants++;
+    }
+  }
+
+  /// Replaces private functions by an identical function preceding them and
+  /// returns true if any function was merged.
+  bool mergeFunctions() {
+    ModuleOp moduleOp = getOperation();
+    DenseMap<llvm::hash_code, SmallVector<func::FuncOp>> functions;
+    SmallVector<func::FuncOp> duplicates;
+    bool changed = false;
+
+    for (auto funcOp : moduleOp.getOps<func::FuncOp>()) {
+      if (!funcOp.isPrivate() || funcOp.isExternal())
+        continue;
+
+      SmallVector<func::FuncOp> &candidates =
+          functions[hashFunction(funcOp)];
+      auto it = llvm::find_if(candidates, [&](func::FuncOp candidate) {
+        return isEquivalentFunction(candidate, funcOp);
+      });
+      if (it == candidates.end()) {
+        candidates.push_back(funcOp);
+        continue;
+      }
+
+      if (failed(SymbolTable::replaceAllSymbolUses(
+              funcOp, it->getSymNameAttr(), moduleOp))) {
+        funcOp.emitError("failed to replace uses of merged function");
+        signalPassFailure();
+        return false;
+      }
+      duplicates.push_back(funcOp);
+    }
+
+    for (func::FuncOp funcOp : duplicates) {
+      funcOp.erase();
+      numMergedFunctions++;
+      changed = true;
+    }
+    return changed;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::ModuleOp>>
+createMergeEmitCDuplicatesPass() {
+  return std::make_unique<MergeEmitCDuplicatesPass>();
+}
+
+} // namespace emitc
+} // namespace mlir
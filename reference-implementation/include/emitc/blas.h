@@ -0,0 +1,225 @@
+// Copyright Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// This file defines the CBLAS kernels used by the `blas` kernels of the GEMM
+// shaped ops if `EMITC_USE_BLAS` is defined. Each kernel returns false if it
+// does not support the element type of its operands, in which case the caller
+// falls back to its naive kernel.
+
+#ifndef EMITC_BLAS_H
+#define EMITC_BLAS_H
+
+#include <algorithm>
+#include <cblas.h>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "emitc/core_ops.h"
+#include "emitc/types.h"
+
+namespace emitc {
+namespace blas {
+
+namespace detail {
+
+// C = op(A) * op(B) + beta * C for row-major [M,K] op(A), [K,N] op(B) and
+// [M,N] C, using a matrix-vector product if C is a single row.
+inline void sgemm(bool transA, bool transB, size_t M, size_t N, size_t K,
+                  const float *a, const float *b, float beta, float *c) {
+  const int m = static_cast<int>(M);
+  const int n = static_cast<int>(N);
+  const int k = static_cast<int>(K);
+
+  if (M == 1) {
+    // The single row of op(A) is contiguous in both layouts.
+    if (transB) {
+      cblas_sgemv(CblasRowMajor, CblasNoTrans, n, k, 1.0f, b, k, a, 1, beta,
+                  c, 1);
+    } else {
+      cblas_sgemv(CblasRowMajor, CblasTrans, k, n, 1.0f, b, n, a, 1, beta, c,
+                  1);
+    }
+    return;
+  }
+
+  cblas_sgemm(CblasRowMajor, transA ? CblasTrans : CblasNoTrans,
+              transB ? CblasTrans : CblasNoTrans, m, n, k, 1.0f, a,
+              transA ? m : k, b, transB ? k : n, beta, c, n);
+}
+
+template <bool TransA, bool TransB, typename Dest, typename Lhs, typename Rhs>
+inline bool gemm(std::false_type, Lhs &, Rhs &, Dest &, bool) {
+  return false;
+}
+
+template <bool TransA, bool TransB, typename Dest, typename Lhs, typename Rhs>
+inline bool gemm(std::true_type, Lhs &a, Rhs &b, Dest &c, bool accumulate) {
+  constexpr size_t R = Dest::rank();
+  constexpr size_t B = R == 3 ? Dest::dim(0) : 1;
+  constexpr size_t M = Dest::dim(R - 2);
+  constexpr size_t N = Dest::dim(R - 1);
+  constexpr size_t K = TransA ? Lhs::dim(R - 2) : Lhs::dim(R - 1);
+
+  for (size_t i = 0; i < B; i++) {
+    sgemm(TransA, TransB, M, N, K, a.get() + i * M * K, b.get() + i * K * N,
+          accumulate ? 1.0f : 0.0f, c.get() + i * M * N);
+  }
+  return true;
+}
+
+// Returns true if the [R,C] matrix with row stride `rs` and column stride `cs`
+// is a row-major matrix or, if `trans` is set, a transposed row-major matrix
+// with the leading dimension `ld`.
+inline bool get_matrix_layout(size_t R, size_t C, size_t rs, size_t cs,
+                              bool &trans, int &ld) {
+  if (cs <= 1 && (R == 1 || rs >= C)) {
+    trans = false;
+    ld = static_cast<int>(R == 1 ? C : rs);
+    return true;
+  }
+  if (rs <= 1 && (C == 1 || cs >= R)) {
+    trans = true;
+    ld = static_cast<int>(C == 1 ? R : cs);
+    return true;
+  }
+  return false;
+}
+
+template <typename Dest, typename Layout, typename Lhs, typename Rhs>
+inline bool dot_general(std::false_type, const Layout &, Lhs &, Rhs &, Dest &) {
+  return false;
+}
+
+template <typename Dest, typename Layout, typename Lhs, typename Rhs>
+inline bool dot_general(std::true_type, const Layout &layout, Lhs &a, Rhs &b,
+                        Dest &c) {
+  const size_t M = layout.rows.size();
+  const size_t N = layout.columns.size();
+  const size_t K = layout.contracting.size();
+
+  size_t a_rs, a_cs, b_rs, b_cs;
+  bool transA, transB;
+  int lda, ldb;
+  if (!layout.rows.get_stride(layout.rows.lhs_strides, a_rs) ||
+      !layout.contracting.get_stride(layout.contracting.lhs_strides, a_cs) ||
+      !layout.contracting.get_stride(layout.contracting.rhs_strides, b_rs) ||
+      !layout.columns.get_stride(layout.columns.rhs_strides, b_cs) ||
+      !get_matrix_layout(M, K, a_rs, a_cs, transA, lda) ||
+      !get_matrix_layout(K, N, b_rs, b_cs, transB, ldb)) {
+    return false;
+  }
+
+  float *output = c.get();
+  layout.batch.for_each([&](size_t a_offset, size_t b_offset) {
+    cblas_sgemm(CblasRowMajor, transA ? CblasTrans : CblasNoTrans,
+                transB ? CblasTrans : CblasNoTrans, static_cast<int>(M),
+                static_cast<int>(N), static_cast<int>(K), 1.0f,
+                a.get() + a_offset, lda, b.get() + b_offset, ldb, 0.0f, output,
+                static_cast<int>(N));
+    output += M * N;
+  });
+  return true;
+}
+
+template <typename Dest, typename Src, typename Weights>
+inline bool conv2d(std::false_type, Src &, Weights &, int64_t, int64_t,
+                   int64_t, int64_t, Dest &) {
+  return false;
+}
+
+template <typename Dest, typename Src, typename Weights>
+inline bool conv2d(std::true_type, Src &input, Weights &weights, int64_t pt,
+                   int64_t pl, int64_t SH, int64_t SW, Dest &output) {
+  constexpr size_t N = Src::dim(0);
+  constexpr size_t H_IN = Src::dim(1);
+  constexpr size_t W_IN = Src::dim(2);
+  constexpr size_t C_IN = Src::dim(3);
+  constexpr size_t K_H = Weights::dim(1);
+  constexpr size_t K_W = Weights::dim(2);
+  constexpr size_t C_OUT = Dest::dim(3);
+  constexpr size_t H = Dest::dim(1);
+  constexpr size_t W = Dest::dim(2);
+  constexpr size_t K = K_H * K_W * C_IN;
+
+  // 1x1 convolutions without padding and strides multiply the input directly.
+  if (K_H == 1 && K_W == 1 && pt == 0 && pl == 0 && SH == 1 && SW == 1 &&
+      H == H_IN && W == W_IN) {
+    sgemm(false, true, N * H * W, C_OUT, C_IN, input.get(), weights.get(),
+          0.0f, output.get());
+    return true;
+  }
+
+  // Lower the input to the [N*H*W,KH*KW*IC] matrix of its zero padded patches,
+  // which matches the [OC,KH,KW,IC] layout of the weights.
+  std::vector<float> patches(N * H * W * K, 0.0f);
+  const float *in = input.get();
+  for (size_t n = 0; n < N; n++) {
+    for (size_t h = 0; h < H; h++) {
+      for (size_t w = 0; w < W; w++) {
+        float *patch = &patches[((n * H + h) * W + w) * K];
+        for (size_t kh = 0; kh < K_H; kh++) {
+          const int64_t h_in = static_cast<int64_t>(h * SH + kh) - pt;
+          if (h_in < 0 || h_in >= static_cast<int64_t>(H_IN))
+            continue;
+          for (size_t kw = 0; kw < K_W; kw++) {
+            const int64_t w_in = static_cast<int64_t>(w * SW + kw) - pl;
+            if (w_in < 0 || w_in >= static_cast<int64_t>(W_IN))
+              continue;
+            std::copy_n(&in[((n * H_IN + h_in) * W_IN + w_in) * C_IN], C_IN,
+                        &patch[(kh * K_W + kw) * C_IN]);
+          }
+        }
+      }
+    }
+  }
+
+  sgemm(false, true, N * H * W, C_OUT, K, patches.data(), weights.get(), 0.0f,
+        output.get());
+  return true;
+}
+
+template <typename T>
+using is_float_tensor = std::is_same<typename get_element_type<T>::type, float>;
+
+template <typename Dest, typename Lhs, typename Rhs>
+using is_float = std::integral_constant<bool, is_float_tensor<Dest>::value &&
+                                                  is_float_tensor<Lhs>::value &&
+                                                  is_float_tensor<Rhs>::value>;
+
+} // namespace detail
+
+// Computes `c` = op(`a`) * op(`b`) for [M,K] and [K,N] operands or, if
+// `accumulate` is set, adds the product to `c`. Operands of rank 3 are
+// multiplied batchwise. op transposes [K,M] `a` if `TransA` is set and [N,K]
+// `b` if `TransB` is set.
+template <bool TransA, bool TransB, typename Dest, typename Lhs, typename Rhs>
+inline bool gemm(Lhs &a, Rhs &b, Dest &c, bool accumulate = false) {
+  return detail::gemm<TransA, TransB>(detail::is_float<Dest, Lhs, Rhs>{}, a, b,
+                                      c, accumulate);
+}
+
+// Computes the DotGeneralOp of `a` and `b` with one GEMM per batch if the rows
+// and columns of both operands are evenly spaced as given by `layout`.
+template <typename Dest, typename Layout, typename Lhs, typename Rhs>
+inline bool dot_general(const Layout &layout, Lhs &a, Rhs &b, Dest &c) {
+  return detail::dot_general(detail::is_float<Dest, Lhs, Rhs>{}, layout, a, b,
+                             c);
+}
+
+// Computes the convolution of [N,IH,IW,IC] `input` and [OC,KH,KW,IC] `weights`
+// as a matrix multiplication of the input patches and the weights.
+template <typename Dest, typename Src, typename Weights>
+inline bool conv2d(Src &input, Weights &weights, int64_t pt, int64_t pl,
+                   int64_t SH, int64_t SW, Dest &output) {
+  return detail::conv2d(detail::is_float<Dest, Src, Weights>{}, input, weights,
+                        pt, pl, SH, SW, output);
+}
+
+} // namespace blas
+} // namespace emitc
+
+#endif // EMITC_BLAS_H
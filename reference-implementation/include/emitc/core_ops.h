@@ -15,9 +15,16 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <type_traits>
 #include <vector>
 
+#ifdef __AVX__
+#include <immintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
 #include "emitc/types.h"
 
 namespace emitc {
@@ -29,7 +36,7 @@ template <typename Src>
 inline Src abs(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::abs);
+  auto f = [](ET_Src element) -> ET_Src { return std::abs(element); };
 
   return unary<Src>(x, f);
 }
@@ -39,7 +46,7 @@ template <typename Src>
 inline Src ceil(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::ceil);
+  auto f = [](ET_Src element) -> ET_Src { return std::ceil(element); };
 
   return unary<Src>(x, f);
 }
@@ -50,9 +57,19 @@ inline Dest convert(Src x) {
   using ET_Dest = typename get_element_type<Dest>::type;
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto cast = [](ET_Src value) { return static_cast<ET_Dest>(value); };
+  // Half precision tensors are converted by the vectorized conversions.
+  constexpr bool half_precision = emitc::is_half_precision<ET_Dest>::value ||
+                                  emitc::is_half_precision<ET_Src>::value;
+  constexpr bool boolean =
+      std::is_same<ET_Dest, bool>::value || std::is_same<ET_Src, bool>::value;
+
+  if constexpr (is_tensor<Src>::value && half_precision && !boolean) {
+    return convert_elements<Dest>(x);
+  } else {
+    auto cast = [](ET_Src value) { return static_cast<ET_Dest>(value); };
 
-  return unary<Dest, Src, UnaryFuncType<ET_Dest, ET_Src>>(x, cast);
+    return unary<Dest, Src, UnaryFuncType<ET_Dest, ET_Src>>(x, cast);
+  }
 }
 
 // ExpOp
@@ -60,7 +77,7 @@ template <typename Src>
 inline Src exp(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::exp);
+  auto f = [](ET_Src element) -> ET_Src { return std::exp(element); };
 
   return unary<Src>(x, f);
 }
@@ -70,7 +87,7 @@ template <typename Src>
 inline Src floor(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::floor);
+  auto f = [](ET_Src element) -> ET_Src { return std::floor(element); };
 
   return unary<Src>(x, f);
 }
@@ -80,7 +97,7 @@ template <typename Src>
 inline Src log(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::log);
+  auto f = [](ET_Src element) -> ET_Src { return std::log(element); };
 
   return unary<Src>(x, f);
 }
@@ -136,17 +153,126 @@ template <typename Src>
 inline Src sqrt(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::sqrt);
+  auto f = [](ET_Src element) -> ET_Src { return std::sqrt(element); };
 
   return unary<Src>(x, f);
 }
 
+// RsqrtOp
+// By default, 1 / sqrt(x) is computed with the same rounding as a sqrt
+// followed by a division. If EMITC_FAST_RSQRT is defined, normal single
+// precision values are instead computed from a reciprocal square root
+// estimate refined by Newton iterations, which is accurate to a few ulp.
+// Single precision tensors use packed estimates of 8 or 4 values.
+#ifdef EMITC_FAST_RSQRT
+constexpr bool fast_rsqrt = true;
+#else
+constexpr bool fast_rsqrt = false;
+#endif
+
+namespace detail {
+inline float rsqrt_estimate(float x) {
+#ifdef __SSE__
+  // Relative error of at most 1.5 * 2^-12.
+  return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+  // Relative error of at most 1.8e-3, refined by an extra Newton iteration.
+  uint32_t i;
+  std::memcpy(&i, &x, sizeof(i));
+  i = 0x5f375a86 - (i >> 1);
+  float y;
+  std::memcpy(&y, &i, sizeof(y));
+  return 1.5f * y - 0.5f * x * y * y * y;
+#endif
+}
+
+inline float fast_rsqrt(float x) {
+  if (!(x >= std::numeric_limits<float>::min() &&
+        x <= std::numeric_limits<float>::max())) {
+    return 1.0f / std::sqrt(x);
+  }
+  float y = rsqrt_estimate(x);
+  return y * (1.5f - 0.5f * x * y * y);
+}
+
+// Computes fast_rsqrt for the n values of src. Blocks with values that are
+// not normal fall back to the scalar function, as does the tail.
+inline void fast_rsqrt_n(const float *src, float *dest, size_t n) {
+  size_t i = 0;
+#ifdef __AVX__
+  const __m256 min8 = _mm256_set1_ps(std::numeric_limits<float>::min());
+  const __m256 max8 = _mm256_set1_ps(std::numeric_limits<float>::max());
+  const __m256 half8 = _mm256_set1_ps(0.5f);
+  const __m256 three_halves8 = _mm256_set1_ps(1.5f);
+  for (; n - i >= 8; i += 8) {
+    __m256 x = _mm256_loadu_ps(src + i);
+    __m256 normal = _mm256_and_ps(_mm256_cmp_ps(x, min8, _CMP_GE_OQ),
+                                  _mm256_cmp_ps(x, max8, _CMP_LE_OQ));
+    if (_mm256_movemask_ps(normal) != 0xff) {
+      for (size_t j = i; j < i + 8; j++) {
+        dest[j] = fast_rsqrt(src[j]);
+      }
+      continue;
+    }
+    __m256 y = _mm256_rsqrt_ps(x);
+    __m256 xyy = _mm256_mul_ps(_mm256_mul_ps(x, y), y);
+    __m256 r = _mm256_sub_ps(three_halves8, _mm256_mul_ps(half8, xyy));
+    _mm256_storeu_ps(dest + i, _mm256_mul_ps(y, r));
+  }
+#endif
+#ifdef __SSE__
+  const __m128 min4 = _mm_set1_ps(std::numeric_limits<float>::min());
+  const __m128 max4 = _mm_set1_ps(std::numeric_limits<float>::max());
+  const __m128 half4 = _mm_set1_ps(0.5f);
+  const __m128 three_halves4 = _mm_set1_ps(1.5f);
+  for (; n - i >= 4; i += 4) {
+    __m128 x = _mm_loadu_ps(src + i);
+    __m128 normal = _mm_and_ps(_mm_cmpge_ps(x, min4), _mm_cmple_ps(x, max4));
+    if (_mm_movemask_ps(normal) != 0xf) {
+      for (size_t j = i; j < i + 4; j++) {
+        dest[j] = fast_rsqrt(src[j]);
+      }
+      continue;
+    }
+    __m128 y = _mm_rsqrt_ps(x);
+    __m128 xyy = _mm_mul_ps(_mm_mul_ps(x, y), y);
+    __m128 r = _mm_sub_ps(three_halves4, _mm_mul_ps(half4, xyy));
+    _mm_storeu_ps(dest + i, _mm_mul_ps(y, r));
+  }
+#endif
+  for (; i < n; i++) {
+    dest[i] = fast_rsqrt(src[i]);
+  }
+}
+} // namespace detail
+
+template <typename Src, bool Fast = fast_rsqrt>
+inline Src rsqrt(Src x) {
+  using ET_Src = typename get_element_type<Src>::type;
+
+  if constexpr (Fast && std::is_same<ET_Src, float>::value) {
+    if constexpr (is_tensor<Src>::value) {
+      Src z;
+      detail::fast_rsqrt_n(x.get(), z.get(), Src::size());
+      return z;
+    } else {
+      return detail::fast_rsqrt(x);
+    }
+  } else {
+    auto f = [](ET_Src element) -> ET_Src {
+      return static_cast<ET_Src>(1.0) / std::sqrt(element);
+    };
+
+    return unary<Src>(x, f);
+  }
+}
+
 // TanhOp
 template <typename Src>
 inline Src tanh(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::tanh);
+  auto f = [](ET_Src element) -> ET_Src { return std::tanh(element); };
 
   return unary<Src>(x, f);
 }
@@ -236,11 +362,11 @@ inline Src sub(Src x, Src y) {
 
 /// Other ops.
 // BroadcastInDimOp
-// The broadcast_dimensions argument maps from Src to Dest dimensions
-template <typename Dest, typename Src>
-inline Dest
-broadcast_in_dim(Src operand,
-                 Tensor<int64_t, Src::rank()> broadcast_dimensions) {
+// The broadcast_dimensions argument maps from Src to Dest dimensions. It is
+// either a tensor or an array of compile-time constants.
+template <typename Dest, typename Src,
+          typename Dimensions = Tensor<int64_t, Src::rank()>>
+inline Dest broadcast_in_dim(Src operand, Dimensions broadcast_dimensions) {
   static_assert(is_tensor<Src>::value, "Expected tensor argument");
   static_assert(is_tensor<Dest>::value, "Expected tensor result");
 
@@ -265,7 +391,7 @@ broadcast_in_dim(Src operand,
     // Reverse mapping with broadcast_dimensions
     std::array<size_t, Src::rank()> src_index;
     for (size_t j = 0; j < src_index.size(); j++) {
-      src_index[j] = dest_index[broadcast_dimensions(j)];
+      src_index[j] = dest_index[broadcast_dimensions[j]];
     }
     // Handle case of broadcasting dimensions of size 1
     for (size_t i = 0; i < src_index.size(); ++i) {
@@ -287,17 +413,19 @@ Dest dot(Lhs lhs, Rhs rhs) {
   static_assert(is_tensor_of_dim<2, Rhs>::value, "Expected 2 dimensional rhs");
   static_assert(Lhs::dim(1) == Rhs::dim(0),
                 "Expected contracting dimension to match");
-  Dest output;
+
+  // Half precision elements are widened one at a time.
+  accumulator_tensor_t<Dest> output;
 
   for (size_t m = 0; m < lhs.dim(0); m++) {
     for (size_t n = 0; n < lhs.dim(1); n++) {
       for (size_t k = 0; k < rhs.dim(1); k++) {
-        output(m, k) += lhs(m, n) * rhs(n, k);
+        output(m, k) += widen(lhs(m, n)) * widen(rhs(n, k));
       }
     }
   }
 
-  return output;
+  return narrow<Dest>(output);
 }
 
 // BatchMatmulOp
@@ -312,18 +440,514 @@ Dest batch_matmul(Lhs lhs, Rhs rhs) {
   static_assert(Dest::dim(1) == Lhs::dim(1), "Expected row dimension to match");
   static_assert(Dest::dim(2) == Rhs::dim(2),
                 "Expected column dimension to match");
-  Dest output;
+
+  accumulator_tensor_t<Dest> output;
 
   for (size_t b = 0; b < lhs.dim(0); b++) {
     for (size_t m = 0; m < lhs.dim(1); m++) {
       for (size_t n = 0; n < lhs.dim(2); n++) {
         for (size_t k = 0; k < rhs.dim(2); k++) {
-          output(b, m, k) += lhs(b, m, n) * rhs(b, n, k);
+          output(b, m, k) += widen(lhs(b, m, n)) * widen(rhs(b, n, k));
         }
       }
     }
   }
 
+  return narrow<Dest>(output);
+}
+
+// DotOp with transposed operands
+// If `TransposeLhs` is set, `lhs` is passed as [K,M] instead of [M,K]. If
+// `TransposeRhs` is set, `rhs` is passed as [N,K] instead of [K,N].
+template <typename Dest, bool TransposeLhs, bool TransposeRhs, typename Lhs,
+          typename Rhs>
+Dest dot_transposed(Lhs lhs, Rhs rhs) {
+  static_assert(is_tensor_of_dim<2, Lhs>::value, "Expected 2 dimensional lhs");
+  static_assert(is_tensor_of_dim<2, Rhs>::value, "Expected 2 dimensional rhs");
+  static_assert(is_tensor_of_dim<2, Dest>::value,
+                "Expected 2 dimensional output");
+
+  constexpr size_t M = Dest::dim(0);
+  constexpr size_t N = Dest::dim(1);
+  constexpr size_t K = TransposeLhs ? Lhs::dim(0) : Lhs::dim(1);
+
+  static_assert(M == (TransposeLhs ? Lhs::dim(1) : Lhs::dim(0)),
+                "Expected row dimension to match");
+  static_assert(N == (TransposeRhs ? Rhs::dim(0) : Rhs::dim(1)),
+                "Expected column dimension to match");
+  static_assert(K == (TransposeRhs ? Rhs::dim(1) : Rhs::dim(0)),
+                "Expected contracting dimension to match");
+
+  accumulator_tensor_t<Dest> output;
+
+  for (size_t m = 0; m < M; m++) {
+    for (size_t k = 0; k < K; k++) {
+      const auto a = widen(TransposeLhs ? lhs(k, m) : lhs(m, k));
+      for (size_t n = 0; n < N; n++) {
+        output(m, n) += a * widen(TransposeRhs ? rhs(n, k) : rhs(k, n));
+      }
+    }
+  }
+
+  return narrow<Dest>(output);
+}
+
+// BatchMatmulOp with transposed operands
+// If `TransposeLhs` is set, `lhs` is passed as [B,K,M] instead of [B,M,K]. If
+// `TransposeRhs` is set, `rhs` is passed as [B,N,K] instead of [B,K,N].
+template <typename Dest, bool TransposeLhs, bool TransposeRhs, typename Lhs,
+          typename Rhs>
+Dest batch_matmul_transposed(Lhs lhs, Rhs rhs) {
+  static_assert(is_tensor_of_dim<3, Lhs>::value, "Expected 3 dimensional lhs");
+  static_assert(is_tensor_of_dim<3, Rhs>::value, "Expected 3 dimensional rhs");
+  static_assert(is_tensor_of_dim<3, Dest>::value,
+                "Expected 3 dimensional output");
+  static_assert(Lhs::dim(0) == Rhs::dim(0) && Lhs::dim(0) == Dest::dim(0),
+                "Expected batch dimension to match");
+
+  constexpr size_t B = Dest::dim(0);
+  constexpr size_t M = Dest::dim(1);
+  constexpr size_t N = Dest::dim(2);
+  constexpr size_t K = TransposeLhs ? Lhs::dim(1) : Lhs::dim(2);
+
+  static_assert(M == (TransposeLhs ? Lhs::dim(2) : Lhs::dim(1)),
+                "Expected row dimension to match");
+  static_assert(N == (TransposeRhs ? Rhs::dim(1) : Rhs::dim(2)),
+                "Expected column dimension to match");
+  static_assert(K == (TransposeRhs ? Rhs::dim(2) : Rhs::dim(1)),
+                "Expected contracting dimension to match");
+
+  accumulator_tensor_t<Dest> output;
+
+  for (size_t b = 0; b < B; b++) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t k = 0; k < K; k++) {
+        const auto a = widen(TransposeLhs ? lhs(b, k, m) : lhs(b, m, k));
+        for (size_t n = 0; n < N; n++) {
+          output(b, m, n) +=
+              a * widen(TransposeRhs ? rhs(b, n, k) : rhs(b, k, n));
+        }
+      }
+    }
+  }
+
+  return narrow<Dest>(output);
+}
+
+namespace detail {
+// Returns the offsets of all indices into the `dimensions` of a tensor.
+template <size_t Rank>
+std::vector<size_t> dimension_offsets(const std::array<size_t, Rank> &shape,
+                                      const std::array<size_t, Rank> &strides,
+                                      const std::vector<size_t> &dimensions) {
+  std::vector<size_t> offsets{0};
+  for (size_t dimension : dimensions) {
+    std::vector<size_t> next;
+    next.reserve(offsets.size() * shape[dimension]);
+    for (size_t offset : offsets) {
+      for (size_t i = 0; i < shape[dimension]; i++) {
+        next.push_back(offset + i * strides[dimension]);
+      }
+    }
+    offsets = std::move(next);
+  }
+  return offsets;
+}
+
+// Sizes and element strides of up to `MaxRank` dimensions of the `lhs` and
+// `rhs` of a DotGeneralOp. Dimensions of only one operand have a zero stride
+// in the other operand.
+template <size_t MaxRank>
+struct DotGeneralDimensions {
+  size_t rank = 0;
+  std::array<size_t, MaxRank> sizes{};
+  std::array<size_t, MaxRank> lhs_strides{};
+  std::array<size_t, MaxRank> rhs_strides{};
+
+  void push_back(size_t size, size_t lhs_stride, size_t rhs_stride) {
+    assert(rank < MaxRank);
+    sizes[rank] = size;
+    lhs_strides[rank] = lhs_stride;
+    rhs_strides[rank] = rhs_stride;
+    rank++;
+  }
+
+  size_t size() const {
+    size_t result = 1;
+    for (size_t i = 0; i < rank; i++) {
+      result *= sizes[i];
+    }
+    return result;
+  }
+
+  // Calls `f(lhs_offset, rhs_offset)` for all indices in row-major order.
+  template <typename F>
+  void for_each(F f) const {
+    if (rank == 0) {
+      f(size_t{0}, size_t{0});
+      return;
+    }
+    if (size() == 0) {
+      return;
+    }
+
+    const size_t inner = rank - 1;
+    std::array<size_t, MaxRank> index{};
+    size_t lhs = 0;
+    size_t rhs = 0;
+    while (true) {
+      for (size_t i = 0; i < sizes[inner]; i++) {
+        f(lhs + i * lhs_strides[inner], rhs + i * rhs_strides[inner]);
+      }
+      size_t d = inner;
+      while (true) {
+        if (d == 0) {
+          return;
+        }
+        d--;
+        lhs += lhs_strides[d];
+        rhs += rhs_strides[d];
+        if (++index[d] < sizes[d]) {
+          break;
+        }
+        lhs -= sizes[d] * lhs_strides[d];
+        rhs -= sizes[d] * rhs_strides[d];
+        index[d] = 0;
+      }
+    }
+  }
+
+  // Returns true if the offsets given by `strides` are evenly spaced and sets
+  // `stride` to their distance, or to 0 for a single offset.
+  bool get_stride(const std::array<size_t, MaxRank> &strides,
+                  size_t &stride) const {
+    stride = 0;
+    size_t extent = 0;
+    for (size_t i = rank; i-- > 0;) {
+      if (sizes[i] == 1) {
+        continue;
+      }
+      if (stride == 0) {
+        stride = strides[i];
+      } else if (strides[i] != extent) {
+        return false;
+      }
+      extent = strides[i] * sizes[i];
+    }
+    return true;
+  }
+};
+
+// Dimensions of a DotGeneralOp, which view `lhs` as [B,M,K] and `rhs` as
+// [B,K,N] matrices without transposing them. B, M, N and K enumerate the
+// batching, lhs free, rhs free and contracting dimensions in their order,
+// such that the result is the row-major [B,M,N] matrix.
+template <size_t MaxRank>
+struct DotGeneralLayout {
+  DotGeneralDimensions<MaxRank> batch;
+  DotGeneralDimensions<MaxRank> rows;
+  DotGeneralDimensions<MaxRank> contracting;
+  DotGeneralDimensions<MaxRank> columns;
+};
+
+template <typename Lhs, typename Rhs, typename BatchingDimensions,
+          typename ContractingDimensions>
+auto dot_general_layout(BatchingDimensions lhs_batching_dimensions,
+                        BatchingDimensions rhs_batching_dimensions,
+                        ContractingDimensions lhs_contracting_dimensions,
+                        ContractingDimensions rhs_contracting_dimensions) {
+  constexpr auto lhs_strides = Lhs::strides();
+  constexpr auto rhs_strides = Rhs::strides();
+
+  DotGeneralLayout<std::max(Lhs::rank(), Rhs::rank())> layout;
+  std::array<bool, Lhs::rank()> lhs_free;
+  std::array<bool, Rhs::rank()> rhs_free;
+  lhs_free.fill(true);
+  rhs_free.fill(true);
+
+  for (size_t i = 0; i < lhs_batching_dimensions.size(); i++) {
+    const size_t l = lhs_batching_dimensions[i];
+    const size_t r = rhs_batching_dimensions[i];
+    assert(Lhs::dim(l) == Rhs::dim(r));
+    layout.batch.push_back(Lhs::dim(l), lhs_strides[l], rhs_strides[r]);
+    lhs_free[l] = false;
+    rhs_free[r] = false;
+  }
+  for (size_t i = 0; i < lhs_contracting_dimensions.size(); i++) {
+    const size_t l = lhs_contracting_dimensions[i];
+    const size_t r = rhs_contracting_dimensions[i];
+    assert(Lhs::dim(l) == Rhs::dim(r));
+    layout.contracting.push_back(Lhs::dim(l), lhs_strides[l], rhs_strides[r]);
+    lhs_free[l] = false;
+    rhs_free[r] = false;
+  }
+  for (size_t i = 0; i < Lhs::rank(); i++) {
+    if (lhs_free[i]) {
+      layout.rows.push_back(Lhs::dim(i), lhs_strides[i], 0);
+    }
+  }
+  for (size_t i = 0; i < Rhs::rank(); i++) {
+    if (rhs_free[i]) {
+      layout.columns.push_back(Rhs::dim(i), 0, rhs_strides[i]);
+    }
+  }
+  return layout;
+}
+
+template <typename Dest, typename Layout, typename Lhs, typename Rhs>
+Dest dot_general(const Layout &layout, Lhs &lhs, Rhs &rhs) {
+  const size_t N = layout.columns.size();
+  assert(layout.batch.size() * layout.rows.size() * N == Dest::size());
+
+  accumulator_tensor_t<Dest> output;
+
+  size_t output_row = 0;
+  layout.batch.for_each([&](size_t lhs_batch, size_t rhs_batch) {
+    layout.rows.for_each([&](size_t lhs_row, size_t) {
+      layout.contracting.for_each([&](size_t lhs_k, size_t rhs_k) {
+        const auto a = widen(lhs[lhs_batch + lhs_row + lhs_k]);
+        const size_t rhs_row = rhs_batch + rhs_k;
+        size_t n = output_row;
+        layout.columns.for_each([&](size_t, size_t rhs_column) {
+          output[n++] += a * widen(rhs[rhs_row + rhs_column]);
+        });
+      });
+      output_row += N;
+    });
+  });
+
+  return narrow<Dest>(output);
+}
+} // namespace detail
+
+// DotGeneralOp
+// Multiplies `lhs` and `rhs` batchwise over the batching dimensions and
+// contracts them over the contracting dimensions. The result has the layout
+// [batch dimensions, lhs free dimensions, rhs free dimensions]. The operands
+// are accessed through the strides of their dimensions instead of being
+// transposed.
+template <typename Dest, typename Lhs, typename Rhs,
+          typename BatchingDimensions, typename ContractingDimensions>
+Dest dot_general(Lhs lhs, Rhs rhs, BatchingDimensions lhs_batching_dimensions,
+                 BatchingDimensions rhs_batching_dimensions,
+                 ContractingDimensions lhs_contracting_dimensions,
+                 ContractingDimensions rhs_contracting_dimensions) {
+  static_assert(is_tensor<Lhs>::value, "Expected tensor lhs");
+  static_assert(is_tensor<Rhs>::value, "Expected tensor rhs");
+  static_assert(is_tensor<Dest>::value, "Expected tensor result");
+
+  auto layout = detail::dot_general_layout<Lhs, Rhs>(
+      lhs_batching_dimensions, rhs_batching_dimensions,
+      lhs_contracting_dimensions, rhs_contracting_dimensions);
+  return detail::dot_general<Dest>(layout, lhs, rhs);
+}
+
+namespace detail {
+// Sizes and element strides of the operands of a 2-D convolution. The
+// operands are accessed through the strides of their logical dimensions,
+// which supports any layout given by dimension numbers as well as flipped
+// kernels with negative strides. Input is [N,H_IN,W_IN,C_IN], the kernel is
+// [K_H,K_W,K_I,C_OUT] starting at `k_offset` and output is [N_OUT,H,W,C_OUT].
+struct ConvParams {
+  int64_t N, H_IN, W_IN, C_IN;
+  int64_t in_n, in_h, in_w, in_c;
+  int64_t K_H, K_W, K_I, C_OUT;
+  int64_t k_offset, k_h, k_w, k_i, k_o;
+  int64_t N_OUT, H, W;
+  int64_t out_n, out_h, out_w, out_c;
+  int64_t S_H = 1, S_W = 1;
+  int64_t pt = 0, pl = 0;
+  int64_t LD_H = 1, LD_W = 1;
+  int64_t RD_H = 1, RD_W = 1;
+  int64_t feature_group_count = 1;
+  int64_t batch_group_count = 1;
+};
+
+// Innermost loops over the channels of a group, specialized for layouts with
+// contiguous output channels (e.g. HWIO kernels), contiguous input channels
+// (e.g. OHWI kernels) and arbitrary strides.
+enum class ConvChannels { OutputContiguous, InputContiguous, Strided };
+
+template <ConvChannels Channels, typename T, typename U, typename V>
+void convolution(const ConvParams &p, const T *input, const U *weights,
+                 V *output) {
+  const int64_t G = p.feature_group_count * p.batch_group_count;
+  const int64_t G_OUT = p.C_OUT / G;
+  // Size of the input dilated by the lhs dilation.
+  const int64_t H_DIL = (p.H_IN - 1) * p.LD_H + 1;
+  const int64_t W_DIL = (p.W_IN - 1) * p.LD_W + 1;
+
+  for (int64_t n = 0; n < p.N_OUT; n++) {
+    for (int64_t g = 0; g < G; g++) {
+      // Batch groups split the input batch, feature groups the input channels.
+      const int64_t n_in = (g / p.feature_group_count) * p.N_OUT + n;
+      const int64_t c_in = (g % p.feature_group_count) * p.K_I;
+      const int64_t c_out = g * G_OUT;
+
+      for (int64_t h = 0; h < p.H; h++) {
+        for (int64_t w = 0; w < p.W; w++) {
+          V *out = output + n * p.out_n + h * p.out_h + w * p.out_w +
+                   c_out * p.out_c;
+
+          for (int64_t kh = 0; kh < p.K_H; kh++) {
+            // Skip the holes of the dilated input instead of materializing it.
+            const int64_t h_dil = h * p.S_H + kh * p.RD_H - p.pt;
+            if (h_dil < 0 || h_dil >= H_DIL || h_dil % p.LD_H != 0)
+              continue;
+            const int64_t h_in = h_dil / p.LD_H;
+
+            for (int64_t kw = 0; kw < p.K_W; kw++) {
+              const int64_t w_dil = w * p.S_W + kw * p.RD_W - p.pl;
+              if (w_dil < 0 || w_dil >= W_DIL || w_dil % p.LD_W != 0)
+                continue;
+              const int64_t w_in = w_dil / p.LD_W;
+
+              const T *in = input + n_in * p.in_n + h_in * p.in_h +
+                            w_in * p.in_w + c_in * p.in_c;
+              const U *k = weights + p.k_offset + kh * p.k_h + kw * p.k_w +
+                           c_out * p.k_o;
+
+              if (Channels == ConvChannels::OutputContiguous) {
+                for (int64_t i = 0; i < p.K_I; i++) {
+                  const V x = widen(in[i * p.in_c]);
+                  const U *k_row = k + i * p.k_i;
+                  for (int64_t o = 0; o < G_OUT; o++) {
+                    out[o] += x * widen(k_row[o]);
+                  }
+                }
+              } else if (Channels == ConvChannels::InputContiguous) {
+                for (int64_t o = 0; o < G_OUT; o++) {
+                  const U *k_row = k + o * p.k_o;
+                  V acc = 0;
+                  for (int64_t i = 0; i < p.K_I; i++) {
+                    acc += widen(in[i]) * widen(k_row[i]);
+                  }
+                  out[o * p.out_c] += acc;
+                }
+              } else {
+                for (int64_t i = 0; i < p.K_I; i++) {
+                  for (int64_t o = 0; o < G_OUT; o++) {
+                    out[o * p.out_c] += widen(in[i * p.in_c]) *
+                                        widen(k[i * p.k_i + o * p.k_o]);
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T, typename U, typename V>
+void convolution(const ConvParams &p, const T *input, const U *weights,
+                 V *output) {
+  if (p.k_o == 1 && p.out_c == 1) {
+    convolution<ConvChannels::OutputContiguous>(p, input, weights, output);
+  } else if (p.in_c == 1 && p.k_i == 1) {
+    convolution<ConvChannels::InputContiguous>(p, input, weights, output);
+  } else {
+    convolution<ConvChannels::Strided>(p, input, weights, output);
+  }
+}
+
+// Accumulates the convolution of the tensors `input` and `weights` into
+// `output`. Half precision operands are widened element by element, while a
+// half precision output is accumulated in single precision.
+template <typename Dest, typename Src, typename Weights>
+void convolution(const ConvParams &p, Src &input, Weights &weights,
+                 Dest &output) {
+  if constexpr (is_half_precision_tensor<Dest>::value) {
+    auto wide_output = widen(output);
+    convolution(p, input.get(), weights.get(), wide_output.get());
+    output = narrow<Dest>(wide_output);
+  } else {
+    convolution(p, input.get(), weights.get(), output.get());
+  }
+}
+} // namespace detail
+
+// ConvolutionOp
+// Supports any dimension numbers, dilations and group counts. Lhs dilated
+// (transposed) convolutions skip the holes of the dilated input instead of
+// materializing it.
+template <typename Dest, typename Src, typename Weights>
+Dest convolution(Src input, Weights weights, int64_t batch_group_count,
+                 int64_t input_batch_dimension, int64_t input_feature_dimension,
+                 Tensor<int64_t, 2> input_spatial_dimensions,
+                 int64_t kernel_input_feature_dimension,
+                 int64_t kernel_output_feature_dimension,
+                 Tensor<int64_t, 2> kernel_spatial_dimensions,
+                 int64_t output_batch_dimension,
+                 int64_t output_feature_dimension,
+                 Tensor<int64_t, 2> output_spatial_dimensions,
+                 int64_t feature_group_count, Tensor<int64_t, 2, 2> padding,
+                 Tensor<int64_t, 2> lhs_dilation,
+                 Tensor<int64_t, 2> rhs_dilation,
+                 Tensor<int64_t, 2> window_strides) {
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+  static_assert(is_tensor_of_dim<4, Weights>::value,
+                "Expected 4 dimensional weights");
+
+  constexpr auto in_shape = Src::shape();
+  constexpr auto in_strides = Src::strides();
+  constexpr auto k_shape = Weights::shape();
+  constexpr auto k_strides = Weights::strides();
+  constexpr auto out_shape = Dest::shape();
+  constexpr auto out_strides = Dest::strides();
+
+  detail::ConvParams p;
+  p.N = in_shape[input_batch_dimension];
+  p.H_IN = in_shape[input_spatial_dimensions[0]];
+  p.W_IN = in_shape[input_spatial_dimensions[1]];
+  p.C_IN = in_shape[input_feature_dimension];
+  p.in_n = in_strides[input_batch_dimension];
+  p.in_h = in_strides[input_spatial_dimensions[0]];
+  p.in_w = in_strides[input_spatial_dimensions[1]];
+  p.in_c = in_strides[input_feature_dimension];
+
+  p.K_H = k_shape[kernel_spatial_dimensions[0]];
+  p.K_W = k_shape[kernel_spatial_dimensions[1]];
+  p.K_I = k_shape[kernel_input_feature_dimension];
+  p.C_OUT = k_shape[kernel_output_feature_dimension];
+  p.k_offset = 0;
+  p.k_h = k_strides[kernel_spatial_dimensions[0]];
+  p.k_w = k_strides[kernel_spatial_dimensions[1]];
+  p.k_i = k_strides[kernel_input_feature_dimension];
+  p.k_o = k_strides[kernel_output_feature_dimension];
+
+  p.N_OUT = out_shape[output_batch_dimension];
+  p.H = out_shape[output_spatial_dimensions[0]];
+  p.W = out_shape[output_spatial_dimensions[1]];
+  p.out_n = out_strides[output_batch_dimension];
+  p.out_h = out_strides[output_spatial_dimensions[0]];
+  p.out_w = out_strides[output_spatial_dimensions[1]];
+  p.out_c = out_strides[output_feature_dimension];
+
+  p.S_H = window_strides[0];
+  p.S_W = window_strides[1];
+  p.pt = padding(0, 0);
+  p.pl = padding(1, 0);
+  p.LD_H = lhs_dilation[0];
+  p.LD_W = lhs_dilation[1];
+  p.RD_H = rhs_dilation[0];
+  p.RD_W = rhs_dilation[1];
+  p.feature_group_count = feature_group_count;
+  p.batch_group_count = batch_group_count;
+
+  assert(p.S_H > 0 && p.S_W > 0);
+  assert(p.LD_H > 0 && p.LD_W > 0 && p.RD_H > 0 && p.RD_W > 0);
+  assert(p.C_IN == p.K_I * feature_group_count);
+  assert(p.N == p.N_OUT * batch_group_count);
+  assert(p.C_OUT == static_cast<int64_t>(out_shape[output_feature_dimension]));
+  assert(p.C_OUT % (feature_group_count * batch_group_count) == 0);
+
+  Dest output;
+  detail::convolution(p, input, weights, output);
   return output;
 }
 
@@ -398,10 +1022,12 @@ inline Dest reshape(Src x) {
 }
 
 // SliceOp
+// The indices are either tensors or arrays of compile-time constants.
 // Overload for 1d case.
-template <typename Dest, typename Src, IsTensorOfDim<1, Src> = true>
-Dest slice(Src x, Tensor<int64_t, 1> start_indices,
-           Tensor<int64_t, 1> limit_indices, Tensor<int64_t, 1> strides) {
+template <typename Dest, typename Src, typename Indices = Tensor<int64_t, 1>,
+          IsTensorOfDim<1, Src> = true>
+Dest slice(Src x, Indices start_indices, Indices limit_indices,
+           Indices strides) {
   Dest z;
 
   size_t index = 0;
@@ -413,9 +1039,10 @@ Dest slice(Src x, Tensor<int64_t, 1> start_indices,
 }
 
 // Overload for 2d case.
-template <typename Dest, typename Src, IsTensorOfDim<2, Src> = true>
-Dest slice(Src x, Tensor<int64_t, 2> start_indices,
-           Tensor<int64_t, 2> limit_indices, Tensor<int64_t, 2> strides) {
+template <typename Dest, typename Src, typename Indices = Tensor<int64_t, 2>,
+          IsTensorOfDim<2, Src> = true>
+Dest slice(Src x, Indices start_indices, Indices limit_indices,
+           Indices strides) {
   Dest z;
 
   size_t index = 0;
@@ -429,9 +1056,10 @@ Dest slice(Src x, Tensor<int64_t, 2> start_indices,
 }
 
 // Overload for 3d case.
-template <typename Dest, typename Src, IsTensorOfDim<3, Src> = true>
-Dest slice(Src x, Tensor<int64_t, 3> start_indices,
-           Tensor<int64_t, 3> limit_indices, Tensor<int64_t, 3> strides) {
+template <typename Dest, typename Src, typename Indices = Tensor<int64_t, 3>,
+          IsTensorOfDim<3, Src> = true>
+Dest slice(Src x, Indices start_indices, Indices limit_indices,
+           Indices strides) {
   Dest z;
 
   size_t index = 0;
@@ -448,9 +1076,10 @@ Dest slice(Src x, Tensor<int64_t, 3> start_indices,
 }
 
 // Overload for 4d case.
-template <typename Dest, typename Src, IsTensorOfDim<4, Src> = true>
-Dest slice(Src x, Tensor<int64_t, 4> start_indices,
-           Tensor<int64_t, 4> limit_indices, Tensor<int64_t, 4> strides) {
+template <typename Dest, typename Src, typename Indices = Tensor<int64_t, 4>,
+          IsTensorOfDim<4, Src> = true>
+Dest slice(Src x, Indices start_indices, Indices limit_indices,
+           Indices strides) {
   Dest z;
 
   size_t index = 0;
@@ -470,13 +1099,14 @@ Dest slice(Src x, Tensor<int64_t, 4> start_indices,
 }
 
 // PadOp
+// The paddings are either tensors or arrays of compile-time constants.
 // TODO: Add support for negative edge padding
-template <typename Dest, typename Src>
+template <typename Dest, typename Src,
+          typename Padding = Tensor<int64_t, Src::rank()>>
 inline Dest pad(Src operand,
                 Tensor<typename get_element_type<Src>::type> padding_value,
-                Tensor<int64_t, Src::rank()> edge_padding_low,
-                Tensor<int64_t, Src::rank()> edge_padding_high,
-                Tensor<int64_t, Src::rank()> interior_padding) {
+                Padding edge_padding_low, Padding edge_padding_high,
+                Padding interior_padding) {
   assert(std::all_of(interior_padding.begin(), interior_padding.end(),
                      [](int64_t i) { return i >= 0; }));
 
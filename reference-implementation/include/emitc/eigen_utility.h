@@ -0,0 +1,113 @@
+// Copyright Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// This file defines helpers shared by the Eigen implementations in
+// tosa_eigen.h and stablehlo_eigen.h. If `EIGEN_USE_THREADS` is defined, they
+// are evaluated on the device set by `set_thread_pool_device`, if any.
+
+#ifndef EMITC_EIGEN_UTILITY_H
+#define EMITC_EIGEN_UTILITY_H
+
+#include "emitc/types.h"
+#include <unsupported/Eigen/CXX11/Tensor>
+
+namespace {
+
+// A view on an emitc tensor as Eigen tensor in row-major order
+template <typename T, size_t... Shape>
+inline auto as_eigen(Tensor<T, Shape...> &t) {
+  return Eigen::TensorMap<Eigen::Tensor<T, sizeof...(Shape), Eigen::RowMajor>>(
+      &*t.begin(), static_cast<Eigen::Index>(Shape)...);
+}
+
+// A view on an emitc tensor as Eigen expression of its accumulator type. Half
+// precision elements are converted as the expression reads them.
+template <typename T, size_t... Shape>
+inline auto as_eigen_accumulator(Tensor<T, Shape...> &t) {
+  if constexpr (emitc::is_half_precision<T>::value) {
+    return as_eigen(t).template cast<emitc::accumulator_type_t<T>>();
+  } else {
+    return as_eigen(t);
+  }
+}
+
+// Padding of the spatial dimensions of a [N,H,W,C] tensor
+template <typename Padding>
+inline Eigen::array<std::pair<int64_t, int64_t>, 4>
+spatial_padding(Padding padding) {
+  return {std::make_pair(0, 0), std::make_pair(padding[0], padding[1]),
+          std::make_pair(padding[2], padding[3]), std::make_pair(0, 0)};
+}
+
+// Strided [N,H,W,C] view of the padded `input` for the kernel element at
+// (`kh`, `kw`)
+template <typename Input>
+inline auto window(const Input &input, Eigen::Index kh, Eigen::Index kw,
+                   Eigen::Index H, Eigen::Index W, Eigen::Index SH,
+                   Eigen::Index SW) {
+  const Eigen::Index N = input.dimension(0);
+  const Eigen::Index C = input.dimension(3);
+  return input
+      .slice(Eigen::DSizes<Eigen::Index, 4>{0, kh, kw, 0},
+             Eigen::DSizes<Eigen::Index, 4>{N, (H - 1) * SH + 1,
+                                            (W - 1) * SW + 1, C})
+      .stride(Eigen::DSizes<Eigen::Index, 4>{1, SH, SW, 1});
+}
+
+} // namespace
+
+namespace emitc {
+namespace eigen {
+
+#ifdef EIGEN_USE_THREADS
+// The device used to evaluate the Eigen implementations. Evaluation is single
+// threaded if no device is set.
+inline Eigen::ThreadPoolDevice *&thread_pool_device() {
+  static Eigen::ThreadPoolDevice *device = nullptr;
+  return device;
+}
+
+inline void set_thread_pool_device(Eigen::ThreadPoolDevice *device) {
+  thread_pool_device() = device;
+}
+#endif
+
+// Calls `f(i)` for 0 <= i < `n`, on the thread pool device if set. `cost` is
+// the estimated number of operations of one call.
+template <typename F>
+inline void parallel_for(Eigen::Index n, [[maybe_unused]] double cost, F f) {
+#ifdef EIGEN_USE_THREADS
+  if (Eigen::ThreadPoolDevice *device = thread_pool_device()) {
+    device->parallelFor(n, Eigen::TensorOpCost(0, 0, cost),
+                        [&f](Eigen::Index first, Eigen::Index last) {
+                          for (Eigen::Index i = first; i < last; i++) {
+                            f(i);
+                          }
+                        });
+    return;
+  }
+#endif
+  for (Eigen::Index i = 0; i < n; i++) {
+    f(i);
+  }
+}
+
+// Assigns `expr` to `dest`, on the thread pool device if set
+template <typename DestExpr, typename Expr>
+inline void evaluate(DestExpr &&dest, const Expr &expr) {
+#ifdef EIGEN_USE_THREADS
+  if (Eigen::ThreadPoolDevice *device = thread_pool_device()) {
+    dest.device(*device) = expr;
+    return;
+  }
+#endif
+  dest = expr;
+}
+
+} // namespace eigen
+} // namespace emitc
+
+#endif // EMITC_EIGEN_UTILITY_H
@@ -0,0 +1,373 @@
+// Copyright Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// This file defines the half precision element types `emitc::half` (IEEE
+// binary16) and `emitc::bfloat16`. They are storage types: arithmetic converts
+// them to float, which is also the type kernels accumulate them in. Buffers
+// are converted with F16C or AVX-512 instructions if available.
+
+#ifndef EMITC_HALF_H
+#define EMITC_HALF_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__F16C__) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace emitc {
+namespace detail {
+
+inline uint32_t float_to_bits(float f) {
+  uint32_t u;
+  std::memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+inline float bits_to_float(uint32_t u) {
+  float f;
+  std::memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+// Conversions of IEEE binary16, rounding to nearest even.
+struct HalfFormat {
+  static float to_float(uint16_t h) {
+#ifdef __F16C__
+    return _cvtsh_ss(h);
+#else
+    // Shifts exponent and mantissa into place and renormalizes subnormals by
+    // a floating point subtraction.
+    constexpr uint32_t shifted_exp = 0x7c00u << 13;
+    uint32_t u = (h & 0x7fffu) << 13;
+    const uint32_t exp = u & shifted_exp;
+    u += (127 - 15) << 23;
+    if (exp == shifted_exp) {
+      // Inf or NaN.
+      u += (128 - 16) << 23;
+    } else if (exp == 0) {
+      // Zero or subnormal.
+      u += 1 << 23;
+      u = float_to_bits(bits_to_float(u) - bits_to_float(113u << 23));
+    }
+    return bits_to_float(u | (h & 0x8000u) << 16);
+#endif
+  }
+
+  static uint16_t from_float(float f) {
+#ifdef __F16C__
+    return _cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT);
+#else
+    uint32_t u = float_to_bits(f);
+    const uint32_t sign = u & 0x80000000u;
+    u ^= sign;
+
+    uint16_t h;
+    if (u >= (127u + 16) << 23) {
+      // Overflows to Inf, NaN is quieted.
+      h = u > 0x7f800000u ? 0x7e00 : 0x7c00;
+    } else if (u < 113u << 23) {
+      // Subnormal or zero, rounded by a floating point addition.
+      constexpr uint32_t magic = ((127 - 15) + (23 - 10) + 1) << 23;
+      h = float_to_bits(bits_to_float(u) + bits_to_float(magic)) - magic;
+    } else {
+      const uint32_t odd = (u >> 13) & 1;
+      u += ((15u - 127) << 23) + 0xfff + odd;
+      h = u >> 13;
+    }
+    return h | sign >> 16;
+#endif
+  }
+};
+
+// Conversions of bfloat16, rounding to nearest even.
+struct BFloat16Format {
+  static float to_float(uint16_t b) {
+    return bits_to_float(uint32_t(b) << 16);
+  }
+
+  static uint16_t from_float(float f) {
+    const uint32_t u = float_to_bits(f);
+    if ((u & 0x7fffffffu) > 0x7f800000u) {
+      return (u | 0x400000u) >> 16;
+    }
+    return (u + 0x7fffu + ((u >> 16) & 1)) >> 16;
+  }
+};
+
+template <typename Format>
+class float16 {
+public:
+  constexpr float16() : bits(0) {}
+
+  float16(float value) : bits(Format::from_float(value)) {}
+
+  operator float() const { return Format::to_float(bits); }
+
+  static constexpr float16 from_bits(uint16_t bits) {
+    return float16(bits, nullptr);
+  }
+
+  constexpr uint16_t to_bits() const { return bits; }
+
+  float16 &operator+=(float rhs) { return *this = float(*this) + rhs; }
+  float16 &operator-=(float rhs) { return *this = float(*this) - rhs; }
+  float16 &operator*=(float rhs) { return *this = float(*this) * rhs; }
+  float16 &operator/=(float rhs) { return *this = float(*this) / rhs; }
+
+private:
+  constexpr float16(uint16_t bits, std::nullptr_t) : bits(bits) {}
+
+  uint16_t bits;
+};
+
+} // namespace detail
+
+using half = detail::float16<detail::HalfFormat>;
+using bfloat16 = detail::float16<detail::BFloat16Format>;
+
+template <typename T>
+struct is_half_precision : std::false_type {};
+
+template <>
+struct is_half_precision<half> : std::true_type {};
+
+template <>
+struct is_half_precision<bfloat16> : std::true_type {};
+
+// Type in which kernels accumulate elements of type `T`.
+template <typename T>
+struct accumulator_type {
+  using type = T;
+};
+
+template <>
+struct accumulator_type<half> {
+  using type = float;
+};
+
+template <>
+struct accumulator_type<bfloat16> {
+  using type = float;
+};
+
+template <typename T>
+using accumulator_type_t = typename accumulator_type<T>::type;
+
+/// Functions to convert buffers.
+// Converts `n` elements of `src` to the type of `dest`.
+template <typename Src, typename Dest>
+inline void convert_n(const Src *src, Dest *dest, size_t n) {
+  std::transform(src, src + n, dest,
+                 [](Src x) { return static_cast<Dest>(x); });
+}
+
+inline void convert_n(const half *src, float *dest, size_t n) {
+  size_t i = 0;
+#if defined(__AVX512F__)
+  for (; n - i >= 16; i += 16) {
+    const __m256i h =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm512_storeu_ps(dest + i, _mm512_cvtph_ps(h));
+  }
+#elif defined(__F16C__)
+  for (; n - i >= 8; i += 8) {
+    const __m128i h =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm256_storeu_ps(dest + i, _mm256_cvtph_ps(h));
+  }
+#endif
+  for (; i < n; i++) {
+    dest[i] = src[i];
+  }
+}
+
+inline void convert_n(const float *src, half *dest, size_t n) {
+  size_t i = 0;
+#if defined(__AVX512F__)
+  for (; n - i >= 16; i += 16) {
+    const __m256i h =
+        _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i), h);
+  }
+#elif defined(__F16C__)
+  for (; n - i >= 8; i += 8) {
+    const __m128i h =
+        _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), h);
+  }
+#endif
+  for (; i < n; i++) {
+    dest[i] = src[i];
+  }
+}
+
+inline void convert_n(const bfloat16 *src, float *dest, size_t n) {
+  size_t i = 0;
+#if defined(__AVX512F__)
+  for (; n - i >= 16; i += 16) {
+    const __m256i b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    const __m512i u = _mm512_slli_epi32(_mm512_cvtepu16_epi32(b), 16);
+    _mm512_storeu_ps(dest + i, _mm512_castsi512_ps(u));
+  }
+#elif defined(__AVX2__)
+  for (; n - i >= 8; i += 8) {
+    const __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m256i u = _mm256_slli_epi32(_mm256_cvtepu16_epi32(b), 16);
+    _mm256_storeu_ps(dest + i, _mm256_castsi256_ps(u));
+  }
+#endif
+  for (; i < n; i++) {
+    dest[i] = src[i];
+  }
+}
+
+inline void convert_n(const float *src, bfloat16 *dest, size_t n) {
+  size_t i = 0;
+#if defined(__AVX512F__)
+  // Rounds with integer instructions instead of VCVTNEPS2BF16, which flushes
+  // subnormals to zero and would differ from the scalar conversion.
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i bias = _mm512_set1_epi32(0x7fff);
+  const __m512i quiet = _mm512_set1_epi32(0x400000);
+  for (; n - i >= 16; i += 16) {
+    const __m512 f = _mm512_loadu_ps(src + i);
+    const __m512i u = _mm512_castps_si512(f);
+    const __m512i odd = _mm512_and_si512(_mm512_srli_epi32(u, 16), one);
+    __m512i r = _mm512_add_epi32(u, _mm512_add_epi32(bias, odd));
+    const __mmask16 nan = _mm512_cmp_ps_mask(f, f, _CMP_UNORD_Q);
+    r = _mm512_mask_mov_epi32(r, nan, _mm512_or_si512(u, quiet));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i),
+                        _mm512_cvtepi32_epi16(_mm512_srli_epi32(r, 16)));
+  }
+#endif
+  for (; i < n; i++) {
+    dest[i] = src[i];
+  }
+}
+
+} // namespace emitc
+
+namespace std {
+
+template <>
+class numeric_limits<emitc::half> {
+public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = false;
+  static constexpr bool has_infinity = true;
+  static constexpr bool has_quiet_NaN = true;
+  static constexpr bool has_signaling_NaN = true;
+  static constexpr float_denorm_style has_denorm = denorm_present;
+  static constexpr bool has_denorm_loss = false;
+  static constexpr float_round_style round_style = round_to_nearest;
+  static constexpr bool is_iec559 = true;
+  static constexpr bool is_bounded = true;
+  static constexpr bool is_modulo = false;
+  static constexpr int digits = 11;
+  static constexpr int digits10 = 3;
+  static constexpr int max_digits10 = 5;
+  static constexpr int radix = 2;
+  static constexpr int min_exponent = -13;
+  static constexpr int min_exponent10 = -4;
+  static constexpr int max_exponent = 16;
+  static constexpr int max_exponent10 = 4;
+  static constexpr bool traps = false;
+  static constexpr bool tinyness_before = false;
+
+  static constexpr emitc::half min() { return emitc::half::from_bits(0x0400); }
+  static constexpr emitc::half lowest() {
+    return emitc::half::from_bits(0xfbff);
+  }
+  static constexpr emitc::half max() { return emitc::half::from_bits(0x7bff); }
+  static constexpr emitc::half epsilon() {
+    return emitc::half::from_bits(0x1400);
+  }
+  static constexpr emitc::half round_error() {
+    return emitc::half::from_bits(0x3800);
+  }
+  static constexpr emitc::half infinity() {
+    return emitc::half::from_bits(0x7c00);
+  }
+  static constexpr emitc::half quiet_NaN() {
+    return emitc::half::from_bits(0x7e00);
+  }
+  static constexpr emitc::half signaling_NaN() {
+    return emitc::half::from_bits(0x7d00);
+  }
+  static constexpr emitc::half denorm_min() {
+    return emitc::half::from_bits(0x0001);
+  }
+};
+
+template <>
+class numeric_limits<emitc::bfloat16> {
+public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = false;
+  static constexpr bool has_infinity = true;
+  static constexpr bool has_quiet_NaN = true;
+  static constexpr bool has_signaling_NaN = true;
+  static constexpr float_denorm_style has_denorm = denorm_present;
+  static constexpr bool has_denorm_loss = false;
+  static constexpr float_round_style round_style = round_to_nearest;
+  static constexpr bool is_iec559 = false;
+  static constexpr bool is_bounded = true;
+  static constexpr bool is_modulo = false;
+  static constexpr int digits = 8;
+  static constexpr int digits10 = 2;
+  static constexpr int max_digits10 = 4;
+  static constexpr int radix = 2;
+  static constexpr int min_exponent = -125;
+  static constexpr int min_exponent10 = -37;
+  static constexpr int max_exponent = 128;
+  static constexpr int max_exponent10 = 38;
+  static constexpr bool traps = false;
+  static constexpr bool tinyness_before = false;
+
+  static constexpr emitc::bfloat16 min() {
+    return emitc::bfloat16::from_bits(0x0080);
+  }
+  static constexpr emitc::bfloat16 lowest() {
+    return emitc::bfloat16::from_bits(0xff7f);
+  }
+  static constexpr emitc::bfloat16 max() {
+    return emitc::bfloat16::from_bits(0x7f7f);
+  }
+  static constexpr emitc::bfloat16 epsilon() {
+    return emitc::bfloat16::from_bits(0x3c00);
+  }
+  static constexpr emitc::bfloat16 round_error() {
+    return emitc::bfloat16::from_bits(0x3f00);
+  }
+  static constexpr emitc::bfloat16 infinity() {
+    return emitc::bfloat16::from_bits(0x7f80);
+  }
+  static constexpr emitc::bfloat16 quiet_NaN() {
+    return emitc::bfloat16::from_bits(0x7fc0);
+  }
+  static constexpr emitc::bfloat16 signaling_NaN() {
+    return emitc::bfloat16::from_bits(0x7fa0);
+  }
+  static constexpr emitc::bfloat16 denorm_min() {
+    return emitc::bfloat16::from_bits(0x0001);
+  }
+};
+
+} // namespace std
+
+#endif // EMITC_HALF_H
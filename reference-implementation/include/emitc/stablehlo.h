@@ -16,11 +16,27 @@
 #include <cstring>
 #include <functional>
 #include <random>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
 #include "emitc/core_ops.h"
 
+#ifdef EMITC_USE_BLAS
+#include "emitc/blas.h"
+#endif
+
+#ifdef EMITC_STABLEHLO_USE_EIGEN
+#include "emitc/stablehlo_eigen.h"
+#endif
+
+// Ops with several kernels provide them in the namespaces `naive`, `eigen`
+// and `blas`. The naive kernels are always available, the Eigen kernels if
+// `EMITC_STABLEHLO_USE_EIGEN` and the CBLAS kernels if `EMITC_USE_BLAS` is
+// defined. The unqualified functions select the Eigen, CBLAS or naive kernel,
+// in this order, and the conversion emits qualified calls for the kernel
+// backends chosen per op.
+
 namespace emitc {
 namespace stablehlo {
 /// See
@@ -81,7 +97,7 @@ template <typename Src>
 inline Src cos(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::cos);
+  auto f = [](ET_Src element) -> ET_Src { return std::cos(element); };
 
   return unary<Src>(x, f);
 }
@@ -97,7 +113,7 @@ template <typename Src>
 inline Src exponential_minus_one(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::expm1);
+  auto f = [](ET_Src element) -> ET_Src { return std::expm1(element); };
 
   return unary<Src>(x, f);
 }
@@ -112,12 +128,13 @@ inline Src floor(Src x) {
 template <typename Src>
 inline typename replace_element_type<bool, Src>::type is_finite(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
-  static_assert(std::is_floating_point<ET_Src>::value,
+  static_assert(std::is_floating_point<ET_Src>::value ||
+                    emitc::is_half_precision<ET_Src>::value,
                 "Operation supports only floating point types");
 
   using Dest = typename replace_element_type<bool, Src>::type;
 
-  auto f = static_cast<bool (*)(ET_Src)>(std::isfinite);
+  auto f = [](ET_Src element) -> bool { return std::isfinite(element); };
 
   return unary<Dest, Src>(x, f);
 }
@@ -133,7 +150,7 @@ template <typename Src>
 inline Src log_plus_one(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::log1p);
+  auto f = [](ET_Src element) -> ET_Src { return std::log1p(element); };
 
   return unary<Src>(x, f);
 }
@@ -149,7 +166,7 @@ template <typename Src>
 inline Src round(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::round);
+  auto f = [](ET_Src element) -> ET_Src { return std::round(element); };
 
   return unary<Src>(x, f);
 }
@@ -159,11 +176,17 @@ template <typename Src>
 inline Src sin(Src x) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src)>(std::sin);
+  auto f = [](ET_Src element) -> ET_Src { return std::sin(element); };
 
   return unary<Src>(x, f);
 }
 
+// RsqrtOp
+template <typename Src>
+inline Src rsqrt(Src x) {
+  return emitc::rsqrt<Src>(x);
+}
+
 // SqrtOp
 template <typename Src>
 inline Src sqrt(Src x) {
@@ -188,7 +211,7 @@ template <typename Src>
 inline Src atan2(Src x, Src y) {
   using ET_Src = typename get_element_type<Src>::type;
 
-  auto f = static_cast<ET_Src (*)(ET_Src, ET_Src)>(std::atan2);
+  auto f = [](ET_Src a, ET_Src b) -> ET_Src { return std::atan2(a, b); };
 
   return binary<Src>(x, y, f);
 }
@@ -288,6 +311,16 @@ broadcast_in_dim(Src operand,
   return emitc::broadcast_in_dim<Dest>(operand, broadcast_dimensions);
 }
 
+// Overload for broadcast dimensions passed as template argument.
+template <typename Dest, typename BroadcastDimensions, typename Src>
+inline Dest broadcast_in_dim(Src operand) {
+  constexpr auto broadcast_dimensions =
+      utility::to_array(BroadcastDimensions{});
+  static_assert(broadcast_dimensions.size() == Src::rank(),
+                "Expected one broadcast dimension per operand dimension");
+  return emitc::broadcast_in_dim<Dest>(operand, broadcast_dimensions);
+}
+
 // ClampOp
 template <typename Min, typename Src, typename Max>
 inline Src clamp(Min min, Src operand, Max max) {
@@ -308,6 +341,20 @@ Dest slice(Src x, Tensor<int64_t, Src::rank()> start_indices,
   return emitc::slice<Dest, Src>(x, start_indices, limit_indices, strides);
 }
 
+// Overload for indices passed as template arguments.
+template <typename Dest, typename StartIndices, typename LimitIndices,
+          typename Strides, typename Src>
+Dest slice(Src x) {
+  constexpr auto start_indices = utility::to_array(StartIndices{});
+  constexpr auto limit_indices = utility::to_array(LimitIndices{});
+  constexpr auto strides = utility::to_array(Strides{});
+  static_assert(start_indices.size() == Src::rank() &&
+                    limit_indices.size() == Src::rank() &&
+                    strides.size() == Src::rank(),
+                "Expected one index per operand dimension");
+  return emitc::slice<Dest, Src>(x, start_indices, limit_indices, strides);
+}
+
 // DynamicSliceOp
 // Overload for 1d case.
 template <typename Dest, typename Src, IsTensorOfDim<1, Src> = true>
@@ -408,9 +455,26 @@ inline Dest pad(Src operand,
                 Tensor<int64_t, Src::rank()> edge_padding_high,
                 Tensor<int64_t, Src::rank()> interior_padding) {
   return emitc::pad<Dest>(operand, padding_value, edge_padding_low,
-                          edge_padding_low, interior_padding);
+                          edge_padding_high, interior_padding);
 }
 
+// Overload for paddings passed as template arguments.
+template <typename Dest, typename EdgePaddingLow, typename EdgePaddingHigh,
+          typename InteriorPadding, typename Src>
+inline Dest pad(Src operand,
+                Tensor<typename get_element_type<Src>::type> padding_value) {
+  constexpr auto edge_padding_low = utility::to_array(EdgePaddingLow{});
+  constexpr auto edge_padding_high = utility::to_array(EdgePaddingHigh{});
+  constexpr auto interior_padding = utility::to_array(InteriorPadding{});
+  static_assert(edge_padding_low.size() == Src::rank() &&
+                    edge_padding_high.size() == Src::rank() &&
+                    interior_padding.size() == Src::rank(),
+                "Expected one padding per operand dimension");
+  return emitc::pad<Dest>(operand, padding_value, edge_padding_low,
+                          edge_padding_high, interior_padding);
+}
+
+namespace naive {
 // ReduceOp
 // 1 result overload
 template <typename Dest, size_t Dimension, typename Src, typename Computation>
@@ -463,6 +527,13 @@ reduce(Src operand, Tensor<typename get_element_type<Src>::type> initValue,
 
   return result;
 }
+} // namespace naive
+
+#ifdef EMITC_STABLEHLO_USE_EIGEN
+using eigen::reduce;
+#else
+using naive::reduce;
+#endif
 
 // 2 result overload
 template <typename Dest1, typename Dest2, size_t Dimension, typename Src1,
@@ -649,10 +720,622 @@ inline Src select(typename replace_element_type<bool, Src>::type pred,
   return z;
 }
 
-// TransposeOp
-// Maps the perms dimension from Dest to Src.
+// SortOp
+// Sorts with a comparator of the form `compare LT` (ascending) or `compare GT`
+// (descending) of the first operand use native comparisons. Other
+// comparators are called as outlined functions. The rows along `dimension`
+// are sorted independently, on the Eigen thread pool device if set.
+enum class SortDirection { Ascending, Descending };
+
+namespace detail {
+// Rows of `Src` along `dimension`. Row `r` starts at `offset(r)` and its
+// elements are `stride` apart.
+template <typename Src>
+struct SortRows {
+  explicit SortRows(int64_t dimension)
+      : size(Src::dim(dimension)), stride(Src::strides()[dimension]),
+        count(Src::size() / Src::dim(dimension)) {
+    assert(dimension >= 0 && static_cast<size_t>(dimension) < Src::rank());
+  }
+
+  size_t offset(size_t row) const {
+    return (row / stride) * size * stride + row % stride;
+  }
+
+  size_t size;
+  size_t stride;
+  size_t count;
+};
+
+// Calls `f(row)` for each row of `rows`.
+template <typename Src, typename F>
+void for_each_row(const SortRows<Src> &rows, F f) {
+#ifdef EMITC_STABLEHLO_USE_EIGEN
+  const double cost = rows.size * std::log2(rows.size + 1.0);
+  emitc::eigen::parallel_for(rows.count, cost, f);
+#else
+  for (size_t row = 0; row < rows.count; row++) {
+    f(row);
+  }
+#endif
+}
+
+// Strict weak ordering of keys in `Direction`. Ties are ordered by index,
+// such that selecting the first k elements matches a stable sort.
+template <SortDirection Direction, typename T>
+struct KeyOrder {
+  bool operator()(const T &a, const T &b) const {
+    return Direction == SortDirection::Ascending ? a < b : b < a;
+  }
+  bool operator()(const std::pair<T, size_t> &a,
+                  const std::pair<T, size_t> &b) const {
+    if ((*this)(a.first, b.first))
+      return true;
+    if ((*this)(b.first, a.first))
+      return false;
+    return a.second < b.second;
+  }
+};
+
+// Reorders the first `k` elements of `begin`..`end` into sorted order. Small
+// k use a heap, larger k a selection followed by a sort of the selected
+// elements.
+template <typename It, typename Compare>
+void select_first(It begin, It end, size_t k, Compare compare) {
+  const size_t n = std::distance(begin, end);
+  if (k >= n) {
+    std::sort(begin, end, compare);
+  } else if (k * 16 <= n) {
+    std::partial_sort(begin, begin + k, end, compare);
+  } else {
+    std::nth_element(begin, begin + k, end, compare);
+    std::sort(begin, begin + k, compare);
+  }
+}
+
+// Sorts the rows of `keys` by value and writes the first `Dest::dim(dim)`
+// elements of each row to `Dest`.
+template <SortDirection Direction, typename Dest, typename Src>
+Dest sort_keys(Src keys, int64_t dimension, bool partial) {
+  using ET = typename get_element_type<Src>::type;
+
+  const SortRows<Src> rows(dimension);
+  const SortRows<Dest> dest_rows(dimension);
+  const size_t k = dest_rows.size;
+
+  Dest result;
+  for_each_row(rows, [&](size_t row) {
+    std::vector<ET> values(rows.size);
+    const ET *src = keys.get() + rows.offset(row);
+    for (size_t i = 0; i < rows.size; i++) {
+      values[i] = src[i * rows.stride];
+    }
+
+    KeyOrder<Direction, ET> order;
+    if (partial) {
+      select_first(values.begin(), values.end(), k, order);
+    } else {
+      std::sort(values.begin(), values.end(), order);
+    }
+
+    ET *dest = result.get() + dest_rows.offset(row);
+    for (size_t i = 0; i < k; i++) {
+      dest[i * dest_rows.stride] = values[i];
+    }
+  });
+  return result;
+}
+
+// Sorts the rows of `keys` and `values` by the keys and writes the first
+// `Dest1::dim(dim)` elements of each row to the results.
+template <SortDirection Direction, typename Dest1, typename Dest2,
+          typename Src1, typename Src2>
+std::tuple<Dest1, Dest2> sort_pairs(Src1 keys, Src2 values, int64_t dimension,
+                                    bool partial) {
+  using ET_Key = typename get_element_type<Src1>::type;
+
+  const SortRows<Src1> rows(dimension);
+  const SortRows<Dest1> dest_rows(dimension);
+  const size_t k = dest_rows.size;
+
+  Dest1 result1;
+  Dest2 result2;
+  for_each_row(rows, [&](size_t row) {
+    // Keys with their index in the row.
+    std::vector<std::pair<ET_Key, size_t>> entries(rows.size);
+    const size_t offset = rows.offset(row);
+    for (size_t i = 0; i < rows.size; i++) {
+      entries[i] = {keys[offset + i * rows.stride], i};
+    }
+
+    KeyOrder<Direction, ET_Key> order;
+    if (partial) {
+      select_first(entries.begin(), entries.end(), k, order);
+    } else {
+      std::sort(entries.begin(), entries.end(), order);
+    }
+
+    const size_t dest_offset = dest_rows.offset(row);
+    for (size_t i = 0; i < k; i++) {
+      const size_t dest_index = dest_offset + i * dest_rows.stride;
+      result1[dest_index] = entries[i].first;
+      result2[dest_index] = values[offset + entries[i].second * rows.stride];
+    }
+  });
+  return std::make_tuple(result1, result2);
+}
+
+// Returns the permutations sorting each row with `less(i, j)`, which compares
+// the elements at the flat indices i and j.
+template <typename Src, typename Less>
+std::vector<size_t> sort_permutation(int64_t dimension, bool is_stable,
+                                     Less less) {
+  const SortRows<Src> rows(dimension);
+  std::vector<size_t> permutation(Src::size());
+  for_each_row(rows, [&](size_t row) {
+    auto begin = permutation.begin() + row * rows.size;
+    auto end = begin + rows.size;
+    const size_t offset = rows.offset(row);
+    for (size_t i = 0; i < rows.size; i++) {
+      begin[i] = offset + i * rows.stride;
+    }
+    if (is_stable) {
+      std::stable_sort(begin, end, less);
+    } else {
+      std::sort(begin, end, less);
+    }
+  });
+  return permutation;
+}
+
+// Gathers `src` into the order of `permutation`.
+template <typename Src>
+Src permute_rows(Src &src, int64_t dimension,
+                 const std::vector<size_t> &permutation) {
+  const SortRows<Src> rows(dimension);
+  Src result;
+  for (size_t row = 0; row < rows.count; row++) {
+    const size_t offset = rows.offset(row);
+    for (size_t i = 0; i < rows.size; i++) {
+      result[offset + i * rows.stride] =
+          src[permutation[row * rows.size + i]];
+    }
+  }
+  return result;
+}
+} // namespace detail
+
+// 1 operand overload with native comparison
+template <typename Dest, typename Src>
+Dest sort(Src operand, int64_t dimension, bool is_stable,
+          SortDirection direction) {
+  static_assert(std::is_same<Dest, Src>::value, "Expected same types");
+  // Equal keys are indistinguishable, so stability is irrelevant.
+  (void)is_stable;
+  if (direction == SortDirection::Ascending)
+    return detail::sort_keys<SortDirection::Ascending, Dest>(operand,
+                                                             dimension, false);
+  return detail::sort_keys<SortDirection::Descending, Dest>(operand, dimension,
+                                                            false);
+}
+
+// 2 operand overload with native comparison of the first operand
+template <typename Dest1, typename Dest2, typename Src1, typename Src2>
+std::tuple<Dest1, Dest2> sort(Src1 keys, Src2 values, int64_t dimension,
+                              bool is_stable, SortDirection direction) {
+  static_assert(std::is_same<Dest1, Src1>::value, "Expected same types");
+  static_assert(std::is_same<Dest2, Src2>::value, "Expected same types");
+  // Ties are ordered by index, which is stable.
+  (void)is_stable;
+  if (direction == SortDirection::Ascending)
+    return detail::sort_pairs<SortDirection::Ascending, Dest1, Dest2>(
+        keys, values, dimension, false);
+  return detail::sort_pairs<SortDirection::Descending, Dest1, Dest2>(
+      keys, values, dimension, false);
+}
+
+// 1 operand overload with comparator
+template <typename Dest, typename Src, typename Comparator>
+Dest sort(Src operand, int64_t dimension, bool is_stable,
+          Comparator comparator) {
+  using ET = typename get_element_type<Src>::type;
+  static_assert(std::is_same<Dest, Src>::value, "Expected same types");
+
+  auto less = [&operand, &comparator](size_t i, size_t j) -> bool {
+    return comparator(Tensor<ET>{operand[i]}, Tensor<ET>{operand[j]})();
+  };
+  return detail::permute_rows(
+      operand, dimension,
+      detail::sort_permutation<Src>(dimension, is_stable, less));
+}
+
+// 2 operand overload with comparator
+template <typename Dest1, typename Dest2, typename Src1, typename Src2,
+          typename Comparator>
+std::tuple<Dest1, Dest2> sort(Src1 operand1, Src2 operand2, int64_t dimension,
+                              bool is_stable, Comparator comparator) {
+  using ET_Src1 = typename get_element_type<Src1>::type;
+  using ET_Src2 = typename get_element_type<Src2>::type;
+  static_assert(std::is_same<Dest1, Src1>::value, "Expected same types");
+  static_assert(std::is_same<Dest2, Src2>::value, "Expected same types");
+
+  auto less = [&](size_t i, size_t j) -> bool {
+    return comparator(
+        Tensor<ET_Src1>{operand1[i]}, Tensor<ET_Src1>{operand1[j]},
+        Tensor<ET_Src2>{operand2[i]}, Tensor<ET_Src2>{operand2[j]})();
+  };
+  std::vector<size_t> permutation =
+      detail::sort_permutation<Src1>(dimension, is_stable, less);
+  return std::make_tuple(
+      detail::permute_rows(operand1, dimension, permutation),
+      detail::permute_rows(operand2, dimension, permutation));
+}
+
+// SortOp followed by a slice to the first k elements along `dimension`, with
+// k = Dest::dim(dimension). Only the first k elements of each row are
+// selected and sorted.
 template <typename Dest, typename Src>
-inline Dest transpose(Src operand, Tensor1D<int64_t, Src::rank()> perms) {
+Dest top_k(Src operand, int64_t dimension, SortDirection direction) {
+  static_assert(Dest::rank() == Src::rank(), "Expected same ranks");
+  if (direction == SortDirection::Ascending)
+    return detail::sort_keys<SortDirection::Ascending, Dest>(operand,
+                                                             dimension, true);
+  return detail::sort_keys<SortDirection::Descending, Dest>(operand, dimension,
+                                                            true);
+}
+
+template <typename Dest1, typename Dest2, typename Src1, typename Src2>
+std::tuple<Dest1, Dest2> top_k(Src1 keys, Src2 values, int64_t dimension,
+                               SortDirection direction) {
+  static_assert(Dest1::rank() == Src1::rank(), "Expected same ranks");
+  static_assert(Dest2::rank() == Src2::rank(), "Expected same ranks");
+  if (direction == SortDirection::Ascending)
+    return detail::sort_pairs<SortDirection::Ascending, Dest1, Dest2>(
+        keys, values, dimension, true);
+  return detail::sort_pairs<SortDirection::Descending, Dest1, Dest2>(
+      keys, values, dimension, true);
+}
+
+// GatherOp
+// Copies the slice of `operand` at each start index of `start_indices`.
+// Slices that are contiguous in the operand and the result, as the rows of an
+// embedding lookup, are copied as a whole while the next one is prefetched.
+namespace detail {
+// Layout of a gather or a scatter. Each batch position selects the start
+// index vector at `indices_batch` and the slice of the operand starting
+// there, whose elements are at `operand_window`. A gather copies the slice to
+// `result_batch` + `result_window` of its result, a scatter reads its updates
+// from there.
+struct GatherLayout {
+  std::vector<size_t> result_batch;
+  std::vector<size_t> indices_batch;
+  std::vector<size_t> result_window;
+  std::vector<size_t> operand_window;
+  // Stride of the components in the start index vectors, and their operand
+  // strides and largest values keeping the slice in bounds.
+  size_t index_stride;
+  std::vector<size_t> index_operand_strides;
+  std::vector<int64_t> index_limits;
+  // Set if the slice elements are consecutive in the operand and the result.
+  bool contiguous;
+  // Set if slices at distinct start indices do not overlap.
+  bool disjoint;
+};
+
+template <typename Operand, typename Result, typename Idx,
+          typename OffsetDims, typename CollapsedDims, typename IndexMap>
+GatherLayout gather_layout(OffsetDims offset_dims, CollapsedDims collapsed_dims,
+                           IndexMap index_map, int64_t index_vector_dim,
+                           const std::array<size_t, Operand::rank()> &sizes) {
+  auto contains = [](const std::vector<size_t> &dims, size_t dim) {
+    return std::find(dims.begin(), dims.end(), dim) != dims.end();
+  };
+  std::vector<size_t> offset(offset_dims.begin(), offset_dims.end());
+  std::vector<size_t> collapsed(collapsed_dims.begin(), collapsed_dims.end());
+  std::vector<size_t> index_dims(index_map.begin(), index_map.end());
+
+  std::vector<size_t> result_batch_dims;
+  for (size_t i = 0; i < Result::rank(); i++) {
+    if (!contains(offset, i)) {
+      result_batch_dims.push_back(i);
+    }
+  }
+  std::vector<size_t> indices_batch_dims;
+  for (size_t i = 0; i < Idx::rank(); i++) {
+    if (static_cast<int64_t>(i) != index_vector_dim) {
+      indices_batch_dims.push_back(i);
+    }
+  }
+  std::vector<size_t> window_dims;
+  for (size_t i = 0; i < Operand::rank(); i++) {
+    if (!contains(collapsed, i)) {
+      window_dims.push_back(i);
+    }
+  }
+  assert(result_batch_dims.size() == indices_batch_dims.size());
+  assert(window_dims.size() == offset.size());
+  for (size_t i = 0; i < offset.size(); i++) {
+    assert(Result::dim(offset[i]) == sizes[window_dims[i]]);
+  }
+
+  GatherLayout layout;
+  layout.result_batch = emitc::detail::dimension_offsets(
+      Result::shape(), Result::strides(), result_batch_dims);
+  layout.indices_batch = emitc::detail::dimension_offsets(
+      Idx::shape(), Idx::strides(), indices_batch_dims);
+  layout.result_window = emitc::detail::dimension_offsets(
+      Result::shape(), Result::strides(), offset);
+  layout.operand_window =
+      emitc::detail::dimension_offsets(sizes, Operand::strides(), window_dims);
+
+  layout.index_stride = static_cast<size_t>(index_vector_dim) < Idx::rank()
+                            ? Idx::strides()[index_vector_dim]
+                            : 0;
+  layout.disjoint = true;
+  for (size_t dim : index_dims) {
+    layout.index_operand_strides.push_back(Operand::strides()[dim]);
+    layout.index_limits.push_back(
+        static_cast<int64_t>(Operand::dim(dim) - sizes[dim]));
+    layout.disjoint &= sizes[dim] == 1;
+  }
+
+  layout.contiguous = true;
+  for (size_t i = 0; i < layout.result_window.size(); i++) {
+    layout.contiguous &=
+        layout.result_window[i] == i && layout.operand_window[i] == i;
+  }
+  return layout;
+}
+
+// Computes the operand offset of the slice of batch position `batch`. Start
+// indices out of bounds are clamped if `clamp` is set, as by a gather, and
+// rejected otherwise, as by a scatter.
+template <typename Idx>
+bool slice_offset(const GatherLayout &layout, Idx &indices, size_t batch,
+                  bool clamp, size_t &offset) {
+  offset = 0;
+  for (size_t k = 0; k < layout.index_limits.size(); k++) {
+    int64_t start = static_cast<int64_t>(
+        indices[layout.indices_batch[batch] + k * layout.index_stride]);
+    if (start < 0 || start > layout.index_limits[k]) {
+      if (!clamp) {
+        return false;
+      }
+      start = std::max<int64_t>(0, std::min(start, layout.index_limits[k]));
+    }
+    offset += static_cast<size_t>(start) * layout.index_operand_strides[k];
+  }
+  return true;
+}
+
+// Hints that the `size` bytes at `address` are read soon.
+inline void prefetch(const void *address, size_t size) {
+#if defined(__GNUC__) || defined(__clang__)
+  const char *bytes = static_cast<const char *>(address);
+  for (size_t i = 0; i < size; i += 64) {
+    __builtin_prefetch(bytes + i);
+  }
+#else
+  (void)address;
+  (void)size;
+#endif
+}
+
+template <typename Operand, typename Updates, typename Idx,
+          typename UpdateWindowDims, typename InsertedWindowDims,
+          typename IndexMap>
+GatherLayout scatter_layout(UpdateWindowDims update_window_dims,
+                            InsertedWindowDims inserted_window_dims,
+                            IndexMap index_map, int64_t index_vector_dim) {
+  std::array<size_t, Operand::rank()> sizes;
+  sizes.fill(1);
+  auto window_dim = update_window_dims.begin();
+  for (size_t i = 0; i < Operand::rank(); i++) {
+    if (std::find(inserted_window_dims.begin(), inserted_window_dims.end(),
+                  static_cast<int64_t>(i)) == inserted_window_dims.end()) {
+      assert(window_dim != update_window_dims.end());
+      sizes[i] = Updates::dim(*window_dim++);
+    }
+  }
+  return gather_layout<Operand, Updates, Idx>(
+      update_window_dims, inserted_window_dims, index_map, index_vector_dim,
+      sizes);
+}
+} // namespace detail
+
+template <typename Dest, typename Src, typename Idx, typename OffsetDims,
+          typename CollapsedSliceDims, typename StartIndexMap,
+          typename SliceSizes>
+Dest gather(Src operand, Idx start_indices, OffsetDims offset_dims,
+            CollapsedSliceDims collapsed_slice_dims,
+            StartIndexMap start_index_map, int64_t index_vector_dim,
+            SliceSizes slice_sizes) {
+  using ET = typename get_element_type<Src>::type;
+  static_assert(std::is_same<ET, typename get_element_type<Dest>::type>::value,
+                "Expected same element types");
+
+  std::array<size_t, Src::rank()> sizes;
+  assert(slice_sizes.size() == sizes.size());
+  std::copy(slice_sizes.begin(), slice_sizes.end(), sizes.begin());
+  const detail::GatherLayout layout = detail::gather_layout<Src, Dest, Idx>(
+      offset_dims, collapsed_slice_dims, start_index_map, index_vector_dim,
+      sizes);
+
+  const size_t batches = layout.result_batch.size();
+  std::vector<size_t> offsets(batches);
+  for (size_t b = 0; b < batches; b++) {
+    detail::slice_offset(layout, start_indices, b, /*clamp=*/true, offsets[b]);
+  }
+
+  Dest result;
+  if constexpr (!std::is_same<ET, bool>::value) {
+    if (layout.contiguous) {
+      const size_t n = layout.result_window.size();
+      const ET *src = operand.get();
+      ET *dest = result.get();
+      for (size_t b = 0; b < batches; b++) {
+        if (b + 1 < batches) {
+          detail::prefetch(src + offsets[b + 1], n * sizeof(ET));
+        }
+        std::copy_n(src + offsets[b], n, dest + layout.result_batch[b]);
+      }
+      return result;
+    }
+  }
+
+  for (size_t b = 0; b < batches; b++) {
+    for (size_t w = 0; w < layout.result_window.size(); w++) {
+      result[layout.result_batch[b] + layout.result_window[w]] =
+          operand[offsets[b] + layout.operand_window[w]];
+    }
+  }
+  return result;
+}
+
+// ScatterOp
+// Combines the slices of `operand` at the start indices of `scatter_indices`
+// with the update windows of `updates`. Windows starting out of bounds are
+// skipped. Windows at the same start index are combined in their order.
+template <typename Dest, typename Src, typename Idx, typename Updates,
+          typename UpdateWindowDims, typename InsertedWindowDims,
+          typename ScatterDimsToOperandDims, typename Computation>
+Dest scatter(Src operand, Idx scatter_indices, Updates updates,
+             UpdateWindowDims update_window_dims,
+             InsertedWindowDims inserted_window_dims,
+             ScatterDimsToOperandDims scatter_dims_to_operand_dims,
+             int64_t index_vector_dim, bool indices_are_sorted,
+             bool unique_indices, Computation computation) {
+  using ET = typename get_element_type<Src>::type;
+  static_assert(std::is_same<Dest, Src>::value, "Expected same types");
+  (void)indices_are_sorted;
+  (void)unique_indices;
+
+  const detail::GatherLayout layout =
+      detail::scatter_layout<Src, Updates, Idx>(
+          update_window_dims, inserted_window_dims,
+          scatter_dims_to_operand_dims, index_vector_dim);
+
+  Dest result = operand;
+  for (size_t b = 0; b < layout.result_batch.size(); b++) {
+    size_t offset;
+    if (!detail::slice_offset(layout, scatter_indices, b, /*clamp=*/false,
+                              offset)) {
+      continue;
+    }
+    for (size_t w = 0; w < layout.result_window.size(); w++) {
+      const size_t index = offset + layout.operand_window[w];
+      const size_t update =
+          layout.result_batch[b] + layout.result_window[w];
+      result[index] = computation(Tensor<ET>{result[index]},
+                                  Tensor<ET>{updates[update]})();
+    }
+  }
+  return result;
+}
+
+// ScatterOp with an update computation of the form `add`. The windows are
+// grouped by their start index, using the order of sorted indices. If
+// windows at distinct start indices cannot overlap, the groups are summed in
+// parallel on the Eigen thread pool device if set. The `unique_indices` hint
+// is not relied on, as duplicate indices would make the parallel sums race.
+template <typename Dest, typename Src, typename Idx, typename Updates,
+          typename UpdateWindowDims, typename InsertedWindowDims,
+          typename ScatterDimsToOperandDims>
+Dest scatter_add(Src operand, Idx scatter_indices, Updates updates,
+                 UpdateWindowDims update_window_dims,
+                 InsertedWindowDims inserted_window_dims,
+                 ScatterDimsToOperandDims scatter_dims_to_operand_dims,
+                 int64_t index_vector_dim, bool indices_are_sorted,
+                 bool unique_indices) {
+  using ET = typename get_element_type<Src>::type;
+  static_assert(std::is_same<Dest, Src>::value, "Expected same types");
+  (void)unique_indices;
+
+  const detail::GatherLayout layout =
+      detail::scatter_layout<Src, Updates, Idx>(
+          update_window_dims, inserted_window_dims,
+          scatter_dims_to_operand_dims, index_vector_dim);
+
+  // The operand offset and batch position of each window in bounds.
+  std::vector<std::pair<size_t, size_t>> windows;
+  windows.reserve(layout.result_batch.size());
+  for (size_t b = 0; b < layout.result_batch.size(); b++) {
+    size_t offset;
+    if (detail::slice_offset(layout, scatter_indices, b, /*clamp=*/false,
+                             offset)) {
+      windows.emplace_back(offset, b);
+    }
+  }
+
+  Dest result = operand;
+  const size_t n = layout.result_window.size();
+  auto add = [&](size_t i) {
+    const size_t offset = windows[i].first;
+    const size_t batch = layout.result_batch[windows[i].second];
+    if constexpr (!std::is_same<ET, bool>::value) {
+      if (layout.contiguous) {
+        ET *dest = result.get() + offset;
+        const ET *src = updates.get() + batch;
+        for (size_t w = 0; w < n; w++) {
+          dest[w] += src[w];
+        }
+        return;
+      }
+    }
+    for (size_t w = 0; w < n; w++) {
+      const size_t index = offset + layout.operand_window[w];
+      result[index] = result[index] + updates[batch + layout.result_window[w]];
+    }
+  };
+
+  if (!layout.disjoint) {
+    for (size_t i = 0; i < windows.size(); i++) {
+      add(i);
+    }
+    return result;
+  }
+
+  // Windows at the same start index are consecutive in sorted indices.
+  // Otherwise, they are grouped by a stable sort, which keeps their order.
+  if (!indices_are_sorted) {
+    std::stable_sort(windows.begin(), windows.end(),
+                     [](const std::pair<size_t, size_t> &a,
+                        const std::pair<size_t, size_t> &b) {
+                       return a.first < b.first;
+                     });
+  }
+  std::vector<size_t> groups;
+  for (size_t i = 0; i < windows.size(); i++) {
+    if (i == 0 || windows[i].first != windows[i - 1].first) {
+      groups.push_back(i);
+    }
+  }
+  groups.push_back(windows.size());
+
+  auto add_group = [&](size_t group) {
+    for (size_t i = groups[group]; i < groups[group + 1]; i++) {
+      add(i);
+    }
+  };
+  const size_t group_count = groups.size() - 1;
+#ifdef EMITC_STABLEHLO_USE_EIGEN
+  const double cost = static_cast<double>(n) * windows.size() /
+                      std::max<size_t>(group_count, 1);
+  emitc::eigen::parallel_for(group_count, cost, add_group);
+#else
+  for (size_t group = 0; group < group_count; group++) {
+    add_group(group);
+  }
+#endif
+  return result;
+}
+
+// TransposeOp
+// Maps the perms dimension from Dest to Src. The perms are either a tensor or
+// an array of compile-time constants.
+template <typename Dest, typename Src,
+          typename Perms = Tensor1D<int64_t, Src::rank()>>
+inline Dest transpose(Src operand, Perms perms) {
   static_assert(is_tensor<Src>::value, "Expected tensor argument");
   static_assert(is_tensor<Dest>::value, "Expected tensor result");
 
@@ -660,7 +1343,7 @@ inline Dest transpose(Src operand, Tensor1D<int64_t, Src::rank()> perms) {
   // "broadcast_dimensions") from Src to Dest and stablehlo::transpose maps the
   // dimensions (argument "perms") from Dest to Src, we have to invert the
   // mapping.
-  Tensor1D<int64_t, Src::rank()> broadcast_dimensions;
+  std::array<int64_t, Src::rank()> broadcast_dimensions;
   for (size_t i = 0; i < perms.size(); ++i) {
     auto pos = std::find(perms.begin(), perms.end(), i);
     assert(pos != std::end(perms));
@@ -670,6 +1353,15 @@ inline Dest transpose(Src operand, Tensor1D<int64_t, Src::rank()> perms) {
   return emitc::broadcast_in_dim<Dest>(operand, broadcast_dimensions);
 }
 
+// Overload for perms passed as template argument.
+template <typename Dest, typename Perms, typename Src>
+inline Dest transpose(Src operand) {
+  constexpr auto perms = utility::to_array(Perms{});
+  static_assert(perms.size() == Src::rank(),
+                "Expected one permutation index per operand dimension");
+  return transpose<Dest>(operand, perms);
+}
+
 // RngUniformOp
 template <typename Dest, typename T, size_t N>
 inline Dest rng_uniform(Tensor<T> low, Tensor<T> high,
@@ -726,12 +1418,8 @@ Src batch_norm_inference(Src input, Feature scale, Feature offset, Feature mean,
   return output;
 }
 
+namespace naive {
 // ConvolutionOp
-// TODO: Replicate ConvDimensionNumbers struct.
-// TODO: Implement general dimension numbers.
-// TODO: Implement lhs_dilation.
-// TODO: Implement rhs_dilation.
-// TODO: Implement batch_group_count.
 template <typename Dest, typename Src, typename Weights>
 Dest convolution(Src input, Weights weights, int64_t batch_group_count,
                  int64_t input_batch_dimension, int64_t input_feature_dimension,
@@ -746,109 +1434,100 @@ Dest convolution(Src input, Weights weights, int64_t batch_group_count,
                  Tensor<int64_t, 2> lhs_dilation,
                  Tensor<int64_t, 2> rhs_dilation,
                  Tensor<int64_t, 2> window_strides) {
-  static_assert(is_tensor_of_dim<4, Src>::value,
-                "Expected 4 dimensional input");
-  static_assert(is_tensor_of_dim<4, Dest>::value,
-                "Expected 4 dimensional output");
-  static_assert(is_tensor_of_dim<4, Weights>::value,
-                "Expected 4 dimensional weights");
-
-  assert(batch_group_count == 1);
-
-  assert(input_batch_dimension == 0);
-  assert(input_spatial_dimensions[0] == 1);
-  assert(input_spatial_dimensions[1] == 2);
-  assert(input_feature_dimension == 3);
-
-  assert(kernel_spatial_dimensions[0] == 0);
-  assert(kernel_spatial_dimensions[1] == 1);
-  assert(kernel_input_feature_dimension == 2);
-  assert(kernel_output_feature_dimension == 3);
-
-  assert(output_batch_dimension == 0);
-  assert(output_spatial_dimensions[0] == 1);
-  assert(output_spatial_dimensions[1] == 2);
-  assert(output_feature_dimension == 3);
-
-  assert(input.dim(input_feature_dimension) % feature_group_count == 0);
-  assert(weights.dim(kernel_input_feature_dimension) ==
-         input.dim(input_feature_dimension) / feature_group_count);
-
-  assert(window_strides[0] > 0);
-  assert(window_strides[1] > 0);
-
-  assert(lhs_dilation[0] == 1);
-  assert(lhs_dilation[0] == 1);
-
-  assert(rhs_dilation[0] == 1);
-  assert(rhs_dilation[0] == 1);
-
-  const int N = input.dim(input_batch_dimension);
-  const int H_IN = input.dim(input_spatial_dimensions[0]);
-  const int W_IN = input.dim(input_spatial_dimensions[1]);
-  const int C_IN = input.dim(input_feature_dimension);
+  return emitc::convolution<Dest>(
+      input, weights, batch_group_count, input_batch_dimension,
+      input_feature_dimension, input_spatial_dimensions,
+      kernel_input_feature_dimension, kernel_output_feature_dimension,
+      kernel_spatial_dimensions, output_batch_dimension,
+      output_feature_dimension, output_spatial_dimensions, feature_group_count,
+      padding, lhs_dilation, rhs_dilation, window_strides);
+}
 
-  assert(C_IN % feature_group_count == 0);
-  const int G_IN = C_IN / feature_group_count;
+// DotOp
+template <typename Dest, typename Lhs, typename Rhs>
+Dest dot(Lhs lhs, Rhs rhs) {
+  return emitc::dot<Dest>(lhs, rhs);
+}
 
-  Dest output;
+// DotOp with transposed operands
+template <typename Dest, bool TransposeLhs, bool TransposeRhs, typename Lhs,
+          typename Rhs>
+Dest dot_transposed(Lhs lhs, Rhs rhs) {
+  return emitc::dot_transposed<Dest, TransposeLhs, TransposeRhs>(lhs, rhs);
+}
 
-  const int C_OUT = output.dim(output_feature_dimension);
-  assert(C_OUT % feature_group_count == 0);
-  const int G_OUT = C_OUT / feature_group_count;
-
-  const int K_H = weights.dim(kernel_spatial_dimensions[0]);
-  const int K_W = weights.dim(kernel_spatial_dimensions[1]);
-  const int S_H = window_strides[0];
-  const int S_W = window_strides[1];
-
-  const int pt = padding(0, 0);
-  const int pb = padding(0, 1);
-  const int pl = padding(1, 0);
-  const int pr = padding(1, 1);
-
-  const int H_PAD = pt + H_IN + pb;
-  const int W_PAD = pl + W_IN + pr;
-
-  // TODO: Test grouped convolutions.
-  assert(feature_group_count == 1 || feature_group_count == C_OUT);
-
-  // Convolution
-  for (int n = 0; n < N; n++) {
-    for (int h_pad = 0; h_pad < H_PAD - K_H + 1; h_pad += S_H) {
-      for (int w_pad = 0; w_pad < W_PAD - K_W + 1; w_pad += S_W) {
-        for (int kh = 0; kh < K_H; kh++) {
-          for (int kw = 0; kw < K_W; kw++) {
-            for (int g = 0; g < feature_group_count; g++) {
-              for (int g_in = 0; g_in < G_IN; g_in++) {
-                for (int g_out = 0; g_out < G_OUT; g_out++) {
-                  const int h_out = h_pad / S_H;
-                  const int w_out = w_pad / S_W;
-                  const int c_out = g * G_OUT + g_out;
-                  const int h_in = h_pad - pt + kh;
-                  const int w_in = w_pad - pl + kw;
-                  const int c_in = g * G_IN + g_in;
-
-                  if (h_in < 0 || h_in >= H_IN || w_in < 0 || w_in >= W_IN)
-                    continue;
-                  output(n, h_out, w_out, c_out) +=
-                      input(n, h_in, w_in, c_in) * weights(kh, kw, g_in, c_out);
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-  }
-  return output;
+// DotGeneralOp
+template <typename Dest, typename Lhs, typename Rhs,
+          typename BatchingDimensions, typename ContractingDimensions>
+Dest dot_general(Lhs lhs, Rhs rhs, BatchingDimensions lhs_batching_dimensions,
+                 BatchingDimensions rhs_batching_dimensions,
+                 ContractingDimensions lhs_contracting_dimensions,
+                 ContractingDimensions rhs_contracting_dimensions) {
+  return emitc::dot_general<Dest>(
+      lhs, rhs, lhs_batching_dimensions, rhs_batching_dimensions,
+      lhs_contracting_dimensions, rhs_contracting_dimensions);
 }
+} // namespace naive
 
+#ifdef EMITC_USE_BLAS
+namespace blas {
 // DotOp
 template <typename Dest, typename Lhs, typename Rhs>
 Dest dot(Lhs lhs, Rhs rhs) {
-  return emitc::dot<Dest>(lhs, rhs);
+  Dest output;
+  if (emitc::blas::gemm<false, false>(lhs, rhs, output))
+    return output;
+  return naive::dot<Dest>(lhs, rhs);
+}
+
+// DotOp with transposed operands
+template <typename Dest, bool TransposeLhs, bool TransposeRhs, typename Lhs,
+          typename Rhs>
+Dest dot_transposed(Lhs lhs, Rhs rhs) {
+  Dest output;
+  if (emitc::blas::gemm<TransposeLhs, TransposeRhs>(lhs, rhs, output))
+    return output;
+  return naive::dot_transposed<Dest, TransposeLhs, TransposeRhs>(lhs, rhs);
+}
+
+// DotGeneralOp
+template <typename Dest, typename Lhs, typename Rhs,
+          typename BatchingDimensions, typename ContractingDimensions>
+Dest dot_general(Lhs lhs, Rhs rhs, BatchingDimensions lhs_batching_dimensions,
+                 BatchingDimensions rhs_batching_dimensions,
+                 ContractingDimensions lhs_contracting_dimensions,
+                 ContractingDimensions rhs_contracting_dimensions) {
+  auto layout = emitc::detail::dot_general_layout<Lhs, Rhs>(
+      lhs_batching_dimensions, rhs_batching_dimensions,
+      lhs_contracting_dimensions, rhs_contracting_dimensions);
+  Dest output;
+  if (emitc::blas::dot_general(layout, lhs, rhs, output))
+    return output;
+  return emitc::detail::dot_general<Dest>(layout, lhs, rhs);
 }
+} // namespace blas
+#endif
+
+#if defined(EMITC_STABLEHLO_USE_EIGEN)
+using eigen::convolution;
+using eigen::dot;
+using eigen::dot_transposed;
+#ifdef EMITC_USE_BLAS
+using blas::dot_general;
+#else
+using naive::dot_general;
+#endif
+#elif defined(EMITC_USE_BLAS)
+using blas::dot;
+using blas::dot_general;
+using blas::dot_transposed;
+using naive::convolution;
+#else
+using naive::convolution;
+using naive::dot;
+using naive::dot_general;
+using naive::dot_transposed;
+#endif
 
 } // namespace stablehlo
 } // namespace emitc
@@ -0,0 +1,299 @@
+// Copyright Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// This file defines alternative implementations for the functions in
+// stablehlo.h utilizing Eigen.
+// They are defined in `emitc::stablehlo::eigen` and selected as default
+// implementations if `EMITC_STABLEHLO_USE_EIGEN` is defined.
+
+#ifndef EMITC_STABLEHLO_EIGEN_H
+#define EMITC_STABLEHLO_EIGEN_H
+
+#include "emitc/eigen_utility.h"
+#include "emitc/types.h"
+#include <algorithm>
+#include <cassert>
+
+namespace emitc {
+namespace stablehlo {
+namespace eigen {
+
+using emitc::eigen::evaluate;
+
+// ReduceOp
+// Eigen reducer applying the `computation` of a ReduceOp to 0-d tensors
+template <typename T, typename Computation>
+struct ComputationReducer {
+  static const bool PacketAccess = false;
+
+  T initValue;
+  Computation computation;
+
+  void reduce(const T t, T *accum) const {
+    *accum = computation(Tensor<T>{*accum}, Tensor<T>{t})();
+  }
+  T initialize() const { return initValue; }
+  T finalize(const T accum) const { return accum; }
+};
+
+// 1 result overload
+template <typename Dest, size_t Dimension, typename Src, typename Computation>
+inline Dest
+reduce(Src operand, Tensor<typename get_element_type<Src>::type> initValue,
+       Tensor<int64_t, Dimension> dimensions, Computation computation) {
+  static_assert(is_tensor<Src>::value, "Expected tensor argument");
+  static_assert(is_tensor<Dest>::value, "Expected tensor result");
+
+  using ET_Src = typename get_element_type<Src>::type;
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  static_assert(std::is_same<ET_Src, ET_Dest>::value, "Element type mismatch");
+
+  static_assert(Src::rank() == Dest::rank() + Dimension,
+                "source rank must equal dest rank + dimension size");
+
+  if constexpr (std::is_same<ET_Src, bool>::value) {
+    // Eigen cannot map the bit packed storage of bool tensors, reduce bytes
+    using ByteSrc = typename replace_element_type<uint8_t, Src>::type;
+    using ByteDest = typename replace_element_type<uint8_t, Dest>::type;
+    ByteSrc bytes;
+    std::copy(operand.begin(), operand.end(), bytes.begin());
+    auto byteComputation = [&computation](Tensor<uint8_t> a,
+                                          Tensor<uint8_t> b) {
+      return Tensor<uint8_t>{
+          computation(Tensor<bool>{a() != 0}, Tensor<bool>{b() != 0})()};
+    };
+    ByteDest byteResult = reduce<ByteDest, Dimension>(
+        bytes, Tensor<uint8_t>{initValue()}, dimensions, byteComputation);
+
+    Dest result;
+    std::copy(byteResult.begin(), byteResult.end(), result.begin());
+    return result;
+  } else {
+    Eigen::array<Eigen::Index, Dimension> dims;
+    for (size_t i = 0; i < Dimension; i++) {
+      assert(dimensions[i] >= 0 &&
+             dimensions[i] < static_cast<int64_t>(Src::rank()));
+      dims[i] = dimensions[i];
+    }
+
+    Dest result;
+    ComputationReducer<ET_Src, Computation> reducer{initValue(), computation};
+    eigen::evaluate(as_eigen(result), as_eigen(operand).reduce(dims, reducer));
+    return result;
+  }
+}
+
+// ConvolutionOp
+// Computes convolutions with input [N,H,W,C], weights [KH,KW,C/G,OC] and
+// output [N,H,W,OC] for a feature group count G with Eigen. Other dimension
+// numbers, lhs dilation and batch groups use the direct implementation.
+template <typename Dest, typename Src, typename Weights>
+Dest convolution(Src input, Weights weights, int64_t batch_group_count,
+                 int64_t input_batch_dimension, int64_t input_feature_dimension,
+                 Tensor<int64_t, 2> input_spatial_dimensions,
+                 int64_t kernel_input_feature_dimension,
+                 int64_t kernel_output_feature_dimension,
+                 Tensor<int64_t, 2> kernel_spatial_dimensions,
+                 int64_t output_batch_dimension,
+                 int64_t output_feature_dimension,
+                 Tensor<int64_t, 2> output_spatial_dimensions,
+                 int64_t feature_group_count, Tensor<int64_t, 2, 2> padding,
+                 Tensor<int64_t, 2> lhs_dilation,
+                 Tensor<int64_t, 2> rhs_dilation,
+                 Tensor<int64_t, 2> window_strides) {
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+  static_assert(is_tensor_of_dim<4, Weights>::value,
+                "Expected 4 dimensional weights");
+
+  const bool nhwc = input_batch_dimension == 0 &&
+                    input_spatial_dimensions[0] == 1 &&
+                    input_spatial_dimensions[1] == 2 &&
+                    input_feature_dimension == 3 &&
+                    kernel_spatial_dimensions[0] == 0 &&
+                    kernel_spatial_dimensions[1] == 1 &&
+                    kernel_input_feature_dimension == 2 &&
+                    kernel_output_feature_dimension == 3 &&
+                    output_batch_dimension == 0 &&
+                    output_spatial_dimensions[0] == 1 &&
+                    output_spatial_dimensions[1] == 2 &&
+                    output_feature_dimension == 3;
+
+  if (!nhwc || batch_group_count != 1 || lhs_dilation[0] != 1 ||
+      lhs_dilation[1] != 1) {
+    return emitc::convolution<Dest>(
+        input, weights, batch_group_count, input_batch_dimension,
+        input_feature_dimension, input_spatial_dimensions,
+        kernel_input_feature_dimension, kernel_output_feature_dimension,
+        kernel_spatial_dimensions, output_batch_dimension,
+        output_feature_dimension, output_spatial_dimensions,
+        feature_group_count, padding, lhs_dilation, rhs_dilation,
+        window_strides);
+  }
+
+  assert(window_strides[0] > 0);
+  assert(window_strides[1] > 0);
+  assert(rhs_dilation[0] > 0);
+  assert(rhs_dilation[1] > 0);
+
+  constexpr Eigen::Index N = Src::dim(0);
+  constexpr Eigen::Index H_IN = Src::dim(1);
+  constexpr Eigen::Index W_IN = Src::dim(2);
+  constexpr Eigen::Index C_IN = Src::dim(3);
+  constexpr Eigen::Index KH = Weights::dim(0);
+  constexpr Eigen::Index KW = Weights::dim(1);
+  constexpr Eigen::Index G_IN = Weights::dim(2);
+  constexpr Eigen::Index C_OUT = Weights::dim(3);
+  constexpr Eigen::Index H = Dest::dim(1);
+  constexpr Eigen::Index W = Dest::dim(2);
+
+  assert(N == static_cast<Eigen::Index>(Dest::dim(0)));
+  assert(C_OUT == static_cast<Eigen::Index>(Dest::dim(3)));
+  assert(C_IN % G_IN == 0);
+  assert(feature_group_count == C_IN / G_IN);
+  assert(C_OUT % feature_group_count == 0);
+  const Eigen::Index G_OUT = C_OUT / feature_group_count;
+
+  const Eigen::Index SH = window_strides[0];
+  const Eigen::Index SW = window_strides[1];
+  const Eigen::Index DH = rhs_dilation[0];
+  const Eigen::Index DW = rhs_dilation[1];
+
+  // Half precision is computed in single precision.
+  using ET_Dest = typename get_element_type<Dest>::type;
+  using ET = emitc::accumulator_type_t<ET_Dest>;
+
+  Dest output;
+  auto e_input = as_eigen_accumulator(input);
+  auto e_weights = as_eigen_accumulator(weights);
+  auto e_output = as_eigen(output);
+
+  if (G_IN == 1) {
+    // Depthwise convolution, weights are viewed as [KH,KW,C,M]. Accumulate
+    // [M,N,H,W,C] over the kernel window, one strided view of the input per
+    // kernel element.
+    const Eigen::Index M = G_OUT;
+    Eigen::Tensor<ET, 4, Eigen::RowMajor> input_pad =
+        e_input.pad(spatial_padding(padding));
+    auto e_filter =
+        e_weights.reshape(Eigen::DSizes<Eigen::Index, 4>{KH, KW, C_IN, M});
+
+    Eigen::Tensor<ET, 5, Eigen::RowMajor> acc(M, N, H, W, C_IN);
+    acc.setZero();
+    for (Eigen::Index kh = 0; kh < KH; kh++) {
+      for (Eigen::Index kw = 0; kw < KW; kw++) {
+        // [N,H,W,C]
+        auto e_window =
+            window(input_pad, kh * DH, kw * DW, H, W, SH, SW);
+        for (Eigen::Index m = 0; m < M; m++) {
+          // [C] broadcasted to [N,H,W,C]
+          auto filter =
+              e_filter.chip(kh, 0)
+                  .chip(kw, 0)
+                  .chip(m, 1)
+                  .reshape(Eigen::DSizes<Eigen::Index, 4>{1, 1, 1, C_IN})
+                  .broadcast(Eigen::DSizes<Eigen::Index, 4>{N, H, W, 1});
+          eigen::evaluate(acc.chip(m, 0), acc.chip(m, 0) + e_window * filter);
+        }
+      }
+    }
+
+    eigen::evaluate(
+        e_output,
+        acc.shuffle(Eigen::array<Eigen::Index, 5>{1, 2, 3, 4, 0})
+            .reshape(Eigen::DSizes<Eigen::Index, 4>{N, H, W, C_OUT})
+            .template cast<ET_Dest>());
+    return output;
+  }
+
+  // Grouped convolution, one matrix multiplication of the input patches
+  // [N*H*W,KH*KW*G_IN] and the weights [KH*KW*G_IN,G_OUT] per group.
+  for (Eigen::Index g = 0; g < feature_group_count; g++) {
+    auto input_group =
+        e_input.slice(Eigen::DSizes<Eigen::Index, 4>{0, 0, 0, g * G_IN},
+                      Eigen::DSizes<Eigen::Index, 4>{N, H_IN, W_IN, G_IN});
+    auto patches = input_group.pad(spatial_padding(padding))
+                       .extract_image_patches(KW, KH, SW, SH, DW, DH,
+                                              Eigen::PADDING_VALID)
+                       .reshape(Eigen::DSizes<Eigen::Index, 2>{
+                           N * H * W, KH * KW * G_IN});
+    auto weights_group =
+        e_weights
+            .slice(Eigen::DSizes<Eigen::Index, 4>{0, 0, 0, g * G_OUT},
+                   Eigen::DSizes<Eigen::Index, 4>{KH, KW, G_IN, G_OUT})
+            .reshape(Eigen::DSizes<Eigen::Index, 2>{KH * KW * G_IN, G_OUT});
+    auto product = patches.contract(
+        weights_group, Eigen::array<Eigen::IndexPair<Eigen::Index>, 1>{
+                           Eigen::IndexPair<Eigen::Index>(1, 0)});
+
+    eigen::evaluate(
+        e_output.slice(Eigen::DSizes<Eigen::Index, 4>{0, 0, 0, g * G_OUT},
+                       Eigen::DSizes<Eigen::Index, 4>{N, H, W, G_OUT}),
+        product.reshape(Eigen::DSizes<Eigen::Index, 4>{N, H, W, G_OUT})
+            .template cast<ET_Dest>());
+  }
+
+  return output;
+}
+
+// DotOp
+template <typename Dest, typename Lhs, typename Rhs>
+Dest dot(Lhs lhs, Rhs rhs) {
+  static_assert(is_tensor_of_dim<2, Lhs>::value, "Expected 2 dimensional lhs");
+  static_assert(is_tensor_of_dim<2, Rhs>::value, "Expected 2 dimensional rhs");
+  static_assert(Lhs::dim(1) == Rhs::dim(0),
+                "Expected contracting dimension to match");
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  // Half precision is computed in single precision.
+  Dest output;
+  eigen::evaluate(as_eigen(output),
+                  as_eigen_accumulator(lhs)
+                      .contract(as_eigen_accumulator(rhs),
+                                Eigen::array<Eigen::IndexPair<Eigen::Index>, 1>{
+                                    Eigen::IndexPair<Eigen::Index>(1, 0)})
+                      .template cast<ET_Dest>());
+  return output;
+}
+
+// DotOp with transposed operands
+// If `TransposeLhs` is set, `lhs` is passed as [K,M] instead of [M,K]. If
+// `TransposeRhs` is set, `rhs` is passed as [N,K] instead of [K,N].
+template <typename Dest, bool TransposeLhs, bool TransposeRhs, typename Lhs,
+          typename Rhs>
+Dest dot_transposed(Lhs lhs, Rhs rhs) {
+  static_assert(is_tensor_of_dim<2, Lhs>::value, "Expected 2 dimensional lhs");
+  static_assert(is_tensor_of_dim<2, Rhs>::value, "Expected 2 dimensional rhs");
+  static_assert(is_tensor_of_dim<2, Dest>::value,
+                "Expected 2 dimensional output");
+  static_assert((TransposeLhs ? Lhs::dim(0) : Lhs::dim(1)) ==
+                    (TransposeRhs ? Rhs::dim(1) : Rhs::dim(0)),
+                "Expected contracting dimension to match");
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  // Half precision is computed in single precision.
+  Dest output;
+  eigen::evaluate(as_eigen(output),
+                  as_eigen_accumulator(lhs)
+                      .contract(as_eigen_accumulator(rhs),
+                                Eigen::array<Eigen::IndexPair<Eigen::Index>, 1>{
+                                    Eigen::IndexPair<Eigen::Index>(
+                                        TransposeLhs ? 0 : 1,
+                                        TransposeRhs ? 1 : 0)})
+                      .template cast<ET_Dest>());
+  return output;
+}
+
+} // namespace eigen
+} // namespace stablehlo
+} // namespace emitc
+
+#endif // EMITC_STABLEHLO_EIGEN_H
@@ -11,14 +11,27 @@
 #define EMITC_TOSA_H
 
 #include <limits>
+#include <type_traits>
+#include <vector>
 
 #include "emitc/core_ops.h"
 #include "emitc/tensor.h"
 
+#ifdef EMITC_USE_BLAS
+#include "emitc/blas.h"
+#endif
+
 #ifdef EMITC_TOSA_USE_EIGEN
 #include "emitc/tosa_eigen.h"
 #endif
 
+// Ops with several kernels provide them in the namespaces `naive`, `eigen`
+// and `blas`. The naive kernels are always available, the Eigen kernels if
+// `EMITC_TOSA_USE_EIGEN` and the CBLAS kernels if `EMITC_USE_BLAS` is
+// defined. The unqualified functions select the Eigen, CBLAS or naive kernel,
+// in this order, and the conversion emits qualified calls for the kernel
+// backends chosen per op.
+
 namespace emitc {
 namespace tosa {
 
@@ -142,6 +155,12 @@ inline Dest rescale(Src x, typename get_element_type<Src>::type in_zp,
   return cast<Dest>(emitc::clamp(min, result, max));
 }
 
+// RsqrtOp
+template <typename Src>
+inline Src rsqrt(Src x) {
+  return emitc::rsqrt<Src>(x);
+}
+
 // TanhOp
 template <typename Src>
 inline Src tanh(Src x) {
@@ -290,86 +309,79 @@ inline Dest concat(Src... inputs) {
   return emitc::concatenate<Dimension, Dest, Src...>(inputs...);
 }
 
-// Disable Conv2DOp if Eigen implementation is used
-#ifndef EMITC_TOSA_USE_EIGEN
+namespace naive {
 // Conv2DOp
-template <typename Dest, typename Src, typename Weights>
-Dest conv2d(Src input, Weights weights, Tensor1D<int64_t, 4> padding,
-            Tensor1D<int64_t, 2> stride, Tensor1D<int64_t, 2> dilation) {
-  // This implementation is taken from emitc_mhlo.c (convolution) and slightly
-  // adapted to fit the memory layout of tosa. Input is [N,IH,IW,IC], weights
-  // are [OC,KH,KW,IC] and output is [N,H,W,OC].
+template <typename Dest, typename Src, typename Weights,
+          typename Padding = Tensor1D<int64_t, 4>,
+          typename Window = Tensor1D<int64_t, 2>>
+Dest conv2d(Src input, Weights weights, Padding padding, Window stride,
+            Window dilation) {
+  // Input is [N,IH,IW,IC], weights are [OC,KH,KW,IC] and output is
+  // [N,H,W,OC].
   static_assert(is_tensor_of_dim<4, Src>::value,
                 "Expected 4 dimensional input");
   static_assert(is_tensor_of_dim<4, Dest>::value,
                 "Expected 4 dimensional output");
   static_assert(is_tensor_of_dim<4, Weights>::value,
                 "Expected 4 dimensional weights");
+  static_assert(Src::dim(3) == Weights::dim(3),
+                "Input channels must equal weights channels");
+  static_assert(Dest::dim(3) == Weights::dim(0),
+                "Output channels must equal weights output channels");
 
   assert(stride[0] > 0);
   assert(stride[1] > 0);
 
-  assert(dilation[0] == 1);
-  assert(dilation[1] == 1);
-
-  const int N = input.dim(0);
-  const int H_IN = input.dim(1);
-  const int W_IN = input.dim(2);
-  const int C_IN = input.dim(3);
+  assert(dilation[0] > 0);
+  assert(dilation[1] > 0);
+
+  constexpr int64_t C_IN = Src::dim(3);
+  constexpr int64_t K_H = Weights::dim(1);
+  constexpr int64_t K_W = Weights::dim(2);
+
+  emitc::detail::ConvParams p;
+  p.N = Src::dim(0);
+  p.H_IN = Src::dim(1);
+  p.W_IN = Src::dim(2);
+  p.C_IN = C_IN;
+  p.in_n = Src::dim(1) * Src::dim(2) * C_IN;
+  p.in_h = Src::dim(2) * C_IN;
+  p.in_w = C_IN;
+  p.in_c = 1;
+  p.K_H = K_H;
+  p.K_W = K_W;
+  p.K_I = C_IN;
+  p.C_OUT = Dest::dim(3);
+  p.k_offset = 0;
+  p.k_h = K_W * C_IN;
+  p.k_w = C_IN;
+  p.k_i = 1;
+  p.k_o = K_H * K_W * C_IN;
+  p.N_OUT = Dest::dim(0);
+  p.H = Dest::dim(1);
+  p.W = Dest::dim(2);
+  p.out_n = Dest::dim(1) * Dest::dim(2) * Dest::dim(3);
+  p.out_h = Dest::dim(2) * Dest::dim(3);
+  p.out_w = Dest::dim(3);
+  p.out_c = 1;
+  p.S_H = stride[0];
+  p.S_W = stride[1];
+  p.pt = padding[0];
+  p.pl = padding[2];
+  p.RD_H = dilation[0];
+  p.RD_W = dilation[1];
 
   Dest output;
-
-  const int C_OUT = output.dim(3);
-
-  const int K_H = weights.dim(1);
-  const int K_W = weights.dim(2);
-
-  const int S_H = stride[0];
-  const int S_W = stride[1];
-
-  const int pt = padding[0];
-  const int pb = padding[1];
-  const int pl = padding[2];
-  const int pr = padding[3];
-
-  const int H_PAD = pt + H_IN + pb;
-  const int W_PAD = pl + W_IN + pr;
-
-  // Convolution
-  for (int n = 0; n < N; n++) {
-    for (int h_pad = 0; h_pad < H_PAD - K_H + 1; h_pad += S_H) {
-      for (int w_pad = 0; w_pad < W_PAD - K_W + 1; w_pad += S_W) {
-        for (int kh = 0; kh < K_H; kh++) {
-          for (int kw = 0; kw < K_W; kw++) {
-            for (int c_in = 0; c_in < C_IN; c_in++) {
-              for (int c_out = 0; c_out < C_OUT; c_out++) {
-                const int h_out = h_pad / S_H;
-                const int w_out = w_pad / S_W;
-                const int h_in = h_pad - pt + kh;
-                const int w_in = w_pad - pl + kw;
-
-                if (h_in < 0 || h_in >= H_IN || w_in < 0 || w_in >= W_IN)
-                  continue;
-
-                output(n, h_out, w_out, c_out) +=
-                    input(n, h_in, w_in, c_in) * weights(c_out, kh, kw, c_in);
-              }
-            }
-          }
-        }
-      }
-    }
-  }
-
+  emitc::detail::convolution(p, input, weights, output);
   return output;
 }
-#endif
 
 // DepthwiseConv2DOp
-template <typename Dest, typename Src, typename Weights>
-Dest depthwise_conv2d(Src input, Weights weights, Tensor1D<int64_t, 4> padding,
-                      Tensor1D<int64_t, 2> stride,
-                      Tensor1D<int64_t, 2> dilation) {
+template <typename Dest, typename Src, typename Weights,
+          typename Padding = Tensor1D<int64_t, 4>,
+          typename Window = Tensor1D<int64_t, 2>>
+Dest depthwise_conv2d(Src input, Weights weights, Padding padding,
+                      Window stride, Window dilation) {
   // Input is [N,H_IN,W_IN,C_IN], weights
   // are [K_H,K_W,C_IN,M] and output is [N,H,W,C_IN*M].
   static_assert(is_tensor_of_dim<4, Src>::value,
@@ -392,69 +404,173 @@ Dest depthwise_conv2d(Src input, Weights weights, Tensor1D<int64_t, 4> padding,
   assert(stride[0] > 0);
   assert(stride[1] > 0);
 
-  assert(dilation[0] == 1);
-  assert(dilation[1] == 1);
+  assert(dilation[0] > 0);
+  assert(dilation[1] > 0);
+
+  // A grouped convolution with one group per input channel. The weights are
+  // interpreted as [K_H,K_W,1,C_IN*M], i.e. the output channels of a group
+  // are contiguous.
+  constexpr int64_t C_IN = Src::dim(3);
+  constexpr int64_t C_OUT = Dest::dim(3);
+
+  emitc::detail::ConvParams p;
+  p.N = Src::dim(0);
+  p.H_IN = Src::dim(1);
+  p.W_IN = Src::dim(2);
+  p.C_IN = C_IN;
+  p.in_n = Src::dim(1) * Src::dim(2) * C_IN;
+  p.in_h = Src::dim(2) * C_IN;
+  p.in_w = C_IN;
+  p.in_c = 1;
+  p.K_H = Weights::dim(0);
+  p.K_W = Weights::dim(1);
+  p.K_I = 1;
+  p.C_OUT = C_OUT;
+  p.k_offset = 0;
+  p.k_h = Weights::dim(1) * C_OUT;
+  p.k_w = C_OUT;
+  p.k_i = C_OUT;
+  p.k_o = 1;
+  p.N_OUT = Dest::dim(0);
+  p.H = Dest::dim(1);
+  p.W = Dest::dim(2);
+  p.out_n = Dest::dim(1) * Dest::dim(2) * C_OUT;
+  p.out_h = Dest::dim(2) * C_OUT;
+  p.out_w = C_OUT;
+  p.out_c = 1;
+  p.S_H = stride[0];
+  p.S_W = stride[1];
+  p.pt = padding[0];
+  p.pl = padding[2];
+  p.RD_H = dilation[0];
+  p.RD_W = dilation[1];
+  p.feature_group_count = C_IN;
 
-  const int N = input.dim(0);
-  const int H_IN = input.dim(1);
-  const int W_IN = input.dim(2);
-  const int C_IN = input.dim(3);
+  Dest output;
+  emitc::detail::convolution(p, input, weights, output);
+  return output;
+}
+} // namespace naive
 
+#ifdef EMITC_USE_BLAS
+namespace blas {
+// Conv2DOp
+template <typename Dest, typename Src, typename Weights,
+          typename Padding = Tensor1D<int64_t, 4>,
+          typename Window = Tensor1D<int64_t, 2>>
+Dest conv2d(Src input, Weights weights, Padding padding, Window stride,
+            Window dilation) {
   Dest output;
+  if (dilation[0] == 1 && dilation[1] == 1 &&
+      emitc::blas::conv2d(input, weights, padding[0], padding[2], stride[0],
+                          stride[1], output))
+    return output;
+  return naive::conv2d<Dest>(input, weights, padding, stride, dilation);
+}
+} // namespace blas
+#endif
 
-  const int K_H = weights.dim(0);
-  const int K_W = weights.dim(1);
-  const int M = weights.dim(3);
+#if defined(EMITC_TOSA_USE_EIGEN)
+using eigen::conv2d;
+using eigen::depthwise_conv2d;
+#elif defined(EMITC_USE_BLAS)
+using blas::conv2d;
+using naive::depthwise_conv2d;
+#else
+using naive::conv2d;
+using naive::depthwise_conv2d;
+#endif
 
-  const int S_H = stride[0];
-  const int S_W = stride[1];
+// Conv2DOp and DepthwiseConv2DOp with attributes passed as template arguments
+template <typename Dest, typename Padding, typename Stride, typename Dilation,
+          typename Src, typename Weights>
+Dest conv2d(Src input, Weights weights) {
+  constexpr auto padding = utility::to_array(Padding{});
+  constexpr auto stride = utility::to_array(Stride{});
+  constexpr auto dilation = utility::to_array(Dilation{});
+  static_assert(padding.size() == 4, "Expected 4 padding values");
+  static_assert(stride[0] > 0 && stride[1] > 0, "Expected positive strides");
+  static_assert(dilation.size() == 2, "Expected 2 dilation values");
+  return conv2d<Dest>(input, weights, padding, stride, dilation);
+}
 
-  const int pt = padding[0];
-  const int pb = padding[1];
-  const int pl = padding[2];
-  const int pr = padding[3];
+template <typename Dest, typename Padding, typename Stride, typename Dilation,
+          typename Src, typename Weights>
+Dest depthwise_conv2d(Src input, Weights weights) {
+  constexpr auto padding = utility::to_array(Padding{});
+  constexpr auto stride = utility::to_array(Stride{});
+  constexpr auto dilation = utility::to_array(Dilation{});
+  static_assert(padding.size() == 4, "Expected 4 padding values");
+  static_assert(stride[0] > 0 && stride[1] > 0, "Expected positive strides");
+  static_assert(dilation.size() == 2, "Expected 2 dilation values");
+  return depthwise_conv2d<Dest>(input, weights, padding, stride, dilation);
+}
 
-  const int H_PAD = pt + H_IN + pb;
-  const int W_PAD = pl + W_IN + pr;
+// TransposeConv2DOp
+// Computed directly as a convolution of the input dilated by the stride with
+// the spatially flipped weights, skipping the holes of the dilated input.
+// Input is [N,IH,IW,IC], weights are [OC,KH,KW,IC] and output is [N,H,W,OC].
+template <typename Dest, typename Src, typename Weights>
+Dest transpose_conv2d(Src input, Weights weights, Tensor1D<int64_t, 4> out_pad,
+                      Tensor1D<int64_t, 2> stride) {
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+  static_assert(is_tensor_of_dim<4, Weights>::value,
+                "Expected 4 dimensional weights");
+  static_assert(Src::dim(3) == Weights::dim(3),
+                "Input channels must equal weights channels");
+  static_assert(Dest::dim(3) == Weights::dim(0),
+                "Output channels must equal weights output channels");
+  static_assert(Src::dim(0) == Dest::dim(0), "Batch sizes must be equal");
 
-  // Convolution
-  for (int n = 0; n < N; ++n) {
-    for (int h_pad = 0; h_pad < H_PAD - K_H + 1; h_pad += S_H) {
-      for (int w_pad = 0; w_pad < W_PAD - K_W + 1; w_pad += S_W) {
-        for (int kh = 0; kh < K_H; ++kh) {
-          for (int kw = 0; kw < K_W; ++kw) {
-            for (int c_in = 0; c_in < C_IN; ++c_in) {
-              for (int m = 0; m < M; ++m) {
-                const int h_out = h_pad / S_H;
-                const int w_out = w_pad / S_W;
-                const int c_out = c_in * M + m;
-                const int h_in = h_pad - pt + kh;
-                const int w_in = w_pad - pl + kw;
-
-                if (h_in < 0 || h_in >= H_IN || w_in < 0 || w_in >= W_IN)
-                  continue;
-
-                // For depthwise convolution we interpret weights as a tensor
-                // with shape [filter_height, filter_width, 1, in_channels *
-                // channel_multiplier]. So we need to calculate the index
-                // using these dimensions.
-                const size_t weights_index = emitc::utility::ravel_index<
-                    Weights::dim(0), Weights::dim(1), 1,
-                    Weights::dim(2) * Weights::dim(3)>(kh, kw, 0, c_out);
-
-                output(n, h_out, w_out, c_out) +=
-                    input(n, h_in, w_in, c_in) * weights[weights_index];
-              }
-            }
-          }
-        }
-      }
-    }
-  }
+  assert(stride[0] > 0);
+  assert(stride[1] > 0);
+
+  constexpr int64_t C_IN = Src::dim(3);
+  constexpr int64_t K_H = Weights::dim(1);
+  constexpr int64_t K_W = Weights::dim(2);
+
+  emitc::detail::ConvParams p;
+  p.N = Src::dim(0);
+  p.H_IN = Src::dim(1);
+  p.W_IN = Src::dim(2);
+  p.C_IN = C_IN;
+  p.in_n = Src::dim(1) * Src::dim(2) * C_IN;
+  p.in_h = Src::dim(2) * C_IN;
+  p.in_w = C_IN;
+  p.in_c = 1;
+  p.K_H = K_H;
+  p.K_W = K_W;
+  p.K_I = C_IN;
+  p.C_OUT = Dest::dim(3);
+  p.k_offset = (K_H - 1) * K_W * C_IN + (K_W - 1) * C_IN;
+  p.k_h = -K_W * C_IN;
+  p.k_w = -C_IN;
+  p.k_i = 1;
+  p.k_o = K_H * K_W * C_IN;
+  p.N_OUT = Dest::dim(0);
+  p.H = Dest::dim(1);
+  p.W = Dest::dim(2);
+  p.out_n = Dest::dim(1) * Dest::dim(2) * Dest::dim(3);
+  p.out_h = Dest::dim(2) * Dest::dim(3);
+  p.out_w = Dest::dim(3);
+  p.out_c = 1;
+  // Output (oy, ox) accumulates input (iy, ix) with weights (ky, kx) for
+  // oy = iy * stride[0] + out_pad[0] + ky and ox = ix * stride[1] + out_pad[2]
+  // + kx.
+  p.pt = K_H - 1 + out_pad[0];
+  p.pl = K_W - 1 + out_pad[2];
+  p.LD_H = stride[0];
+  p.LD_W = stride[1];
 
+  Dest output;
+  emitc::detail::convolution(p, input, weights, output);
   return output;
 }
 
+namespace naive {
 // MaxPool2d
 template <typename Dest, typename Src>
 Dest max_pool2d(Src input, std::array<int64_t, 4> padding,
@@ -488,7 +604,7 @@ Dest max_pool2d(Src input, std::array<int64_t, 4> padding,
         for (int c = 0; c < C; c++) {
           const int h_out = h_pad / S_H;
           const int w_out = w_pad / S_W;
-          output(n, h_out, w_out, c) = std::numeric_limits<ET_Dest>::min();
+          output(n, h_out, w_out, c) = std::numeric_limits<ET_Dest>::lowest();
           for (int kh = 0; kh < K_H; kh++) {
             for (int kw = 0; kw < K_W; kw++) {
               const int h_in = h_pad - pt + kh;
@@ -516,8 +632,9 @@ Dest avg_pool2d(Src input, std::array<int64_t, 4> padding,
                 "Expected 4 dimensional output");
 
   using ET_Dest = typename get_element_type<Dest>::type;
-  static_assert(std::is_same<ET_Dest, float>::value,
-                "Only float data type supported");
+  static_assert(std::is_same<ET_Dest, float>::value ||
+                    emitc::is_half_precision<ET_Dest>::value,
+                "Only float data types supported");
 
   assert(stride[0] > 0);
   assert(stride[1] > 0);
@@ -548,7 +665,8 @@ Dest avg_pool2d(Src input, std::array<int64_t, 4> padding,
           const int h_out = h_pad / S_H;
           const int w_out = w_pad / S_W;
 
-          ET_Dest acc = ET_Dest(0);
+          // Half precision elements are summed in single precision.
+          emitc::accumulator_type_t<ET_Dest> acc = 0;
           size_t count = 0;
 
           for (int kh = 0; kh < K_H; kh++) {
@@ -559,10 +677,11 @@ Dest avg_pool2d(Src input, std::array<int64_t, 4> padding,
                 continue;
 
               count++;
-              acc += input(n, h_in, w_in, c);
+              acc += widen(input(n, h_in, w_in, c));
             }
           }
-          output(n, h_out, w_out, c) = acc / static_cast<ET_Dest>(count);
+          output(n, h_out, w_out, c) =
+              static_cast<ET_Dest>(acc / static_cast<decltype(acc)>(count));
         }
       }
     }
@@ -596,19 +715,752 @@ Dest fully_connected(Src input, Weights weights, Bias bias) {
   const size_t C_IN = input.dim(1);
   const size_t C_OUT = weights.dim(0);
 
+  using ET_Dest = typename get_element_type<Dest>::type;
+
   for (size_t n = 0; n < N; ++n) {
     for (size_t c_out = 0; c_out < C_OUT; ++c_out) {
+      // Half precision elements are accumulated in single precision.
+      emitc::accumulator_type_t<ET_Dest> acc = 0;
       for (size_t c_in = 0; c_in < C_IN; ++c_in) {
-        auto in = input(n, c_in);
-        auto weight = weights(c_out, c_in);
-        output(n, c_out) += in * weight;
+        auto in = widen(input(n, c_in));
+        auto weight = widen(weights(c_out, c_in));
+        acc += in * weight;
       }
+      acc += widen(bias(c_out));
+      output(n, c_out) = static_cast<ET_Dest>(acc);
+    }
+  }
+  return output;
+}
+
+// FullyConnectedOp with transposed operands
+// If `TransposeInput` is set, `input` is passed as [IC,N]. If
+// `TransposeWeights` is set, `weights` are passed as [IC,OC].
+template <typename Dest, bool TransposeInput, bool TransposeWeights,
+          typename Src, typename Weights, typename Bias>
+Dest fully_connected_transposed(Src input, Weights weights, Bias bias) {
+  static_assert(is_tensor_of_dim<1, Bias>::value,
+                "Expected 1 dimensional bias");
+  static_assert(Dest::dim(1) == Bias::dim(0),
+                "Bias and output dimensions do not match.");
+
+  // The weights of fully_connected are already transposed, i.e. [OC,IC].
+  Dest output = emitc::dot_transposed<Dest, TransposeInput, !TransposeWeights>(
+      input, weights);
+
+  for (size_t n = 0; n < Dest::dim(0); ++n) {
+    for (size_t c_out = 0; c_out < Dest::dim(1); ++c_out) {
+      output(n, c_out) += bias(c_out);
+    }
+  }
+  return output;
+}
+} // namespace naive
+
+#ifdef EMITC_USE_BLAS
+namespace blas {
+// FullyConnectedOp
+template <typename Dest, typename Src, typename Weights, typename Bias>
+Dest fully_connected(Src input, Weights weights, Bias bias) {
+  Dest output;
+  if (!emitc::blas::gemm<false, true>(input, weights, output))
+    return naive::fully_connected<Dest>(input, weights, bias);
+
+  for (size_t n = 0; n < Dest::dim(0); ++n) {
+    for (size_t c_out = 0; c_out < Dest::dim(1); ++c_out) {
       output(n, c_out) += bias(c_out);
     }
   }
   return output;
 }
 
+// FullyConnectedOp with transposed operands
+template <typename Dest, bool TransposeInput, bool TransposeWeights,
+          typename Src, typename Weights, typename Bias>
+Dest fully_connected_transposed(Src input, Weights weights, Bias bias) {
+  // The weights of fully_connected are already transposed, i.e. [OC,IC].
+  Dest output;
+  if (!emitc::blas::gemm<TransposeInput, !TransposeWeights>(input, weights,
+                                                             output))
+    return naive::fully_connected_transposed<Dest, TransposeInput,
+                                             TransposeWeights>(input, weights,
+                                                               bias);
+
+  for (size_t n = 0; n < Dest::dim(0); ++n) {
+    for (size_t c_out = 0; c_out < Dest::dim(1); ++c_out) {
+      output(n, c_out) += bias(c_out);
+    }
+  }
+  return output;
+}
+} // namespace blas
+#endif
+
+#if defined(EMITC_TOSA_USE_EIGEN)
+using eigen::avg_pool2d;
+using eigen::fully_connected;
+using eigen::fully_connected_transposed;
+using eigen::max_pool2d;
+#elif defined(EMITC_USE_BLAS)
+using blas::fully_connected;
+using blas::fully_connected_transposed;
+using naive::avg_pool2d;
+using naive::max_pool2d;
+#else
+using naive::avg_pool2d;
+using naive::fully_connected;
+using naive::fully_connected_transposed;
+using naive::max_pool2d;
+#endif
+
+// Packed weights layout
+// The `pack-tosa-weights` pass packs constant weights of `conv2d` and
+// `fully_connected` into panels of B output channels. [OC,KH,KW,IC] weights
+// become [ceil(OC/B),KH,KW,IC,B] and [OC,IC] weights become [ceil(OC/B),IC,B].
+// Output channels beyond OC are zero. The pass passes the layout version as
+// template argument, which must match the version below.
+// The packed weights may be stored compressed as f16, bf16 or as int8 with a
+// float scale per output channel. The kernels dequantize each row of B packed
+// weights to the accumulator type before using it and apply the scales to the
+// accumulated sums.
+constexpr int64_t packed_weights_layout_version = 1;
+
+template <typename Packed, typename Weights>
+inline Packed pack_weights(Weights weights) {
+  static_assert(Packed::rank() == Weights::rank() + 1,
+                "Expected packed weights to have one additional dimension");
+
+  constexpr size_t B = Packed::dim(Packed::rank() - 1);
+  constexpr size_t OC = Weights::dim(0);
+  constexpr size_t K = Weights::size() / OC;
+
+  static_assert(Packed::dim(0) == (OC + B - 1) / B,
+                "Unexpected number of output channel panels");
+  static_assert(Packed::size() == Packed::dim(0) * K * B,
+                "Packed weights size does not match weights");
+
+  using ET_Packed = typename get_element_type<Packed>::type;
+
+  Packed packed;
+  for (size_t oc = 0; oc < OC; oc++) {
+    for (size_t k = 0; k < K; k++) {
+      packed[((oc / B) * K + k) * B + oc % B] =
+          static_cast<ET_Packed>(weights[oc * K + k]);
+    }
+  }
+  return packed;
+}
+
+namespace detail {
+// Returns a row of B packed weights in the accumulator type Acc. Compressed
+// weights are converted into `buffer`.
+template <typename Acc, size_t B, typename ET_Weights>
+inline const Acc *dequantize_packed_row(const ET_Weights *weights,
+                                        std::array<Acc, B> &buffer) {
+  if constexpr (std::is_same<ET_Weights, Acc>::value) {
+    return weights;
+  } else {
+    emitc::convert_n(weights, buffer.data(), B);
+    return buffer.data();
+  }
+}
+
+// Scales is either a tensor of one scale per output channel or
+// std::nullptr_t for weights stored without scales.
+template <typename Dest, typename Src, typename Weights, typename Scales,
+          typename Bias>
+Dest conv2d_prepacked(Src input, Weights weights, Scales scales, Bias bias,
+                      Tensor1D<int64_t, 4> padding, Tensor1D<int64_t, 2> stride,
+                      Tensor1D<int64_t, 2> dilation) {
+  // Input is [N,IH,IW,IC], weights are [OC/B,KH,KW,IC,B], scales and bias are
+  // [OC] and output is [N,H,W,OC].
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+  static_assert(is_tensor_of_dim<5, Weights>::value,
+                "Expected 5 dimensional packed weights");
+  static_assert(is_tensor_of_dim<1, Bias>::value,
+                "Expected 1 dimensional bias");
+
+  constexpr size_t N = Src::dim(0);
+  constexpr size_t H_IN = Src::dim(1);
+  constexpr size_t W_IN = Src::dim(2);
+  constexpr size_t C_IN = Src::dim(3);
+  constexpr size_t H_OUT = Dest::dim(1);
+  constexpr size_t W_OUT = Dest::dim(2);
+  constexpr size_t C_OUT = Dest::dim(3);
+  constexpr size_t PANELS = Weights::dim(0);
+  constexpr size_t K_H = Weights::dim(1);
+  constexpr size_t K_W = Weights::dim(2);
+  constexpr size_t B = Weights::dim(4);
+  constexpr bool SCALED = !std::is_null_pointer<Scales>::value;
+
+  static_assert(Src::dim(0) == Dest::dim(0), "Batch sizes must be equal");
+  static_assert(Weights::dim(3) == C_IN,
+                "Input channels must equal weights channels");
+  static_assert(PANELS == (C_OUT + B - 1) / B,
+                "Unexpected number of output channel panels");
+  static_assert(Bias::dim(0) == C_OUT, "Bias and output channels must match");
+
+  assert(stride[0] > 0);
+  assert(stride[1] > 0);
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+  using ET_Acc = emitc::accumulator_type_t<ET_Dest>;
+
+  const int64_t pt = padding[0];
+  const int64_t pl = padding[2];
+  const int64_t S_H = stride[0];
+  const int64_t S_W = stride[1];
+  const int64_t D_H = dilation[0];
+  const int64_t D_W = dilation[1];
+
+  Dest output;
+  std::array<ET_Acc, B> acc;
+  std::array<ET_Acc, B> row;
+
+  for (size_t n = 0; n < N; n++) {
+    for (size_t h_out = 0; h_out < H_OUT; h_out++) {
+      for (size_t w_out = 0; w_out < W_OUT; w_out++) {
+        for (size_t panel = 0; panel < PANELS; panel++) {
+          acc.fill(ET_Acc(0));
+          for (size_t kh = 0; kh < K_H; kh++) {
+            const int64_t h_in =
+                static_cast<int64_t>(h_out * S_H + kh * D_H) - pt;
+            if (h_in < 0 || h_in >= static_cast<int64_t>(H_IN))
+              continue;
+            for (size_t kw = 0; kw < K_W; kw++) {
+              const int64_t w_in =
+                  static_cast<int64_t>(w_out * S_W + kw * D_W) - pl;
+              if (w_in < 0 || w_in >= static_cast<int64_t>(W_IN))
+                continue;
+              const auto *in = &input[((n * H_IN + h_in) * W_IN + w_in) * C_IN];
+              const auto *w =
+                  &weights[((panel * K_H + kh) * K_W + kw) * C_IN * B];
+              for (size_t c_in = 0; c_in < C_IN; c_in++) {
+                const ET_Acc *w_row =
+                    dequantize_packed_row<ET_Acc, B>(&w[c_in * B], row);
+                for (size_t b = 0; b < B; b++) {
+                  acc[b] += in[c_in] * w_row[b];
+                }
+              }
+            }
+          }
+          auto *out = &output[((n * H_OUT + h_out) * W_OUT + w_out) * C_OUT];
+          for (size_t b = 0; b < B && panel * B + b < C_OUT; b++) {
+            if constexpr (SCALED) {
+              acc[b] *= scales[panel * B + b];
+            }
+            out[panel * B + b] = acc[b] + bias[panel * B + b];
+          }
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+template <typename Dest, typename Src, typename Weights, typename Scales,
+          typename Bias>
+Dest fully_connected_prepacked(Src input, Weights weights, Scales scales,
+                               Bias bias) {
+  // Input is [N,IC], weights are [OC/B,IC,B], scales and bias are [OC] and
+  // output is [N,OC].
+  static_assert(is_tensor_of_dim<2, Src>::value,
+                "Expected 2 dimensional input");
+  static_assert(is_tensor_of_dim<2, Dest>::value,
+                "Expected 2 dimensional output");
+  static_assert(is_tensor_of_dim<3, Weights>::value,
+                "Expected 3 dimensional packed weights");
+  static_assert(is_tensor_of_dim<1, Bias>::value,
+                "Expected 1 dimensional bias");
+
+  constexpr size_t N = Src::dim(0);
+  constexpr size_t C_IN = Src::dim(1);
+  constexpr size_t C_OUT = Dest::dim(1);
+  constexpr size_t PANELS = Weights::dim(0);
+  constexpr size_t B = Weights::dim(2);
+  constexpr bool SCALED = !std::is_null_pointer<Scales>::value;
+
+  static_assert(Src::dim(0) == Dest::dim(0),
+                "Output and input batch dimension do not match.");
+  static_assert(Weights::dim(1) == C_IN,
+                "Input and weights dimensions do not match.");
+  static_assert(PANELS == (C_OUT + B - 1) / B,
+                "Unexpected number of output channel panels");
+  static_assert(Bias::dim(0) == C_OUT, "Bias and output channels must match");
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+  using ET_Acc = emitc::accumulator_type_t<ET_Dest>;
+
+  Dest output;
+  std::array<ET_Acc, B> acc;
+  std::array<ET_Acc, B> row;
+
+  for (size_t n = 0; n < N; n++) {
+    for (size_t panel = 0; panel < PANELS; panel++) {
+      acc.fill(ET_Acc(0));
+      const auto *w = &weights[panel * C_IN * B];
+      for (size_t c_in = 0; c_in < C_IN; c_in++) {
+        const auto in = input(n, c_in);
+        const ET_Acc *w_row =
+            dequantize_packed_row<ET_Acc, B>(&w[c_in * B], row);
+        for (size_t b = 0; b < B; b++) {
+          acc[b] += in * w_row[b];
+        }
+      }
+      for (size_t b = 0; b < B && panel * B + b < C_OUT; b++) {
+        if constexpr (SCALED) {
+          acc[b] *= scales[panel * B + b];
+        }
+        output(n, panel * B + b) = acc[b] + bias[panel * B + b];
+      }
+    }
+  }
+
+  return output;
+}
+} // namespace detail
+
+// Conv2DOp with packed weights
+template <typename Dest, int64_t Version, typename Src, typename Weights,
+          typename Bias>
+Dest conv2d_prepacked(Src input, Weights weights, Bias bias,
+                      Tensor1D<int64_t, 4> padding, Tensor1D<int64_t, 2> stride,
+                      Tensor1D<int64_t, 2> dilation) {
+  static_assert(Version == packed_weights_layout_version,
+                "Packed weights layout version mismatch");
+  return detail::conv2d_prepacked<Dest>(input, weights, nullptr, bias, padding,
+                                        stride, dilation);
+}
+
+// Conv2DOp with packed int8 weights and a scale per output channel
+template <typename Dest, int64_t Version, typename Src, typename Weights,
+          typename Scales, typename Bias>
+Dest conv2d_prepacked(Src input, Weights weights, Scales scales, Bias bias,
+                      Tensor1D<int64_t, 4> padding, Tensor1D<int64_t, 2> stride,
+                      Tensor1D<int64_t, 2> dilation) {
+  static_assert(Version == packed_weights_layout_version,
+                "Packed weights layout version mismatch");
+  static_assert(is_tensor_of_dim<1, Scales>::value,
+                "Expected 1 dimensional scales");
+  static_assert(Scales::dim(0) == Dest::dim(3),
+                "Scales and output channels must match");
+  return detail::conv2d_prepacked<Dest>(input, weights, scales, bias, padding,
+                                        stride, dilation);
+}
+
+// FullyConnectedOp with packed weights
+template <typename Dest, int64_t Version, typename Src, typename Weights,
+          typename Bias>
+Dest fully_connected_prepacked(Src input, Weights weights, Bias bias) {
+  static_assert(Version == packed_weights_layout_version,
+                "Packed weights layout version mismatch");
+  return detail::fully_connected_prepacked<Dest>(input, weights, nullptr, bias);
+}
+
+// FullyConnectedOp with packed int8 weights and a scale per output channel
+template <typename Dest, int64_t Version, typename Src, typename Weights,
+          typename Scales, typename Bias>
+Dest fully_connected_prepacked(Src input, Weights weights, Scales scales,
+                               Bias bias) {
+  static_assert(Version == packed_weights_layout_version,
+                "Packed weights layout version mismatch");
+  static_assert(is_tensor_of_dim<1, Scales>::value,
+                "Expected 1 dimensional scales");
+  static_assert(Scales::dim(0) == Dest::dim(1),
+                "Scales and output channels must match");
+  return detail::fully_connected_prepacked<Dest>(input, weights, scales, bias);
+}
+
+// Sparse weights layout
+// The `sparsify-tosa-weights` pass encodes constant weights of
+// `fully_connected` and 1x1 `conv2d` with enough zeros in compressed sparse
+// row (CSR) format. The nonzero weights of output channel oc are
+// `values[row_offsets[oc]]` to `values[row_offsets[oc + 1] - 1]`, applied to
+// the input channels at the same positions of `col_indices`.
+
+namespace detail {
+// Computes the [P,OC] output of P input rows of IC elements and the CSR
+// weights, where `row(p)` returns input row p. A single row is computed as
+// sparse matrix-vector product. Otherwise, tiles of rows are transposed such
+// that the products of each weight vectorize over the rows of the tile.
+template <typename ET_Dest, typename Row, typename ET_Values,
+          typename ET_Indices, typename ET_Offsets, typename ET_Bias>
+inline void sparse_matmul(Row row, const ET_Values *values,
+                          const ET_Indices *col_indices,
+                          const ET_Offsets *row_offsets, const ET_Bias *bias,
+                          ET_Dest *output, size_t P, size_t C_IN,
+                          size_t C_OUT) {
+  using ET_Acc = emitc::accumulator_type_t<ET_Dest>;
+  constexpr size_t T = 16;
+
+  if (P == 1) {
+    const auto *in = row(0);
+    for (size_t c_out = 0; c_out < C_OUT; c_out++) {
+      ET_Acc acc = bias[c_out];
+      for (ET_Offsets k = row_offsets[c_out]; k < row_offsets[c_out + 1];
+           k++) {
+        acc += in[col_indices[k]] * values[k];
+      }
+      output[c_out] = acc;
+    }
+    return;
+  }
+
+  std::vector<ET_Acc> tile(C_IN * T);
+  std::array<ET_Acc, T> acc;
+
+  for (size_t p0 = 0; p0 < P; p0 += T) {
+    const size_t rows = std::min(T, P - p0);
+    for (size_t t = 0; t < rows; t++) {
+      const auto *in = row(p0 + t);
+      for (size_t c_in = 0; c_in < C_IN; c_in++) {
+        tile[c_in * T + t] = in[c_in];
+      }
+    }
+
+    for (size_t c_out = 0; c_out < C_OUT; c_out++) {
+      acc.fill(bias[c_out]);
+      for (ET_Offsets k = row_offsets[c_out]; k < row_offsets[c_out + 1];
+           k++) {
+        const ET_Acc value = values[k];
+        const ET_Acc *x = &tile[col_indices[k] * T];
+        for (size_t t = 0; t < T; t++) {
+          acc[t] += value * x[t];
+        }
+      }
+      for (size_t t = 0; t < rows; t++) {
+        output[(p0 + t) * C_OUT + c_out] = acc[t];
+      }
+    }
+  }
+}
+} // namespace detail
+
+// FullyConnectedOp with sparse weights
+template <typename Dest, typename Src, typename Values, typename Indices,
+          typename Offsets, typename Bias>
+Dest fully_connected_sparse(Src input, Values values, Indices col_indices,
+                            Offsets row_offsets, Bias bias) {
+  // Input is [N,IC], values and col_indices are [NNZ], row_offsets is [OC+1],
+  // bias is [OC] and output is [N,OC].
+  static_assert(is_tensor_of_dim<2, Src>::value,
+                "Expected 2 dimensional input");
+  static_assert(is_tensor_of_dim<2, Dest>::value,
+                "Expected 2 dimensional output");
+  static_assert(is_tensor_of_dim<1, Values>::value &&
+                    is_tensor_of_dim<1, Indices>::value &&
+                    is_tensor_of_dim<1, Offsets>::value,
+                "Expected 1 dimensional sparse weights");
+  static_assert(is_tensor_of_dim<1, Bias>::value,
+                "Expected 1 dimensional bias");
+
+  constexpr size_t N = Src::dim(0);
+  constexpr size_t C_IN = Src::dim(1);
+  constexpr size_t C_OUT = Dest::dim(1);
+
+  static_assert(Src::dim(0) == Dest::dim(0),
+                "Output and input batch dimension do not match.");
+  static_assert(Values::dim(0) == Indices::dim(0),
+                "Values and column indices must match");
+  static_assert(Offsets::dim(0) == C_OUT + 1,
+                "Expected a row offset per output channel and the end offset");
+  static_assert(Bias::dim(0) == C_OUT, "Bias and output channels must match");
+
+  Dest output;
+  auto row = [&input](size_t n) { return &input[n * C_IN]; };
+  detail::sparse_matmul(row, values.get(), col_indices.get(),
+                        row_offsets.get(), bias.get(), output.get(), N, C_IN,
+                        C_OUT);
+  return output;
+}
+
+// Conv2DOp with a 1x1 kernel, no padding and sparse weights
+template <typename Dest, typename Src, typename Values, typename Indices,
+          typename Offsets, typename Bias>
+Dest conv2d_1x1_sparse(Src input, Values values, Indices col_indices,
+                       Offsets row_offsets, Bias bias,
+                       Tensor1D<int64_t, 2> stride) {
+  // Input is [N,IH,IW,IC], values and col_indices are [NNZ], row_offsets is
+  // [OC+1], bias is [OC] and output is [N,H,W,OC].
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+  static_assert(is_tensor_of_dim<1, Values>::value &&
+                    is_tensor_of_dim<1, Indices>::value &&
+                    is_tensor_of_dim<1, Offsets>::value,
+                "Expected 1 dimensional sparse weights");
+  static_assert(is_tensor_of_dim<1, Bias>::value,
+                "Expected 1 dimensional bias");
+
+  constexpr size_t N = Src::dim(0);
+  constexpr size_t H_IN = Src::dim(1);
+  constexpr size_t W_IN = Src::dim(2);
+  constexpr size_t C_IN = Src::dim(3);
+  constexpr size_t H_OUT = Dest::dim(1);
+  constexpr size_t W_OUT = Dest::dim(2);
+  constexpr size_t C_OUT = Dest::dim(3);
+
+  static_assert(Src::dim(0) == Dest::dim(0), "Batch sizes must be equal");
+  static_assert(Values::dim(0) == Indices::dim(0),
+                "Values and column indices must match");
+  static_assert(Offsets::dim(0) == C_OUT + 1,
+                "Expected a row offset per output channel and the end offset");
+  static_assert(Bias::dim(0) == C_OUT, "Bias and output channels must match");
+
+  assert(stride[0] > 0);
+  assert(stride[1] > 0);
+
+  const size_t S_H = stride[0];
+  const size_t S_W = stride[1];
+
+  // Output pixel p reads the input pixel at the strided position.
+  auto row = [&input, S_H, S_W](size_t p) {
+    const size_t w_out = p % W_OUT;
+    const size_t h_out = (p / W_OUT) % H_OUT;
+    const size_t n = p / (W_OUT * H_OUT);
+    return &input[((n * H_IN + h_out * S_H) * W_IN + w_out * S_W) * C_IN];
+  };
+
+  Dest output;
+  detail::sparse_matmul(row, values.get(), col_indices.get(),
+                        row_offsets.get(), bias.get(), output.get(),
+                        N * H_OUT * W_OUT, C_IN, C_OUT);
+  return output;
+}
+
+// Blocked activation layout
+// The `tosa-blocked-layout` pass assigns a channel-blocked layout to chains of
+// convolutions, max poolings and elementwise ops. [N,H,W,C] activations become
+// [N,ceil(C/B),H,W,B] with channel c stored at (c / B, c % B). Channels beyond
+// C are zero after a reorder and unspecified after any other op.
+
+// Reorder from NHWC to NCHWc
+template <typename Dest, typename Src>
+inline Dest to_nchwc(Src input) {
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<5, Dest>::value,
+                "Expected 5 dimensional output");
+
+  constexpr size_t N = Src::dim(0);
+  constexpr size_t H = Src::dim(1);
+  constexpr size_t W = Src::dim(2);
+  constexpr size_t C = Src::dim(3);
+  constexpr size_t B = Dest::dim(4);
+
+  static_assert(Dest::dim(0) == N && Dest::dim(2) == H && Dest::dim(3) == W,
+                "Batch and spatial dimensions must match");
+  static_assert(Dest::dim(1) == (C + B - 1) / B,
+                "Unexpected number of channel blocks");
+
+  Dest output;
+
+  for (size_t n = 0; n < N; n++) {
+    for (size_t h = 0; h < H; h++) {
+      for (size_t w = 0; w < W; w++) {
+        for (size_t c = 0; c < C; c++) {
+          output(n, c / B, h, w, c % B) = input(n, h, w, c);
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// Reorder from NCHWc to NHWC
+template <typename Dest, typename Src>
+inline Dest from_nchwc(Src input) {
+  static_assert(is_tensor_of_dim<5, Src>::value,
+                "Expected 5 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+
+  constexpr size_t N = Dest::dim(0);
+  constexpr size_t H = Dest::dim(1);
+  constexpr size_t W = Dest::dim(2);
+  constexpr size_t C = Dest::dim(3);
+  constexpr size_t B = Src::dim(4);
+
+  static_assert(Src::dim(0) == N && Src::dim(2) == H && Src::dim(3) == W,
+                "Batch and spatial dimensions must match");
+  static_assert(Src::dim(1) == (C + B - 1) / B,
+                "Unexpected number of channel blocks");
+
+  Dest output;
+
+  for (size_t n = 0; n < N; n++) {
+    for (size_t h = 0; h < H; h++) {
+      for (size_t w = 0; w < W; w++) {
+        for (size_t c = 0; c < C; c++) {
+          output(n, h, w, c) = input(n, c / B, h, w, c % B);
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// Conv2DOp in blocked layout
+template <typename Dest, int64_t Version, typename Src, typename Weights,
+          typename Bias>
+Dest conv2d_nchwc(Src input, Weights weights, Bias bias,
+                  Tensor1D<int64_t, 4> padding, Tensor1D<int64_t, 2> stride,
+                  Tensor1D<int64_t, 2> dilation) {
+  // Input is [N,IC/B,IH,IW,B], weights are packed [OC/B,KH,KW,IC,B], bias is
+  // [OC] and output is [N,OC/B,H,W,B].
+  static_assert(Version == packed_weights_layout_version,
+                "Packed weights layout version mismatch");
+  static_assert(is_tensor_of_dim<5, Src>::value,
+                "Expected 5 dimensional input");
+  static_assert(is_tensor_of_dim<5, Dest>::value,
+                "Expected 5 dimensional output");
+  static_assert(is_tensor_of_dim<5, Weights>::value,
+                "Expected 5 dimensional packed weights");
+  static_assert(is_tensor_of_dim<1, Bias>::value,
+                "Expected 1 dimensional bias");
+
+  constexpr size_t N = Src::dim(0);
+  constexpr size_t H_IN = Src::dim(2);
+  constexpr size_t W_IN = Src::dim(3);
+  constexpr size_t B = Src::dim(4);
+  constexpr size_t H_OUT = Dest::dim(2);
+  constexpr size_t W_OUT = Dest::dim(3);
+  constexpr size_t BLOCKS_OUT = Dest::dim(1);
+  constexpr size_t K_H = Weights::dim(1);
+  constexpr size_t K_W = Weights::dim(2);
+  constexpr size_t C_IN = Weights::dim(3);
+  constexpr size_t C_OUT = Bias::dim(0);
+
+  static_assert(Src::dim(0) == Dest::dim(0), "Batch sizes must be equal");
+  static_assert(Dest::dim(4) == B && Weights::dim(4) == B,
+                "Block sizes must be equal");
+  static_assert(Src::dim(1) == (C_IN + B - 1) / B,
+                "Unexpected number of input channel blocks");
+  static_assert(Weights::dim(0) == BLOCKS_OUT &&
+                    BLOCKS_OUT == (C_OUT + B - 1) / B,
+                "Unexpected number of output channel blocks");
+
+  assert(stride[0] > 0);
+  assert(stride[1] > 0);
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  const int64_t pt = padding[0];
+  const int64_t pl = padding[2];
+  const int64_t S_H = stride[0];
+  const int64_t S_W = stride[1];
+  const int64_t D_H = dilation[0];
+  const int64_t D_W = dilation[1];
+
+  Dest output;
+  std::array<emitc::accumulator_type_t<ET_Dest>, B> acc;
+
+  for (size_t n = 0; n < N; n++) {
+    for (size_t block = 0; block < BLOCKS_OUT; block++) {
+      for (size_t h_out = 0; h_out < H_OUT; h_out++) {
+        for (size_t w_out = 0; w_out < W_OUT; w_out++) {
+          acc.fill(ET_Dest(0));
+          for (size_t kh = 0; kh < K_H; kh++) {
+            const int64_t h_in =
+                static_cast<int64_t>(h_out * S_H + kh * D_H) - pt;
+            if (h_in < 0 || h_in >= static_cast<int64_t>(H_IN))
+              continue;
+            for (size_t kw = 0; kw < K_W; kw++) {
+              const int64_t w_in =
+                  static_cast<int64_t>(w_out * S_W + kw * D_W) - pl;
+              if (w_in < 0 || w_in >= static_cast<int64_t>(W_IN))
+                continue;
+              const auto *w =
+                  &weights[((block * K_H + kh) * K_W + kw) * C_IN * B];
+              for (size_t c_in = 0; c_in < C_IN; c_in++) {
+                const auto in = input(n, c_in / B, h_in, w_in, c_in % B);
+                for (size_t b = 0; b < B; b++) {
+                  acc[b] += in * w[c_in * B + b];
+                }
+              }
+            }
+          }
+          for (size_t b = 0; b < B && block * B + b < C_OUT; b++) {
+            output(n, block, h_out, w_out, b) = acc[b] + bias[block * B + b];
+          }
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// MaxPool2d in blocked layout
+template <typename Dest, typename Src>
+Dest max_pool2d_nchwc(Src input, std::array<int64_t, 4> padding,
+                      std::array<int64_t, 2> stride,
+                      std::array<int64_t, 2> kernel) {
+  static_assert(is_tensor_of_dim<5, Src>::value,
+                "Expected 5 dimensional input");
+  static_assert(is_tensor_of_dim<5, Dest>::value,
+                "Expected 5 dimensional output");
+  static_assert(Src::dim(0) == Dest::dim(0) && Src::dim(1) == Dest::dim(1) &&
+                    Src::dim(4) == Dest::dim(4),
+                "Batch and channel dimensions must match");
+
+  constexpr size_t N = Src::dim(0);
+  constexpr size_t BLOCKS = Src::dim(1);
+  constexpr size_t H_IN = Src::dim(2);
+  constexpr size_t W_IN = Src::dim(3);
+  constexpr size_t B = Src::dim(4);
+  constexpr size_t H_OUT = Dest::dim(2);
+  constexpr size_t W_OUT = Dest::dim(3);
+
+  assert(stride[0] > 0);
+  assert(stride[1] > 0);
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  const int64_t pt = padding[0];
+  const int64_t pl = padding[2];
+
+  Dest output;
+  std::array<ET_Dest, B> acc;
+
+  for (size_t n = 0; n < N; n++) {
+    for (size_t block = 0; block < BLOCKS; block++) {
+      for (size_t h_out = 0; h_out < H_OUT; h_out++) {
+        for (size_t w_out = 0; w_out < W_OUT; w_out++) {
+          acc.fill(std::numeric_limits<ET_Dest>::lowest());
+          for (int64_t kh = 0; kh < kernel[0]; kh++) {
+            const int64_t h_in =
+                static_cast<int64_t>(h_out) * stride[0] + kh - pt;
+            if (h_in < 0 || h_in >= static_cast<int64_t>(H_IN))
+              continue;
+            for (int64_t kw = 0; kw < kernel[1]; kw++) {
+              const int64_t w_in =
+                  static_cast<int64_t>(w_out) * stride[1] + kw - pl;
+              if (w_in < 0 || w_in >= static_cast<int64_t>(W_IN))
+                continue;
+              for (size_t b = 0; b < B; b++) {
+                acc[b] = std::max(acc[b], input(n, block, h_in, w_in, b));
+              }
+            }
+          }
+          for (size_t b = 0; b < B; b++) {
+            output(n, block, h_out, w_out, b) = acc[b];
+          }
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
 // GatherOp
 template <typename Dest, typename Src, typename Idx,
           IsTensorOfDim<3, Dest> = true, IsTensorOfDim<3, Src> = true,
@@ -636,24 +1488,73 @@ Dest gather(Src input, Idx indices) {
   return result;
 }
 
+namespace naive {
 // MatMulOp
 template <typename T, size_t B, size_t M, size_t K, size_t N>
 Tensor3D<T, B, M, N> matmul(Tensor3D<T, B, M, K> a, Tensor3D<T, B, K, N> b) {
   return emitc::batch_matmul<Tensor3D<T, B, M, N>>(a, b);
 }
 
+// MatMulOp with transposed operands
+// If `TransposeA` is set, `a` is passed as [B,K,M]. If `TransposeB` is set, `b`
+// is passed as [B,N,K].
+template <typename Dest, bool TransposeA, bool TransposeB, typename A,
+          typename B>
+Dest matmul_transposed(A a, B b) {
+  return emitc::batch_matmul_transposed<Dest, TransposeA, TransposeB>(a, b);
+}
+} // namespace naive
+
+#ifdef EMITC_USE_BLAS
+namespace blas {
+// MatMulOp
+template <typename T, size_t B, size_t M, size_t K, size_t N>
+Tensor3D<T, B, M, N> matmul(Tensor3D<T, B, M, K> a, Tensor3D<T, B, K, N> b) {
+  Tensor3D<T, B, M, N> output;
+  if (emitc::blas::gemm<false, false>(a, b, output))
+    return output;
+  return naive::matmul(a, b);
+}
+
+// MatMulOp with transposed operands
+template <typename Dest, bool TransposeA, bool TransposeB, typename A,
+          typename B>
+Dest matmul_transposed(A a, B b) {
+  Dest output;
+  if (emitc::blas::gemm<TransposeA, TransposeB>(a, b, output))
+    return output;
+  return naive::matmul_transposed<Dest, TransposeA, TransposeB>(a, b);
+}
+} // namespace blas
+#endif
+
+#if defined(EMITC_TOSA_USE_EIGEN)
+using eigen::matmul;
+using eigen::matmul_transposed;
+#elif defined(EMITC_USE_BLAS)
+using blas::matmul;
+using blas::matmul_transposed;
+#else
+using naive::matmul;
+using naive::matmul_transposed;
+#endif
+
 namespace {
 // Common reduce function used by specialized TOSA reduce ops.
 template <typename Dest, typename Src, typename Computation>
-inline Dest reduce(Src operand, typename get_element_type<Src>::type initValue,
+inline Dest reduce(Src operand, typename get_element_type<Dest>::type initValue,
                    int64_t dimension, Computation computation) {
   static_assert(is_tensor<Src>::value, "Expected tensor argument");
   static_assert(is_tensor<Dest>::value, "Expected tensor result");
 
   using ET_Src = typename get_element_type<Src>::type;
   using ET_Dest = typename get_element_type<Dest>::type;
+  using ET_Acc = emitc::accumulator_type_t<ET_Src>;
 
-  static_assert(std::is_same<ET_Src, ET_Dest>::value, "Element type mismatch");
+  // Half precision operands may be reduced in their accumulator type.
+  static_assert(std::is_same<ET_Src, ET_Dest>::value ||
+                    std::is_same<ET_Acc, ET_Dest>::value,
+                "Element type mismatch");
 
   static_assert(Src::rank() == Dest::rank() + 1,
                 "source rank must equal dest rank + 1");
@@ -668,7 +1569,7 @@ inline Dest reduce(Src operand, typename get_element_type<Src>::type initValue,
   std::fill(result.begin(), result.end(), initValue);
 
   for (size_t i = 0; i < operand.size(); ++i) {
-    auto value = operand[i];
+    auto value = static_cast<ET_Dest>(operand[i]);
     auto index = operand.unravel_index(i);
 
     std::array<size_t, Dest::rank()> reducedIndex;
@@ -766,6 +1667,7 @@ inline Dest reduce_any(Src input, int64_t dimension) {
   return tosa::reduce<Dest, Src>(input, false, dimension, or_);
 }
 
+namespace naive {
 // ReduceMaxOp
 template <typename Dest, typename Src>
 inline Dest reduce_max(Src input, int64_t dimension) {
@@ -774,7 +1676,7 @@ inline Dest reduce_max(Src input, int64_t dimension) {
   auto f =
       static_cast<const ET_Src &(*)(const ET_Src &, const ET_Src &)>(std::max);
 
-  return tosa::reduce<Dest, Src>(input, std::numeric_limits<ET_Src>::min(),
+  return tosa::reduce<Dest, Src>(input, std::numeric_limits<ET_Src>::lowest(),
                                  dimension, f);
 }
 
@@ -794,18 +1696,34 @@ inline Dest reduce_min(Src input, int64_t dimension) {
 template <typename Dest, typename Src>
 inline Dest reduce_prod(Src input, int64_t dimension) {
   using ET_Src = typename get_element_type<Src>::type;
+  using ET_Acc = emitc::accumulator_type_t<ET_Src>;
 
-  return tosa::reduce<Dest, Src>(input, 1, dimension,
-                                 std::multiplies<ET_Src>{});
+  return narrow<Dest>(tosa::reduce<accumulator_tensor_t<Dest>, Src>(
+      input, 1, dimension, std::multiplies<ET_Acc>{}));
 }
 
 // ReduceSumOp
 template <typename Dest, typename Src>
 inline Dest reduce_sum(Src input, int64_t dimension) {
   using ET_Src = typename get_element_type<Src>::type;
+  using ET_Acc = emitc::accumulator_type_t<ET_Src>;
 
-  return tosa::reduce<Dest, Src>(input, 0, dimension, std::plus<ET_Src>{});
+  return narrow<Dest>(tosa::reduce<accumulator_tensor_t<Dest>, Src>(
+      input, 0, dimension, std::plus<ET_Acc>{}));
 }
+} // namespace naive
+
+#ifdef EMITC_TOSA_USE_EIGEN
+using eigen::reduce_max;
+using eigen::reduce_min;
+using eigen::reduce_prod;
+using eigen::reduce_sum;
+#else
+using naive::reduce_max;
+using naive::reduce_min;
+using naive::reduce_prod;
+using naive::reduce_sum;
+#endif
 
 // ReshapeOp
 template <typename Dest, typename Src>
@@ -813,6 +1731,141 @@ inline Dest reshape(Src x) {
   return emitc::reshape<Dest>(x);
 }
 
+// ResizeOp
+enum class ResizeMode { NearestNeighbor, Bilinear };
+
+namespace detail {
+// Source indices and interpolation weights of the output positions along one
+// axis. Weights are in units of `1` for floating point and of the scale
+// numerator for integer resizes.
+template <typename T>
+struct ResizeAxis {
+  std::vector<int64_t> lower;
+  std::vector<int64_t> upper;
+  std::vector<T> weight;
+};
+
+template <typename T>
+ResizeAxis<T> resize_axis(int64_t out_size, int64_t in_size, int64_t scale_n,
+                          int64_t scale_d, int64_t offset, ResizeMode mode) {
+  ResizeAxis<T> axis;
+  axis.lower.resize(out_size);
+  axis.upper.resize(out_size);
+  axis.weight.resize(out_size);
+
+  for (int64_t o = 0; o < out_size; o++) {
+    const int64_t y = o * scale_d + offset;
+    const int64_t i = y >= 0 ? y / scale_n : -((scale_n - 1 - y) / scale_n);
+    const int64_t r = y - i * scale_n;
+    // Positive borders and negative offsets read beyond the input edges,
+    // which are clamped to the edge pixels.
+    const int64_t lower =
+        std::min<int64_t>(std::max<int64_t>(i, 0), in_size - 1);
+    const int64_t upper =
+        std::min<int64_t>(std::max<int64_t>(i + 1, 0), in_size - 1);
+
+    if (mode == ResizeMode::NearestNeighbor) {
+      axis.lower[o] = axis.upper[o] = 2 * r >= scale_n ? upper : lower;
+      axis.weight[o] = 0;
+    } else {
+      axis.lower[o] = lower;
+      axis.upper[o] = upper;
+      axis.weight[o] = std::is_floating_point<T>::value
+                           ? static_cast<T>(r) / static_cast<T>(scale_n)
+                           : static_cast<T>(r);
+    }
+  }
+  return axis;
+}
+} // namespace detail
+
+// Input is [N,IH,IW,C] and output is [N,OH,OW,C]. `scale` is
+// [scale_y_n,scale_y_d,scale_x_n,scale_x_d]. The source indices and weights
+// are computed once per axis, such that the innermost loop over the channels
+// only loads and blends contiguous rows. Integer bilinear resizes return the
+// unnormalized result scaled by scale_y_n * scale_x_n.
+template <typename Dest, typename Src>
+Dest resize(Src input, Tensor1D<int64_t, 4> scale, Tensor1D<int64_t, 2> offset,
+            Tensor1D<int64_t, 2> border, ResizeMode mode) {
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+  static_assert(Src::dim(0) == Dest::dim(0), "Batch sizes must be equal");
+  static_assert(Src::dim(3) == Dest::dim(3), "Channels must be equal");
+
+  using ET_Src = typename get_element_type<Src>::type;
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  constexpr int64_t N = Src::dim(0);
+  constexpr int64_t IH = Src::dim(1);
+  constexpr int64_t IW = Src::dim(2);
+  constexpr int64_t C = Src::dim(3);
+  constexpr int64_t OH = Dest::dim(1);
+  constexpr int64_t OW = Dest::dim(2);
+
+  assert(scale[0] > 0 && scale[1] > 0 && scale[2] > 0 && scale[3] > 0);
+  assert(OH == ((IH - 1) * scale[0] - offset[0] + border[0]) / scale[1] + 1);
+  assert(OW == ((IW - 1) * scale[2] - offset[1] + border[1]) / scale[3] + 1);
+  (void)border;
+
+  auto ys = detail::resize_axis<ET_Dest>(OH, IH, scale[0], scale[1],
+                                         offset[0], mode);
+  auto xs = detail::resize_axis<ET_Dest>(OW, IW, scale[2], scale[3],
+                                         offset[1], mode);
+
+  Dest output;
+  const ET_Src *in = input.get();
+  ET_Dest *out = output.get();
+
+  if (mode == ResizeMode::NearestNeighbor) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t oy = 0; oy < OH; oy++) {
+        const ET_Src *row = in + (n * IH + ys.lower[oy]) * IW * C;
+        for (int64_t ox = 0; ox < OW; ox++) {
+          const ET_Src *src = row + xs.lower[ox] * C;
+          for (int64_t c = 0; c < C; c++) {
+            out[c] = static_cast<ET_Dest>(src[c]);
+          }
+          out += C;
+        }
+      }
+    }
+    return output;
+  }
+
+  constexpr bool is_float = std::is_floating_point<ET_Dest>::value;
+  const ET_Dest unit_y = is_float ? 1 : static_cast<ET_Dest>(scale[0]);
+  const ET_Dest unit_x = is_float ? 1 : static_cast<ET_Dest>(scale[2]);
+
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t oy = 0; oy < OH; oy++) {
+      const ET_Src *row0 = in + (n * IH + ys.lower[oy]) * IW * C;
+      const ET_Src *row1 = in + (n * IH + ys.upper[oy]) * IW * C;
+      const ET_Dest dy = ys.weight[oy];
+      for (int64_t ox = 0; ox < OW; ox++) {
+        const ET_Dest dx = xs.weight[ox];
+        const ET_Dest w00 = (unit_y - dy) * (unit_x - dx);
+        const ET_Dest w01 = (unit_y - dy) * dx;
+        const ET_Dest w10 = dy * (unit_x - dx);
+        const ET_Dest w11 = dy * dx;
+        const ET_Src *v00 = row0 + xs.lower[ox] * C;
+        const ET_Src *v01 = row0 + xs.upper[ox] * C;
+        const ET_Src *v10 = row1 + xs.lower[ox] * C;
+        const ET_Src *v11 = row1 + xs.upper[ox] * C;
+        for (int64_t c = 0; c < C; c++) {
+          out[c] = static_cast<ET_Dest>(v00[c]) * w00 +
+                   static_cast<ET_Dest>(v01[c]) * w01 +
+                   static_cast<ET_Dest>(v10[c]) * w10 +
+                   static_cast<ET_Dest>(v11[c]) * w11;
+        }
+        out += C;
+      }
+    }
+  }
+  return output;
+}
+
 // SliceOp
 template <typename Dest, typename Src>
 Dest slice(Src x, Tensor<int64_t, Src::rank()> start_indices,
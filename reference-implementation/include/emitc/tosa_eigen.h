@@ -6,31 +6,28 @@
 
 // This file defines alternative implementations for the functions in
 // tosa.h utilizing Eigen.
+// They are defined in `emitc::tosa::eigen` and selected as default
+// implementations if `EMITC_TOSA_USE_EIGEN` is defined.
 
 #ifndef EMITC_TOSA_EIGEN_H
 #define EMITC_TOSA_EIGEN_H
 
+#include "emitc/eigen_utility.h"
 #include "emitc/types.h"
-#include <unsupported/Eigen/CXX11/Tensor>
-
-namespace {
-
-// A view on an emitc tensor as Eigen tensor in row-major order
-template <typename T, size_t... Shape>
-inline auto as_eigen(Tensor<T, Shape...> &t) {
-  return Eigen::TensorMap<Eigen::Tensor<T, sizeof...(Shape), Eigen::RowMajor>>(
-      &*t.begin(), Shape...);
-}
-
-} // namespace
+#include <limits>
 
 namespace emitc {
 namespace tosa {
+namespace eigen {
+
+using emitc::eigen::evaluate;
 
 // Conv2DOp
-template <typename Dest, typename Src, typename Weights>
-Dest conv2d(Src input, Weights weights, Tensor1D<int64_t, 4> padding,
-            Tensor1D<int64_t, 2> stride, Tensor1D<int64_t, 2> dilation) {
+template <typename Dest, typename Src, typename Weights,
+          typename Padding = Tensor1D<int64_t, 4>,
+          typename Window = Tensor1D<int64_t, 2>>
+Dest conv2d(Src input, Weights weights, Padding padding, Window stride,
+            Window dilation) {
   // Input is [N,IH,IW,IC], weights are [OC,KH,KW,IC] and output is [N,H,W,OC]
   static_assert(is_tensor_of_dim<4, Src>::value,
                 "Expected 4 dimensional input");
@@ -63,17 +60,21 @@ Dest conv2d(Src input, Weights weights, Tensor1D<int64_t, 4> padding,
   const int64_t DH = dilation[0];
   const int64_t DW = dilation[1];
 
+  using ET_Dest = typename get_element_type<Dest>::type;
+
   Dest output;
-  // [N,IH,IW,IC]
-  auto e_input = as_eigen(input);
+  // [N,IH,IW,IC], half precision is computed in single precision
+  auto e_input = as_eigen_accumulator(input);
 
   // [KH,KW,IC,OC]
 #if EIGEN_VERSION_AT_LEAST(3, 4, 0)
-  auto e_weight =
-      as_eigen(weights).shuffle(Eigen::array<Eigen::Index, 4>({1, 2, 3, 0}));
+  auto e_weight = as_eigen_accumulator(weights).shuffle(
+      Eigen::array<Eigen::Index, 4>({1, 2, 3, 0}));
 #else
-  Eigen::Tensor<typename Weights::value_type, 4, Eigen::RowMajor> e_weight =
-      as_eigen(weights).shuffle(Eigen::array<Eigen::Index, 4>({1, 2, 3, 0}));
+  Eigen::Tensor<emitc::accumulator_type_t<typename Weights::value_type>, 4,
+                Eigen::RowMajor>
+      e_weight = as_eigen_accumulator(weights).shuffle(
+          Eigen::array<Eigen::Index, 4>({1, 2, 3, 0}));
 #endif
 
   // [N,H,W,OC]
@@ -102,11 +103,362 @@ Dest conv2d(Src input, Weights weights, Tensor1D<int64_t, 4> padding,
                     Eigen::IndexPair<Eigen::Index>(1, 0)});
 
   // reshape result to output [N,H,W,OC]
-  e_output = contr.reshape(Eigen::DSizes<Eigen::Index, 4>{N, H, W, OC});
+  eigen::evaluate(e_output,
+                  contr.reshape(Eigen::DSizes<Eigen::Index, 4>{N, H, W, OC})
+                      .template cast<ET_Dest>());
+
+  return output;
+}
+
+// DepthwiseConv2DOp
+template <typename Dest, typename Src, typename Weights,
+          typename Padding = Tensor1D<int64_t, 4>,
+          typename Window = Tensor1D<int64_t, 2>>
+Dest depthwise_conv2d(Src input, Weights weights, Padding padding,
+                      Window stride, Window dilation) {
+  // Input is [N,IH,IW,C], weights are [KH,KW,C,M] and output is [N,H,W,C*M]
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+  static_assert(is_tensor_of_dim<4, Weights>::value,
+                "Expected 4 dimensional weights");
+
+  constexpr Eigen::Index N = Src::dim(0);
+  constexpr Eigen::Index C = Src::dim(3);
+  constexpr Eigen::Index KH = Weights::dim(0);
+  constexpr Eigen::Index KW = Weights::dim(1);
+  constexpr Eigen::Index M = Weights::dim(3);
+  constexpr Eigen::Index H = Dest::dim(1);
+  constexpr Eigen::Index W = Dest::dim(2);
+
+  static_assert(N == Dest::dim(0), "Batch sizes must be equal");
+  static_assert(C == Weights::dim(2),
+                "Input channels must equal weights channels");
+  static_assert(Dest::dim(3) == C * M,
+                "Output channels size must be input channels times channel "
+                "multiplier");
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+  using ET = emitc::accumulator_type_t<ET_Dest>;
+
+  // apply padding to input [N,IH+pt+pb,IW+pl+pr,C]
+  Eigen::Tensor<ET, 4, Eigen::RowMajor> input_pad =
+      as_eigen_accumulator(input).pad(spatial_padding(padding));
+  auto e_weights = as_eigen_accumulator(weights);
+
+  // accumulate [M,N,H,W,C] over the kernel window, one strided view of the
+  // input per kernel element
+  Eigen::Tensor<ET, 5, Eigen::RowMajor> acc(M, N, H, W, C);
+  acc.setZero();
+  for (Eigen::Index kh = 0; kh < KH; kh++) {
+    for (Eigen::Index kw = 0; kw < KW; kw++) {
+      // [N,H,W,C]
+      auto e_window = window(input_pad, kh * dilation[0], kw * dilation[1], H,
+                             W, stride[0], stride[1]);
+      for (Eigen::Index m = 0; m < M; m++) {
+        // [C] broadcasted to [N,H,W,C]
+        auto filter =
+            e_weights.chip(kh, 0)
+                .chip(kw, 0)
+                .chip(m, 1)
+                .reshape(Eigen::DSizes<Eigen::Index, 4>{1, 1, 1, C})
+                .broadcast(Eigen::DSizes<Eigen::Index, 4>{N, H, W, 1});
+        eigen::evaluate(acc.chip(m, 0), acc.chip(m, 0) + e_window * filter);
+      }
+    }
+  }
+
+  // reorder [M,N,H,W,C] to output [N,H,W,C*M]
+  Dest output;
+  eigen::evaluate(as_eigen(output),
+                  acc.shuffle(Eigen::array<Eigen::Index, 5>{1, 2, 3, 4, 0})
+                      .reshape(Eigen::DSizes<Eigen::Index, 4>{N, H, W, C * M})
+                      .template cast<ET_Dest>());
 
   return output;
 }
 
+// MaxPool2d
+template <typename Dest, typename Src>
+Dest max_pool2d(Src input, std::array<int64_t, 4> padding,
+                std::array<int64_t, 2> stride, std::array<int64_t, 2> kernel) {
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+  using ET_Src = typename get_element_type<Src>::type;
+
+  constexpr Eigen::Index H = Dest::dim(1);
+  constexpr Eigen::Index W = Dest::dim(2);
+
+  // apply padding with the lowest value to input
+  Eigen::Tensor<ET_Src, 4, Eigen::RowMajor> input_pad = as_eigen(input).pad(
+      spatial_padding(padding), std::numeric_limits<ET_Src>::lowest());
+
+  Dest output;
+  auto e_output = as_eigen(output);
+  eigen::evaluate(e_output,
+                  window(input_pad, 0, 0, H, W, stride[0], stride[1]));
+  for (Eigen::Index kh = 0; kh < kernel[0]; kh++) {
+    for (Eigen::Index kw = 0; kw < kernel[1]; kw++) {
+      if (kh == 0 && kw == 0)
+        continue;
+      eigen::evaluate(e_output,
+                      e_output.cwiseMax(window(input_pad, kh, kw, H, W,
+                                               stride[0], stride[1])));
+    }
+  }
+
+  return output;
+}
+
+// AvgPool2d
+template <typename Dest, typename Src>
+Dest avg_pool2d(Src input, std::array<int64_t, 4> padding,
+                std::array<int64_t, 2> stride, std::array<int64_t, 2> kernel) {
+  static_assert(is_tensor_of_dim<4, Src>::value,
+                "Expected 4 dimensional input");
+  static_assert(is_tensor_of_dim<4, Dest>::value,
+                "Expected 4 dimensional output");
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+  static_assert(std::is_same<ET_Dest, float>::value ||
+                    emitc::is_half_precision<ET_Dest>::value,
+                "Only float data types supported");
+
+  constexpr Eigen::Index N = Dest::dim(0);
+  constexpr Eigen::Index H = Dest::dim(1);
+  constexpr Eigen::Index W = Dest::dim(2);
+  constexpr Eigen::Index C = Dest::dim(3);
+
+  // Half precision elements are summed in single precision.
+  using ET_Acc = emitc::accumulator_type_t<ET_Dest>;
+
+  // apply zero padding to input and count the elements of each window which
+  // are not padding, as the padding is not included in the average
+  auto e_input = as_eigen_accumulator(input);
+  Eigen::Tensor<ET_Acc, 4, Eigen::RowMajor> input_pad =
+      e_input.pad(spatial_padding(padding));
+  Eigen::Tensor<ET_Acc, 4, Eigen::RowMajor> ones_pad =
+      e_input.constant(ET_Acc(1)).pad(spatial_padding(padding));
+
+  Eigen::Tensor<ET_Acc, 4, Eigen::RowMajor> sum(N, H, W, C);
+  Eigen::Tensor<ET_Acc, 4, Eigen::RowMajor> count(N, H, W, C);
+  sum.setZero();
+  count.setZero();
+  for (Eigen::Index kh = 0; kh < kernel[0]; kh++) {
+    for (Eigen::Index kw = 0; kw < kernel[1]; kw++) {
+      eigen::evaluate(sum, sum + window(input_pad, kh, kw, H, W, stride[0],
+                                        stride[1]));
+      eigen::evaluate(count, count + window(ones_pad, kh, kw, H, W, stride[0],
+                                            stride[1]));
+    }
+  }
+
+  Dest output;
+  eigen::evaluate(as_eigen(output), (sum / count).template cast<ET_Dest>());
+
+  return output;
+}
+
+// FullyConnectedOp
+template <typename Dest, typename Src, typename Weights, typename Bias>
+Dest fully_connected(Src input, Weights weights, Bias bias) {
+  // Input is [N,IC], weights are [OC,IC], bias is [OC] and output is [N,OC]
+  static_assert(is_tensor_of_dim<2, Src>::value,
+                "Expected 2 dimensional input");
+  static_assert(is_tensor_of_dim<2, Dest>::value,
+                "Expected 2 dimensional output");
+  static_assert(is_tensor_of_dim<2, Weights>::value,
+                "Expected 2 dimensional weights");
+  static_assert(is_tensor_of_dim<1, Bias>::value,
+                "Expected 1 dimensional bias");
+
+  constexpr Eigen::Index N = Dest::dim(0);
+  constexpr Eigen::Index OC = Dest::dim(1);
+
+  static_assert(Src::dim(0) == N,
+                "Output and input batch dimension do not match.");
+  static_assert(Src::dim(1) == Weights::dim(1),
+                "Input and weights dimensions do not match.");
+  static_assert(Weights::dim(0) == OC,
+                "Output and weights dimensions do not match.");
+  static_assert(Bias::dim(0) == OC,
+                "Bias and weights dimensions do not match.");
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  Dest output;
+  auto e_output = as_eigen(output);
+
+  // Half precision is computed in single precision.
+  auto product = as_eigen_accumulator(input).contract(
+      as_eigen_accumulator(weights),
+      Eigen::array<Eigen::IndexPair<Eigen::Index>, 1>{
+          Eigen::IndexPair<Eigen::Index>(1, 1)});
+  auto e_bias = as_eigen_accumulator(bias)
+                    .reshape(Eigen::DSizes<Eigen::Index, 2>{1, OC})
+                    .broadcast(Eigen::DSizes<Eigen::Index, 2>{N, 1});
+
+  eigen::evaluate(e_output, (product + e_bias).template cast<ET_Dest>());
+
+  return output;
+}
+
+// FullyConnectedOp with transposed operands
+// If `TransposeInput` is set, `input` is passed as [IC,N]. If
+// `TransposeWeights` is set, `weights` are passed as [IC,OC].
+template <typename Dest, bool TransposeInput, bool TransposeWeights,
+          typename Src, typename Weights, typename Bias>
+Dest fully_connected_transposed(Src input, Weights weights, Bias bias) {
+  static_assert(is_tensor_of_dim<2, Src>::value,
+                "Expected 2 dimensional input");
+  static_assert(is_tensor_of_dim<2, Dest>::value,
+                "Expected 2 dimensional output");
+  static_assert(is_tensor_of_dim<2, Weights>::value,
+                "Expected 2 dimensional weights");
+  static_assert(is_tensor_of_dim<1, Bias>::value,
+                "Expected 1 dimensional bias");
+
+  constexpr Eigen::Index N = Dest::dim(0);
+  constexpr Eigen::Index OC = Dest::dim(1);
+
+  static_assert((TransposeInput ? Src::dim(0) : Src::dim(1)) ==
+                    (TransposeWeights ? Weights::dim(0) : Weights::dim(1)),
+                "Input and weights dimensions do not match.");
+  static_assert(Bias::dim(0) == OC,
+                "Bias and output dimensions do not match.");
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  Dest output;
+  auto e_output = as_eigen(output);
+
+  // Half precision is computed in single precision.
+  auto product = as_eigen_accumulator(input).contract(
+      as_eigen_accumulator(weights),
+      Eigen::array<Eigen::IndexPair<Eigen::Index>, 1>{
+          Eigen::IndexPair<Eigen::Index>(TransposeInput ? 0 : 1,
+                                         TransposeWeights ? 0 : 1)});
+  auto e_bias = as_eigen_accumulator(bias)
+                    .reshape(Eigen::DSizes<Eigen::Index, 2>{1, OC})
+                    .broadcast(Eigen::DSizes<Eigen::Index, 2>{N, 1});
+
+  eigen::evaluate(e_output, (product + e_bias).template cast<ET_Dest>());
+
+  return output;
+}
+
+// MatMulOp
+template <typename T, size_t B, size_t M, size_t K, size_t N>
+Tensor3D<T, B, M, N> matmul(Tensor3D<T, B, M, K> a, Tensor3D<T, B, K, N> b) {
+  Tensor3D<T, B, M, N> output;
+  // Half precision is computed in single precision.
+  auto e_a = as_eigen_accumulator(a);
+  auto e_b = as_eigen_accumulator(b);
+  auto e_output = as_eigen(output);
+
+  const Eigen::array<Eigen::IndexPair<Eigen::Index>, 1> dims{
+      Eigen::IndexPair<Eigen::Index>(1, 0)};
+
+  // [M,K] x [K,N] per batch
+  for (size_t i = 0; i < B; i++) {
+    eigen::evaluate(
+        e_output.chip(i, 0),
+        e_a.chip(i, 0).contract(e_b.chip(i, 0), dims).template cast<T>());
+  }
+
+  return output;
+}
+
+// MatMulOp with transposed operands
+// If `TransposeA` is set, `a` is passed as [B,K,M]. If `TransposeB` is set, `b`
+// is passed as [B,N,K].
+template <typename Dest, bool TransposeA, bool TransposeB, typename A,
+          typename B>
+Dest matmul_transposed(A a, B b) {
+  static_assert(is_tensor_of_dim<3, A>::value, "Expected 3 dimensional a");
+  static_assert(is_tensor_of_dim<3, B>::value, "Expected 3 dimensional b");
+  static_assert(is_tensor_of_dim<3, Dest>::value,
+                "Expected 3 dimensional output");
+  static_assert((TransposeA ? A::dim(1) : A::dim(2)) ==
+                    (TransposeB ? B::dim(2) : B::dim(1)),
+                "Expected contracting dimension to match");
+
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  Dest output;
+  // Half precision is computed in single precision.
+  auto e_a = as_eigen_accumulator(a);
+  auto e_b = as_eigen_accumulator(b);
+  auto e_output = as_eigen(output);
+
+  const Eigen::array<Eigen::IndexPair<Eigen::Index>, 1> dims{
+      Eigen::IndexPair<Eigen::Index>(TransposeA ? 0 : 1, TransposeB ? 1 : 0)};
+
+  for (size_t i = 0; i < Dest::dim(0); i++) {
+    auto product = e_a.chip(i, 0).contract(e_b.chip(i, 0), dims);
+    eigen::evaluate(e_output.chip(i, 0), product.template cast<ET_Dest>());
+  }
+
+  return output;
+}
+
+namespace {
+// Common reduce function used by the specialized TOSA reduce ops below.
+// `reducer` applies an Eigen reduction over the given dimensions.
+template <typename Dest, typename Src, typename Reducer>
+inline Dest reduce(Src input, int64_t dimension, Reducer reducer) {
+  static_assert(is_tensor<Src>::value, "Expected tensor argument");
+  static_assert(is_tensor<Dest>::value, "Expected tensor result");
+  static_assert(Src::rank() == Dest::rank() + 1,
+                "source rank must equal dest rank + 1");
+  assert(dimension >= 0 && dimension < static_cast<int64_t>(Src::rank()));
+
+  // Half precision elements are reduced in single precision.
+  using ET_Dest = typename get_element_type<Dest>::type;
+
+  Dest output;
+  eigen::evaluate(as_eigen(output),
+                  reducer(as_eigen_accumulator(input),
+                          Eigen::array<Eigen::Index, 1>{dimension})
+                      .template cast<ET_Dest>());
+  return output;
+}
+} // namespace
+
+// ReduceMaxOp
+template <typename Dest, typename Src>
+inline Dest reduce_max(Src input, int64_t dimension) {
+  return eigen::reduce<Dest>(input, dimension, [](auto x, const auto &dims) {
+    return x.maximum(dims);
+  });
+}
+
+// ReduceMinOp
+template <typename Dest, typename Src>
+inline Dest reduce_min(Src input, int64_t dimension) {
+  return eigen::reduce<Dest>(input, dimension, [](auto x, const auto &dims) {
+    return x.minimum(dims);
+  });
+}
+
+// ReduceProdOp
+template <typename Dest, typename Src>
+inline Dest reduce_prod(Src input, int64_t dimension) {
+  return eigen::reduce<Dest>(
+      input, dimension, [](auto x, const auto &dims) { return x.prod(dims); });
+}
+
+// ReduceSumOp
+template <typename Dest, typename Src>
+inline Dest reduce_sum(Src input, int64_t dimension) {
+  return eigen::reduce<Dest>(
+      input, dimension, [](auto x, const auto &dims) { return x.sum(dims); });
+}
+
+} // namespace eigen
 } // namespace tosa
 } // namespace emitc
 
@@ -18,6 +18,7 @@
 #include <numeric>
 #include <vector>
 
+#include "emitc/half.h"
 #include "emitc/utility.h"
 
 namespace detail {
@@ -211,7 +212,9 @@ template <typename T, size_t Dim0, size_t Dim1, size_t Dim2, size_t Dim3>
 using Tensor4D = Tensor<T, Dim0, Dim1, Dim2, Dim3>;
 
 template <typename T>
-using is_scalar = std::is_arithmetic<T>;
+using is_scalar =
+    std::integral_constant<bool, std::is_arithmetic<T>::value ||
+                                     emitc::is_half_precision<T>::value>;
 
 template <typename T, typename Unused = void>
 struct is_tensor : std::false_type {};
@@ -228,7 +231,8 @@ struct is_tensor_of_dim<Dim, Tensor<T, Shape...>> {
 };
 
 template <typename T>
-using IsScalar = typename std::enable_if_t<std::is_scalar<T>::value, bool>;
+using IsScalar = typename std::enable_if_t<
+    std::is_scalar<T>::value || emitc::is_half_precision<T>::value, bool>;
 
 template <typename T>
 using IsTensor = typename std::enable_if_t<is_tensor<T>::value, bool>;
@@ -261,6 +265,47 @@ struct replace_element_type<Dest, Tensor<Src, Shape...>> {
   using type = Tensor<Dest, Shape...>;
 };
 
+template <typename T>
+struct is_half_precision_tensor
+    : emitc::is_half_precision<typename get_element_type<T>::type> {};
+
+// Tensor type in which kernels accumulate tensors of type `T`.
+template <typename T>
+using accumulator_tensor_t = typename replace_element_type<
+    emitc::accumulator_type_t<typename get_element_type<T>::type>, T>::type;
+
+// Converts the elements of the tensor `x` to the element type of `Dest`.
+template <typename Dest, typename Src>
+inline Dest convert_elements(Src x) {
+  static_assert(Dest::size() == Src::size(), "Expected the same size");
+  Dest z;
+  emitc::convert_n(x.get(), z.get(), Src::size());
+  return z;
+}
+
+// Widens the scalar `x` to its accumulator type.
+template <typename Src, IsScalar<Src> = true>
+inline emitc::accumulator_type_t<Src> widen(Src x) {
+  return static_cast<emitc::accumulator_type_t<Src>>(x);
+}
+
+// Widens the elements of the tensor `x` to their accumulator type.
+template <typename Src, IsTensor<Src> = true>
+inline accumulator_tensor_t<Src> widen(Src x) {
+  return convert_elements<accumulator_tensor_t<Src>>(x);
+}
+
+// Narrows the accumulator tensor `x` to `Dest`, which is a no-op unless
+// `Dest` has half precision elements.
+template <typename Dest, typename Src>
+inline Dest narrow(Src x) {
+  if constexpr (std::is_same<Dest, Src>::value) {
+    return x;
+  } else {
+    return convert_elements<Dest>(x);
+  }
+}
+
 template <typename Dest, typename Src>
 using UnaryFuncType = Dest (*)(Src);
 
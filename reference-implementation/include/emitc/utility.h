@@ -12,6 +12,7 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <utility>
 
 namespace emitc {
 namespace utility {
@@ -84,6 +85,14 @@ constexpr std::array<size_t, sizeof...(Shape)> unravel_index(size_t index) {
   return result;
 }
 
+// Converts a sequence of attribute values passed as template argument to an
+// array, e.g. `std::integer_sequence<int64_t, 1, 2>` to `{1, 2}`.
+template <typename T, T... Values>
+constexpr std::array<T, sizeof...(Values)>
+to_array(std::integer_sequence<T, Values...>) {
+  return {Values...};
+}
+
 } // namespace utility
 } // namespace emitc
 
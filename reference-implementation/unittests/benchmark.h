@@ -0,0 +1,32 @@
+// Copyright Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// This file defines helpers for the benchmarks in the unit tests. Benchmarks
+// are disabled by default, run them with --gtest_also_run_disabled_tests.
+
+#ifndef EMITC_UNITTESTS_BENCHMARK_H
+#define EMITC_UNITTESTS_BENCHMARK_H
+
+#include <chrono>
+#include <iostream>
+
+// Returns the average runtime of `f` in milliseconds.
+template <typename F>
+double benchmark(F f, int repetitions = 5) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; i++) {
+    f();
+  }
+  std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count() / repetitions;
+}
+
+// Returns the stream to report benchmark results to, in the format of the
+// test output.
+inline std::ostream &report_speed() { return std::cout << "[   SPEED  ] "; }
+
+#endif // EMITC_UNITTESTS_BENCHMARK_H
@@ -0,0 +1,213 @@
+// Copyright Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "gmock/gmock.h"
+
+#include "emitc/stablehlo.h"
+#include "emitc/tosa.h"
+#include "emitc/types.h"
+
+namespace {
+
+using namespace emitc;
+using ::testing::Eq;
+using ::testing::FloatNear;
+using ::testing::Pointwise;
+
+const float EPSILON = 5e-4;
+
+template <typename T>
+void fill(T &tensor) {
+  for (size_t i = 0; i < tensor.size(); i++) {
+    tensor[i] = static_cast<float>(i % 7) - 3;
+  }
+}
+
+// Single row products are computed as matrix-vector products.
+TEST(blas, dot_transposed_row) {
+  using ResultType = Tensor2D<float, 1, 3>;
+  Tensor2D<float, 1, 2> a{1, 2};
+  Tensor2D<float, 2, 1> a_t{1, 2};
+  Tensor2D<float, 2, 3> b{3, 4, 5, 6, 7, 8};
+  Tensor2D<float, 3, 2> b_t{3, 6, 4, 7, 5, 8};
+  ResultType expected_result{15, 18, 21};
+
+  ResultType nn = stablehlo::dot_transposed<ResultType, false, false>(a, b);
+  ResultType nt = stablehlo::dot_transposed<ResultType, false, true>(a, b_t);
+  ResultType tn = stablehlo::dot_transposed<ResultType, true, false>(a_t, b);
+  ResultType tt = stablehlo::dot_transposed<ResultType, true, true>(a_t, b_t);
+
+  EXPECT_THAT(nn, Pointwise(FloatNear(EPSILON), expected_result));
+  EXPECT_THAT(nt, Pointwise(FloatNear(EPSILON), expected_result));
+  EXPECT_THAT(tn, Pointwise(FloatNear(EPSILON), expected_result));
+  EXPECT_THAT(tt, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(blas, batch_matmul_transposed) {
+  using ResultType = Tensor3D<float, 2, 2, 2>;
+  Tensor3D<float, 2, 3, 2> a_t{1, 4, 2, 5, 3, 6, 1, 0, 0, 1, 1, 1};
+  Tensor3D<float, 2, 2, 3> b_t{7, 9, 11, 8, 10, 12, 1, 2, 3, 4, 5, 6};
+  ResultType expected_result{58, 64, 139, 154, 4, 10, 5, 11};
+
+  ResultType result =
+      tosa::matmul_transposed<ResultType, true, true>(a_t, b_t);
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+// Integer products fall back to the naive kernels.
+TEST(blas, dot_int) {
+  Tensor2D<int32_t, 2, 2> a{1, 2, 3, 4};
+  Tensor2D<int32_t, 2, 2> b{5, 6, 7, 8};
+  Tensor2D<int32_t, 2, 2> expected_result{19, 22, 43, 50};
+
+  Tensor2D<int32_t, 2, 2> result =
+      stablehlo::dot<Tensor2D<int32_t, 2, 2>>(a, b);
+  EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+}
+
+TEST(blas, fully_connected_row) {
+  Tensor2D<float, 1, 3> input{1, 2, 3};
+  Tensor2D<float, 2, 3> weights{1, 0, -1, 2, 1, 0};
+  Tensor1D<float, 2> bias{10, 20};
+  Tensor2D<float, 1, 2> expected_result{8, 24};
+
+  Tensor2D<float, 1, 2> result =
+      tosa::fully_connected<Tensor2D<float, 1, 2>>(input, weights, bias);
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+// 1x1 convolutions multiply the input without lowering it to patches.
+TEST(blas, conv2d_1x1) {
+  using InputType = Tensor4D<float, 2, 3, 3, 4>;
+  using WeightType = Tensor4D<float, 5, 1, 1, 4>;
+  using ResultType = Tensor4D<float, 2, 3, 3, 5>;
+  InputType input;
+  WeightType weights;
+  fill(input);
+  fill(weights);
+
+  ResultType expected_result;
+  for (size_t i = 0; i < expected_result.size(); i++) {
+    size_t pixel = i / 5;
+    size_t c_out = i % 5;
+    for (size_t c_in = 0; c_in < 4; c_in++) {
+      expected_result[i] +=
+          input[pixel * 4 + c_in] * weights[c_out * 4 + c_in];
+    }
+  }
+
+  Tensor1D<int64_t, 4> padding{0, 0, 0, 0};
+  Tensor1D<int64_t, 2> stride{1, 1};
+  Tensor1D<int64_t, 2> dilation{1, 1};
+  ResultType result =
+      tosa::conv2d<ResultType>(input, weights, padding, stride, dilation);
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(blas, conv2d_padded) {
+  using InputType = Tensor4D<float, 1, 3, 3, 1>;
+  using WeightType = Tensor4D<float, 2, 2, 2, 1>;
+  using ResultType = Tensor4D<float, 1, 2, 2, 2>;
+  InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  WeightType weights{1, 1, 1, 1, 0, 1, -1, 0};
+  ResultType expected_result{1, 0, 5, -2, 11, 4, 28, -2};
+
+  Tensor1D<int64_t, 4> padding{1, 1, 1, 1};
+  Tensor1D<int64_t, 2> stride{2, 2};
+  Tensor1D<int64_t, 2> dilation{1, 1};
+  ResultType result =
+      tosa::conv2d<ResultType>(input, weights, padding, stride, dilation);
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+// Operands with evenly spaced rows and columns are multiplied with one GEMM
+// per batch, others fall back to the naive kernel.
+TEST(blas, dot_general) {
+  { // Attention scores: [B,N,S,D] x [B,N,T,D] -> [B,N,S,T]
+    Tensor4D<float, 2, 3, 4, 8> query;
+    Tensor4D<float, 2, 3, 5, 8> key;
+    fill(query);
+    fill(key);
+    Tensor1D<int64_t, 2> batching{0, 1};
+    Tensor1D<int64_t, 1> contracting{3};
+
+    using ResultType = Tensor4D<float, 2, 3, 4, 5>;
+    ResultType expected_result = stablehlo::naive::dot_general<ResultType>(
+        query, key, batching, batching, contracting, contracting);
+    ResultType result = stablehlo::dot_general<ResultType>(
+        query, key, batching, batching, contracting, contracting);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+  { // Attention context: [B,N,S,T] x [B,N,T,D] -> [B,N,S,D]
+    Tensor4D<float, 2, 3, 4, 5> probs;
+    Tensor4D<float, 2, 3, 5, 8> value;
+    fill(probs);
+    fill(value);
+    Tensor1D<int64_t, 2> batching{0, 1};
+    Tensor1D<int64_t, 1> lhs_contracting{3};
+    Tensor1D<int64_t, 1> rhs_contracting{2};
+
+    using ResultType = Tensor4D<float, 2, 3, 4, 8>;
+    ResultType expected_result = stablehlo::naive::dot_general<ResultType>(
+        probs, value, batching, batching, lhs_contracting, rhs_contracting);
+    ResultType result = stablehlo::dot_general<ResultType>(
+        probs, value, batching, batching, lhs_contracting, rhs_contracting);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+  { // Transposed lhs with batching dimension in the middle:
+    // [D,B,S] x [B,D,T] -> [B,S,T]
+    Tensor3D<float, 6, 2, 4> lhs;
+    Tensor3D<float, 2, 6, 3> rhs;
+    fill(lhs);
+    fill(rhs);
+    Tensor1D<int64_t, 1> lhs_batching{1};
+    Tensor1D<int64_t, 1> rhs_batching{0};
+    Tensor1D<int64_t, 1> lhs_contracting{0};
+    Tensor1D<int64_t, 1> rhs_contracting{1};
+
+    using ResultType = Tensor3D<float, 2, 4, 3>;
+    ResultType expected_result = stablehlo::naive::dot_general<ResultType>(
+        lhs, rhs, lhs_batching, rhs_batching, lhs_contracting,
+        rhs_contracting);
+    ResultType result = stablehlo::dot_general<ResultType>(
+        lhs, rhs, lhs_batching, rhs_batching, lhs_contracting,
+        rhs_contracting);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+  { // Free dimensions around the contracting dimension:
+    // [2,3,4] x [3,5] -> [2,4,5]
+    Tensor3D<float, 2, 3, 4> lhs;
+    Tensor2D<float, 3, 5> rhs;
+    fill(lhs);
+    fill(rhs);
+    Tensor1D<int64_t, 0> no_dims;
+    Tensor1D<int64_t, 1> lhs_contracting{1};
+    Tensor1D<int64_t, 1> rhs_contracting{0};
+
+    using ResultType = Tensor3D<float, 2, 4, 5>;
+    ResultType expected_result = stablehlo::naive::dot_general<ResultType>(
+        lhs, rhs, no_dims, no_dims, lhs_contracting, rhs_contracting);
+    ResultType result = stablehlo::dot_general<ResultType>(
+        lhs, rhs, no_dims, no_dims, lhs_contracting, rhs_contracting);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+}
+
+#ifdef EMITC_USE_BLAS
+// The naive kernels remain available next to the CBLAS kernels.
+TEST(blas, mixed_backends) {
+  Tensor3D<float, 2, 3, 4> a;
+  Tensor3D<float, 2, 4, 5> b;
+  fill(a);
+  fill(b);
+
+  Tensor3D<float, 2, 3, 5> naive_result = tosa::naive::matmul(a, b);
+  Tensor3D<float, 2, 3, 5> blas_result = tosa::blas::matmul(a, b);
+  EXPECT_THAT(blas_result, Pointwise(FloatNear(EPSILON), naive_result));
+}
+#endif
+
+} // namespace
@@ -0,0 +1,189 @@
+// Copyright Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "emitc/half.h"
+#include "emitc/types.h"
+
+namespace {
+
+using namespace emitc;
+using ::testing::Eq;
+using ::testing::Pointwise;
+
+TEST(half, half_from_float) {
+  EXPECT_EQ(0x0000, half(0.0f).to_bits());
+  EXPECT_EQ(0x8000, half(-0.0f).to_bits());
+  EXPECT_EQ(0x3c00, half(1.0f).to_bits());
+  EXPECT_EQ(0xc000, half(-2.0f).to_bits());
+  EXPECT_EQ(0x7bff, half(65504.0f).to_bits());
+  EXPECT_EQ(0x7c00, half(65520.0f).to_bits());
+  EXPECT_EQ(0xfc00, half(-INFINITY).to_bits());
+  EXPECT_EQ(0x0001, half(std::ldexp(1.0f, -24)).to_bits());
+  EXPECT_EQ(0x0000, half(std::ldexp(1.0f, -25)).to_bits());
+  EXPECT_EQ(0x0400, half(std::ldexp(1.0f, -14)).to_bits());
+
+  // Ties round to even.
+  EXPECT_EQ(0x3c00, half(1.0f + std::ldexp(1.0f, -11)).to_bits());
+  EXPECT_EQ(0x3c02, half(1.0f + 3 * std::ldexp(1.0f, -11)).to_bits());
+
+  EXPECT_TRUE(std::isnan(half(NAN)));
+  EXPECT_EQ(0x7e00, half(NAN).to_bits() & 0x7e00);
+}
+
+TEST(half, half_to_float) {
+  for (uint32_t bits = 0; bits <= 0xffff; bits++) {
+    half h = half::from_bits(bits);
+    float f = h;
+    if ((bits & 0x7fff) > 0x7c00) {
+      EXPECT_TRUE(std::isnan(f));
+      continue;
+    }
+    EXPECT_EQ(bits, half(f).to_bits());
+  }
+  EXPECT_EQ(std::ldexp(1.0f, -24), float(half::from_bits(0x0001)));
+  EXPECT_EQ(65504.0f, float(half::from_bits(0x7bff)));
+  EXPECT_EQ(INFINITY, float(half::from_bits(0x7c00)));
+}
+
+TEST(half, bfloat16_from_float) {
+  EXPECT_EQ(0x0000, bfloat16(0.0f).to_bits());
+  EXPECT_EQ(0x3f80, bfloat16(1.0f).to_bits());
+  EXPECT_EQ(0xc000, bfloat16(-2.0f).to_bits());
+  EXPECT_EQ(0x7f80, bfloat16(INFINITY).to_bits());
+  EXPECT_EQ(0x7f80, bfloat16(std::numeric_limits<float>::max()).to_bits());
+  EXPECT_EQ(0x0001, bfloat16(std::ldexp(1.0f, -133)).to_bits());
+
+  // Ties round to even.
+  EXPECT_EQ(0x3f80, bfloat16(1.0f + std::ldexp(1.0f, -8)).to_bits());
+  EXPECT_EQ(0x3f82, bfloat16(1.0f + 3 * std::ldexp(1.0f, -8)).to_bits());
+
+  EXPECT_TRUE(std::isnan(bfloat16(NAN)));
+  EXPECT_TRUE(std::isnan(bfloat16(-NAN)));
+}
+
+TEST(half, bfloat16_to_float) {
+  for (uint32_t bits = 0; bits <= 0xffff; bits++) {
+    bfloat16 b = bfloat16::from_bits(bits);
+    float f = b;
+    if ((bits & 0x7fff) > 0x7f80) {
+      EXPECT_TRUE(std::isnan(f));
+      continue;
+    }
+    EXPECT_EQ(bits, bfloat16(f).to_bits());
+  }
+}
+
+template <typename T>
+void test_convert_n() {
+  // Covers the vectorized loops and their scalar remainder.
+  const size_t n = 1003;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<uint32_t> distribution;
+  std::vector<float> src(n);
+  for (size_t i = 0; i < n; i++) {
+    uint32_t bits = distribution(generator);
+    // Keep most values in the range of half, including subnormals.
+    if (i % 4 != 0) {
+      bits = (bits & 0x87ffffff) | 0x30000000;
+    }
+    std::memcpy(&src[i], &bits, sizeof(bits));
+  }
+  src[1] = NAN;
+  src[2] = -INFINITY;
+  src[3] = std::ldexp(1.0f, -20);
+
+  std::vector<T> narrow(n);
+  convert_n(src.data(), narrow.data(), n);
+  for (size_t i = 0; i < n; i++) {
+    if (std::isnan(src[i])) {
+      EXPECT_TRUE(std::isnan(narrow[i]));
+    } else {
+      EXPECT_EQ(T(src[i]).to_bits(), narrow[i].to_bits()) << src[i];
+    }
+  }
+
+  std::vector<float> wide(n);
+  convert_n(narrow.data(), wide.data(), n);
+  for (size_t i = 0; i < n; i++) {
+    if (std::isnan(src[i])) {
+      EXPECT_TRUE(std::isnan(wide[i]));
+    } else {
+      EXPECT_EQ(float(narrow[i]), wide[i]);
+    }
+  }
+}
+
+TEST(half, convert_n) {
+  test_convert_n<half>();
+  test_convert_n<bfloat16>();
+
+  int32_t ints[3] = {-2, 0, 7};
+  half halfs[3];
+  convert_n(ints, halfs, 3);
+  EXPECT_EQ(-2.0f, halfs[0]);
+  EXPECT_EQ(0.0f, halfs[1]);
+  EXPECT_EQ(7.0f, halfs[2]);
+}
+
+TEST(half, numeric_limits) {
+  EXPECT_EQ(65504.0f, float(std::numeric_limits<half>::max()));
+  EXPECT_EQ(-65504.0f, float(std::numeric_limits<half>::lowest()));
+  EXPECT_EQ(std::ldexp(1.0f, -14), float(std::numeric_limits<half>::min()));
+  EXPECT_EQ(std::ldexp(1.0f, -10),
+            float(std::numeric_limits<half>::epsilon()));
+  EXPECT_EQ(INFINITY, float(std::numeric_limits<half>::infinity()));
+  EXPECT_TRUE(std::isnan(std::numeric_limits<half>::quiet_NaN()));
+
+  EXPECT_EQ(std::numeric_limits<float>::min(),
+            float(std::numeric_limits<bfloat16>::min()));
+  EXPECT_EQ(std::ldexp(1.0f, -7),
+            float(std::numeric_limits<bfloat16>::epsilon()));
+  EXPECT_EQ(-float(std::numeric_limits<bfloat16>::max()),
+            float(std::numeric_limits<bfloat16>::lowest()));
+  EXPECT_TRUE(std::isnan(std::numeric_limits<bfloat16>::quiet_NaN()));
+}
+
+TEST(half, arithmetic) {
+  half a = 1.5f;
+  half b = -2.0f;
+  EXPECT_EQ(-0.5f, a + b);
+  EXPECT_EQ(-3.0f, a * b);
+  EXPECT_TRUE(b < a);
+
+  a += 1.0f;
+  EXPECT_EQ(2.5f, a);
+  a *= b;
+  EXPECT_EQ(-5.0f, a);
+
+  bfloat16 c = float(a);
+  EXPECT_EQ(-5.0f, c);
+  EXPECT_EQ(0.0f, half());
+}
+
+TEST(half, tensor) {
+  static_assert(is_scalar<half>::value, "");
+  static_assert(is_half_precision_tensor<Tensor1D<bfloat16, 2>>::value, "");
+  static_assert(!is_half_precision_tensor<Tensor1D<float, 2>>::value, "");
+  static_assert(std::is_same<accumulator_tensor_t<Tensor1D<half, 2>>,
+                             Tensor1D<float, 2>>::value,
+                "");
+  static_assert(std::is_same<accumulator_tensor_t<Tensor1D<int8_t, 2>>,
+                             Tensor1D<int8_t, 2>>::value,
+                "");
+
+  Tensor1D<half, 3> t{0.5f, -1, 2};
+  EXPECT_THAT(widen(t), Pointwise(Eq(), {0.5f, -1.0f, 2.0f}));
+  auto b = convert_elements<Tensor1D<bfloat16, 3>>(widen(t));
+  EXPECT_THAT(widen(b), Pointwise(Eq(), {0.5f, -1.0f, 2.0f}));
+}
+
+} // namespace
@@ -14,6 +14,8 @@
 namespace {
 
 using namespace emitc;
+// OpenBLAS declares a global bfloat16 type.
+using emitc::bfloat16;
 using ::testing::DoubleEq;
 using ::testing::DoubleNear;
 using ::testing::Eq;
@@ -153,6 +155,21 @@ TEST(stablehlo, convert) {
 
     EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
   }
+  {
+    Tensor1D<float, 3> x{0.5f, -3.0f, 65536.0f};
+    auto x_half = stablehlo::convert<Tensor1D<half, 3>>(x);
+    auto x_bf16 = stablehlo::convert<Tensor1D<bfloat16, 3>>(x);
+    auto half_to_bf16 = stablehlo::convert<Tensor1D<bfloat16, 3>>(x_half);
+    auto result = stablehlo::convert<Tensor1D<int32_t, 3>>(x_bf16);
+    auto result_bool = stablehlo::convert<Tensor1D<bool, 3>>(x_half);
+    auto half_to_float = stablehlo::convert<Tensor1D<float, 3>>(x_half);
+
+    EXPECT_THAT(half_to_float, Pointwise(FloatEq(), {0.5f, -3.0f, INFINITY}));
+    EXPECT_THAT(widen(half_to_bf16),
+                Pointwise(FloatEq(), {0.5f, -3.0f, INFINITY}));
+    EXPECT_THAT(result, Pointwise(Eq(), {0, -3, 65536}));
+    EXPECT_THAT(result_bool, Pointwise(Eq(), {true, true, true}));
+  }
 }
 
 TEST(stablehlo, cos) {
@@ -239,6 +256,13 @@ TEST(stablehlo, exponential) {
 
     EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
   }
+  {
+    Tensor1D<half, 2> x{0.0f, 1.0f};
+    Tensor1D<float, 2> expected_result{1.0f, 2.71875f};
+    Tensor1D<half, 2> result = stablehlo::exponential(x);
+
+    EXPECT_THAT(widen(result), Pointwise(FloatEq(), expected_result));
+  }
 }
 
 TEST(stablehlo, exponential_minus_one) {
@@ -545,6 +569,23 @@ TEST(stablehlo, round) {
   }
 }
 
+TEST(stablehlo, rsqrt) {
+  {
+    Tensor0D<float> x{4.0f};
+    Tensor0D<float> expected_result{0.5f};
+    Tensor0D<float> result = stablehlo::rsqrt(x);
+
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    Tensor2D<double, 2, 2> x{2.0, 3.0, 10.0, 1.0};
+    Tensor2D<double, 2, 2> expected_result{0.707106, 0.577350, 0.316227, 1.0};
+    Tensor2D<double, 2, 2> result = stablehlo::rsqrt(x);
+
+    EXPECT_THAT(result, Pointwise(DoubleNear(EPSILON), expected_result));
+  }
+}
+
 TEST(stablehlo, sin) {
   EXPECT_NEAR(0.0f, stablehlo::sin(0.0f), EPSILON);
 
@@ -1234,6 +1275,14 @@ TEST(stablehlo, slice) {
                                        Tensor4D<float, 4, 3, 1, 2>>(
       s4, {0, 2, 0, 0}, {4, 3, 1, 1}, {2, 1, 1, 1});
   EXPECT_THAT(t4_strided_2, Pointwise(FloatEq(), {4.0f, 16.0f}));
+
+  // Indices passed as template arguments
+  auto t2_template =
+      stablehlo::slice<Tensor2D<float, 2, 2>,
+                       std::integer_sequence<int64_t, 1, 0>,
+                       std::integer_sequence<int64_t, 4, 3>,
+                       std::integer_sequence<int64_t, 2, 2>>(s2);
+  EXPECT_THAT(t2_template, Pointwise(FloatEq(), {3.0f, 5.0f, 9.0f, 11.0f}));
 }
 
 TEST(stablehlo, dynamic_slice) {
@@ -1403,6 +1452,14 @@ TEST(stablehlo, broadcast_in_dim) {
                          1.5, 1.6, 2.1, 2.2, 2.3, 2.4, 2.5, 2.6};
     EXPECT_THAT(result, Pointwise(Eq(), expected_result));
   }
+  { // 2D -> 3D + transpose, dimensions passed as template argument
+    using Dest = Tensor3D<float, 1, 3, 2>;
+    Dest result =
+        stablehlo::broadcast_in_dim<Dest, std::integer_sequence<int64_t, 2, 1>>(
+            t3);
+    Dest expected_result{1.1, 1.1, 1.2, 1.2, 1.3, 1.3};
+    EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+  }
 }
 
 TEST(stablehlo, clamp) {
@@ -1727,12 +1784,137 @@ TEST(stablehlo, convolution_depthwise) {
   EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
 }
 
-TEST(stablehlo, DISABLED_convolution_grouped) {
-  // TODO implement test
+TEST(stablehlo, convolution_grouped) {
+  using InputType = Tensor4D<float, 1, 3, 3, 4>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 2, 4>; // KH KW CIN/G COUT
+  using ResultType = Tensor4D<float, 1, 2, 2, 4>; // N H W C
+  InputType input;
+  WeightType weights;
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = i + 1;
+  }
+  for (size_t i = 0; i < weights.size(); i++) {
+    weights[i] = static_cast<float>(i % 5) - 2;
+  }
+  ResultType expected_result{18, -1,  -46, 6, 22, -5,  -58, 6,
+                             30, -13, -82, 6, 34, -17, -94, 6};
+
+  ResultType result = stablehlo::convolution<ResultType, InputType, WeightType>(
+      input, weights, /*batch_group_count=*/1, 0, 3, {1, 2}, 2, 3, {0, 1}, 0, 3,
+      {1, 2}, /*feature_group_count=*/2, {0, 0, 0, 0}, {1, 1}, {1, 1},
+      {1, 1});
+
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(stablehlo, convolution_dilated) {
+  using InputType = Tensor4D<float, 1, 4, 4, 1>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 1, 1>; // KH KW CIN COUT
+  {
+    // Kernel (rhs) dilation
+    using ResultType = Tensor4D<float, 1, 2, 2, 1>; // N H W C
+    InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    WeightType weights{1, 2, 3, 4};
+    ResultType expected_result{78, 88, 118, 128};
+
+    ResultType result =
+        stablehlo::convolution<ResultType, InputType, WeightType>(
+            input, weights, 1, 0, 3, {1, 2}, 2, 3, {0, 1}, 0, 3, {1, 2}, 1,
+            {0, 0, 0, 0}, /*lhs_dilation=*/{1, 1}, /*rhs_dilation=*/{2, 2},
+            {1, 1});
+
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+  {
+    // Input (lhs) dilation, i.e. a transposed convolution
+    using InputType = Tensor4D<float, 1, 2, 2, 1>;  // N H W C
+    using ResultType = Tensor4D<float, 1, 4, 4, 1>; // N H W C
+    InputType input{1, 2, 3, 4};
+    WeightType weights{1, 2, 3, 4};
+    // clang-format off
+    ResultType expected_result{4,  3, 8,  6,
+                               2,  1, 4,  2,
+                               12, 9, 16, 12,
+                               6,  3, 8,  4};
+    // clang-format on
+
+    ResultType result =
+        stablehlo::convolution<ResultType, InputType, WeightType>(
+            input, weights, 1, 0, 3, {1, 2}, 2, 3, {0, 1}, 0, 3, {1, 2}, 1,
+            {1, 1, 1, 1}, /*lhs_dilation=*/{2, 2}, /*rhs_dilation=*/{1, 1},
+            {1, 1});
+
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+}
+
+TEST(stablehlo, convolution_nchw) {
+  using InputType = Tensor4D<float, 1, 2, 3, 3>;  // N C H W
+  using WeightType = Tensor4D<float, 2, 2, 2, 2>; // COUT CIN KH KW
+  using ResultType = Tensor4D<float, 1, 2, 2, 2>; // N C H W
+  InputType input;
+  WeightType weights;
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = i + 1;
+  }
+  for (size_t i = 0; i < weights.size(); i++) {
+    weights[i] = static_cast<float>(i % 5) - 2;
+  }
+  ResultType expected_result{-14, -17, -23, -26, 1, 2, 4, 5};
+
+  ResultType result = stablehlo::convolution<ResultType, InputType, WeightType>(
+      input, weights, 1, /*input_batch_dimension=*/0,
+      /*input_feature_dimension=*/1, {2, 3},
+      /*kernel_input_feature_dimension=*/1,
+      /*kernel_output_feature_dimension=*/0, {2, 3},
+      /*output_batch_dimension=*/0, /*output_feature_dimension=*/1, {2, 3}, 1,
+      {0, 0, 0, 0}, {1, 1}, {1, 1}, {1, 1});
+
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
 }
 
-TEST(stablehlo, DISABLED_convolution_dilated) {
-  // TODO implement test
+TEST(stablehlo, convolution_batch_grouped) {
+  using InputType = Tensor4D<float, 2, 2, 2, 2>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 2, 2>; // KH KW CIN COUT
+  using ResultType = Tensor4D<float, 1, 1, 1, 2>; // N/G H W C
+  InputType input;
+  WeightType weights;
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = i + 1;
+  }
+  for (size_t i = 0; i < weights.size(); i++) {
+    weights[i] = static_cast<float>(i % 5) - 2;
+  }
+  ResultType expected_result{9, -26};
+
+  ResultType result = stablehlo::convolution<ResultType, InputType, WeightType>(
+      input, weights, /*batch_group_count=*/2, 0, 3, {1, 2}, 2, 3, {0, 1}, 0, 3,
+      {1, 2}, 1, {0, 0, 0, 0}, {1, 1}, {1, 1}, {1, 1});
+
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(stablehlo, convolution_half) {
+  // 1x1 convolution accumulating 4096 input channels.
+  constexpr size_t C = 4096;
+  using InputType = Tensor4D<half, 1, 1, 2, C>;  // N H W C
+  using WeightType = Tensor4D<half, 1, 1, C, 1>; // KH KW CIN COUT
+  using ResultType = Tensor4D<half, 1, 1, 2, 1>; // N H W C
+  InputType input;
+  WeightType weights;
+  std::fill(input.begin(), input.end(), half(1.0f));
+  std::fill(weights.begin(), weights.end(), half(1.0f));
+
+  Tensor1D<int64_t, 2> spatial_dimensions{1, 2};
+  Tensor1D<int64_t, 2> kernel_spatial_dimensions{0, 1};
+  Tensor2D<int64_t, 2, 2> padding{0, 0, 0, 0};
+  Tensor1D<int64_t, 2> ones{1, 1};
+  ResultType result = stablehlo::convolution<ResultType, InputType, WeightType>(
+      input, weights, 1, 0, 3, spatial_dimensions, 2, 3,
+      kernel_spatial_dimensions, 0, 3, spatial_dimensions, 1, padding, ones,
+      ones, ones);
+
+  EXPECT_THAT(widen(result), Pointwise(FloatEq(), {4096.0f, 4096.0f}));
 }
 
 TEST(stablehlo, dot) {
@@ -1746,6 +1928,102 @@ TEST(stablehlo, dot) {
   EXPECT_THAT(lambda_2d(), Pointwise(Eq(), {4, 1, 2, 2}));
 }
 
+TEST(stablehlo, dot_transposed) {
+  using ResultType = Tensor2D<int, 2, 2>;
+  Tensor2D<int, 2, 3> a{1, 2, 3, 4, 5, 6};
+  Tensor2D<int, 3, 2> a_t{1, 4, 2, 5, 3, 6};
+  Tensor2D<int, 3, 2> b{7, 8, 9, 10, 11, 12};
+  Tensor2D<int, 2, 3> b_t{7, 9, 11, 8, 10, 12};
+  ResultType expected_result{58, 64, 139, 154};
+
+  ResultType nn = stablehlo::dot_transposed<ResultType, false, false>(a, b);
+  ResultType nt = stablehlo::dot_transposed<ResultType, false, true>(a, b_t);
+  ResultType tn = stablehlo::dot_transposed<ResultType, true, false>(a_t, b);
+  ResultType tt = stablehlo::dot_transposed<ResultType, true, true>(a_t, b_t);
+
+  EXPECT_THAT(nn, Pointwise(Eq(), expected_result));
+  EXPECT_THAT(nt, Pointwise(Eq(), expected_result));
+  EXPECT_THAT(tn, Pointwise(Eq(), expected_result));
+  EXPECT_THAT(tt, Pointwise(Eq(), expected_result));
+}
+
+TEST(stablehlo, dot_general) {
+  Tensor1D<int64_t, 0> no_dims;
+
+  { // Dense layer: [B,S,H] x [H,F] -> [B,S,F]
+    Tensor3D<int, 1, 2, 3> lhs{1, 2, 3, 4, 5, 6};
+    Tensor2D<int, 3, 2> rhs{1, 0, 0, 1, 1, 1};
+    Tensor1D<int64_t, 1> lhs_contracting{2};
+    Tensor1D<int64_t, 1> rhs_contracting{0};
+    auto result = stablehlo::dot_general<Tensor3D<int, 1, 2, 2>>(
+        lhs, rhs, no_dims, no_dims, lhs_contracting, rhs_contracting);
+    EXPECT_THAT(result, Pointwise(Eq(), {4, 5, 10, 11}));
+  }
+  { // Attention scores: [B,N,S,D] x [B,N,T,D] -> [B,N,S,T]
+    Tensor4D<int, 1, 2, 2, 2> query{1, 2, 3, 4, 5, 6, 7, 8};
+    Tensor4D<int, 1, 2, 2, 2> key{1, 0, 0, 1, 1, 1, 2, 0};
+    Tensor1D<int64_t, 2> batching{0, 1};
+    Tensor1D<int64_t, 1> contracting{3};
+    auto result = stablehlo::dot_general<Tensor4D<int, 1, 2, 2, 2>>(
+        query, key, batching, batching, contracting, contracting);
+    EXPECT_THAT(result, Pointwise(Eq(), {1, 2, 3, 4, 11, 10, 15, 14}));
+  }
+  { // Attention context: [B,N,S,T] x [B,N,T,D] -> [B,N,S,D]
+    Tensor4D<int, 1, 2, 2, 2> probs{1, 0, 0, 1, 1, 1, 2, 0};
+    Tensor4D<int, 1, 2, 2, 2> value{1, 2, 3, 4, 5, 6, 7, 8};
+    Tensor1D<int64_t, 2> batching{0, 1};
+    Tensor1D<int64_t, 1> lhs_contracting{3};
+    Tensor1D<int64_t, 1> rhs_contracting{2};
+    auto result = stablehlo::dot_general<Tensor4D<int, 1, 2, 2, 2>>(
+        probs, value, batching, batching, lhs_contracting, rhs_contracting);
+    EXPECT_THAT(result, Pointwise(Eq(), {1, 2, 3, 4, 12, 14, 10, 12}));
+  }
+  { // Batching dimensions in the middle: [D,B,S] x [T,B,D] -> [B,S,T]
+    Tensor3D<int, 2, 2, 2> lhs{1, 2, 3, 4, 5, 6, 7, 8};
+    Tensor3D<int, 2, 2, 2> rhs{1, 0, 0, 1, 1, 1, 2, 0};
+    Tensor1D<int64_t, 1> batching{1};
+    Tensor1D<int64_t, 1> lhs_contracting{0};
+    Tensor1D<int64_t, 1> rhs_contracting{2};
+    auto result = stablehlo::dot_general<Tensor3D<int, 2, 2, 2>>(
+        lhs, rhs, batching, batching, lhs_contracting, rhs_contracting);
+    EXPECT_THAT(result, Pointwise(Eq(), {1, 6, 2, 8, 7, 6, 8, 8}));
+  }
+  { // Several contracting dimensions: [2,3] x [2,3] -> []
+    Tensor2D<int, 2, 3> lhs{1, 2, 3, 4, 5, 6};
+    Tensor2D<int, 2, 3> rhs{1, 1, 1, 1, 1, 1};
+    Tensor1D<int64_t, 2> contracting{0, 1};
+    auto result = stablehlo::dot_general<Tensor0D<int>>(
+        lhs, rhs, no_dims, no_dims, contracting, contracting);
+    EXPECT_THAT(result, Pointwise(Eq(), {21}));
+  }
+}
+
+TEST(stablehlo, dot_half) {
+  // Accumulating 4096 ones in half precision would stall at 2048 and in
+  // bfloat16 at 256.
+  constexpr size_t K = 4096;
+  Tensor2D<half, 1, K> a;
+  Tensor2D<half, K, 2> b;
+  std::fill(a.begin(), a.end(), half(1.0f));
+  std::fill(b.begin(), b.end(), half(1.0f));
+
+  auto result = stablehlo::dot<Tensor2D<half, 1, 2>>(a, b);
+  EXPECT_THAT(widen(result), Pointwise(FloatEq(), {4096.0f, 4096.0f}));
+
+  auto result_t =
+      stablehlo::dot_transposed<Tensor2D<half, 2, 1>, true, true>(b, a);
+  EXPECT_THAT(widen(result_t), Pointwise(FloatEq(), {4096.0f, 4096.0f}));
+
+  Tensor1D<int64_t, 0> no_dims;
+  Tensor1D<int64_t, 1> lhs_contracting{1};
+  Tensor1D<int64_t, 1> rhs_contracting{0};
+  auto a_bf16 = stablehlo::convert<Tensor2D<bfloat16, 1, K>>(a);
+  auto b_bf16 = stablehlo::convert<Tensor2D<bfloat16, K, 2>>(b);
+  auto result_general = stablehlo::dot_general<Tensor2D<bfloat16, 1, 2>>(
+      a_bf16, b_bf16, no_dims, no_dims, lhs_contracting, rhs_contracting);
+  EXPECT_THAT(widen(result_general), Pointwise(FloatEq(), {4096.0f, 4096.0f}));
+}
+
 TEST(stablehlo, reshape) {
   Tensor0D<int> s0{-3};
   auto t0 = stablehlo::reshape<Tensor1D<int, 1>>(s0);
@@ -1789,6 +2067,14 @@ TEST(stablehlo, pad) {
       operand, value, {0, 1}, {1, 2}, {1, 1});
 
   EXPECT_THAT(result2, Pointwise(Eq(), expected_result2));
+
+  Tensor<int32_t, 4, 8> result3 =
+      stablehlo::pad<Tensor<int32_t, 4, 8>,
+                     std::integer_sequence<int64_t, 0, 1>,
+                     std::integer_sequence<int64_t, 1, 2>,
+                     std::integer_sequence<int64_t, 1, 1>>(operand, value);
+
+  EXPECT_THAT(result3, Pointwise(Eq(), expected_result2));
 }
 
 Tensor<int32_t> reduce_computation(Tensor<int32_t> a, Tensor<int32_t> b) {
@@ -2067,6 +2353,208 @@ TEST(stablehlo, select) {
   }
 }
 
+TEST(stablehlo, sort) {
+  using OperandType = Tensor2D<float, 2, 4>;
+  OperandType operand{3, -1, 2, 0, 5, 7, -2, 1};
+  {
+    OperandType expected_result{-1, 0, 2, 3, -2, 1, 5, 7};
+    OperandType result = stablehlo::sort<OperandType>(
+        operand, 1, false, stablehlo::SortDirection::Ascending);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    OperandType expected_result{5, 7, 2, 1, 3, -1, -2, 0};
+    OperandType result = stablehlo::sort<OperandType>(
+        operand, 0, false, stablehlo::SortDirection::Descending);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    // Sorts by absolute value with a comparator, equal keys keep their order.
+    auto comparator = [](Tensor0D<float> a, Tensor0D<float> b) {
+      return Tensor0D<bool>{std::abs(a()) < std::abs(b())};
+    };
+    Tensor1D<float, 5> operand{-3, 2, 1, -2, 3};
+    Tensor1D<float, 5> expected_result{1, 2, -2, -3, 3};
+    Tensor1D<float, 5> result =
+        stablehlo::sort<Tensor1D<float, 5>>(operand, 0, true, comparator);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+}
+
+TEST(stablehlo, sort_pairs) {
+  using KeyType = Tensor2D<float, 2, 4>;
+  using IndexType = Tensor2D<int32_t, 2, 4>;
+  KeyType keys{3, -1, 3, 0, 5, 7, -2, 7};
+  IndexType indices{0, 1, 2, 3, 0, 1, 2, 3};
+  {
+    KeyType expected_keys{3, 3, 0, -1, 7, 7, 5, -2};
+    IndexType expected_indices{0, 2, 3, 1, 1, 3, 0, 2};
+    std::tuple<KeyType, IndexType> result =
+        stablehlo::sort<KeyType, IndexType>(
+            keys, indices, 1, true, stablehlo::SortDirection::Descending);
+    EXPECT_THAT(std::get<0>(result), Pointwise(FloatEq(), expected_keys));
+    EXPECT_THAT(std::get<1>(result), Pointwise(Eq(), expected_indices));
+  }
+  {
+    // Sorts by descending index with a comparator.
+    auto comparator = [](Tensor0D<float>, Tensor0D<float>, Tensor0D<int32_t> a,
+                         Tensor0D<int32_t> b) {
+      return Tensor0D<bool>{a() > b()};
+    };
+    KeyType expected_keys{0, 3, -1, 3, 7, -2, 7, 5};
+    IndexType expected_indices{3, 2, 1, 0, 3, 2, 1, 0};
+    std::tuple<KeyType, IndexType> result =
+        stablehlo::sort<KeyType, IndexType>(keys, indices, 1, false,
+                                            comparator);
+    EXPECT_THAT(std::get<0>(result), Pointwise(FloatEq(), expected_keys));
+    EXPECT_THAT(std::get<1>(result), Pointwise(Eq(), expected_indices));
+  }
+}
+
+TEST(stablehlo, top_k) {
+  {
+    Tensor2D<float, 2, 5> operand{3, 9, -1, 4, 9, 0, 2, 8, 2, -5};
+    Tensor2D<float, 2, 3> expected_result{9, 9, 4, 8, 2, 2};
+    Tensor2D<float, 2, 3> result = stablehlo::top_k<Tensor2D<float, 2, 3>>(
+        operand, 1, stablehlo::SortDirection::Descending);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+
+    Tensor2D<float, 1, 5> expected_min{0, 2, -1, 2, -5};
+    Tensor2D<float, 1, 5> min = stablehlo::top_k<Tensor2D<float, 1, 5>>(
+        operand, 0, stablehlo::SortDirection::Ascending);
+    EXPECT_THAT(min, Pointwise(FloatEq(), expected_min));
+  }
+  {
+    // Large rows select with a heap, ties are ordered by index.
+    using KeyType = Tensor1D<int32_t, 40>;
+    using IndexType = Tensor1D<int32_t, 40>;
+    KeyType keys;
+    IndexType indices;
+    for (size_t i = 0; i < keys.size(); i++) {
+      keys[i] = (i * 7) % 10;
+      indices[i] = i;
+    }
+    Tensor1D<int32_t, 2> expected_keys{9, 9};
+    Tensor1D<int32_t, 2> expected_indices{7, 17};
+    auto [top_keys, top_indices] =
+        stablehlo::top_k<Tensor1D<int32_t, 2>, Tensor1D<int32_t, 2>>(
+            keys, indices, 0, stablehlo::SortDirection::Descending);
+    EXPECT_THAT(top_keys, Pointwise(Eq(), expected_keys));
+    EXPECT_THAT(top_indices, Pointwise(Eq(), expected_indices));
+  }
+}
+
+TEST(stablehlo, gather) {
+  {
+    // Embedding lookup, which copies whole rows.
+    Tensor2D<float, 4, 3> operand{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    Tensor2D<int32_t, 3, 1> indices{2, 0, 2};
+    Tensor2D<float, 3, 3> expected_result{6, 7, 8, 0, 1, 2, 6, 7, 8};
+    Tensor2D<float, 3, 3> result = stablehlo::gather<Tensor2D<float, 3, 3>>(
+        operand, indices, Tensor1D<int64_t, 1>{1}, Tensor1D<int64_t, 1>{0},
+        Tensor1D<int64_t, 1>{0}, 1, Tensor1D<int64_t, 2>{1, 3});
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    // Column slices with an implicit index vector dimension. The second start
+    // index is clamped into the operand.
+    Tensor2D<int32_t, 3, 4> operand{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    Tensor1D<int64_t, 2> indices{1, 5};
+    Tensor3D<int32_t, 2, 3, 2> expected_result{1, 2, 5, 6, 9,  10,
+                                               2, 3, 6, 7, 10, 11};
+    Tensor3D<int32_t, 2, 3, 2> result =
+        stablehlo::gather<Tensor3D<int32_t, 2, 3, 2>>(
+            operand, indices, Tensor1D<int64_t, 2>{1, 2},
+            Tensor1D<int64_t, 0>{}, Tensor1D<int64_t, 1>{1}, 1,
+            Tensor1D<int64_t, 2>{3, 2});
+    EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+
+    Tensor3D<int32_t, 3, 2, 2> expected_result_transposed{
+        1, 2, 2, 3, 5, 6, 6, 7, 9, 10, 10, 11};
+    Tensor3D<int32_t, 3, 2, 2> result_transposed =
+        stablehlo::gather<Tensor3D<int32_t, 3, 2, 2>>(
+            operand, indices, Tensor1D<int64_t, 2>{0, 2},
+            Tensor1D<int64_t, 0>{}, Tensor1D<int64_t, 1>{1}, 1,
+            Tensor1D<int64_t, 2>{3, 2});
+    EXPECT_THAT(result_transposed, Pointwise(Eq(), expected_result_transposed));
+  }
+}
+
+TEST(stablehlo, scatter) {
+  // Replaces the elements at the indices, the last update wins.
+  auto computation = [](Tensor0D<float> /*lhs*/, Tensor0D<float> rhs) {
+    return rhs;
+  };
+  Tensor1D<float, 4> operand{0, 0, 0, 0};
+  Tensor2D<int32_t, 3, 1> indices{1, 3, 1};
+  Tensor1D<float, 3> updates{5, 6, 7};
+  Tensor1D<float, 4> expected_result{0, 7, 0, 6};
+  Tensor1D<float, 4> result = stablehlo::scatter<Tensor1D<float, 4>>(
+      operand, indices, updates, Tensor1D<int64_t, 0>{},
+      Tensor1D<int64_t, 1>{0}, Tensor1D<int64_t, 1>{0}, 1, false, false,
+      computation);
+  EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+}
+
+TEST(stablehlo, scatter_add) {
+  using OperandType = Tensor2D<float, 4, 2>;
+  using IndicesType = Tensor2D<int32_t, 4, 1>;
+  using UpdatesType = Tensor2D<float, 4, 2>;
+  OperandType operand{1, 1, 1, 1, 1, 1, 1, 1};
+  Tensor1D<int64_t, 1> update_window_dims{1};
+  Tensor1D<int64_t, 1> inserted_window_dims{0};
+  Tensor1D<int64_t, 1> scatter_dims_to_operand_dims{0};
+  {
+    // Rows updated repeatedly are summed, updates out of bounds are skipped.
+    IndicesType indices{3, 1, 3, 7};
+    UpdatesType updates{1, 2, 3, 4, 5, 6, 7, 8};
+    OperandType expected_result{1, 1, 4, 5, 1, 1, 7, 9};
+    OperandType result = stablehlo::scatter_add<OperandType>(
+        operand, indices, updates, update_window_dims, inserted_window_dims,
+        scatter_dims_to_operand_dims, 1, false, false);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    IndicesType indices{1, 3, 3, 4};
+    UpdatesType updates{3, 4, 1, 2, 5, 6, 7, 8};
+    OperandType expected_result{1, 1, 4, 5, 1, 1, 7, 9};
+    OperandType result = stablehlo::scatter_add<OperandType>(
+        operand, indices, updates, update_window_dims, inserted_window_dims,
+        scatter_dims_to_operand_dims, 1, true, false);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    IndicesType indices{3, 1, 0, 2};
+    UpdatesType updates{1, 2, 3, 4, 5, 6, 7, 8};
+    OperandType expected_result{6, 7, 4, 5, 8, 9, 2, 3};
+    OperandType result = stablehlo::scatter_add<OperandType>(
+        operand, indices, updates, update_window_dims, inserted_window_dims,
+        scatter_dims_to_operand_dims, 1, false, true);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    // A wrong `unique_indices` hint does not lose updates.
+    IndicesType indices{3, 1, 3, 1};
+    UpdatesType updates{1, 2, 3, 4, 5, 6, 7, 8};
+    OperandType expected_result{1, 1, 11, 13, 1, 1, 7, 9};
+    OperandType result = stablehlo::scatter_add<OperandType>(
+        operand, indices, updates, update_window_dims, inserted_window_dims,
+        scatter_dims_to_operand_dims, 1, false, true);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    // Overlapping windows.
+    Tensor1D<int32_t, 5> operand{0, 0, 0, 0, 0};
+    Tensor2D<int32_t, 2, 1> indices{0, 2};
+    Tensor2D<int32_t, 2, 3> updates{1, 1, 1, 1, 1, 1};
+    Tensor1D<int32_t, 5> expected_result{1, 1, 2, 1, 1};
+    Tensor1D<int32_t, 5> result = stablehlo::scatter_add<Tensor1D<int32_t, 5>>(
+        operand, indices, updates, Tensor1D<int64_t, 1>{1},
+        Tensor1D<int64_t, 0>{}, Tensor1D<int64_t, 1>{0}, 1, false, false);
+    EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+  }
+}
+
 TEST(stablehlo, transpose) {
   {
     Tensor0D<int32_t> operand{1};
@@ -2121,6 +2609,13 @@ TEST(stablehlo, transpose) {
         stablehlo::transpose<Tensor4D<int32_t, 3, 2, 4, 1>>(operand, perms);
 
     EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+
+    Tensor4D<int32_t, 3, 2, 4, 1> result_template =
+        stablehlo::transpose<Tensor4D<int32_t, 3, 2, 4, 1>,
+                             std::integer_sequence<int64_t, 3, 1, 2, 0>>(
+            operand);
+
+    EXPECT_THAT(result_template, Pointwise(Eq(), expected_result));
   }
 }
 
@@ -0,0 +1,132 @@
+// Copyright Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "gmock/gmock.h"
+
+#include "emitc/stablehlo.h"
+#include "emitc/types.h"
+
+namespace {
+
+using namespace emitc;
+using ::testing::Eq;
+using ::testing::FloatNear;
+using ::testing::Pointwise;
+
+const float EPSILON = 5e-4;
+
+Tensor<int32_t> add_computation(Tensor<int32_t> a, Tensor<int32_t> b) {
+  return stablehlo::add(a, b);
+}
+
+Tensor<bool> or_computation(Tensor<bool> a, Tensor<bool> b) {
+  return stablehlo::logical_or(a, b);
+}
+
+TEST(stablehlo, reduce_noncontiguous) {
+  Tensor<int32_t, 2, 3, 4> x{0,  1,  2,  3,  4,  5,  6,  7,
+                             8,  9,  10, 11, 12, 13, 14, 15,
+                             16, 17, 18, 19, 20, 21, 22, 23};
+  Tensor<int32_t> initValue{0};
+
+  Tensor<int32_t, 3> expected_result{60, 92, 124};
+  Tensor<int32_t, 3> result = stablehlo::reduce<Tensor<int32_t, 3>, 2>(
+      x, initValue, {0, 2}, add_computation);
+  EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+
+  Tensor<int32_t, 3, 4> expected_result_outer{12, 14, 16, 18, 20, 22,
+                                              24, 26, 28, 30, 32, 34};
+  Tensor<int32_t, 3, 4> result_outer =
+      stablehlo::reduce<Tensor<int32_t, 3, 4>, 1>(x, initValue, {0},
+                                                  add_computation);
+  EXPECT_THAT(result_outer, Pointwise(Eq(), expected_result_outer));
+}
+
+TEST(stablehlo, reduce_bool) {
+  Tensor<bool, 2, 2, 2> x{false, false, true,  false,
+                          false, false, false, false};
+  Tensor<bool> initValue{false};
+
+  Tensor<bool, 2> expected_result{true, false};
+  Tensor<bool, 2> result = stablehlo::reduce<Tensor<bool, 2>, 2>(
+      x, initValue, {1, 2}, or_computation);
+  EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+
+  Tensor<bool, 2> expected_result_middle{false, true};
+  Tensor<bool, 2> result_middle = stablehlo::reduce<Tensor<bool, 2>, 2>(
+      x, initValue, {0, 2}, or_computation);
+  EXPECT_THAT(result_middle, Pointwise(Eq(), expected_result_middle));
+}
+
+#ifdef EMITC_STABLEHLO_USE_EIGEN
+// Runs a convolution with the dimension numbers supported by the reference
+// implementation.
+template <typename Dest, typename Src, typename Weights>
+Dest convolution(Src input, Weights weights, int64_t feature_group_count,
+                 Tensor2D<int64_t, 2, 2> padding,
+                 Tensor1D<int64_t, 2> rhs_dilation,
+                 Tensor1D<int64_t, 2> window_strides) {
+  return stablehlo::convolution<Dest>(
+      input, weights, /*batch_group_count=*/1, /*input_batch_dimension=*/0,
+      /*input_feature_dimension=*/3, /*input_spatial_dimensions=*/{1, 2},
+      /*kernel_input_feature_dimension=*/2,
+      /*kernel_output_feature_dimension=*/3,
+      /*kernel_spatial_dimensions=*/{0, 1}, /*output_batch_dimension=*/0,
+      /*output_feature_dimension=*/3, /*output_spatial_dimensions=*/{1, 2},
+      feature_group_count, padding, /*lhs_dilation=*/{1, 1}, rhs_dilation,
+      window_strides);
+}
+
+TEST(stablehlo, convolution_grouped) {
+  using InputType = Tensor4D<float, 1, 3, 3, 4>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 2, 4>; // KH KW CIN/G COUT
+  using ResultType = Tensor4D<float, 1, 2, 2, 4>; // N H W C
+  InputType input;
+  WeightType weights;
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = i + 1;
+  }
+  for (size_t i = 0; i < weights.size(); i++) {
+    weights[i] = static_cast<float>(i % 5) - 2;
+  }
+  ResultType expected_result{18, -1,  -46, 6, 22, -5,  -58, 6,
+                             30, -13, -82, 6, 34, -17, -94, 6};
+
+  ResultType result = convolution<ResultType>(input, weights, 2, {0, 0, 0, 0},
+                                              {1, 1}, {1, 1});
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(stablehlo, convolution_dilated) {
+  using InputType = Tensor4D<float, 1, 4, 4, 1>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 1, 1>; // KH KW CIN COUT
+  using ResultType = Tensor4D<float, 1, 2, 2, 1>; // N H W C
+  InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  WeightType weights{1, 2, 3, 4};
+  ResultType expected_result{78, 88, 118, 128};
+
+  ResultType result = convolution<ResultType>(input, weights, 1, {0, 0, 0, 0},
+                                              {2, 2}, {1, 1});
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(stablehlo, convolution_depthwise_multiplier) {
+  using InputType = Tensor4D<float, 1, 3, 3, 2>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 1, 4>; // KH KW 1 C*M
+  using ResultType = Tensor4D<float, 1, 2, 2, 4>; // N H W C*M
+  InputType input{1,  2,  3,  4,  5,  6,  7,  8,  9,
+                  10, 11, 12, 13, 14, 15, 16, 17, 18};
+  WeightType weights{1, -1, 2, -2, 0, 1, 1, 0, 3, 1, -1, 2, 1, 1, 2, -3};
+  ResultType expected_result{6,  4,  6,  -8,  15, 5, -6, 12,
+                             61, 30, 44, -36, 62, 6, 6,  12};
+
+  ResultType result = convolution<ResultType>(input, weights, 2, {1, 0, 0, 1},
+                                              {1, 1}, {2, 2});
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+#endif
+
+} // namespace
@@ -10,10 +10,18 @@
 #include "emitc/tosa.h"
 #include "emitc/types.h"
 
+#include "benchmark.h"
+
+#include <algorithm>
+#include <numeric>
+
 namespace {
 
 using namespace emitc;
+// OpenBLAS declares a global bfloat16 type.
+using emitc::bfloat16;
 using ::testing::DoubleEq;
+using ::testing::Each;
 using ::testing::Eq;
 using ::testing::FloatEq;
 using ::testing::FloatNear;
@@ -293,6 +301,43 @@ TEST(tosa, rescale) {
   }
 }
 
+TEST(tosa, rsqrt) {
+  {
+    Tensor1D<float, 4> x{1.0f, 4.0f, 0.25f, 2.0f};
+    Tensor1D<float, 4> expected_result{1.0f / std::sqrt(1.0f), 0.5f, 2.0f,
+                                       1.0f / std::sqrt(2.0f)};
+    Tensor1D<float, 4> result = tosa::rsqrt(x);
+
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    // Estimate with Newton refinement
+    Tensor1D<float, 13> x{1.393225e+27f, 1.151362e-12f, 5.340778e+5f,
+                          1.346074e+6f,  1.373985f,     9.198730e+7f,
+                          2.0f,          3.0f,          7.5e-3f,
+                          6.25e+2f,      1.0e+30f,      4.2e-20f,
+                          8.0f};
+    Tensor1D<float, 13> result = emitc::rsqrt<decltype(x), true>(x);
+
+    for (size_t i = 0; i < x.size(); i++) {
+      float expected = 1.0f / std::sqrt(x[i]);
+      EXPECT_NEAR(result[i], expected, 1e-6f * expected);
+    }
+  }
+  {
+    // Special values are computed exactly
+    Tensor1D<float, 8> x{0.0f, std::numeric_limits<float>::infinity(), -1.0f,
+                         1e-40f, 1.0f, 4.0f, 16.0f, 64.0f};
+    Tensor1D<float, 8> result = emitc::rsqrt<decltype(x), true>(x);
+
+    EXPECT_EQ(result[0], std::numeric_limits<float>::infinity());
+    EXPECT_EQ(result[1], 0.0f);
+    EXPECT_TRUE(std::isnan(result[2]));
+    EXPECT_FLOAT_EQ(result[3], 1.0f / std::sqrt(1e-40f));
+    EXPECT_NEAR(result[7], 0.125f, 1e-6f);
+  }
+}
+
 // Binary elementwise ops
 TEST(tosa, arithmetic_right_shift) {
   {
@@ -899,6 +944,91 @@ TEST(tosa, depthwise_conv2d) {
     ResultType result = tosa::depthwise_conv2d<ResultType>(
         input, weights, padding, stride, dilation);
     EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+
+    ResultType result_template =
+        tosa::depthwise_conv2d<ResultType,
+                               std::integer_sequence<int64_t, 0, 0, 0, 0>,
+                               std::integer_sequence<int64_t, 1, 1>,
+                               std::integer_sequence<int64_t, 1, 1>>(input,
+                                                                     weights);
+    EXPECT_THAT(result_template,
+                Pointwise(FloatNear(EPSILON), expected_result));
+  }
+}
+
+TEST(tosa, conv2d_dilated) {
+  using InputType = Tensor4D<float, 1, 4, 4, 1>;  // N H W C
+  using WeightType = Tensor4D<float, 1, 2, 2, 1>; // COUT KH KW CIN
+  using ResultType = Tensor4D<float, 1, 2, 2, 1>; // N H W C
+  InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  WeightType weights{1, 2, 3, 4};
+  ResultType expected_result{78, 88, 118, 128};
+
+  Tensor1D<int64_t, 4> padding{0, 0, 0, 0}; // {pt, pb, pl, pr}
+  Tensor1D<int64_t, 2> dilation{2, 2};
+  Tensor1D<int64_t, 2> stride{1, 1};
+
+  ResultType result =
+      tosa::conv2d<ResultType>(input, weights, padding, stride, dilation);
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(tosa, depthwise_conv2d_dilated) {
+  using InputType = Tensor4D<float, 1, 3, 3, 2>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 2, 1>; // KH KW CIN M
+  using ResultType = Tensor4D<float, 1, 1, 1, 2>; // N H W CXM
+  InputType input{1,  2,  3,  4,  5,  6,  7,  8,  9,
+                  10, 11, 12, 13, 14, 15, 16, 17, 18};
+  WeightType weights{1, 2, 3, 4, 5, 6, 7, 8};
+  ResultType expected_result{200, 256};
+
+  ResultType result_template =
+      tosa::depthwise_conv2d<ResultType,
+                             std::integer_sequence<int64_t, 0, 0, 0, 0>,
+                             std::integer_sequence<int64_t, 1, 1>,
+                             std::integer_sequence<int64_t, 2, 2>>(input,
+                                                                   weights);
+  EXPECT_THAT(result_template, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(tosa, transpose_conv2d) {
+  {
+    using InputType = Tensor4D<float, 1, 2, 2, 1>;  // N H W C
+    using WeightType = Tensor4D<float, 1, 2, 2, 1>; // COUT KH KW CIN
+    using ResultType = Tensor4D<float, 1, 4, 4, 1>; // N H W C
+    InputType input{1, 2, 3, 4};
+    WeightType weights{1, 2, 3, 4};
+    // clang-format off
+    ResultType expected_result{1, 2,  2,  4,
+                               3, 4,  6,  8,
+                               3, 6,  4,  8,
+                               9, 12, 12, 16};
+    // clang-format on
+
+    ResultType result = tosa::transpose_conv2d<ResultType>(
+        input, weights, {0, 0, 0, 0}, {2, 2});
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+  {
+    // Overlapping windows, multiple channels and output padding
+    using InputType = Tensor4D<float, 1, 2, 3, 2>;  // N H W C
+    using WeightType = Tensor4D<float, 3, 2, 2, 2>; // COUT KH KW CIN
+    using ResultType = Tensor4D<float, 1, 3, 7, 3>; // N H W C
+    InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    WeightType weights;
+    for (size_t i = 0; i < weights.size(); i++) {
+      weights[i] = static_cast<float>(i % 5) - 2;
+    }
+    ResultType expected_result{
+        0,   0,   0,  -4, 5,   -1,  2,   -4,  5,   -10, 11,  -3,  4,
+        -10, 11,  -16, 17, -5, 6,   -16, 17,  0,   0,   0,   -24, 25,
+        -11, 7,   -24, 25, -30, 33, -19, 7,   -30, 33,  -36, 41,  -27,
+        7,   -36, 41,  0,  0,   0,   -2,  8,   -22, -7,  -2,  8,   -2,
+        10,  -28, -9,  -2, 10,  -2,  12,  -34, -11, -2,  12};
+
+    ResultType result = tosa::transpose_conv2d<ResultType>(
+        input, weights, {0, 0, 1, 0}, {1, 2});
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
   }
 }
 
@@ -938,6 +1068,20 @@ TEST(tosa, max_pool2d) {
 
     EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
   }
+  {
+    //              N IH IW C
+    Tensor4D<float, 1, 2, 2, 1> input{-4.f, -3.f, -2.f, -1.f};
+    std::array<int64_t, 4> padding{1, 0, 1, 0}; // {pt, pb, pl, pr}
+    std::array<int64_t, 2> stride{1, 1};
+    std::array<int64_t, 2> kernel{2, 2};
+
+    using ResultType = Tensor4D<float, 1, 2, 2, 1>; // N OH OW C
+    ResultType expected_result{-4.f, -3.f, -2.f, -1.f};
+    ResultType result =
+        tosa::max_pool2d<ResultType>(input, padding, stride, kernel);
+
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
 }
 
 TEST(tosa, avg_pool2d) {
@@ -978,6 +1122,21 @@ TEST(tosa, avg_pool2d) {
   }
 }
 
+TEST(tosa, avg_pool2d_half) {
+  // Averages 4096 ones, whose sum would stall at 2048 in half precision.
+  Tensor4D<half, 1, 64, 64, 1> input;
+  std::fill(input.begin(), input.end(), half(1.0f));
+  std::array<int64_t, 4> padding{0, 0, 0, 0};
+  std::array<int64_t, 2> stride{1, 1};
+  std::array<int64_t, 2> kernel{64, 64};
+
+  using ResultType = Tensor4D<half, 1, 1, 1, 1>;
+  ResultType result =
+      tosa::avg_pool2d<ResultType>(input, padding, stride, kernel);
+
+  EXPECT_THAT(widen(result), Pointwise(FloatEq(), {1.0f}));
+}
+
 TEST(tosa, fully_connected) {
   using InputType = Tensor2D<float, 2, 5>;  // N CIN
   using WeightType = Tensor2D<float, 2, 5>; // COUT CIN
@@ -992,6 +1151,392 @@ TEST(tosa, fully_connected) {
   EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
 }
 
+TEST(tosa, fully_connected_half) {
+  constexpr size_t C_IN = 4096;
+  Tensor2D<half, 1, C_IN> input;
+  Tensor2D<half, 2, C_IN> weights;
+  Tensor1D<half, 2> bias{1.0f, -1.0f};
+  std::fill(input.begin(), input.end(), half(1.0f));
+  std::fill(weights.begin(), weights.end(), half(1.0f));
+
+  using ResultType = Tensor2D<half, 1, 2>;
+  ResultType result = tosa::fully_connected<ResultType>(input, weights, bias);
+
+  // 4097 rounds to 4096 and 4095 to 4096 in half precision.
+  EXPECT_THAT(widen(result), Pointwise(FloatEq(), {4096.0f, 4096.0f}));
+
+  using Conv2DResultType = Tensor4D<half, 1, 1, 1, 2>;
+  Tensor4D<half, 1, 1, 1, C_IN> conv_input;
+  Tensor4D<half, 2, 1, 1, C_IN> conv_weights;
+  std::fill(conv_input.begin(), conv_input.end(), half(1.0f));
+  std::fill(conv_weights.begin(), conv_weights.end(), half(1.0f));
+  Conv2DResultType conv_result = tosa::conv2d<Conv2DResultType>(
+      conv_input, conv_weights, Tensor1D<int64_t, 4>{0, 0, 0, 0},
+      Tensor1D<int64_t, 2>{1, 1}, Tensor1D<int64_t, 2>{1, 1});
+
+  EXPECT_THAT(widen(conv_result), Pointwise(FloatEq(), {4096.0f, 4096.0f}));
+}
+
+TEST(tosa, fully_connected_transposed) {
+  using InputType = Tensor2D<float, 5, 2>;  // CIN N
+  using WeightType = Tensor2D<float, 5, 2>; // CIN COUT
+  using BiasType = Tensor1D<float, 2>;      // COUT
+  using ResultType = Tensor2D<float, 2, 2>; // N COUT
+  InputType input{1, 6, 2, 7, 3, 8, 4, 9, 5, 10};
+  WeightType weights{1, 6, 2, 7, 3, 8, 4, 9, 5, 10};
+  BiasType bias{100, 200};
+  ResultType expected_result{155, 330, 230, 530};
+  ResultType result =
+      tosa::fully_connected_transposed<ResultType, true, true>(input, weights,
+                                                               bias);
+
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(tosa, pack_weights) {
+  using WeightType = Tensor2D<float, 3, 2>;    // COUT CIN
+  using PackedType = Tensor3D<float, 2, 2, 2>; // COUT/B CIN B
+  WeightType weights{1, 2, 3, 4, 5, 6};
+  PackedType expected_result{1, 3, 2, 4, 5, 0, 6, 0};
+  PackedType result = tosa::pack_weights<PackedType>(weights);
+
+  EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+}
+
+TEST(tosa, conv2d_prepacked) {
+  constexpr int64_t version = tosa::packed_weights_layout_version;
+  {
+    using InputType = Tensor4D<float, 1, 4, 5, 2>;  // N H W C
+    using WeightType = Tensor4D<float, 1, 3, 2, 2>; // COUT KH KW CIN
+    using PackedType = Tensor<float, 1, 3, 2, 2, 4>; // COUT/B KH KW CIN B
+    using BiasType = Tensor1D<float, 1>;             // COUT
+    using ResultType = Tensor4D<float, 1, 4, 5, 1>;  // N H W C
+    InputType input{1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,
+                    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+                    29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40};
+    WeightType weights{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    BiasType bias{10};
+    ResultType expected_result{610,  746,  882,  1018, 486,  1320, 1476,
+                               1632, 1788, 815,  2100, 2256, 2412, 2568,
+                               1145, 1090, 1162, 1234, 1306, 534};
+
+    Tensor1D<int64_t, 4> padding{1, 1, 0, 1}; // {pt, pb, pl, pr}
+    Tensor1D<int64_t, 2> dilation{1, 1};
+    Tensor1D<int64_t, 2> stride{1, 1};
+
+    PackedType packed = tosa::pack_weights<PackedType>(weights);
+    ResultType result = tosa::conv2d_prepacked<ResultType, version>(
+        input, packed, bias, padding, stride, dilation);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+  {
+    // Strided convolution with multiple output channel panels
+    using InputType = Tensor4D<float, 1, 4, 4, 1>;  // N H W C
+    using WeightType = Tensor4D<float, 3, 2, 2, 1>; // COUT KH KW CIN
+    using PackedType = Tensor<float, 2, 2, 2, 1, 2>; // COUT/B KH KW CIN B
+    using BiasType = Tensor1D<float, 3>;             // COUT
+    using ResultType = Tensor4D<float, 1, 2, 2, 3>;  // N H W C
+    // clang-format off
+    InputType input{1,  2,  3,  4,
+                    5,  6,  7,  8,
+                    9,  10, 11, 12,
+                    13, 14, 15, 16};
+    WeightType weights{1, 2,
+                       3, 4,
+                       0, 0,
+                       0, 1,
+                       1, 0,
+                       0, 0};
+    BiasType bias{0, 1, 2};
+    ResultType expected_result{44,  7,  3,  64,  9,  5,
+                               124, 15, 11, 144, 17, 13};
+    // clang-format on
+    Tensor1D<int64_t, 4> padding{0, 0, 0, 1}; // {pt, pb, pl, pr}
+    Tensor1D<int64_t, 2> dilation{1, 1};
+    Tensor1D<int64_t, 2> stride{2, 2};
+
+    PackedType packed = tosa::pack_weights<PackedType>(weights);
+    ResultType result = tosa::conv2d_prepacked<ResultType, version>(
+        input, packed, bias, padding, stride, dilation);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+}
+
+TEST(tosa, fully_connected_prepacked) {
+  constexpr int64_t version = tosa::packed_weights_layout_version;
+  using InputType = Tensor2D<float, 2, 5>;     // N CIN
+  using WeightType = Tensor2D<float, 2, 5>;    // COUT CIN
+  using PackedType = Tensor3D<float, 1, 5, 4>; // COUT/B CIN B
+  using BiasType = Tensor1D<float, 2>;         // COUT
+  using ResultType = Tensor2D<float, 2, 2>;    // N COUT
+  InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  WeightType weights{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  BiasType bias{100, 200};
+  ResultType expected_result{155, 330, 230, 530};
+
+  PackedType packed = tosa::pack_weights<PackedType>(weights);
+  ResultType result =
+      tosa::fully_connected_prepacked<ResultType, version>(input, packed, bias);
+
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(tosa, prepacked_compressed_weights) {
+  constexpr int64_t version = tosa::packed_weights_layout_version;
+  {
+    using InputType = Tensor2D<float, 2, 5>;  // N CIN
+    using WeightType = Tensor2D<float, 3, 5>; // COUT CIN
+    using BiasType = Tensor1D<float, 3>;      // COUT
+    using ResultType = Tensor2D<float, 2, 3>; // N COUT
+    InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    WeightType weights{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0.5, 0.25, 0, -1, -2};
+    BiasType bias{100, 200, 300};
+    ResultType expected_result{155, 330, 287, 230, 530, 275.75};
+
+    auto half_packed =
+        tosa::pack_weights<Tensor3D<half, 2, 5, 2>>(weights); // COUT/B CIN B
+    ResultType result = tosa::fully_connected_prepacked<ResultType, version>(
+        input, half_packed, bias);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+
+    auto bfloat16_packed =
+        tosa::pack_weights<Tensor3D<bfloat16, 2, 5, 2>>(weights);
+    result = tosa::fully_connected_prepacked<ResultType, version>(
+        input, bfloat16_packed, bias);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+
+    // Weights are quantized to int8 with the scale max(abs(w)) / 127 of their
+    // output channel.
+    Tensor1D<float, 3> scales{5.0f / 127, 10.0f / 127, 2.0f / 127};
+    Tensor2D<int8_t, 3, 5> quantized{25, 51, 76, 102, 127, 76, 89,  102,
+                                     114, 127, 32, 16, 0, -64, -127};
+    auto int8_packed = tosa::pack_weights<Tensor3D<int8_t, 2, 5, 2>>(quantized);
+    result = tosa::fully_connected_prepacked<ResultType, version>(
+        input, int8_packed, scales, bias);
+    EXPECT_THAT(result, Pointwise(FloatNear(0.5f), expected_result));
+  }
+  {
+    using InputType = Tensor4D<float, 1, 2, 2, 1>;  // N H W C
+    using WeightType = Tensor4D<float, 2, 2, 2, 1>; // COUT KH KW CIN
+    using BiasType = Tensor1D<float, 2>;            // COUT
+    using ResultType = Tensor4D<float, 1, 1, 1, 2>; // N H W C
+    InputType input{1, 2, 3, 4};
+    WeightType weights{1, 2, 3, 4, -1, 0, 0, 1};
+    BiasType bias{1, 2};
+    ResultType expected_result{31, 5};
+
+    Tensor1D<int64_t, 4> padding{0, 0, 0, 0}; // {pt, pb, pl, pr}
+    Tensor1D<int64_t, 2> dilation{1, 1};
+    Tensor1D<int64_t, 2> stride{1, 1};
+
+    // COUT/B KH KW CIN B
+    auto half_packed = tosa::pack_weights<Tensor<half, 1, 2, 2, 1, 2>>(weights);
+    ResultType result = tosa::conv2d_prepacked<ResultType, version>(
+        input, half_packed, bias, padding, stride, dilation);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+
+    Tensor1D<float, 2> scales{4.0f / 127, 1.0f / 127};
+    Tensor4D<int8_t, 2, 2, 2, 1> quantized{32, 64, 95, 127, -127, 0, 0, 127};
+    auto int8_packed =
+        tosa::pack_weights<Tensor<int8_t, 1, 2, 2, 1, 2>>(quantized);
+    result = tosa::conv2d_prepacked<ResultType, version>(
+        input, int8_packed, scales, bias, padding, stride, dilation);
+    EXPECT_THAT(result, Pointwise(FloatNear(0.1f), expected_result));
+  }
+}
+
+// Returns [OC,IC] weights with NNZ / OC nonzeros per output channel and their
+// CSR encoding.
+template <size_t OC, size_t IC, size_t NNZ>
+struct SparseWeights {
+  Tensor2D<float, OC, IC> dense;
+  Tensor1D<float, NNZ> values;
+  Tensor1D<int32_t, NNZ> col_indices;
+  Tensor1D<int32_t, OC + 1> row_offsets;
+
+  SparseWeights() {
+    static_assert(NNZ % OC == 0, "Expected the same nonzeros per channel");
+    constexpr size_t PER_CHANNEL = NNZ / OC;
+    for (size_t oc = 0; oc < OC; oc++) {
+      row_offsets[oc] = oc * PER_CHANNEL;
+      for (size_t j = 0; j < PER_CHANNEL; j++) {
+        size_t ic = (oc * 13 + j * IC / PER_CHANNEL) % IC;
+        float value = static_cast<float>((oc + j) % 5) - 1.5f;
+        dense(oc, ic) = value;
+        values[oc * PER_CHANNEL + j] = value;
+        col_indices[oc * PER_CHANNEL + j] = ic;
+      }
+    }
+    row_offsets[OC] = NNZ;
+  }
+};
+
+TEST(tosa, fully_connected_sparse) {
+  using InputType = Tensor2D<float, 2, 4>;  // N CIN
+  using ResultType = Tensor2D<float, 2, 3>; // N COUT
+  InputType input{1, 2, 3, 4, 5, 6, 7, 8};
+  // Weights are {{0, 2, 0, 0}, {0, 0, 0, 0}, {1, 0, 0, -1}}.
+  Tensor1D<float, 3> values{2, 1, -1};
+  Tensor1D<int32_t, 3> col_indices{1, 0, 3};
+  Tensor1D<int32_t, 4> row_offsets{0, 1, 1, 3};
+  Tensor1D<float, 3> bias{10, 20, 30};
+  ResultType expected_result{14, 20, 27, 22, 20, 27};
+
+  ResultType result = tosa::fully_connected_sparse<ResultType>(
+      input, values, col_indices, row_offsets, bias);
+  EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+}
+
+TEST(tosa, conv2d_1x1_sparse) {
+  using InputType = Tensor4D<float, 2, 5, 4, 16>; // N H W C
+  using WeightType = Tensor4D<float, 8, 1, 1, 16>; // COUT KH KW CIN
+  SparseWeights<8, 16, 32> sparse;
+  WeightType weights;
+  std::copy(sparse.dense.begin(), sparse.dense.end(), weights.begin());
+  Tensor1D<float, 8> bias;
+
+  InputType input;
+  std::iota(input.begin(), input.end(), -100.0f);
+  Tensor1D<int64_t, 4> padding{0, 0, 0, 0}; // {pt, pb, pl, pr}
+  Tensor1D<int64_t, 2> dilation{1, 1};
+  {
+    using ResultType = Tensor4D<float, 2, 5, 4, 8>; // N H W C
+    Tensor1D<int64_t, 2> stride{1, 1};
+    ResultType expected_result =
+        tosa::conv2d<ResultType>(input, weights, padding, stride, dilation);
+    ResultType result = tosa::conv2d_1x1_sparse<ResultType>(
+        input, sparse.values, sparse.col_indices, sparse.row_offsets, bias,
+        stride);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+  {
+    using ResultType = Tensor4D<float, 2, 3, 2, 8>; // N H W C
+    Tensor1D<int64_t, 2> stride{2, 3};
+    ResultType expected_result =
+        tosa::conv2d<ResultType>(input, weights, padding, stride, dilation);
+    ResultType result = tosa::conv2d_1x1_sparse<ResultType>(
+        input, sparse.values, sparse.col_indices, sparse.row_offsets, bias,
+        stride);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+}
+
+// Disabled by default, run with --gtest_also_run_disabled_tests.
+TEST(tosa, DISABLED_conv2d_1x1_sparse_benchmark) {
+  // Compares the sparse 1x1 convolution at several densities against the naive
+  // dense kernel and the dense kernel of the configured backend, which the
+  // default `min-sparsity` of the `sparsify-tosa-weights` pass is based on.
+  // Disabled by default, see benchmark.h.
+  using InputType = Tensor4D<float, 1, 28, 28, 128>;
+  using WeightType = Tensor4D<float, 128, 1, 1, 128>;
+  using ResultType = Tensor4D<float, 1, 28, 28, 128>;
+  InputType input = tensor::splat<InputType>(0.5f);
+  Tensor1D<int64_t, 4> padding{0, 0, 0, 0};
+  Tensor1D<int64_t, 2> stride{1, 1};
+  Tensor1D<int64_t, 2> dilation{1, 1};
+  Tensor1D<float, 128> bias;
+
+  auto run = [&](auto sparse, size_t percent) {
+    WeightType weights;
+    std::copy(sparse.dense.begin(), sparse.dense.end(), weights.begin());
+
+    ResultType naive_result, dense_result, sparse_result;
+    double naive_time = benchmark([&]() {
+      naive_result = tosa::naive::conv2d<ResultType>(input, weights, padding,
+                                                     stride, dilation);
+    });
+    double dense_time = benchmark([&]() {
+      dense_result =
+          tosa::conv2d<ResultType>(input, weights, padding, stride, dilation);
+    });
+    double sparse_time = benchmark([&]() {
+      sparse_result = tosa::conv2d_1x1_sparse<ResultType>(
+          input, sparse.values, sparse.col_indices, sparse.row_offsets, bias,
+          stride);
+    });
+    report_speed() << "conv2d 1x1 " << percent << "% naive: " << naive_time
+                   << " ms, dense: " << dense_time
+                   << " ms, sparse: " << sparse_time << " ms\n";
+
+    EXPECT_THAT(dense_result, Pointwise(FloatNear(EPSILON), naive_result));
+    EXPECT_THAT(sparse_result, Pointwise(FloatNear(EPSILON), dense_result));
+  };
+
+  run(SparseWeights<128, 128, 128 * 2>{}, 2);
+  run(SparseWeights<128, 128, 128 * 4>{}, 3);
+  run(SparseWeights<128, 128, 128 * 8>{}, 6);
+  run(SparseWeights<128, 128, 128 * 16>{}, 12);
+  run(SparseWeights<128, 128, 128 * 32>{}, 25);
+  run(SparseWeights<128, 128, 128 * 64>{}, 50);
+}
+
+TEST(tosa, nchwc_reorder) {
+  using InputType = Tensor4D<float, 1, 2, 1, 3>;     // N H W C
+  using BlockedType = Tensor<float, 1, 2, 2, 1, 2>; // N C/B H W B
+  InputType input{1, 2, 3, 4, 5, 6};
+  BlockedType expected_blocked{1, 2, 4, 5, 3, 0, 6, 0};
+
+  BlockedType blocked = tosa::to_nchwc<BlockedType>(input);
+  EXPECT_THAT(blocked, Pointwise(FloatNear(EPSILON), expected_blocked));
+
+  InputType result = tosa::from_nchwc<InputType>(blocked);
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), input));
+}
+
+TEST(tosa, conv2d_nchwc) {
+  constexpr int64_t version = tosa::packed_weights_layout_version;
+  using InputType = Tensor4D<float, 1, 4, 4, 3>;        // N H W C
+  using BlockedInputType = Tensor<float, 1, 2, 4, 4, 2>; // N C/B H W B
+  using WeightType = Tensor4D<float, 3, 2, 2, 3>;       // COUT KH KW CIN
+  using PackedType = Tensor<float, 2, 2, 2, 3, 2>;      // COUT/B KH KW CIN B
+  using BiasType = Tensor1D<float, 3>;                  // COUT
+  using ResultType = Tensor4D<float, 1, 2, 3, 3>;       // N H W C
+  using BlockedResultType = Tensor<float, 1, 2, 2, 3, 2>;
+
+  InputType input;
+  std::iota(input.begin(), input.end(), -20.0f);
+  WeightType weights;
+  std::iota(weights.begin(), weights.end(), -18.0f);
+  BiasType bias{1, -2, 3};
+
+  Tensor1D<int64_t, 4> padding{1, 0, 0, 1}; // {pt, pb, pl, pr}
+  Tensor1D<int64_t, 2> stride{2, 1};
+  Tensor1D<int64_t, 2> dilation{1, 2};
+
+  PackedType packed = tosa::pack_weights<PackedType>(weights);
+  ResultType expected_result = tosa::conv2d_prepacked<ResultType, version>(
+      input, packed, bias, padding, stride, dilation);
+
+  BlockedResultType blocked = tosa::conv2d_nchwc<BlockedResultType, version>(
+      tosa::to_nchwc<BlockedInputType>(input), packed, bias, padding, stride,
+      dilation);
+  ResultType result = tosa::from_nchwc<ResultType>(blocked);
+
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(tosa, max_pool2d_nchwc) {
+  using InputType = Tensor4D<float, 2, 3, 4, 3>;         // N H W C
+  using BlockedInputType = Tensor<float, 2, 2, 3, 4, 2>; // N C/B H W B
+  using ResultType = Tensor4D<float, 2, 2, 2, 3>;        // N H W C
+  using BlockedResultType = Tensor<float, 2, 2, 2, 2, 2>;
+
+  InputType input;
+  std::iota(input.begin(), input.end(), -30.0f);
+  std::array<int64_t, 4> padding{2, 1, 0, 2}; // {pt, pb, pl, pr}
+  std::array<int64_t, 2> stride{3, 2};        // {sy, sx}
+  std::array<int64_t, 2> kernel{3, 4};        // {ky, kx}
+
+  ResultType expected_result =
+      tosa::max_pool2d<ResultType>(input, padding, stride, kernel);
+
+  BlockedResultType blocked = tosa::max_pool2d_nchwc<BlockedResultType>(
+      tosa::to_nchwc<BlockedInputType>(input), padding, stride, kernel);
+  ResultType result = tosa::from_nchwc<ResultType>(blocked);
+
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
 TEST(tosa, gather) {
   {
     using InputType = Tensor3D<float, 1, 2, 2>;  // N K C
@@ -1040,6 +1585,42 @@ TEST(tosa, matmul) {
   }
 }
 
+TEST(tosa, matmul_half) {
+  // Accumulating 512 ones in bfloat16 would stall at 256.
+  constexpr size_t K = 512;
+  Tensor3D<bfloat16, 1, 1, K> a;
+  Tensor3D<bfloat16, 1, K, 1> b;
+  std::fill(a.begin(), a.end(), bfloat16(1.0f));
+  std::fill(b.begin(), b.end(), bfloat16(1.0f));
+
+  Tensor3D<bfloat16, 1, 1, 1> c = tosa::matmul(a, b);
+
+  EXPECT_THAT(widen(c), Pointwise(FloatEq(), {512.0f}));
+}
+
+TEST(tosa, matmul_transposed) {
+  using AType = Tensor3D<float, 1, 3, 2>;   // M K
+  using ATType = Tensor3D<float, 1, 2, 3>;  // K M
+  using BType = Tensor3D<float, 1, 2, 2>;   // K N
+  using BTType = Tensor3D<float, 1, 2, 2>;  // N K
+  using CType = Tensor3D<float, 1, 3, 2>;   // M N
+  AType a{1, 2, 3, 4, 5, 6};
+  ATType a_t{1, 3, 5, 2, 4, 6};
+  BType b{7, 8, 9, 10};
+  BTType b_t{7, 9, 8, 10};
+  CType expected_result{25, 28, 57, 64, 89, 100};
+
+  CType nn = tosa::matmul_transposed<CType, false, false>(a, b);
+  CType nt = tosa::matmul_transposed<CType, false, true>(a, b_t);
+  CType tn = tosa::matmul_transposed<CType, true, false>(a_t, b);
+  CType tt = tosa::matmul_transposed<CType, true, true>(a_t, b_t);
+
+  EXPECT_THAT(nn, Pointwise(FloatNear(EPSILON), expected_result));
+  EXPECT_THAT(nt, Pointwise(FloatNear(EPSILON), expected_result));
+  EXPECT_THAT(tn, Pointwise(FloatNear(EPSILON), expected_result));
+  EXPECT_THAT(tt, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
 TEST(tosa, argmax) {
   {
     Tensor<int32_t, 6> x{4, 1, 3, 7, 0, 0};
@@ -1184,6 +1765,18 @@ TEST(tosa, reduce_sum) {
   }
 }
 
+TEST(tosa, reduce_sum_half) {
+  Tensor<bfloat16, 512, 2> input;
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = i % 2 == 0 ? 1.0f : 0.5f;
+  }
+  Tensor<bfloat16, 2> result = tosa::reduce_sum<Tensor<bfloat16, 2>>(input, 0);
+  Tensor<bfloat16, 2> max = tosa::reduce_max<Tensor<bfloat16, 2>>(input, 0);
+
+  EXPECT_THAT(widen(result), Pointwise(FloatEq(), {512.0f, 256.0f}));
+  EXPECT_THAT(widen(max), Pointwise(FloatEq(), {1.0f, 0.5f}));
+}
+
 TEST(tosa, reshape) {
   {
     Tensor2D<int, 1, 2> x = {1, 2};
@@ -1214,6 +1807,130 @@ TEST(tosa, reshape) {
   }
 }
 
+TEST(tosa, resize) {
+  // Upsampling by 2 with half pixel centers
+  using InputType = Tensor4D<float, 1, 2, 2, 2>;  // N H W C
+  using ResultType = Tensor4D<float, 1, 4, 4, 2>; // N H W C
+  InputType input{1, 2, 3, 4, 5, 6, 7, 8};
+  Tensor1D<int64_t, 4> scale{4, 2, 4, 2};
+  Tensor1D<int64_t, 2> offset{-1, -1};
+  Tensor1D<int64_t, 2> border{1, 1};
+  {
+    ResultType expected_result{1, 2, 1, 2, 3, 4, 3, 4, 1, 2, 1, 2, 3, 4, 3, 4,
+                               5, 6, 5, 6, 7, 8, 7, 8, 5, 6, 5, 6, 7, 8, 7, 8};
+    ResultType result = tosa::resize<ResultType>(
+        input, scale, offset, border, tosa::ResizeMode::NearestNeighbor);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+  {
+    ResultType expected_result{1,   2,   1.5, 2.5, 2.5, 3.5, 3,   4,
+                               2,   3,   2.5, 3.5, 3.5, 4.5, 4,   5,
+                               4,   5,   4.5, 5.5, 5.5, 6.5, 6,   7,
+                               5,   6,   5.5, 6.5, 6.5, 7.5, 7,   8};
+    ResultType result = tosa::resize<ResultType>(input, scale, offset, border,
+                                                 tosa::ResizeMode::Bilinear);
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+  }
+}
+
+TEST(tosa, resize_edges) {
+  using InputType = Tensor4D<float, 1, 2, 2, 1>; // N H W C
+  InputType input{1, 2, 3, 4};
+  Tensor1D<int64_t, 4> scale{2, 1, 2, 1};
+  {
+    // A positive border reads beyond the last input pixel
+    using ResultType = Tensor4D<float, 1, 5, 5, 1>; // N H W C
+    Tensor1D<int64_t, 2> offset{0, 0};
+    Tensor1D<int64_t, 2> border{2, 2};
+    {
+      ResultType expected_result{1, 2, 2, 2, 2, 3, 4, 4, 4, 4, 3, 4, 4,
+                                 4, 4, 3, 4, 4, 4, 4, 3, 4, 4, 4, 4};
+      ResultType result = tosa::resize<ResultType>(
+          input, scale, offset, border, tosa::ResizeMode::NearestNeighbor);
+      EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+    }
+    {
+      ResultType expected_result{1, 1.5, 2, 2, 2, 2, 2.5, 3, 3, 3, 3, 3.5, 4,
+                                 4, 4,   3, 3.5, 4, 4, 4, 3, 3.5, 4, 4, 4};
+      ResultType result = tosa::resize<ResultType>(
+          input, scale, offset, border, tosa::ResizeMode::Bilinear);
+      EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+    }
+  }
+  {
+    // An offset of -scale_n reads before the first input pixel
+    using ResultType = Tensor4D<float, 1, 4, 4, 1>; // N H W C
+    Tensor1D<int64_t, 2> offset{-2, -2};
+    Tensor1D<int64_t, 2> border{-1, -1};
+    {
+      ResultType expected_result{1, 1, 1, 2, 1, 1, 1, 2,
+                                 1, 1, 1, 2, 3, 3, 3, 4};
+      ResultType result = tosa::resize<ResultType>(
+          input, scale, offset, border, tosa::ResizeMode::NearestNeighbor);
+      EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+    }
+    {
+      ResultType expected_result{1, 1, 1, 1.5, 1, 1, 1, 1.5,
+                                 1, 1, 1, 1.5, 2, 2, 2, 2.5};
+      ResultType result = tosa::resize<ResultType>(
+          input, scale, offset, border, tosa::ResizeMode::Bilinear);
+      EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+    }
+  }
+}
+
+TEST(tosa, resize_quantized) {
+  {
+    // Bilinear results are scaled by scale_y_n * scale_x_n
+    using InputType = Tensor4D<int8_t, 1, 2, 2, 2>;   // N H W C
+    using ResultType = Tensor4D<int32_t, 1, 4, 4, 2>; // N H W C
+    InputType input{1, 2, 3, 4, 5, 6, 7, 8};
+    ResultType expected_result{16, 32,  24,  40,  40,  56,  48,  64,
+                               32, 48,  40,  56,  56,  72,  64,  80,
+                               64, 80,  72,  88,  88,  104, 96,  112,
+                               80, 96,  88,  104, 104, 120, 112, 128};
+    ResultType result = tosa::resize<ResultType>(
+        input, {4, 2, 4, 2}, {-1, -1}, {1, 1}, tosa::ResizeMode::Bilinear);
+    EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+  }
+  {
+    // Downsampling by 2
+    using InputType = Tensor4D<int8_t, 1, 4, 4, 1>;  // N H W C
+    using ResultType = Tensor4D<int8_t, 1, 2, 2, 1>; // N H W C
+    InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    ResultType expected_result{1, 3, 9, 11};
+    ResultType result =
+        tosa::resize<ResultType>(input, {1, 2, 1, 2}, {0, 0}, {0, 0},
+                                 tosa::ResizeMode::NearestNeighbor);
+    EXPECT_THAT(result, Pointwise(Eq(), expected_result));
+  }
+}
+
+// Disabled by default, see benchmark.h.
+TEST(tosa, DISABLED_resize_benchmark) {
+  // Bilinear upsampling of a constant image preserves the constant.
+  using InputType = Tensor4D<float, 1, 32, 32, 64>;
+  InputType input = tensor::splat<InputType>(3.0f);
+
+  auto run = [&input](auto result, int64_t factor) {
+    using ResultType = decltype(result);
+    Tensor1D<int64_t, 4> scale{2 * factor, 2, 2 * factor, 2};
+    Tensor1D<int64_t, 2> offset{1 - factor, 1 - factor};
+    Tensor1D<int64_t, 2> border{factor - 1, factor - 1};
+
+    double time = benchmark([&]() {
+      result = tosa::resize<ResultType>(input, scale, offset, border,
+                                        tosa::ResizeMode::Bilinear);
+    });
+    report_speed() << "resize x" << factor << ": " << time << " ms\n";
+
+    EXPECT_THAT(result, Each(FloatNear(3.0f, EPSILON)));
+  };
+
+  run(Tensor4D<float, 1, 64, 64, 64>{}, 2);
+  run(Tensor4D<float, 1, 128, 128, 64>{}, 4);
+}
+
 TEST(tosa, slice) {
   {
     Tensor1D<float, 5> x{0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
@@ -9,6 +9,8 @@
 #include "emitc/tosa.h"
 #include "emitc/types.h"
 
+#include "benchmark.h"
+
 namespace {
 
 using namespace emitc;
@@ -64,7 +66,238 @@ TEST(tosa, conv2d) {
     ResultType result =
         tosa::conv2d<ResultType>(input, weights, padding, stride, dilation);
     EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+
+    ResultType result_template =
+        tosa::conv2d<ResultType, std::integer_sequence<int64_t, 0, 0, 0, 1>,
+                     std::integer_sequence<int64_t, 2, 2>,
+                     std::integer_sequence<int64_t, 1, 1>>(input, weights);
+    EXPECT_THAT(result_template,
+                Pointwise(FloatNear(EPSILON), expected_result));
+  }
+}
+
+TEST(tosa, depthwise_conv2d_padded) {
+  using InputType = Tensor4D<float, 1, 3, 4, 2>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 2, 2>; // KH KW C M
+  using ResultType = Tensor4D<float, 1, 2, 2, 4>; // N H W C*M
+  InputType input{-10, -9, -8, -7, -6, -5, -4, -3, -2, -1, 0,  1,
+                  2,   3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13};
+  WeightType weights{-2, -1, 0, 1, 2, -2, -1, 0, 1, 2, -2, -1, 0, 1, 2, -2};
+  ResultType expected_result{0,  -10, -18, 18, -8, -22, 4, 17,
+                             -4, 10,  15,  -14, 12, 22, 1, -30};
+
+  Tensor1D<int64_t, 4> padding{1, 0, 1, 0}; // {pt, pb, pl, pr}
+  Tensor1D<int64_t, 2> dilation{1, 1};
+  Tensor1D<int64_t, 2> stride{2, 2};
+
+  ResultType result = tosa::depthwise_conv2d<ResultType>(
+      input, weights, padding, stride, dilation);
+  EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+}
+
+TEST(tosa, pool2d_padded) {
+  using InputType = Tensor4D<float, 1, 3, 3, 1>;
+  using ResultType = Tensor4D<float, 1, 2, 2, 1>;
+  std::array<int64_t, 4> padding{1, 1, 1, 1};
+  std::array<int64_t, 2> stride{2, 2};
+  std::array<int64_t, 2> kernel{2, 2};
+  {
+    // Padding must not be part of the maximum
+    InputType input{-1, -2, -3, -4, -5, -6, -7, -8, -9};
+    ResultType expected_result{-1, -2, -4, -5};
+    ResultType result =
+        tosa::max_pool2d<ResultType>(input, padding, stride, kernel);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+  {
+    // Padding must not be part of the average
+    InputType input{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ResultType expected_result{1, 2.5, 5.5, 7};
+    ResultType result =
+        tosa::avg_pool2d<ResultType>(input, padding, stride, kernel);
+    EXPECT_THAT(result, Pointwise(FloatEq(), expected_result));
+  }
+}
+
+TEST(tosa, reduce_negative) {
+  Tensor3D<float, 2, 3, 2> input{-1, -2, -3, -4,  -5,  -6,
+                                 -7, -8, -9, -10, -11, -12};
+
+  Tensor2D<float, 2, 2> expected_max{-1, -2, -7, -8};
+  Tensor2D<float, 2, 2> result_max =
+      tosa::reduce_max<Tensor2D<float, 2, 2>>(input, 1);
+  EXPECT_THAT(result_max, Pointwise(FloatEq(), expected_max));
+
+  Tensor2D<float, 2, 3> expected_min{-2, -4, -6, -8, -10, -12};
+  Tensor2D<float, 2, 3> result_min =
+      tosa::reduce_min<Tensor2D<float, 2, 3>>(input, 2);
+  EXPECT_THAT(result_min, Pointwise(FloatEq(), expected_min));
+}
+
+#ifdef EMITC_TOSA_USE_EIGEN
+// The naive kernels remain available next to the Eigen kernels.
+TEST(tosa, mixed_backends) {
+  using InputType = Tensor4D<float, 1, 3, 3, 2>;  // N H W C
+  using WeightType = Tensor4D<float, 2, 2, 2, 2>; // COUT KH KW CIN
+  using ResultType = Tensor4D<float, 1, 2, 2, 2>; // N H W C
+  InputType input{1,  2,  3,  4,  5,  6,  7,  8,  9,
+                  10, 11, 12, 13, 14, 15, 16, 17, 18};
+  WeightType weights{1, 0, -1, 2, 0, 1, 1, -1, 2, 1, 0, 0, -1, 1, 3, 0};
+  Tensor1D<int64_t, 4> padding{0, 0, 0, 0};
+  Tensor1D<int64_t, 2> stride{1, 1};
+  Tensor1D<int64_t, 2> dilation{1, 1};
+
+  ResultType naive_result = tosa::naive::conv2d<ResultType>(
+      input, weights, padding, stride, dilation);
+  ResultType eigen_result = tosa::eigen::conv2d<ResultType>(
+      input, weights, padding, stride, dilation);
+  EXPECT_THAT(eigen_result, Pointwise(FloatNear(EPSILON), naive_result));
+
+  Tensor3D<float, 1, 3, 2> naive_sum =
+      tosa::naive::reduce_sum<Tensor3D<float, 1, 3, 2>>(input, 1);
+  Tensor3D<float, 1, 3, 2> eigen_sum =
+      tosa::eigen::reduce_sum<Tensor3D<float, 1, 3, 2>>(input, 1);
+  EXPECT_THAT(eigen_sum, Pointwise(FloatEq(), naive_sum));
+}
+#endif
+
+#if defined(EMITC_TOSA_USE_EIGEN) && defined(EIGEN_USE_THREADS)
+// The thread pool tests are benchmarks, see benchmark.h.
+
+template <typename T>
+void fill(T &tensor) {
+  for (size_t i = 0; i < tensor.size(); i++) {
+    tensor[i] = static_cast<float>(i % 7) - 3;
+  }
+}
+
+class ThreadPoolTest : public ::testing::Test {
+protected:
+  ThreadPoolTest() : pool(4), device(&pool, 4) {}
+
+  void TearDown() override { eigen::set_thread_pool_device(nullptr); }
+
+  // Runs `f` on the default and on the thread pool device, checks that the
+  // results are equal and reports the runtimes.
+  template <typename F>
+  void compare(const std::string &name, F f) {
+    auto expected_result = f();
+    double single = benchmark(f);
+
+    eigen::set_thread_pool_device(&device);
+    auto result = f();
+    double threaded = benchmark(f);
+    eigen::set_thread_pool_device(nullptr);
+
+    EXPECT_THAT(result, Pointwise(FloatNear(EPSILON), expected_result));
+    report_speed() << name << ": " << single << " ms, " << threaded
+                   << " ms on 4 threads\n";
   }
+
+  Eigen::ThreadPool pool;
+  Eigen::ThreadPoolDevice device;
+};
+
+TEST_F(ThreadPoolTest, DISABLED_conv2d) {
+  Tensor4D<float, 1, 56, 56, 32> input;
+  Tensor4D<float, 64, 3, 3, 32> weights;
+  fill(input);
+  fill(weights);
+  Tensor1D<int64_t, 4> padding{1, 1, 1, 1};
+  Tensor1D<int64_t, 2> stride{1, 1};
+  Tensor1D<int64_t, 2> dilation{1, 1};
+
+  compare("conv2d", [&]() {
+    return tosa::conv2d<Tensor4D<float, 1, 56, 56, 64>>(input, weights,
+                                                        padding, stride,
+                                                        dilation);
+  });
+}
+
+TEST_F(ThreadPoolTest, DISABLED_depthwise_conv2d) {
+  Tensor4D<float, 1, 56, 56, 64> input;
+  Tensor4D<float, 3, 3, 64, 1> weights;
+  fill(input);
+  fill(weights);
+  Tensor1D<int64_t, 4> padding{1, 1, 1, 1};
+  Tensor1D<int64_t, 2> stride{1, 1};
+  Tensor1D<int64_t, 2> dilation{1, 1};
+
+  compare("depthwise_conv2d", [&]() {
+    return tosa::depthwise_conv2d<Tensor4D<float, 1, 56, 56, 64>>(
+        input, weights, padding, stride, dilation);
+  });
+}
+
+TEST_F(ThreadPoolTest, DISABLED_pool2d) {
+  Tensor4D<float, 1, 112, 112, 32> input;
+  fill(input);
+
+  compare("max_pool2d", [&]() {
+    return tosa::max_pool2d<Tensor4D<float, 1, 56, 56, 32>>(
+        input, {0, 1, 0, 1}, {2, 2}, {3, 3});
+  });
+  compare("avg_pool2d", [&]() {
+    return tosa::avg_pool2d<Tensor4D<float, 1, 56, 56, 32>>(
+        input, {0, 1, 0, 1}, {2, 2}, {3, 3});
+  });
+}
+
+TEST_F(ThreadPoolTest, DISABLED_reduce_sum) {
+  Tensor3D<float, 64, 256, 64> input;
+  fill(input);
+
+  compare("reduce_sum", [&]() {
+    return tosa::reduce_sum<Tensor2D<float, 64, 64>>(input, 1);
+  });
+}
+
+// Compares against the generic implementations in core_ops.h
+TEST_F(ThreadPoolTest, DISABLED_matmul) {
+  using AType = Tensor3D<float, 4, 128, 256>;
+  using BType = Tensor3D<float, 4, 256, 128>;
+  using CType = Tensor3D<float, 4, 128, 128>;
+  AType a;
+  BType b;
+  fill(a);
+  fill(b);
+
+  auto generic_matmul = [&]() { return emitc::batch_matmul<CType>(a, b); };
+  CType expected_result = generic_matmul();
+  report_speed() << "generic matmul: " << benchmark(generic_matmul)
+                 << " ms\n";
+
+  EXPECT_THAT(tosa::matmul(a, b),
+              Pointwise(FloatNear(EPSILON), expected_result));
+  compare("matmul", [&]() { return tosa::matmul(a, b); });
+}
+
+TEST_F(ThreadPoolTest, DISABLED_fully_connected) {
+  using InputType = Tensor2D<float, 16, 1280>;
+  using WeightsType = Tensor2D<float, 1000, 1280>;
+  using BiasType = Tensor1D<float, 1000>;
+  using ResultType = Tensor2D<float, 16, 1000>;
+  InputType input;
+  WeightsType weights;
+  BiasType bias;
+  fill(input);
+  fill(weights);
+  fill(bias);
+
+  auto generic_fc = [&]() {
+    return tosa::naive::fully_connected_transposed<ResultType, false, false>(
+        input, weights, bias);
+  };
+  ResultType expected_result = generic_fc();
+  report_speed() << "generic fully_connected: " << benchmark(generic_fc)
+                 << " ms\n";
+
+  EXPECT_THAT(tosa::fully_connected<ResultType>(input, weights, bias),
+              Pointwise(FloatNear(EPSILON), expected_result));
+  compare("fully_connected", [&]() {
+    return tosa::fully_connected<ResultType>(input, weights, bias);
+  });
 }
+#endif
 
 } // namespace
@@ -15,10 +15,12 @@
 
 set -e
 
-if [[ $# -ne 7 ]] ; then
-  echo "Usage: $0 <path/to/model> <path/to/emitc/reference-implementation/include/> <path/to/emitc-opt> <compiler> <batch-size> <seed> <output_dir>"
+if [[ $# -ne 7 && $# -ne 8 ]] ; then
+  echo "Usage: $0 <path/to/model> <path/to/emitc/reference-implementation/include/> <path/to/emitc-opt> <compiler> <batch-size> <seed> <output_dir> [weight-type]"
   echo
   echo "Both a keras and a tensorflow saved model is supported."
+  echo "If a weight type (f16, bf16 or i8) is given, constant weights are packed"
+  echo "and stored compressed, and the accuracy loss is reported."
   echo
   echo "This script expects a python version in the PATH with a recent version of tensorflow installed."
   echo "Tested with python 3.10.12 and tf-nightly 2.16.0.dev20231102"
@@ -34,6 +36,7 @@ CPP_COMPILER=$4
 BATCH_SIZE=$5
 SEED=$6
 OUTPUT_DIR=$7
+WEIGHT_TYPE=${8:-}
 
 echo "MODEL=$MODEL"
 echo "EMITC_INCLUDE_DIR=$EMITC_INCLUDE_DIR"
@@ -43,6 +46,7 @@ echo "CPP_COMPILER=$CPP_COMPILER"
 echo "BATCH_SIZE=$BATCH_SIZE"
 echo "SEED=$SEED"
 echo "OUTPUT_DIR=$OUTPUT_DIR"
+echo "WEIGHT_TYPE=$WEIGHT_TYPE"
 
 echo "Setting up output directory"
 mkdir -p "$OUTPUT_DIR"
@@ -69,13 +73,19 @@ FUNCTION_NAME=$(grep -m 1 -oe "@[^(]*" "$OUTPUT_DIR"/model_tosa_noattr.mlir)
 sed "s/$FUNCTION_NAME/@predict/g" "$OUTPUT_DIR"/model_tosa_noattr.mlir > "$OUTPUT_DIR"/model_fix_name.mlir
 
 echo "Converting tosa dialect to emitc dialect"
-"$EMITC_OPT" --insert-emitc-tosa-include --convert-tosa-to-emitc "$OUTPUT_DIR"/model_fix_name.mlir > "$OUTPUT_DIR"/model_emitc.mlir
+if [[ -z "$WEIGHT_TYPE" ]] ; then
+  "$EMITC_OPT" --insert-emitc-tosa-include --convert-tosa-to-emitc "$OUTPUT_DIR"/model_fix_name.mlir > "$OUTPUT_DIR"/model_emitc.mlir
+  EPS=1e-4
+else
+  "$EMITC_OPT" --pack-tosa-weights="weight-type=$WEIGHT_TYPE" --insert-emitc-tosa-include --convert-tosa-to-emitc --lower-emitc-half-types "$OUTPUT_DIR"/model_fix_name.mlir > "$OUTPUT_DIR"/model_emitc.mlir
+  EPS=1e-1
+fi
 
 echo "Translating emitc dialect to cpp header"
 "$EMITC_TRANSLATE" --mlir-to-cpp "$OUTPUT_DIR"/model_emitc.mlir > "$OUTPUT_DIR"/model_generated.h
 
 echo "Generating test case"
-python generate_testscases.py --file-format cpp --count 1 --batch-size "$BATCH_SIZE" --seed "$SEED" "$MODEL" "$OUTPUT_DIR"
+python generate_testscases.py --file-format cpp --count 1 --batch-size "$BATCH_SIZE" --seed "$SEED" --eps "$EPS" "$MODEL" "$OUTPUT_DIR"
 
 echo "Compiling test case"
 "$CPP_COMPILER" "$OUTPUT_DIR"/test.cpp -O3 -I "$EMITC_INCLUDE_DIR" -I "$OUTPUT_DIR" -o "$OUTPUT_DIR"/test
@@ -59,7 +59,7 @@ def generate_examples(model, count: int, seed: int, batch_size: int):
     return result
 
 
-def save_examples(path: str, examples, file_format: str):
+def save_examples(path: str, examples, file_format: str, eps: float):
     def c_type_specifier(array: np.ndarray) -> str:
         dtype = array.dtype
         if dtype == np.float32:
@@ -94,19 +94,23 @@ def save_examples(path: str, examples, file_format: str):
                         f"{{{', '.join(map(c_value, curr_output.flat))}}};\n")
     elif file_format == "cpp":
         with open(Path(path) / "test.cpp", mode="w") as output_file:
+            output_file.write("#include <algorithm>\n")
             output_file.write("#include <iostream>\n")
             output_file.write('#include "model_generated.h"\n')
             output_file.write("\n")
             output_file.write("""template <typename T, typename U>
 bool check_tensor(T result, U expected, float eps, bool print_error) {
     bool error = false;
+    float max_err = 0;
     for (size_t i = 0; i < result.size(); i++) {
         auto err = std::abs(result[i] - expected[i]);
         error |= (err > eps);
+        max_err = std::max<float>(max_err, err);
         if (print_error) {
             std::cout << "index " << i << " -> " << err << std::endl;
         }
     }
+    std::cout << "max abs error " << max_err << std::endl;
     return error;
 }
   """)
@@ -145,7 +149,7 @@ bool check_tensor(T result, U expected, float eps, bool print_error) {
                         f"Tensor<{c_type}, {shape_str}> result{i};\n")
 
             output_file.write("bool error = false;\n")
-            output_file.write("float EPS = 1e-4;\n")
+            output_file.write(f"float EPS = {eps};\n")
 
             if len(outputs) > 1:
                 results_str = ",".join(f"result{i}"
@@ -180,10 +184,11 @@ def generate(
     count: int,
     seed: int,
     batch_size: int,
+    eps: float,
 ):
     model = tf.keras.models.load_model(model_path)
     examples = generate_examples(model, count, seed, batch_size)
-    save_examples(output_path, examples, file_format)
+    save_examples(output_path, examples, file_format, eps)
 
 
 def main():
@@ -207,6 +212,12 @@ def main():
         default=1,
         help="Set the batch size for the testcases",
     )
+    parser.add_argument(
+        "--eps",
+        type=float,
+        default=1e-4,
+        help="Maximum absolute error of the outputs in the cpp test",
+    )
     parser.add_argument("--file-format",
                         choices=["header", "cpp"],
                         required=True)
@@ -217,7 +228,7 @@ def main():
     args = parser.parse_args()
 
     generate(args.model_path, args.output, args.file_format, args.count,
-             args.seed, args.batch_size)
+             args.seed, args.batch_size, args.eps)
 
 
 if __name__ == "__main__":
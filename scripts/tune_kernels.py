@@ -0,0 +1,198 @@
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import argparse
+import json
+from pathlib import Path
+import re
+import subprocess
+import tempfile
+
+KERNEL_PATTERN = re.compile(
+    r'func\.func @(kernel_\d+)\(.*attributes \{'
+    r'emitc\.kernel_backends = \[(?P<backends>[^\]]*)\], '
+    r'emitc\.kernel_signature = "(?P<signature>(?:[^"\\]|\\.)*)"')
+
+BACKEND_DEFINES = {
+    "naive": [],
+    "eigen": ["-DEMITC_STABLEHLO_USE_EIGEN", "-DEMITC_TOSA_USE_EIGEN"],
+    "blas": ["-DEMITC_USE_BLAS"],
+}
+
+BENCHMARK_MAIN = """
+#include <chrono>
+#include <cstdio>
+#include <tuple>
+
+template <typename T>
+void fill(T &tensor) {
+  for (size_t i = 0; i < tensor.size(); i++) {
+    tensor[i] = static_cast<typename T::value_type>(i % 7) - 3;
+  }
+}
+
+double checksum = 0;
+
+template <typename Result, typename... Args>
+double benchmark(Result (*kernel)(Args...), int repetitions) {
+  std::tuple<Args...> args;
+  std::apply([](auto &...tensors) { (fill(tensors), ...); }, args);
+  checksum += std::apply(kernel, args)[0];
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; i++) {
+    checksum += std::apply(kernel, args)[0];
+  }
+  std::chrono::duration<double, std::milli> time =
+      std::chrono::steady_clock::now() - start;
+  return time.count() / repetitions;
+}
+
+int main() {
+{calls}
+  std::fprintf(stderr, "checksum %f\\n", checksum);
+  return 0;
+}
+"""
+
+
+def unescape(string: str) -> str:
+    return re.sub(r"\\([0-9A-Fa-f]{2})", lambda m: chr(int(m.group(1), 16)),
+                  string)
+
+
+def run(command, **kwargs):
+    return subprocess.run(command,
+                          check=True,
+                          stdout=subprocess.PIPE,
+                          universal_newlines=True,
+                          **kwargs).stdout
+
+
+def extract_kernels(emitc_opt: str, input_path: str, backend: str = ""):
+    option = f"=backend={backend}" if backend else ""
+    mlir = run([emitc_opt, f"--extract-emitc-kernels{option}", input_path])
+
+    kernels = {}
+    for match in KERNEL_PATTERN.finditer(mlir):
+        backends = re.findall(r'"(\w+)"', match.group("backends"))
+        kernels[match.group(1)] = (unescape(match.group("signature")),
+                                   backends)
+    return mlir, kernels
+
+
+def tune(args):
+    _, kernels = extract_kernels(args.emitc_opt, args.input_path)
+    if not kernels:
+        print("No tunable calls found.")
+
+    includes = set()
+    sources = []
+    calls = []
+    flags = []
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        for backend in args.backends:
+            mlir, backend_kernels = extract_kernels(args.emitc_opt,
+                                                    args.input_path, backend)
+            mlir_path = Path(tmp_dir) / f"{backend}.mlir"
+            mlir_path.write_text(mlir)
+            cpp = run([args.emitc_translate, "--mlir-to-cpp", mlir_path])
+
+            body = []
+            for line in cpp.splitlines():
+                if line.startswith("#include"):
+                    includes.add(line)
+                else:
+                    body.append(line)
+            sources.append(f"namespace tuning_{backend} {{\n" +
+                           "\n".join(body) +
+                           f"\n}} // namespace tuning_{backend}")
+            calls.extend(
+                f'  std::printf("{name} {backend} %f\\n", '
+                f"benchmark(tuning_{backend}::{name}, {args.repetitions}));"
+                for name in backend_kernels)
+            flags.extend(BACKEND_DEFINES[backend])
+
+        benchmark_path = Path(tmp_dir) / "benchmark.cpp"
+        benchmark_path.write_text(
+            "\n".join(sorted(includes)) + "\n\n" + "\n\n".join(sources) +
+            "\n" + BENCHMARK_MAIN.replace("{calls}", "\n".join(calls)))
+        executable_path = Path(tmp_dir) / "benchmark"
+        run([args.cxx, "-std=c++17", f"-I{args.include_dir}"] +
+            sorted(set(flags)) + args.cxxflags.split() +
+            [benchmark_path, "-o", executable_path] + args.ldflags.split())
+        output = run([executable_path])
+
+    times = {}
+    for line in output.splitlines():
+        name, backend, time = line.split()
+        times.setdefault(name, {})[backend] = float(time)
+
+    database = {"version": 1, "kernels": []}
+    for name, (signature, _) in kernels.items():
+        if name not in times:
+            continue
+        backend = min(times[name], key=times[name].get)
+        database["kernels"].append({
+            "signature": signature,
+            "backend": backend,
+            "times_ms": times[name]
+        })
+        print(f"{signature}\n  {backend}: " + ", ".join(
+            f"{b} {t:.4f} ms" for b, t in times[name].items()))
+
+    with open(args.output_path, "w") as file:
+        json.dump(database, file, indent=2)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark the kernel backends of the reference "
+        "implementation for each unique call of an EmitC module and write "
+        "the fastest backends to a tuning database")
+    parser.add_argument("input_path",
+                        metavar="input-path",
+                        help="Path to the EmitC module")
+    parser.add_argument("output_path",
+                        metavar="output-path",
+                        help="Path of the tuning database")
+    parser.add_argument("--include-dir",
+                        required=True,
+                        help="Include directory of the reference "
+                        "implementation")
+    parser.add_argument("--backends",
+                        nargs="+",
+                        default=["naive"],
+                        choices=BACKEND_DEFINES.keys(),
+                        help="Kernel backends to benchmark")
+    parser.add_argument("--emitc-opt", default="emitc-opt")
+    parser.add_argument("--emitc-translate", default="emitc-translate")
+    parser.add_argument("--cxx", default="c++", help="C++ compiler")
+    parser.add_argument("--cxxflags",
+                        default="-O3 -DNDEBUG",
+                        help="Compiler flags, e.g. Eigen include directories")
+    parser.add_argument("--ldflags",
+                        default="",
+                        help="Linker flags, e.g. -lcblas or -lpthread")
+    parser.add_argument("--repetitions",
+                        type=int,
+                        default=100,
+                        help="Number of timed calls per kernel")
+    args = parser.parse_args()
+
+    tune(args)
+
+
+if __name__ == "__main__":
+    main()
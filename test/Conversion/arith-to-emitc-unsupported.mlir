@@ -0,0 +1,17 @@
+// RUN: emitc-opt -convert-arith-to-emitc %s | FileCheck %s
+
+// Ops without a native C++ equivalent are kept.
+// CHECK-LABEL: func @arith_unsupported
+func.func @arith_unsupported(%arg0: f32, %arg1: i32, %arg2: i1, %arg3: tensor<2xf32>) -> (i1, i32, i1, i32, tensor<2xf32>) {
+  // CHECK-NEXT: arith.cmpf ult
+  // CHECK-NEXT: arith.divui
+  // CHECK-NEXT: arith.addi %arg2, %arg2 : i1
+  // CHECK-NEXT: arith.extsi %arg2 : i1 to i32
+  // CHECK-NEXT: arith.addf %arg3, %arg3 : tensor<2xf32>
+  %0 = arith.cmpf ult, %arg0, %arg0 : f32
+  %1 = arith.divui %arg1, %arg1 : i32
+  %2 = arith.addi %arg2, %arg2 : i1
+  %3 = arith.extsi %arg2 : i1 to i32
+  %4 = arith.addf %arg3, %arg3 : tensor<2xf32>
+  return %0, %1, %2, %3, %4 : i1, i32, i1, i32, tensor<2xf32>
+}
@@ -12,12 +12,149 @@ func.func @arith_index_cast(%arg0: tensor<index>, %arg1: tensor<2xi32>, %arg2: t
   return %1 : tensor<2xindex>
 }
 // CHECK-LABEL: func @arith_index_cast
-//  CHECK-NEXT: emitc.call_opaque "emitc::arith::index_cast"(%arg0) {template_args = [tensor<i32>]} : (tensor<index>) -> tensor<i32>
-//  CHECK-NEXT: emitc.call_opaque "emitc::arith::index_cast"(%arg1) {template_args = [tensor<2xindex>]} : (tensor<2xi32>) -> tensor<2xindex>
-//  CHECK-NEXT: emitc.call_opaque "emitc::arith::index_cast"(%arg2) {template_args = [tensor<2x2xindex>]} : (tensor<2x2xi32>) -> tensor<2x2xindex>
+//  CHECK-NEXT: emitc.call_opaque "emitc::arith::index_cast"(%arg0) {emitc.pure, template_args = [tensor<i32>]} : (tensor<index>) -> tensor<i32>
+//  CHECK-NEXT: emitc.call_opaque "emitc::arith::index_cast"(%arg1) {emitc.pure, template_args = [tensor<2xindex>]} : (tensor<2xi32>) -> tensor<2xindex>
+//  CHECK-NEXT: emitc.call_opaque "emitc::arith::index_cast"(%arg2) {emitc.pure, template_args = [tensor<2x2xindex>]} : (tensor<2x2xi32>) -> tensor<2x2xindex>
 
 // CPP-LABEL: Tensor<size_t, 2> arith_index_cast(Tensor<size_t> v1, Tensor<int32_t, 2> v2, Tensor<int32_t, 2, 2> v3)
 //  CPP-NEXT: emitc::arith::index_cast<Tensor<int32_t>>(v1)
 //  CPP-NEXT: emitc::arith::index_cast<Tensor<size_t, 2>>(v2)
 //  CPP-NEXT: emitc::arith::index_cast<Tensor<size_t, 2, 2>>(v3)
 //  CPP-NEXT: return v5;
+
+// Integer operations that wrap around are computed as unsigned.
+func.func @arith_scalar_int(%arg0: i32, %arg1: i32) -> i32 {
+  %0 = arith.addi %arg0, %arg1 : i32
+  %1 = arith.muli %0, %arg1 : i32
+  %2 = arith.divsi %1, %arg0 : i32
+  %3 = arith.cmpi slt, %2, %arg1 : i32
+  %4 = arith.select %3, %2, %arg0 : i32
+  return %4 : i32
+}
+// CHECK-LABEL: func @arith_scalar_int
+//  CHECK-NEXT: %[[LHS0:.*]] = emitc.cast %arg0 : i32 to ui32
+//  CHECK-NEXT: %[[RHS0:.*]] = emitc.cast %arg1 : i32 to ui32
+//  CHECK-NEXT: %[[ADD:.*]] = emitc.add %[[LHS0]], %[[RHS0]] : (ui32, ui32) -> ui32
+//  CHECK-NEXT: %[[ADDI:.*]] = emitc.cast %[[ADD]] : ui32 to i32
+//  CHECK-NEXT: %[[LHS1:.*]] = emitc.cast %[[ADDI]] : i32 to ui32
+//  CHECK-NEXT: %[[RHS1:.*]] = emitc.cast %arg1 : i32 to ui32
+//  CHECK-NEXT: %[[MUL:.*]] = emitc.mul %[[LHS1]], %[[RHS1]] : (ui32, ui32) -> ui32
+//  CHECK-NEXT: %[[MULI:.*]] = emitc.cast %[[MUL]] : ui32 to i32
+//  CHECK-NEXT: %[[DIV:.*]] = emitc.div %[[MULI]], %arg0 : (i32, i32) -> i32
+//  CHECK-NEXT: %[[CMP:.*]] = emitc.cmp lt, %[[DIV]], %arg1 : (i32, i32) -> i1
+//  CHECK-NEXT: %[[SELECT:.*]] = emitc.conditional %[[CMP]], %[[DIV]], %arg0 : i32
+//  CHECK-NEXT: return %[[SELECT]] : i32
+
+// CPP-LABEL: int32_t arith_scalar_int(int32_t v1, int32_t v2)
+//  CPP-NEXT: uint32_t v3 = (uint32_t) v1;
+//  CPP-NEXT: uint32_t v4 = (uint32_t) v2;
+//  CPP-NEXT: uint32_t v5 = v3 + v4;
+//  CPP-NEXT: int32_t v6 = (int32_t) v5;
+//       CPP: int32_t v11 = v10 / v1;
+//  CPP-NEXT: bool v12 = v11 < v2;
+//  CPP-NEXT: int32_t v13 = v12 ? v11 : v1;
+//  CPP-NEXT: return v13;
+
+// Integers narrower than 32 bits are computed in ui32 and truncated, since
+// C++ promotes narrower unsigned operands to int.
+func.func @arith_scalar_narrow_int(%arg0: i8, %arg1: i16) -> (i8, i16) {
+  %0 = arith.addi %arg0, %arg0 : i8
+  %1 = arith.muli %arg1, %arg1 : i16
+  return %0, %1 : i8, i16
+}
+// CHECK-LABEL: func @arith_scalar_narrow_int
+//  CHECK-NEXT: %[[LHS0:.*]] = emitc.cast %arg0 : i8 to ui32
+//  CHECK-NEXT: %[[RHS0:.*]] = emitc.cast %arg0 : i8 to ui32
+//  CHECK-NEXT: %[[ADD:.*]] = emitc.add %[[LHS0]], %[[RHS0]] : (ui32, ui32) -> ui32
+//  CHECK-NEXT: %[[ADDI:.*]] = emitc.cast %[[ADD]] : ui32 to i8
+//  CHECK-NEXT: %[[LHS1:.*]] = emitc.cast %arg1 : i16 to ui32
+//  CHECK-NEXT: %[[RHS1:.*]] = emitc.cast %arg1 : i16 to ui32
+//  CHECK-NEXT: %[[MUL:.*]] = emitc.mul %[[LHS1]], %[[RHS1]] : (ui32, ui32) -> ui32
+//  CHECK-NEXT: %[[MULI:.*]] = emitc.cast %[[MUL]] : ui32 to i16
+//  CHECK-NEXT: return %[[ADDI]], %[[MULI]] : i8, i16
+
+// CPP-LABEL: std::tuple<int8_t, int16_t> arith_scalar_narrow_int(int8_t v1, int16_t v2)
+//  CPP-NEXT: uint32_t v3 = (uint32_t) v1;
+//  CPP-NEXT: uint32_t v4 = (uint32_t) v1;
+//  CPP-NEXT: uint32_t v5 = v3 + v4;
+//  CPP-NEXT: int8_t v6 = (int8_t) v5;
+//  CPP-NEXT: uint32_t v7 = (uint32_t) v2;
+//  CPP-NEXT: uint32_t v8 = (uint32_t) v2;
+//  CPP-NEXT: uint32_t v9 = v7 * v8;
+//  CPP-NEXT: int16_t v10 = (int16_t) v9;
+
+// Index is emitted as size_t and compared as signed with int64_t.
+func.func @arith_scalar_index(%arg0: index, %arg1: index) -> (index, i1, i1) {
+  %0 = arith.addi %arg0, %arg1 : index
+  %1 = arith.cmpi slt, %0, %arg1 : index
+  %2 = arith.cmpi ult, %0, %arg1 : index
+  return %0, %1, %2 : index, i1, i1
+}
+// CHECK-LABEL: func @arith_scalar_index
+//  CHECK-NEXT: %[[ADD:.*]] = emitc.add %arg0, %arg1 : (index, index) -> index
+//  CHECK-NEXT: %[[LHS:.*]] = emitc.cast %[[ADD]] : index to i64
+//  CHECK-NEXT: %[[RHS:.*]] = emitc.cast %arg1 : index to i64
+//  CHECK-NEXT: %[[SLT:.*]] = emitc.cmp lt, %[[LHS]], %[[RHS]] : (i64, i64) -> i1
+//  CHECK-NEXT: %[[ULT:.*]] = emitc.cmp lt, %[[ADD]], %arg1 : (index, index) -> i1
+//  CHECK-NEXT: return %[[ADD]], %[[SLT]], %[[ULT]] : index, i1, i1
+
+func.func @arith_scalar_float(%arg0: f32, %arg1: i32) -> (f64, i1, index) {
+  %0 = arith.sitofp %arg1 : i32 to f32
+  %1 = arith.mulf %arg0, %0 : f32
+  %2 = arith.extf %1 : f32 to f64
+  %3 = arith.cmpf oge, %1, %arg0 : f32
+  %4 = arith.index_cast %arg1 : i32 to index
+  return %2, %3, %4 : f64, i1, index
+}
+// CHECK-LABEL: func @arith_scalar_float
+//  CHECK-NEXT: %[[SITOFP:.*]] = emitc.cast %arg1 : i32 to f32
+//  CHECK-NEXT: %[[MUL:.*]] = emitc.mul %arg0, %[[SITOFP]] : (f32, f32) -> f32
+//  CHECK-NEXT: %[[EXTF:.*]] = emitc.cast %[[MUL]] : f32 to f64
+//  CHECK-NEXT: %[[CMP:.*]] = emitc.cmp ge, %[[MUL]], %arg0 : (f32, f32) -> i1
+//  CHECK-NEXT: %[[INDEX:.*]] = emitc.cast %arg1 : i32 to index
+//  CHECK-NEXT: return %[[EXTF]], %[[CMP]], %[[INDEX]] : f64, i1, index
+
+// CPP-LABEL: std::tuple<double, bool, size_t> arith_scalar_float(float v1, int32_t v2)
+//  CPP-NEXT: float v3 = (float) v2;
+//  CPP-NEXT: float v4 = v1 * v3;
+//  CPP-NEXT: double v5 = (double) v4;
+//  CPP-NEXT: bool v6 = v4 >= v1;
+//  CPP-NEXT: size_t v7 = (size_t) v2;
+
+func.func @arith_scalar_ops(%arg0: i32, %arg1: f64, %arg2: i16) -> (f32, i16, i32, i64) {
+  %0 = arith.subi %arg0, %arg0 : i32
+  %1 = arith.subf %arg1, %arg1 : f64
+  %2 = arith.divf %1, %arg1 : f64
+  %3 = arith.remsi %0, %arg0 : i32
+  %4 = arith.truncf %2 : f64 to f32
+  %5 = arith.trunci %3 : i32 to i16
+  %6 = arith.fptosi %4 : f32 to i32
+  %7 = arith.extsi %arg2 : i16 to i64
+  return %4, %5, %6, %7 : f32, i16, i32, i64
+}
+// CHECK-LABEL: func @arith_scalar_ops
+//  CHECK-NEXT: %[[LHS:.*]] = emitc.cast %arg0 : i32 to ui32
+//  CHECK-NEXT: %[[RHS:.*]] = emitc.cast %arg0 : i32 to ui32
+//  CHECK-NEXT: %[[SUB:.*]] = emitc.sub %[[LHS]], %[[RHS]] : (ui32, ui32) -> ui32
+//  CHECK-NEXT: %[[SUBI:.*]] = emitc.cast %[[SUB]] : ui32 to i32
+//  CHECK-NEXT: %[[SUBF:.*]] = emitc.sub %arg1, %arg1 : (f64, f64) -> f64
+//  CHECK-NEXT: %[[DIVF:.*]] = emitc.div %[[SUBF]], %arg1 : (f64, f64) -> f64
+//  CHECK-NEXT: %[[REMSI:.*]] = emitc.rem %[[SUBI]], %arg0 : (i32, i32) -> i32
+//  CHECK-NEXT: %[[TRUNCF:.*]] = emitc.cast %[[DIVF]] : f64 to f32
+//  CHECK-NEXT: %[[TRUNCI:.*]] = emitc.cast %[[REMSI]] : i32 to i16
+//  CHECK-NEXT: %[[FPTOSI:.*]] = emitc.cast %[[TRUNCF]] : f32 to i32
+//  CHECK-NEXT: %[[EXTSI:.*]] = emitc.cast %arg2 : i16 to i64
+//  CHECK-NEXT: return %[[TRUNCF]], %[[TRUNCI]], %[[FPTOSI]], %[[EXTSI]] : f32, i16, i32, i64
+
+// CPP-LABEL: std::tuple<float, int16_t, int32_t, int64_t> arith_scalar_ops(int32_t v1, double v2, int16_t v3)
+//  CPP-NEXT: uint32_t v4 = (uint32_t) v1;
+//  CPP-NEXT: uint32_t v5 = (uint32_t) v1;
+//  CPP-NEXT: uint32_t v6 = v4 - v5;
+//  CPP-NEXT: int32_t v7 = (int32_t) v6;
+//  CPP-NEXT: double v8 = v2 - v2;
+//  CPP-NEXT: double v9 = v8 / v2;
+//  CPP-NEXT: int32_t v10 = v7 % v1;
+//  CPP-NEXT: float v11 = (float) v9;
+//  CPP-NEXT: int16_t v12 = (int16_t) v10;
+//  CPP-NEXT: int32_t v13 = (int32_t) v11;
+//  CPP-NEXT: int64_t v14 = (int64_t) v3;
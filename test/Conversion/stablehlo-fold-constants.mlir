@@ -0,0 +1,60 @@
+// RUN: emitc-opt -fold-stablehlo-constants %s | FileCheck %s
+// RUN: emitc-opt -fold-stablehlo-constants -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+
+// STATS: FoldStablehloConstants
+// STATS-DAG: 5 num-removed-ops
+// STATS-DAG: 78 num-removed-bytes
+
+// CHECK-LABEL: func @stablehlo_transpose
+func.func @stablehlo_transpose() -> tensor<3x2xi32> {
+  // CHECK-NEXT: %[[CST:.*]] = stablehlo.constant dense<{{\[}}[1, 4], [2, 5], [3, 6]]> : tensor<3x2xi32>
+  // CHECK-NEXT: return %[[CST]]
+  %0 = stablehlo.constant dense<[[1, 2, 3], [4, 5, 6]]> : tensor<2x3xi32>
+  %1 = "stablehlo.transpose"(%0) {permutation = array<i64: 1, 0>} : (tensor<2x3xi32>) -> tensor<3x2xi32>
+  return %1 : tensor<3x2xi32>
+}
+
+// CHECK-LABEL: func @stablehlo_convert
+func.func @stablehlo_convert() -> tensor<3xf16> {
+  // CHECK-NEXT: %[[CST:.*]] = stablehlo.constant dense<[1.000000e+00, 2.000000e+00, 3.000000e+00]> : tensor<3xf16>
+  // CHECK-NEXT: return %[[CST]]
+  %0 = stablehlo.constant dense<[1, 2, 3]> : tensor<3xui32>
+  %1 = "stablehlo.convert"(%0) : (tensor<3xui32>) -> tensor<3xf16>
+  return %1 : tensor<3xf16>
+}
+
+// CHECK-LABEL: func @stablehlo_reshape_multiply
+func.func @stablehlo_reshape_multiply() -> tensor<2x2xf32> {
+  // CHECK-NEXT: %[[CST:.*]] = stablehlo.constant dense<{{\[}}[2.000000e+00, 4.000000e+00], [6.000000e+00, 8.000000e+00]]> : tensor<2x2xf32>
+  // CHECK-NEXT: return %[[CST]]
+  %0 = stablehlo.constant dense<[1.0, 2.0, 3.0, 4.0]> : tensor<4xf32>
+  %1 = "stablehlo.reshape"(%0) : (tensor<4xf32>) -> tensor<2x2xf32>
+  %2 = stablehlo.constant dense<2.0> : tensor<2x2xf32>
+  %3 = "stablehlo.multiply"(%1, %2) : (tensor<2x2xf32>, tensor<2x2xf32>) -> tensor<2x2xf32>
+  return %3 : tensor<2x2xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_convolution_weights
+func.func @stablehlo_convolution_weights(%arg0: tensor<1x4x4x2xf32>) -> tensor<1x4x4x2xf32> {
+  // CHECK-NOT: stablehlo.transpose
+  // CHECK: %[[CST:.*]] = stablehlo.constant dense<{{\[\[\[}}[1.000000e+00, 3.000000e+00], [2.000000e+00, 4.000000e+00]]]]> : tensor<1x1x2x2xf32>
+  // CHECK: stablehlo.convolution{{.*}}%arg0, %[[CST]]
+  %0 = stablehlo.constant dense<[[[[1.0, 2.0], [3.0, 4.0]]]]> : tensor<1x1x2x2xf32>
+  %1 = "stablehlo.transpose"(%0) {permutation = array<i64: 0, 1, 3, 2>} : (tensor<1x1x2x2xf32>) -> tensor<1x1x2x2xf32>
+  %2 = "stablehlo.convolution"(%arg0, %1) {
+    batch_group_count = 1 : i64,
+    dimension_numbers = #stablehlo.conv<raw
+      input_batch_dimension = 0,
+      input_feature_dimension = 3,
+      input_spatial_dimensions = [1, 2],
+      kernel_input_feature_dimension = 2,
+      kernel_output_feature_dimension = 3,
+      kernel_spatial_dimensions = [0, 1],
+      output_batch_dimension = 0,
+      output_feature_dimension = 3,
+      output_spatial_dimensions = [1, 2]
+    >,
+    feature_group_count = 1 : i64
+  } : (tensor<1x4x4x2xf32>, tensor<1x1x2x2xf32>) -> tensor<1x4x4x2xf32>
+  return %2 : tensor<1x4x4x2xf32>
+}
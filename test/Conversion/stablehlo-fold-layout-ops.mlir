@@ -0,0 +1,75 @@
+// RUN: emitc-opt -fold-stablehlo-layout-ops %s | FileCheck %s
+// RUN: emitc-opt -fold-stablehlo-layout-ops -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+
+// STATS: FoldStablehloLayoutOps
+// STATS: 8 num-removed-ops
+
+// CHECK-LABEL: func @stablehlo_reshape_chain
+func.func @stablehlo_reshape_chain(%arg0: tensor<2x3x4xf32>) -> tensor<4x6xf32> {
+  // CHECK-NEXT: %[[R:.*]] = stablehlo.reshape %arg0 : (tensor<2x3x4xf32>) -> tensor<4x6xf32>
+  // CHECK-NEXT: return %[[R]]
+  %0 = "stablehlo.reshape"(%arg0) : (tensor<2x3x4xf32>) -> tensor<24xf32>
+  %1 = "stablehlo.reshape"(%0) : (tensor<24xf32>) -> tensor<4x6xf32>
+  return %1 : tensor<4x6xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_reshape_identity
+func.func @stablehlo_reshape_identity(%arg0: tensor<2x3xf32>) -> tensor<2x3xf32> {
+  // CHECK-NEXT: return %arg0
+  %0 = "stablehlo.reshape"(%arg0) : (tensor<2x3xf32>) -> tensor<6xf32>
+  %1 = "stablehlo.reshape"(%0) : (tensor<6xf32>) -> tensor<2x3xf32>
+  return %1 : tensor<2x3xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_reshape_duplicate
+func.func @stablehlo_reshape_duplicate(%arg0: tensor<2x3xf32>) -> tensor<6xf32> {
+  // CHECK-NEXT: %[[R:.*]] = stablehlo.reshape %arg0
+  // CHECK-NEXT: %[[ADD:.*]] = stablehlo.add %[[R]], %[[R]]
+  // CHECK-NEXT: return %[[ADD]]
+  %0 = "stablehlo.reshape"(%arg0) : (tensor<2x3xf32>) -> tensor<6xf32>
+  %1 = "stablehlo.reshape"(%arg0) : (tensor<2x3xf32>) -> tensor<6xf32>
+  %2 = "stablehlo.add"(%0, %1) : (tensor<6xf32>, tensor<6xf32>) -> tensor<6xf32>
+  return %2 : tensor<6xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_transpose_chain
+func.func @stablehlo_transpose_chain(%arg0: tensor<2x3x4xf32>) -> tensor<4x2x3xf32> {
+  // CHECK-NEXT: %[[T:.*]] = stablehlo.transpose %arg0, dims = [2, 0, 1] : (tensor<2x3x4xf32>) -> tensor<4x2x3xf32>
+  // CHECK-NEXT: return %[[T]]
+  %0 = "stablehlo.transpose"(%arg0) {permutation = array<i64: 1, 0, 2>} : (tensor<2x3x4xf32>) -> tensor<3x2x4xf32>
+  %1 = "stablehlo.transpose"(%0) {permutation = array<i64: 2, 1, 0>} : (tensor<3x2x4xf32>) -> tensor<4x2x3xf32>
+  return %1 : tensor<4x2x3xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_transpose_identity
+func.func @stablehlo_transpose_identity(%arg0: tensor<2x3xf32>) -> tensor<2x3xf32> {
+  // CHECK-NEXT: return %arg0
+  %0 = "stablehlo.transpose"(%arg0) {permutation = array<i64: 1, 0>} : (tensor<2x3xf32>) -> tensor<3x2xf32>
+  %1 = "stablehlo.transpose"(%0) {permutation = array<i64: 1, 0>} : (tensor<3x2xf32>) -> tensor<2x3xf32>
+  return %1 : tensor<2x3xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_transpose_as_reshape
+func.func @stablehlo_transpose_as_reshape(%arg0: tensor<1x1x3x4xf32>) -> tensor<3x1x4x1xf32> {
+  // CHECK-NEXT: %[[R:.*]] = stablehlo.reshape %arg0 : (tensor<1x1x3x4xf32>) -> tensor<3x1x4x1xf32>
+  // CHECK-NEXT: return %[[R]]
+  %0 = "stablehlo.transpose"(%arg0) {permutation = array<i64: 2, 0, 3, 1>} : (tensor<1x1x3x4xf32>) -> tensor<3x1x4x1xf32>
+  return %0 : tensor<3x1x4x1xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_broadcast_in_dim_as_reshape
+func.func @stablehlo_broadcast_in_dim_as_reshape(%arg0: tensor<4xf32>) -> tensor<2x2xf32> {
+  // CHECK-NEXT: %[[R:.*]] = stablehlo.reshape %arg0 : (tensor<4xf32>) -> tensor<2x2xf32>
+  // CHECK-NEXT: return %[[R]]
+  %0 = "stablehlo.broadcast_in_dim"(%arg0) {broadcast_dimensions = array<i64: 1>} : (tensor<4xf32>) -> tensor<1x4xf32>
+  %1 = "stablehlo.reshape"(%0) : (tensor<1x4xf32>) -> tensor<2x2xf32>
+  return %1 : tensor<2x2xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_broadcast_in_dim
+func.func @stablehlo_broadcast_in_dim(%arg0: tensor<1xf32>) -> tensor<1x3xf32> {
+  // CHECK-NEXT: %[[B:.*]] = stablehlo.broadcast_in_dim %arg0
+  // CHECK-NEXT: return %[[B]]
+  %0 = "stablehlo.broadcast_in_dim"(%arg0) {broadcast_dimensions = array<i64: 1>} : (tensor<1xf32>) -> tensor<1x3xf32>
+  return %0 : tensor<1x3xf32>
+}
@@ -0,0 +1,83 @@
+// RUN: emitc-opt -fold-stablehlo-pad %s | FileCheck %s
+
+// CHECK-LABEL: func @stablehlo_conv
+func.func @stablehlo_conv(%arg0: tensor<1x4x4x3xf32>, %arg1: tensor<3x3x3x8xf32>) -> tensor<1x2x2x8xf32> {
+  // CHECK-NOT: stablehlo.pad
+  // CHECK: stablehlo.convolution{{.*}}%arg0, %arg1
+  // CHECK-SAME: padding = dense<{{\[}}[1, 2], [0, 1]]> : tensor<2x2xi64>
+  %0 = stablehlo.constant dense<0.000000e+00> : tensor<f32>
+  %1 = "stablehlo.pad"(%arg0, %0) {edge_padding_high = array<i64: 0, 1, 1, 0>, edge_padding_low = array<i64: 0, 1, 0, 0>, interior_padding = array<i64: 0, 0, 0, 0>} : (tensor<1x4x4x3xf32>, tensor<f32>) -> tensor<1x6x5x3xf32>
+  %2 = "stablehlo.convolution"(%1, %arg1) {
+    batch_group_count = 1 : i64,
+    dimension_numbers = #stablehlo.conv<raw
+      input_batch_dimension = 0,
+      input_feature_dimension = 3,
+      input_spatial_dimensions = [1, 2],
+      kernel_input_feature_dimension = 2,
+      kernel_output_feature_dimension = 3,
+      kernel_spatial_dimensions = [0, 1],
+      output_batch_dimension = 0,
+      output_feature_dimension = 3,
+      output_spatial_dimensions = [1, 2]
+    >,
+    feature_group_count = 1 : i64,
+    padding = dense<[[0, 1], [0, 0]]> : tensor<2x2xi64>,
+    window_strides = array<i64: 2, 2>
+  } : (tensor<1x6x5x3xf32>, tensor<3x3x3x8xf32>) -> tensor<1x2x2x8xf32>
+  return %2 : tensor<1x2x2x8xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_conv_nonzero_pad
+func.func @stablehlo_conv_nonzero_pad(%arg0: tensor<1x4x4x3xf32>, %arg1: tensor<3x3x3x8xf32>) -> tensor<1x2x2x8xf32> {
+  // CHECK: stablehlo.pad
+  // CHECK: stablehlo.convolution
+  %0 = stablehlo.constant dense<1.000000e+00> : tensor<f32>
+  %1 = "stablehlo.pad"(%arg0, %0) {edge_padding_high = array<i64: 0, 1, 1, 0>, edge_padding_low = array<i64: 0, 0, 0, 0>, interior_padding = array<i64: 0, 0, 0, 0>} : (tensor<1x4x4x3xf32>, tensor<f32>) -> tensor<1x5x5x3xf32>
+  %2 = "stablehlo.convolution"(%1, %arg1) {
+    batch_group_count = 1 : i64,
+    dimension_numbers = #stablehlo.conv<raw
+      input_batch_dimension = 0,
+      input_feature_dimension = 3,
+      input_spatial_dimensions = [1, 2],
+      kernel_input_feature_dimension = 2,
+      kernel_output_feature_dimension = 3,
+      kernel_spatial_dimensions = [0, 1],
+      output_batch_dimension = 0,
+      output_feature_dimension = 3,
+      output_spatial_dimensions = [1, 2]
+    >,
+    feature_group_count = 1 : i64,
+    window_strides = array<i64: 2, 2>
+  } : (tensor<1x5x5x3xf32>, tensor<3x3x3x8xf32>) -> tensor<1x2x2x8xf32>
+  return %2 : tensor<1x2x2x8xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_reduce_window
+func.func @stablehlo_reduce_window(%arg0 : tensor<2x112x112x64xf32>) -> tensor<2x56x56x64xf32> {
+  // CHECK-NOT: stablehlo.pad
+  // CHECK: stablehlo.reduce_window{{.*}}%arg0
+  // CHECK: padding = dense<{{\[}}[0, 0], [0, 1], [0, 1], [0, 0]]> : tensor<4x2xi64>
+  %0 = stablehlo.constant dense<0xFF800000> : tensor<f32>
+  %1 = "stablehlo.pad"(%arg0, %0) {edge_padding_high = array<i64: 0, 1, 1, 0>, edge_padding_low = array<i64: 0, 0, 0, 0>, interior_padding = array<i64: 0, 0, 0, 0>} : (tensor<2x112x112x64xf32>, tensor<f32>) -> tensor<2x113x113x64xf32>
+  %2 = "stablehlo.reduce_window"(%1, %0) ( {
+    ^bb0(%arg2: tensor<f32>, %arg3: tensor<f32>):  // no predecessors
+      %3 = stablehlo.maximum %arg2, %arg3 : tensor<f32>
+      "stablehlo.return"(%3) : (tensor<f32>) -> ()
+    }) {window_dimensions = array<i64: 1, 3, 3, 1>, window_strides = array<i64: 1, 2, 2, 1>} : (tensor<2x113x113x64xf32>, tensor<f32>) -> tensor<2x56x56x64xf32>
+  return %2 : tensor<2x56x56x64xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_reduce_window_other_pad_value
+func.func @stablehlo_reduce_window_other_pad_value(%arg0 : tensor<2x112x112x64xf32>) -> tensor<2x56x56x64xf32> {
+  // CHECK: stablehlo.pad
+  // CHECK: stablehlo.reduce_window
+  %0 = stablehlo.constant dense<0xFF800000> : tensor<f32>
+  %1 = stablehlo.constant dense<0.000000e+00> : tensor<f32>
+  %2 = "stablehlo.pad"(%arg0, %1) {edge_padding_high = array<i64: 0, 1, 1, 0>, edge_padding_low = array<i64: 0, 0, 0, 0>, interior_padding = array<i64: 0, 0, 0, 0>} : (tensor<2x112x112x64xf32>, tensor<f32>) -> tensor<2x113x113x64xf32>
+  %3 = "stablehlo.reduce_window"(%2, %0) ( {
+    ^bb0(%arg2: tensor<f32>, %arg3: tensor<f32>):  // no predecessors
+      %4 = stablehlo.maximum %arg2, %arg3 : tensor<f32>
+      "stablehlo.return"(%4) : (tensor<f32>) -> ()
+    }) {window_dimensions = array<i64: 1, 3, 3, 1>, window_strides = array<i64: 1, 2, 2, 1>} : (tensor<2x113x113x64xf32>, tensor<f32>) -> tensor<2x56x56x64xf32>
+  return %3 : tensor<2x56x56x64xf32>
+}
@@ -0,0 +1,31 @@
+// RUN: emitc-opt -fold-stablehlo-transpose %s | FileCheck %s
+// RUN: emitc-opt -fold-stablehlo-transpose="kernel-backends=dot:blas" %s | FileCheck %s --check-prefix=BLAS
+
+// CHECK-LABEL: func @stablehlo_dot_nt
+// BLAS-LABEL: func @stablehlo_dot_nt
+func.func @stablehlo_dot_nt(%arg0: tensor<2x3xf32>, %arg1: tensor<4x3xf32>) -> tensor<2x4xf32> {
+  // CHECK-NOT: stablehlo.transpose
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dot_transposed"(%arg0, %arg1) {emitc.pure, template_args = [tensor<2x4xf32>, false, true]} : (tensor<2x3xf32>, tensor<4x3xf32>) -> tensor<2x4xf32>
+  // BLAS: emitc.call_opaque "emitc::stablehlo::blas::dot_transposed"(%arg0, %arg1) {emitc.pure, template_args = [tensor<2x4xf32>, false, true]}
+  %0 = "stablehlo.transpose"(%arg1) {permutation = array<i64: 1, 0>} : (tensor<4x3xf32>) -> tensor<3x4xf32>
+  %1 = "stablehlo.dot"(%arg0, %0) : (tensor<2x3xf32>, tensor<3x4xf32>) -> tensor<2x4xf32>
+  return %1 : tensor<2x4xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_dot_tt
+func.func @stablehlo_dot_tt(%arg0: tensor<3x3xf32>) -> tensor<3x3xf32> {
+  // CHECK-NOT: stablehlo.transpose
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dot_transposed"(%arg0, %arg0) {emitc.pure, template_args = [tensor<3x3xf32>, true, true]}
+  %0 = "stablehlo.transpose"(%arg0) {permutation = array<i64: 1, 0>} : (tensor<3x3xf32>) -> tensor<3x3xf32>
+  %1 = "stablehlo.dot"(%0, %0) : (tensor<3x3xf32>, tensor<3x3xf32>) -> tensor<3x3xf32>
+  return %1 : tensor<3x3xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_dot_matrix_vector
+func.func @stablehlo_dot_matrix_vector(%arg0: tensor<3x2xf32>, %arg1: tensor<3xf32>) -> tensor<2xf32> {
+  // CHECK: stablehlo.transpose
+  // CHECK: stablehlo.dot
+  %0 = "stablehlo.transpose"(%arg0) {permutation = array<i64: 1, 0>} : (tensor<3x2xf32>) -> tensor<2x3xf32>
+  %1 = "stablehlo.dot"(%0, %arg1) : (tensor<2x3xf32>, tensor<3xf32>) -> tensor<2xf32>
+  return %1 : tensor<2xf32>
+}
@@ -0,0 +1,50 @@
+// RUN: emitc-opt -convert-stablehlo-to-emitc="kernel-backends=convolution:eigen,dot:blas,dot_general:blas" %s | FileCheck %s
+// RUN: emitc-opt -stablehlo-to-emitc-pipeline="kernel-backends=convolution:eigen,dot:blas,dot_general:blas" %s | FileCheck %s
+// RUN: not emitc-opt -convert-stablehlo-to-emitc="kernel-backends=convolution:blas" %s 2>&1 | FileCheck %s --check-prefix=UNSUPPORTED
+
+// RUN: not emitc-opt -convert-stablehlo-to-emitc="kernel-backends=dot_general:eigen" %s 2>&1 | FileCheck %s --check-prefix=UNSUPPORTED-EIGEN
+
+// UNSUPPORTED: error: no 'blas' kernel for 'convolution'
+// UNSUPPORTED-EIGEN: error: no 'eigen' kernel for 'dot_general'
+
+func.func @stablehlo_conv(%arg0: tensor<3x2x4x3xf32>, %arg1 : tensor<2x2x3x4xf32>) -> tensor<2x1x2x3xf32> {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::eigen::convolution"(%arg1, %arg0)
+  %out = "stablehlo.convolution"(%arg1, %arg0) {
+    batch_group_count = 1 : i64,
+    dimension_numbers = #stablehlo.conv<raw
+      input_batch_dimension = 0,
+      input_feature_dimension = 3,
+      input_spatial_dimensions = [1, 2],
+      kernel_input_feature_dimension = 2,
+      kernel_output_feature_dimension = 3,
+      kernel_spatial_dimensions = [0, 1],
+      output_batch_dimension = 0,
+      output_feature_dimension = 3,
+      output_spatial_dimensions = [1, 2]
+    >,
+    feature_group_count = 1 : i64,
+    padding = dense<[[0, 1], [0, 1]]> : tensor<2x2xi64>,
+    rhs_dilation = array<i64: 1, 2>,
+    window_strides = array<i64: 2, 1>
+  } : (tensor<2x2x3x4xf32>, tensor<3x2x4x3xf32>) -> tensor<2x1x2x3xf32>
+  return %out : tensor<2x1x2x3xf32>
+}
+
+func.func @stablehlo_dot(%arg0: tensor<512x512xf32>) -> tensor<512x512xf32> {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::blas::dot"(%arg0, %arg0) {emitc.pure, template_args = [tensor<512x512xf32>]} : (tensor<512x512xf32>, tensor<512x512xf32>) -> tensor<512x512xf32>
+  %0 = "stablehlo.dot"(%arg0, %arg0) : (tensor<512x512xf32>, tensor<512x512xf32>) -> tensor<512x512xf32>
+  return %0 : tensor<512x512xf32>
+}
+
+func.func @stablehlo_dot_general(%arg0: tensor<2x64x32xf32>, %arg1: tensor<2x48x32xf32>) -> tensor<2x64x48xf32> {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::blas::dot_general"(%arg0, %arg1)
+  %0 = "stablehlo.dot_general"(%arg0, %arg1) {
+    dot_dimension_numbers = #stablehlo.dot<
+      lhs_batching_dimensions = [0],
+      rhs_batching_dimensions = [0],
+      lhs_contracting_dimensions = [2],
+      rhs_contracting_dimensions = [2]
+    >
+  } : (tensor<2x64x32xf32>, tensor<2x48x32xf32>) -> tensor<2x64x48xf32>
+  return %0 : tensor<2x64x48xf32>
+}
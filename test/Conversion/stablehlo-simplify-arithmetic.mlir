@@ -0,0 +1,63 @@
+// RUN: emitc-opt -simplify-stablehlo-arithmetic %s | FileCheck %s --check-prefixes=CHECK,STRICT
+// RUN: emitc-opt -simplify-stablehlo-arithmetic=fast-math=true %s | FileCheck %s --check-prefixes=CHECK,FAST
+
+// CHECK-LABEL: func @stablehlo_pow
+func.func @stablehlo_pow(%arg0: tensor<2x3xf32>, %arg1: tensor<4xi32>) -> (tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<4xi32>, tensor<2x3xf32>) {
+  // CHECK-NOT: stablehlo.constant
+  // CHECK-NOT: stablehlo.power
+  // CHECK: %[[MUL:.*]] = stablehlo.multiply %arg0, %arg0 : tensor<2x3xf32>
+  // STRICT: %[[HALF:.*]] = stablehlo.constant dense<5.000000e-01> : tensor<2x3xf32>
+  // STRICT: %[[SQRT:.*]] = stablehlo.power %arg0, %[[HALF]] : tensor<2x3xf32>
+  // FAST: %[[SQRT:.*]] = stablehlo.sqrt %arg0 : tensor<2x3xf32>
+  // CHECK: %[[IMUL:.*]] = stablehlo.multiply %arg1, %arg1 : tensor<4xi32>
+  // STRICT: %[[CST:.*]] = stablehlo.constant dense<-5.000000e-01> : tensor<2x3xf32>
+  // STRICT: %[[RSQRT:.*]] = stablehlo.power %arg0, %[[CST]] : tensor<2x3xf32>
+  // FAST: %[[RSQRT:.*]] = stablehlo.rsqrt %arg0 : tensor<2x3xf32>
+  // CHECK: return %arg0, %[[MUL]], %[[SQRT]], %[[IMUL]], %[[RSQRT]]
+  %0 = stablehlo.constant dense<1.0> : tensor<2x3xf32>
+  %1 = stablehlo.power %arg0, %0 : tensor<2x3xf32>
+  %2 = stablehlo.constant dense<2.0> : tensor<2x3xf32>
+  %3 = stablehlo.power %arg0, %2 : tensor<2x3xf32>
+  %4 = stablehlo.constant dense<0.5> : tensor<2x3xf32>
+  %5 = stablehlo.power %arg0, %4 : tensor<2x3xf32>
+  %6 = stablehlo.constant dense<2> : tensor<4xi32>
+  %7 = stablehlo.power %arg1, %6 : tensor<4xi32>
+  %8 = stablehlo.constant dense<-0.5> : tensor<2x3xf32>
+  %9 = stablehlo.power %arg0, %8 : tensor<2x3xf32>
+  return %1, %3, %5, %7, %9 : tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<4xi32>, tensor<2x3xf32>
+}
+
+// CHECK-LABEL: func @stablehlo_divide
+func.func @stablehlo_divide(%arg0: tensor<2xf32>, %arg1: tensor<2xi32>) -> (tensor<2xf32>, tensor<2xf32>, tensor<2xi32>) {
+  // STRICT: %[[CST:.*]] = stablehlo.constant dense<[2.000000e+00, 4.000000e+00]>
+  // STRICT: %[[DIV:.*]] = stablehlo.divide %arg0, %[[CST]]
+  // FAST: %[[CST:.*]] = stablehlo.constant dense<[5.000000e-01, 2.500000e-01]>
+  // FAST: %[[DIV:.*]] = stablehlo.multiply %arg0, %[[CST]]
+  // CHECK: %[[IDIV:.*]] = stablehlo.divide %arg1
+  // CHECK: return %arg0, %[[DIV]], %[[IDIV]]
+  %0 = stablehlo.constant dense<1.0> : tensor<2xf32>
+  %1 = stablehlo.divide %arg0, %0 : tensor<2xf32>
+  %2 = stablehlo.constant dense<[2.0, 4.0]> : tensor<2xf32>
+  %3 = stablehlo.divide %arg0, %2 : tensor<2xf32>
+  %4 = stablehlo.constant dense<2> : tensor<2xi32>
+  %5 = stablehlo.divide %arg1, %4 : tensor<2xi32>
+  return %1, %3, %5 : tensor<2xf32>, tensor<2xf32>, tensor<2xi32>
+}
+
+// Without fast-math, only -0.0 is removed from additions and +0.0 from
+// subtractions, as -0.0 + 0.0 is +0.0.
+// CHECK-LABEL: func @stablehlo_identities
+func.func @stablehlo_identities(%arg0: tensor<2x3xf32>, %arg1: tensor<2xi32>) -> (tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<2xi32>) {
+  // STRICT-NEXT: %[[ZERO:.*]] = stablehlo.constant dense<0.000000e+00> : tensor<2x3xf32>
+  // STRICT-NEXT: %[[ADD:.*]] = stablehlo.add %[[ZERO]], %arg0 : tensor<2x3xf32>
+  // STRICT-NEXT: return %[[ADD]], %[[ADD]], %arg0, %arg1
+  // FAST-NEXT: return %arg0, %arg0, %arg0, %arg1
+  %0 = stablehlo.constant dense<0.0> : tensor<2x3xf32>
+  %1 = stablehlo.add %0, %arg0 : tensor<2x3xf32>
+  %2 = stablehlo.subtract %1, %0 : tensor<2x3xf32>
+  %3 = stablehlo.constant dense<-0.0> : tensor<2x3xf32>
+  %4 = stablehlo.add %arg0, %3 : tensor<2x3xf32>
+  %5 = stablehlo.constant dense<1> : tensor<2xi32>
+  %6 = stablehlo.multiply %arg1, %5 : tensor<2xi32>
+  return %1, %2, %4, %6 : tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<2xi32>
+}
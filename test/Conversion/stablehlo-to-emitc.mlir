@@ -1,6 +1,7 @@
 // RUN: emitc-opt -convert-stablehlo-region-ops-to-emitc -convert-stablehlo-to-emitc %s | FileCheck %s
 // RUN: emitc-opt --insert-emitc-stablehlo-include -convert-stablehlo-region-ops-to-emitc -convert-stablehlo-to-emitc %s | FileCheck %s  --check-prefixes=CHECK,CHECK-INCLUDE
 // RUN: emitc-opt -stablehlo-to-emitc-pipeline %s | FileCheck %s --check-prefixes=CHECK,CHECK-INCLUDE
+// RUN: emitc-opt -convert-stablehlo-region-ops-to-emitc -convert-stablehlo-to-emitc=attributes-as-template-args=true %s | FileCheck %s --check-prefix=TEMPLATE
 
 // CHECK-INCLUDE: emitc.include "emitc/stablehlo.h"
 
@@ -17,91 +18,97 @@ func.func @stablehlo_constant(%arg0: tensor<2xi32>) -> tensor<2xi32> {
 
 
 func.func @float_abs(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::abs"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::abs"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.abs"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_ceil(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::ceil"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::ceil"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.ceil"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_convert(%arg0: tensor<ui32>) -> tensor<ui64> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::convert"(%arg0) {template_args = [tensor<ui64>]} : (tensor<ui32>) -> tensor<ui64>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::convert"(%arg0) {emitc.pure, template_args = [tensor<ui64>]} : (tensor<ui32>) -> tensor<ui64>
   %0 = "stablehlo.convert"(%arg0) : (tensor<ui32>) -> tensor<ui64>
   return %0 : tensor<ui64>
 }
 
 func.func @stablehlo_cos(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::cos"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::cos"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.cosine"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_exponential(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::exponential"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::exponential"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.exponential"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_exponential_minus_one(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::exponential_minus_one"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::exponential_minus_one"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.exponential_minus_one"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_floor(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::floor"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::floor"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.floor"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_is_finite(%arg0: tensor<4xf32>) -> tensor<4xi1> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::is_finite"(%arg0) : (tensor<4xf32>) -> tensor<4xi1>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::is_finite"(%arg0) {emitc.pure} : (tensor<4xf32>) -> tensor<4xi1>
   %0 = "stablehlo.is_finite"(%arg0) : (tensor<4xf32>) -> tensor<4xi1>
   return %0 : tensor<4xi1>
 }
 
 func.func @stablehlo_log(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::log"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::log"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.log"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_log_plus_one(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::log_plus_one"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::log_plus_one"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.log_plus_one"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_negate(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::negate"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::negate"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.negate"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_round(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::round"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::round"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.round_nearest_afz"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
+func.func @stablehlo_rsqrt(%arg0: tensor<2xf32>) -> tensor<2xf32> {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::rsqrt"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
+  %0 = "stablehlo.rsqrt"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  return %0 : tensor<2xf32>
+}
+
 func.func @stablehlo_sine(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::sin"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::sin"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.sine"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_sqrt(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::sqrt"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::sqrt"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.sqrt"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
 
 func.func @stablehlo_tanh(%arg0: tensor<2xf32>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::tanh"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::tanh"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
   %0 = "stablehlo.tanh"(%arg0) : (tensor<2xf32>) -> tensor<2xf32>
   return %0 : tensor<2xf32>
 }
@@ -110,13 +117,13 @@ func.func @stablehlo_tanh(%arg0: tensor<2xf32>) -> tensor<2xf32> {
 // Binary elementwise ops
 
 func.func @stablehlo_add_i64(%arg0: tensor<i64>) -> tensor<i64> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::add"(%arg0, %arg0) : (tensor<i64>, tensor<i64>) -> tensor<i64>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::add"(%arg0, %arg0) {emitc.pure} : (tensor<i64>, tensor<i64>) -> tensor<i64>
   %0 = stablehlo.add %arg0, %arg0 : tensor<i64>
   return %0 : tensor<i64>
 }
 
 func.func @stablehlo_add_f64(%arg0: tensor<f64>) -> tensor<f64> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::add"(%arg0, %arg0) : (tensor<f64>, tensor<f64>) -> tensor<f64>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::add"(%arg0, %arg0) {emitc.pure} : (tensor<f64>, tensor<f64>) -> tensor<f64>
   %0 = stablehlo.add %arg0, %arg0 : tensor<f64>
   return %0 : tensor<f64>
 }
@@ -128,49 +135,49 @@ func.func @stablehlo_atan2(%arg0: tensor<2xf32>, %arg1: tensor<2xf32>) -> tensor
 }
 
 func.func @stablehlo_divide(%arg0: tensor<f32>, %arg1: tensor<f32>) -> tensor<f32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::div"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::div"(%arg0, %arg1) {emitc.pure} : (tensor<f32>, tensor<f32>) -> tensor<f32>
   %0 = "stablehlo.divide"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
   return %0 : tensor<f32>
 }
 
 func.func @stablehlo_max(%arg0: tensor<4xf32>, %arg1: tensor<4xf32>) -> tensor<4xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::max"(%arg0, %arg0) : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::max"(%arg0, %arg0) {emitc.pure} : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
   %0 = "stablehlo.maximum"(%arg0, %arg0) : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
   return %0 : tensor<4xf32>
 }
 
 func.func @stablehlo_min(%arg0: tensor<4xf32>, %arg1: tensor<4xf32>) -> tensor<4xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::min"(%arg0, %arg0) : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::min"(%arg0, %arg0) {emitc.pure} : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
   %0 = "stablehlo.minimum"(%arg0, %arg0) : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
   return %0 : tensor<4xf32>
 }
 
 func.func @stablehlo_multiply(%arg0: tensor<f32>, %arg1: tensor<f32>) -> tensor<f32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::mul"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::mul"(%arg0, %arg1) {emitc.pure} : (tensor<f32>, tensor<f32>) -> tensor<f32>
   %0 = "stablehlo.multiply"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
   return %0 : tensor<f32>
 }
 
 func.func @stablehlo_power(%arg0: tensor<f32>, %arg1: tensor<f32>) -> tensor<f32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::pow"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::pow"(%arg0, %arg1) {emitc.pure} : (tensor<f32>, tensor<f32>) -> tensor<f32>
   %0 = "stablehlo.power"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
   return %0 : tensor<f32>
 }
 
 func.func @stablehlo_shift_left(%arg0: tensor<i32>, %arg1: tensor<i32>) -> tensor<i32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::shift_left"(%arg0, %arg1) : (tensor<i32>, tensor<i32>) -> tensor<i32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::shift_left"(%arg0, %arg1) {emitc.pure} : (tensor<i32>, tensor<i32>) -> tensor<i32>
   %0 = "stablehlo.shift_left"(%arg0, %arg1) : (tensor<i32>, tensor<i32>) -> tensor<i32>
   return %0 : tensor<i32>
 }
 
 func.func @stablehlo_shift_right_logical(%arg0: tensor<i32>, %arg1: tensor<i32>) -> tensor<i32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::shift_right_logical"(%arg0, %arg1) : (tensor<i32>, tensor<i32>) -> tensor<i32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::shift_right_logical"(%arg0, %arg1) {emitc.pure} : (tensor<i32>, tensor<i32>) -> tensor<i32>
   %0 = "stablehlo.shift_right_logical"(%arg0, %arg1) : (tensor<i32>, tensor<i32>) -> tensor<i32>
   return %0 : tensor<i32>
 }
 
 func.func @stablehlo_sub(%arg0: tensor<f32>) -> tensor<f32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::sub"(%arg0, %arg0) : (tensor<f32>, tensor<f32>) -> tensor<f32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::sub"(%arg0, %arg0) {emitc.pure} : (tensor<f32>, tensor<f32>) -> tensor<f32>
   %0 = "stablehlo.subtract"(%arg0, %arg0) : (tensor<f32>, tensor<f32>) -> tensor<f32>
   return %0 : tensor<f32>
 }
@@ -179,13 +186,13 @@ func.func @stablehlo_sub(%arg0: tensor<f32>) -> tensor<f32> {
 // Binary logical elementwise ops
 
 func.func @stablehlo_or(%arg0: tensor<ui64>, %arg1: tensor<ui64>) -> tensor<ui64> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::logical_or"(%arg0, %arg1) : (tensor<ui64>, tensor<ui64>) -> tensor<ui64>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::logical_or"(%arg0, %arg1) {emitc.pure} : (tensor<ui64>, tensor<ui64>) -> tensor<ui64>
   %0 = "stablehlo.or"(%arg0, %arg1) : (tensor<ui64>, tensor<ui64>) -> tensor<ui64>
   return %0 : tensor<ui64>
 }
 
 func.func @stablehlo_xor(%arg0: tensor<ui64>, %arg1: tensor<ui64>) -> tensor<ui64> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::logical_xor"(%arg0, %arg1) : (tensor<ui64>, tensor<ui64>) -> tensor<ui64>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::logical_xor"(%arg0, %arg1) {emitc.pure} : (tensor<ui64>, tensor<ui64>) -> tensor<ui64>
   %0 = "stablehlo.xor"(%arg0, %arg1) : (tensor<ui64>, tensor<ui64>) -> tensor<ui64>
   return %0 : tensor<ui64>
 }
@@ -194,119 +201,128 @@ func.func @stablehlo_xor(%arg0: tensor<ui64>, %arg1: tensor<ui64>) -> tensor<ui6
 // Tuple ops
 
 func.func @stablehlo_tuple(%arg0: tensor<i32>, %arg1: tensor<ui64>) -> (tuple<tensor<i32>, tensor<ui64>, tensor<i32>, tensor<ui64>>) {
-  // CHECK: emitc.call_opaque "std::make_tuple"() : () -> tuple<>
+  // CHECK: emitc.call_opaque "std::make_tuple"() {emitc.pure} : () -> tuple<>
   %0 = "stablehlo.tuple"() : () -> tuple<>
-  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0) : (tensor<i32>) -> tuple<tensor<i32>>
+  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0) {emitc.pure} : (tensor<i32>) -> tuple<tensor<i32>>
   %1 = "stablehlo.tuple"(%arg0) : (tensor<i32>) -> tuple<tensor<i32>>
-  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0, %arg1) : (tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>>
+  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0, %arg1) {emitc.pure} : (tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>>
   %2 = "stablehlo.tuple"(%arg0, %arg1) : (tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>>
-  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0, %arg1, %arg0, %arg1) : (tensor<i32>, tensor<ui64>, tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>, tensor<i32>, tensor<ui64>>
+  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0, %arg1, %arg0, %arg1) {emitc.pure} : (tensor<i32>, tensor<ui64>, tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>, tensor<i32>, tensor<ui64>>
   %3 = "stablehlo.tuple"(%arg0, %arg1, %arg0, %arg1) : (tensor<i32>, tensor<ui64>, tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>, tensor<i32>, tensor<ui64>>
   return %3 : tuple<tensor<i32>, tensor<ui64>, tensor<i32>, tensor<ui64>>
 }
 
 func.func @stablehlo_tuple_nested(%arg0: tensor<i32>, %arg1: tensor<ui64>) -> tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>> {
-  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0, %arg1) : (tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>>
+  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0, %arg1) {emitc.pure} : (tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>>
   %0 = "stablehlo.tuple"(%arg0, %arg1) : (tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tensor<ui64>>
-  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0, %0) : (tensor<i32>, tuple<tensor<i32>, tensor<ui64>>) -> tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>>
+  // CHECK: emitc.call_opaque "std::make_tuple"(%arg0, %0) {emitc.pure} : (tensor<i32>, tuple<tensor<i32>, tensor<ui64>>) -> tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>>
   %1 = "stablehlo.tuple"(%arg0, %0) : (tensor<i32>, tuple<tensor<i32>, tensor<ui64>>) -> tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>>
   return %1 : tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>>
 }
 
 func.func @stablehlo_tuple_unpack(%arg0: tensor<i32>, %arg1: tensor<ui64>) -> (tuple<tensor<i32>, tensor<ui64>>, tensor<i32>) {
   %0 = call @stablehlo_tuple_nested(%arg0, %arg1) : (tensor<i32>, tensor<ui64>) -> tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>>
-  // CHECK: emitc.call_opaque "std::get"(%0) {template_args = [1 : i32]} : (tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>>) -> tuple<tensor<i32>, tensor<ui64>>
+  // CHECK: emitc.call_opaque "std::get"(%0) {emitc.pure, template_args = [1 : i32]} : (tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>>) -> tuple<tensor<i32>, tensor<ui64>>
   %1 = "stablehlo.get_tuple_element"(%0) {index = 1 : i32} : (tuple<tensor<i32>, tuple<tensor<i32>, tensor<ui64>>>) -> tuple<tensor<i32>, tensor<ui64>>
-  // CHECK: emitc.call_opaque "std::get"(%1) {template_args = [0 : i32]} : (tuple<tensor<i32>, tensor<ui64>>) -> tensor<i32>
+  // CHECK: emitc.call_opaque "std::get"(%1) {emitc.pure, template_args = [0 : i32]} : (tuple<tensor<i32>, tensor<ui64>>) -> tensor<i32>
   %2 = "stablehlo.get_tuple_element"(%1) {index = 0 : i32} : (tuple<tensor<i32>, tensor<ui64>>) -> tensor<i32>
   return %1, %2 : tuple<tensor<i32>, tensor<ui64>>, tensor<i32>
 }
 
-func.func @stablehlo_compare(%arg0: tensor<4xi32>, %arg1: tensor<4xi32>) -> tensor<4xi1> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {template_args = [tensor<4xi32>, #emitc.opaque<"std::less">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
+func.func @stablehlo_compare(%arg0: tensor<4xi32>, %arg1: tensor<4xi32>) -> (tensor<4xi1>, tensor<4xi1>, tensor<4xi1>, tensor<4xi1>, tensor<4xi1>, tensor<4xi1>) {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {emitc.pure, template_args = [tensor<4xi32>, #emitc.opaque<"std::less">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
   %0 = "stablehlo.compare"(%arg0, %arg1) {comparison_direction = #stablehlo<comparison_direction LT>} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {template_args = [tensor<4xi32>, #emitc.opaque<"std::less_equal">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {emitc.pure, template_args = [tensor<4xi32>, #emitc.opaque<"std::less_equal">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
   %1 = "stablehlo.compare"(%arg0, %arg1) {comparison_direction = #stablehlo<comparison_direction LE>} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {template_args = [tensor<4xi32>, #emitc.opaque<"std::greater">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {emitc.pure, template_args = [tensor<4xi32>, #emitc.opaque<"std::greater">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
   %2 = "stablehlo.compare"(%arg0, %arg1) {comparison_direction = #stablehlo<comparison_direction GT>} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {template_args = [tensor<4xi32>, #emitc.opaque<"std::greater_equal">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {emitc.pure, template_args = [tensor<4xi32>, #emitc.opaque<"std::greater_equal">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
   %3 = "stablehlo.compare"(%arg0, %arg1) {comparison_direction = #stablehlo<comparison_direction GE>} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {template_args = [tensor<4xi32>, #emitc.opaque<"std::equal_to">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {emitc.pure, template_args = [tensor<4xi32>, #emitc.opaque<"std::equal_to">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
   %4 = "stablehlo.compare"(%arg0, %arg1) {comparison_direction = #stablehlo<comparison_direction EQ>} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {template_args = [tensor<4xi32>, #emitc.opaque<"std::not_equal_to">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::compare"(%arg0, %arg1) {emitc.pure, template_args = [tensor<4xi32>, #emitc.opaque<"std::not_equal_to">]} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
   %5 = "stablehlo.compare"(%arg0, %arg1) {comparison_direction = #stablehlo<comparison_direction NE>} : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
 
-  return %0 : tensor<4xi1>
+  return %0, %1, %2, %3, %4, %5 : tensor<4xi1>, tensor<4xi1>, tensor<4xi1>, tensor<4xi1>, tensor<4xi1>, tensor<4xi1>
 }
 
 
 // Slice ops
 
-func.func @stablehlo_slice(%arg0: tensor<12xi32>, %arg1: tensor<8x7xi32>) -> tensor<4x3xi32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::slice"(%arg0) {args = [0 : index, dense<0> : tensor<1xi64>, dense<1> : tensor<1xi64>, dense<1> : tensor<1xi64>], template_args = [tensor<1xi32>]} : (tensor<12xi32>) -> tensor<1xi32>
+func.func @stablehlo_slice(%arg0: tensor<12xi32>, %arg1: tensor<8x7xi32>) -> (tensor<1xi32>, tensor<4x3xi32>) {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::slice"(%arg0) {args = [0 : index, dense<0> : tensor<1xi64>, dense<1> : tensor<1xi64>, dense<1> : tensor<1xi64>], emitc.pure, template_args = [tensor<1xi32>]} : (tensor<12xi32>) -> tensor<1xi32>
+  // TEMPLATE: emitc.call_opaque "emitc::stablehlo::slice"(%arg0) {emitc.pure, template_args = [tensor<1xi32>, #emitc.opaque<"std::integer_sequence<int64_t, 0>">, #emitc.opaque<"std::integer_sequence<int64_t, 1>">, #emitc.opaque<"std::integer_sequence<int64_t, 1>">]} : (tensor<12xi32>) -> tensor<1xi32>
   %0 = "stablehlo.slice"(%arg0) {limit_indices = array<i64: 1>, start_indices = array<i64: 0>, strides = array<i64: 1>} : (tensor<12xi32>) -> tensor<1xi32>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::slice"(%arg1) {args = [0 : index, dense<0> : tensor<2xi64>, dense<[4, 3]> : tensor<2xi64>, dense<1> : tensor<2xi64>], template_args = [tensor<4x3xi32>]} : (tensor<8x7xi32>) -> tensor<4x3xi32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::slice"(%arg1) {args = [0 : index, dense<0> : tensor<2xi64>, dense<[4, 3]> : tensor<2xi64>, dense<1> : tensor<2xi64>], emitc.pure, template_args = [tensor<4x3xi32>]} : (tensor<8x7xi32>) -> tensor<4x3xi32>
+  // TEMPLATE: emitc.call_opaque "emitc::stablehlo::slice"(%arg1) {emitc.pure, template_args = [tensor<4x3xi32>, #emitc.opaque<"std::integer_sequence<int64_t, 0, 0>">, #emitc.opaque<"std::integer_sequence<int64_t, 4, 3>">, #emitc.opaque<"std::integer_sequence<int64_t, 1, 1>">]} : (tensor<8x7xi32>) -> tensor<4x3xi32>
   %1 = "stablehlo.slice"(%arg1) {limit_indices = array<i64: 4, 3 >, start_indices = array<i64: 0, 0>, strides = array<i64: 1, 1>} : (tensor<8x7xi32>) -> tensor<4x3xi32>
-  return %1 : tensor<4x3xi32>
+  return %0, %1 : tensor<1xi32>, tensor<4x3xi32>
 }
 
-func.func @stablehlo_dynamic_slice(%arg0: tensor<12xi32>, %arg1: tensor<8x7xi32>) -> () {
+func.func @stablehlo_dynamic_slice(%arg0: tensor<12xi32>, %arg1: tensor<8x7xi32>) -> (tensor<4xi32>, tensor<4x2xi32>) {
   %cst = "arith.constant"() {value = dense<1> : tensor<i64>} : () -> tensor<i64>
   %cst_0 = "arith.constant"() {value = dense<3> : tensor<i64>} : () -> tensor<i64>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::dynamic_slice"(%arg0, %cst) {args = [0 : index, 1 : index, dense<4> : tensor<1xi64>], template_args = [tensor<4xi32>]} : (tensor<12xi32>, tensor<i64>) -> tensor<4xi32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dynamic_slice"(%arg0, %cst) {args = [0 : index, 1 : index, dense<4> : tensor<1xi64>], emitc.pure, template_args = [tensor<4xi32>]} : (tensor<12xi32>, tensor<i64>) -> tensor<4xi32>
   %0 = "stablehlo.dynamic_slice"(%arg0, %cst) {slice_sizes = array<i64: 4>} : (tensor<12xi32>, tensor<i64>) -> tensor<4xi32>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::dynamic_slice"(%arg1, %cst, %cst_0) {args = [0 : index, 1 : index, 2 : index, dense<[4, 2]> : tensor<2xi64>], template_args = [tensor<4x2xi32>]} : (tensor<8x7xi32>, tensor<i64>, tensor<i64>) -> tensor<4x2xi32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dynamic_slice"(%arg1, %cst, %cst_0) {args = [0 : index, 1 : index, 2 : index, dense<[4, 2]> : tensor<2xi64>], emitc.pure, template_args = [tensor<4x2xi32>]} : (tensor<8x7xi32>, tensor<i64>, tensor<i64>) -> tensor<4x2xi32>
   %1 = "stablehlo.dynamic_slice"(%arg1, %cst, %cst_0) {slice_sizes = array<i64: 4, 2>} : (tensor<8x7xi32>, tensor<i64>, tensor<i64>) -> tensor<4x2xi32>
-  return
+  return %0, %1 : tensor<4xi32>, tensor<4x2xi32>
 }
 
-func.func @stablehlo_dynamic_update_slice(%arg0: tensor<12xi32>, %arg1: tensor<8x7xi32>) -> () {
+func.func @stablehlo_dynamic_update_slice(%arg0: tensor<12xi32>, %arg1: tensor<8x7xi32>) -> (tensor<12xi32>, tensor<8x7xi32>) {
   %cst = "arith.constant"() {value = dense<1> : tensor<i64>} : () -> tensor<i64>
   %cst_0 = "arith.constant"() {value = dense<3> : tensor<i64>} : () -> tensor<i64>
   %cst_1 = "arith.constant"() {value = dense<1> : tensor<4xi32>} : () -> tensor<4xi32>
   %cst_2 = "arith.constant"() {value = dense<1> : tensor<2x4xi32>} : () -> tensor<2x4xi32>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::dynamic_update_slice"(%arg0, %cst_1, %cst) {template_args = [tensor<4xi32>]}
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dynamic_update_slice"(%arg0, %cst_1, %cst) {emitc.pure, template_args = [tensor<4xi32>]}
   %0 = "stablehlo.dynamic_update_slice"(%arg0, %cst_1, %cst) : (tensor<12xi32>, tensor<4xi32>, tensor<i64>) -> tensor<12xi32>
-  // CHECK: emitc.call_opaque "emitc::stablehlo::dynamic_update_slice"(%arg1, %cst_2, %cst, %cst_0) {template_args = [tensor<2x4xi32>]}
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dynamic_update_slice"(%arg1, %cst_2, %cst, %cst_0) {emitc.pure, template_args = [tensor<2x4xi32>]}
   %1 = "stablehlo.dynamic_update_slice"(%arg1, %cst_2, %cst, %cst_0) : (tensor<8x7xi32>, tensor<2x4xi32>, tensor<i64>, tensor<i64>) -> tensor<8x7xi32>
-  return
+  return %0, %1 : tensor<12xi32>, tensor<8x7xi32>
+}
+
+func.func @stablehlo_gather(%arg0: tensor<1000x64xf32>, %arg1: tensor<8x1xi32>) -> tensor<8x64xf32> {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::gather"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<1> : tensor<1xi64>, dense<0> : tensor<1xi64>, dense<0> : tensor<1xi64>, 1, dense<[1, 64]> : tensor<2xi64>], emitc.pure, template_args = [tensor<8x64xf32>]} : (tensor<1000x64xf32>, tensor<8x1xi32>) -> tensor<8x64xf32>
+  %0 = "stablehlo.gather"(%arg0, %arg1) {dimension_numbers = #stablehlo.gather<offset_dims = [1], collapsed_slice_dims = [0], start_index_map = [0], index_vector_dim = 1>, indices_are_sorted = false, slice_sizes = array<i64: 1, 64>} : (tensor<1000x64xf32>, tensor<8x1xi32>) -> tensor<8x64xf32>
+  return %0 : tensor<8x64xf32>
 }
 
 
 // Other ops
 
 func.func @stablehlo_batch_norm_inference(%arg0: tensor<4x2xf32>, %arg1: tensor<2xf32>, %arg2: tensor<2xf32>, %arg3: tensor<2xf32>, %arg4: tensor<2xf32>) -> tensor<4x2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::batch_norm_inference"(%arg0, %arg1, %arg2, %arg3, %arg4) {args = [0 : index, 1 : index, 2 : index, 3 : index, 4 : index, 1.000000e-03 : f32, 1], template_args = [tensor<4x2xf32>, tensor<2xf32>]} : (tensor<4x2xf32>, tensor<2xf32>, tensor<2xf32>, tensor<2xf32>, tensor<2xf32>) -> tensor<4x2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::batch_norm_inference"(%arg0, %arg1, %arg2, %arg3, %arg4) {args = [0 : index, 1 : index, 2 : index, 3 : index, 4 : index, 1.000000e-03 : f32, 1], emitc.pure, template_args = [tensor<4x2xf32>, tensor<2xf32>]} : (tensor<4x2xf32>, tensor<2xf32>, tensor<2xf32>, tensor<2xf32>, tensor<2xf32>) -> tensor<4x2xf32>
   %0 = "stablehlo.batch_norm_inference"(%arg0, %arg1, %arg2, %arg3, %arg4) {epsilon = 0.001 : f32, feature_index = 1 : i64} : (tensor<4x2xf32>, tensor<2xf32>, tensor<2xf32>, tensor<2xf32>, tensor<2xf32>) -> tensor<4x2xf32>
   return %0 : tensor<4x2xf32>
 }
 
 func.func @stablehlo_bitcast_convert(%arg0: tensor<ui32>) -> tensor<i32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::bitcast_convert"(%arg0) {template_args = [tensor<i32>]} : (tensor<ui32>) -> tensor<i32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::bitcast_convert"(%arg0) {emitc.pure, template_args = [tensor<i32>]} : (tensor<ui32>) -> tensor<i32>
   %0 = "stablehlo.bitcast_convert"(%arg0) : (tensor<ui32>) -> tensor<i32>
   return %0 : tensor<i32>
 }
 
 func.func @stablehlo_broadcast_in_dim(%arg0: tensor<i32>) -> tensor<3xi32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::broadcast_in_dim"(%arg0) {args = [0 : index, dense<> : tensor<0xi64>], template_args = [tensor<3xi32>]} : (tensor<i32>) -> tensor<3xi32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::broadcast_in_dim"(%arg0) {args = [0 : index, dense<> : tensor<0xi64>], emitc.pure, template_args = [tensor<3xi32>]} : (tensor<i32>) -> tensor<3xi32>
+  // TEMPLATE: emitc.call_opaque "emitc::stablehlo::broadcast_in_dim"(%arg0) {emitc.pure, template_args = [tensor<3xi32>, #emitc.opaque<"std::integer_sequence<int64_t>">]} : (tensor<i32>) -> tensor<3xi32>
   %0 = "stablehlo.broadcast_in_dim"(%arg0) {broadcast_dimensions = array<i64>} : (tensor<i32>) -> tensor<3xi32>
   return %0 : tensor<3xi32>
 }
 
 func.func @stablehlo_clamp(%arg0: tensor<2x1xf32>, %arg1: tensor<2x1xf32>, %arg2: tensor<2x1xf32>) -> tensor<2x1xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::clamp"(%arg0, %arg1, %arg2) {template_args = [tensor<2x1xf32>, tensor<2x1xf32>, tensor<2x1xf32>]} : (tensor<2x1xf32>, tensor<2x1xf32>, tensor<2x1xf32>) -> tensor<2x1xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::clamp"(%arg0, %arg1, %arg2) {emitc.pure, template_args = [tensor<2x1xf32>, tensor<2x1xf32>, tensor<2x1xf32>]} : (tensor<2x1xf32>, tensor<2x1xf32>, tensor<2x1xf32>) -> tensor<2x1xf32>
   %0 = "stablehlo.clamp"(%arg0, %arg1, %arg2) : (tensor<2x1xf32>, tensor<2x1xf32>, tensor<2x1xf32>) -> tensor<2x1xf32>
   return %0 : tensor<2x1xf32>
 }
 
 func.func @stablehlo_clamp_broadcast(%arg0: tensor<i32>, %arg1: tensor<4x2x1xi32>, %arg2: tensor<i32>) -> tensor<4x2x1xi32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::clamp"(%arg0, %arg1, %arg2) {template_args = [tensor<i32>, tensor<4x2x1xi32>, tensor<i32>]} : (tensor<i32>, tensor<4x2x1xi32>, tensor<i32>) -> tensor<4x2x1xi32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::clamp"(%arg0, %arg1, %arg2) {emitc.pure, template_args = [tensor<i32>, tensor<4x2x1xi32>, tensor<i32>]} : (tensor<i32>, tensor<4x2x1xi32>, tensor<i32>) -> tensor<4x2x1xi32>
   %0 = "stablehlo.clamp"(%arg0, %arg1, %arg2) : (tensor<i32>, tensor<4x2x1xi32>, tensor<i32>) -> tensor<4x2x1xi32>
   return %0 : tensor<4x2x1xi32>
 }
 
 func.func @stablehlo_concaternate(%arg0: tensor<1xf32>, %arg1: tensor<2xf32>) -> tensor<3xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::concatenate"(%arg0, %arg1) {template_args = [0, tensor<3xf32>]} : (tensor<1xf32>, tensor<2xf32>) -> tensor<3xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::concatenate"(%arg0, %arg1) {emitc.pure, template_args = [0, tensor<3xf32>]} : (tensor<1xf32>, tensor<2xf32>) -> tensor<3xf32>
   %0 = "stablehlo.concatenate"(%arg0, %arg1) {dimension = 0 : i64} : (tensor<1xf32>, tensor<2xf32>) -> tensor<3xf32>
   return %0 : tensor<3xf32>
 }
@@ -340,13 +356,38 @@ func.func @stablehlo_conv(%arg0: tensor<3x2x4x3xf32>, %arg1 : tensor<2x2x3x4xf32
 }
 
 func.func @stablehlo_dot(%arg0: tensor<512x512xf32>) -> tensor<512x512xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::dot"(%arg0, %arg0) {template_args = [tensor<512x512xf32>]} : (tensor<512x512xf32>, tensor<512x512xf32>) -> tensor<512x512xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dot"(%arg0, %arg0) {emitc.pure, template_args = [tensor<512x512xf32>]} : (tensor<512x512xf32>, tensor<512x512xf32>) -> tensor<512x512xf32>
   %0 = "stablehlo.dot"(%arg0, %arg0) : (tensor<512x512xf32>, tensor<512x512xf32>) -> tensor<512x512xf32>
   return %0 : tensor<512x512xf32>
 }
 
+func.func @stablehlo_dot_general(%arg0: tensor<2x12x64x32xf32>, %arg1: tensor<2x12x48x32xf32>) -> tensor<2x12x64x48xf32> {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dot_general"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<[0, 1]> : tensor<2xi64>, dense<[0, 1]> : tensor<2xi64>, dense<3> : tensor<1xi64>, dense<3> : tensor<1xi64>], emitc.pure, template_args = [tensor<2x12x64x48xf32>]} : (tensor<2x12x64x32xf32>, tensor<2x12x48x32xf32>) -> tensor<2x12x64x48xf32>
+  %0 = "stablehlo.dot_general"(%arg0, %arg1) {
+    dot_dimension_numbers = #stablehlo.dot<
+      lhs_batching_dimensions = [0, 1],
+      rhs_batching_dimensions = [0, 1],
+      lhs_contracting_dimensions = [3],
+      rhs_contracting_dimensions = [3]
+    >
+  } : (tensor<2x12x64x32xf32>, tensor<2x12x48x32xf32>) -> tensor<2x12x64x48xf32>
+  return %0 : tensor<2x12x64x48xf32>
+}
+
+func.func @stablehlo_dot_general_dense(%arg0: tensor<4x16x32xf32>, %arg1: tensor<32x8xf32>) -> tensor<4x16x8xf32> {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::dot_general"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<> : tensor<0xi64>, dense<> : tensor<0xi64>, dense<2> : tensor<1xi64>, dense<0> : tensor<1xi64>], emitc.pure, template_args = [tensor<4x16x8xf32>]} : (tensor<4x16x32xf32>, tensor<32x8xf32>) -> tensor<4x16x8xf32>
+  %0 = "stablehlo.dot_general"(%arg0, %arg1) {
+    dot_dimension_numbers = #stablehlo.dot<
+      lhs_contracting_dimensions = [2],
+      rhs_contracting_dimensions = [0]
+    >
+  } : (tensor<4x16x32xf32>, tensor<32x8xf32>) -> tensor<4x16x8xf32>
+  return %0 : tensor<4x16x8xf32>
+}
+
 func.func @stablehlo_pad(%arg0: tensor<2x3xf32>, %arg1: tensor<f32>) -> tensor<4x7xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::pad"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<-1> : tensor<2xi64>, dense<1> : tensor<2xi64>, dense<2> : tensor<2xi64>], template_args = [tensor<4x7xf32>]} : (tensor<2x3xf32>, tensor<f32>) -> tensor<4x7xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::pad"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<-1> : tensor<2xi64>, dense<1> : tensor<2xi64>, dense<2> : tensor<2xi64>], emitc.pure, template_args = [tensor<4x7xf32>]} : (tensor<2x3xf32>, tensor<f32>) -> tensor<4x7xf32>
+  // TEMPLATE: emitc.call_opaque "emitc::stablehlo::pad"(%arg0, %arg1) {emitc.pure, template_args = [tensor<4x7xf32>, #emitc.opaque<"std::integer_sequence<int64_t, -1, -1>">, #emitc.opaque<"std::integer_sequence<int64_t, 1, 1>">, #emitc.opaque<"std::integer_sequence<int64_t, 2, 2>">]} : (tensor<2x3xf32>, tensor<f32>) -> tensor<4x7xf32>
   %0 = "stablehlo.pad"(%arg0, %arg1) {
     edge_padding_low = array<i64: -1, -1>,
     edge_padding_high = array<i64: 1, 1>,
@@ -355,30 +396,30 @@ func.func @stablehlo_pad(%arg0: tensor<2x3xf32>, %arg1: tensor<f32>) -> tensor<4
   return %0 : tensor<4x7xf32>
 }
 
-func.func @stablehlo_reduce(%arg0 : tensor<2x1000xf32>, %arg1 : tensor<f32>, %arg2 : tensor<2x1000xi32>, %arg3 : tensor<i32>) -> tensor<2xi32>{
-  // CHECK: func @stablehlo_reduce_lambda_0(%arg0: tensor<f32>, %arg1: tensor<f32>)
+func.func @stablehlo_reduce(%arg0 : tensor<2x1000xf32>, %arg1 : tensor<f32>, %arg2 : tensor<2x1000xi32>, %arg3 : tensor<i32>) -> (tensor<2xf32>, tensor<2xi32>, tensor<2xf32>, tensor<2xi32>) {
+  // CHECK: func private @stablehlo_reduce_lambda_0(%arg0: tensor<f32>, %arg1: tensor<f32>)
   // CHECK: "emitc::stablehlo::add"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
-  // CHECK: func @stablehlo_reduce_lambda_1(%arg0: tensor<i32>, %arg1: tensor<i32>)
+  // CHECK: func private @stablehlo_reduce_lambda_1(%arg0: tensor<i32>, %arg1: tensor<i32>)
   // CHECK: "emitc::stablehlo::max"(%arg0, %arg1) : (tensor<i32>, tensor<i32>) -> tensor<i32>
-  // CHECK: func @stablehlo_reduce_lambda_2(%arg0: tensor<f32>, %arg1: tensor<i32>, %arg2: tensor<f32>, %arg3: tensor<i32>)
+  // CHECK: func private @stablehlo_reduce_lambda_2(%arg0: tensor<f32>, %arg1: tensor<i32>, %arg2: tensor<f32>, %arg3: tensor<i32>)
   // CHECK: "emitc::stablehlo::max"(%arg0, %arg2) : (tensor<f32>, tensor<f32>) -> tensor<f32>
   // CHECK: "emitc::stablehlo::min"(%arg1, %arg3) : (tensor<i32>, tensor<i32>) -> tensor<i32>
   
-  // CHECK: emitc.call_opaque "emitc::stablehlo::reduce"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<1> : tensor<1xi64>, @stablehlo_reduce_lambda_0], template_args = [tensor<2xf32>, 1]} : (tensor<2x1000xf32>, tensor<f32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::reduce"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<1> : tensor<1xi64>, @stablehlo_reduce_lambda_0], emitc.pure, template_args = [tensor<2xf32>, 1]} : (tensor<2x1000xf32>, tensor<f32>) -> tensor<2xf32>
   %0 = "stablehlo.reduce"(%arg0, %arg1) ({
     ^bb0(%arg4: tensor<f32>, %arg5: tensor<f32>):
       %1 = stablehlo.add %arg4, %arg5 : tensor<f32>
       "stablehlo.return"(%1) : (tensor<f32>) -> ()
     }) {dimensions = array<i64: 1>} : (tensor<2x1000xf32>, tensor<f32>) -> tensor<2xf32>
   
-  // CHECK: emitc.call_opaque "emitc::stablehlo::reduce"(%arg2, %arg3) {args = [0 : index, 1 : index, dense<1> : tensor<1xi64>, @stablehlo_reduce_lambda_1], template_args = [tensor<2xi32>, 1]} : (tensor<2x1000xi32>, tensor<i32>) -> tensor<2xi32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::reduce"(%arg2, %arg3) {args = [0 : index, 1 : index, dense<1> : tensor<1xi64>, @stablehlo_reduce_lambda_1], emitc.pure, template_args = [tensor<2xi32>, 1]} : (tensor<2x1000xi32>, tensor<i32>) -> tensor<2xi32>
   %1 = "stablehlo.reduce"(%arg2, %arg3) ({
     ^bb0(%arg4: tensor<i32>, %arg5: tensor<i32>):
       %2 = stablehlo.maximum %arg4, %arg5 : tensor<i32>
       "stablehlo.return"(%2) : (tensor<i32>) -> ()
     }) {dimensions = array<i64: 1>} : (tensor<2x1000xi32>, tensor<i32>) -> tensor<2xi32>
   
-  // CHECK: emitc.call_opaque "emitc::stablehlo::reduce"(%arg0, %arg2, %arg1, %arg3) {args = [0 : index, 1 : index, 2 : index, 3 : index, dense<1> : tensor<1xi64>, @stablehlo_reduce_lambda_2], template_args = [tensor<2xf32>, tensor<2xi32>, 1]} : (tensor<2x1000xf32>, tensor<2x1000xi32>, tensor<f32>, tensor<i32>) -> (tensor<2xf32>, tensor<2xi32>)
+  // CHECK: emitc.call_opaque "emitc::stablehlo::reduce"(%arg0, %arg2, %arg1, %arg3) {args = [0 : index, 1 : index, 2 : index, 3 : index, dense<1> : tensor<1xi64>, @stablehlo_reduce_lambda_2], emitc.pure, template_args = [tensor<2xf32>, tensor<2xi32>, 1]} : (tensor<2x1000xf32>, tensor<2x1000xi32>, tensor<f32>, tensor<i32>) -> (tensor<2xf32>, tensor<2xi32>)
   %2:2 = stablehlo.reduce(%arg0 init: %arg1), (%arg2 init: %arg3) across dimensions = [1] : (tensor<2x1000xf32>, tensor<2x1000xi32>, tensor<f32>, tensor<i32>) -> (tensor<2xf32>, tensor<2xi32>)
      reducer(%arg4: tensor<f32>, %arg5: tensor<f32>) (%arg6: tensor<i32>, %arg7: tensor<i32>)  {
       %2 = stablehlo.maximum %arg4, %arg5 : tensor<f32>
@@ -386,13 +427,13 @@ func.func @stablehlo_reduce(%arg0 : tensor<2x1000xf32>, %arg1 : tensor<f32>, %ar
       "stablehlo.return"(%2, %3) : (tensor<f32>, tensor<i32>) -> ()
     }
   
-  return %1 : tensor<2xi32>
+  return %0, %1, %2#0, %2#1 : tensor<2xf32>, tensor<2xi32>, tensor<2xf32>, tensor<2xi32>
 }
 
 func.func @stablehlo_reduce_window(%arg0 : tensor<2x114x114x64xf32>, %arg1 : tensor<f32>) -> tensor<2x56x56x64xf32> {
-  // CHECK: func @stablehlo_reduce_window_lambda_0(%arg0: tensor<f32>, %arg1: tensor<f32>)
+  // CHECK: func private @stablehlo_reduce_window_lambda_0(%arg0: tensor<f32>, %arg1: tensor<f32>)
   // CHECK: "emitc::stablehlo::max"
-  // CHECK: emitc.call_opaque "emitc::stablehlo::reduce_window"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<[1, 3, 3, 1]> : tensor<4xi64>, dense<[1, 2, 2, 1]> : tensor<4xi64>, dense<1> : tensor<4xi64>, dense<1> : tensor<4xi64>, dense<0> : tensor<8xi64>, @stablehlo_reduce_window_lambda_0], template_args = [tensor<2x56x56x64xf32>]}
+  // CHECK: emitc.call_opaque "emitc::stablehlo::reduce_window"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<[1, 3, 3, 1]> : tensor<4xi64>, dense<[1, 2, 2, 1]> : tensor<4xi64>, dense<1> : tensor<4xi64>, dense<1> : tensor<4xi64>, dense<0> : tensor<8xi64>, @stablehlo_reduce_window_lambda_0], emitc.pure, template_args = [tensor<2x56x56x64xf32>]}
   %0 = "stablehlo.reduce_window"(%arg0, %arg1) ( {
     ^bb0(%arg2: tensor<f32>, %arg3: tensor<f32>):  // no predecessors
       %516 = stablehlo.maximum %arg2, %arg3 : tensor<f32>
@@ -402,14 +443,76 @@ func.func @stablehlo_reduce_window(%arg0 : tensor<2x114x114x64xf32>, %arg1 : ten
   return %0 : tensor<2x56x56x64xf32>
 }
 
+func.func @stablehlo_scatter(%arg0 : tensor<1000x64xf32>, %arg1 : tensor<8x1xi32>, %arg2 : tensor<8x64xf32>, %arg3 : tensor<4xi32>, %arg4 : tensor<2x1xi64>, %arg5 : tensor<2xi32>) -> (tensor<1000x64xf32>, tensor<4xi32>) {
+  // CHECK: func private @stablehlo_scatter_lambda_0(%arg0: tensor<i32>, %arg1: tensor<i32>) -> tensor<i32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::scatter_add"(%arg0, %arg1, %arg2) {args = [0 : index, 1 : index, 2 : index, dense<1> : tensor<1xi64>, dense<0> : tensor<1xi64>, dense<0> : tensor<1xi64>, 1, false, false], emitc.pure, template_args = [tensor<1000x64xf32>]} : (tensor<1000x64xf32>, tensor<8x1xi32>, tensor<8x64xf32>) -> tensor<1000x64xf32>
+  %0 = "stablehlo.scatter"(%arg0, %arg1, %arg2) ({
+    ^bb0(%arg6: tensor<f32>, %arg7: tensor<f32>):
+      %2 = stablehlo.add %arg6, %arg7 : tensor<f32>
+      "stablehlo.return"(%2) : (tensor<f32>) -> ()
+    }) {scatter_dimension_numbers = #stablehlo.scatter<update_window_dims = [1], inserted_window_dims = [0], scatter_dims_to_operand_dims = [0], index_vector_dim = 1>, indices_are_sorted = false, unique_indices = false} : (tensor<1000x64xf32>, tensor<8x1xi32>, tensor<8x64xf32>) -> tensor<1000x64xf32>
+
+  // CHECK: emitc.call_opaque "emitc::stablehlo::scatter"(%arg3, %arg4, %arg5) {args = [0 : index, 1 : index, 2 : index, dense<> : tensor<0xi64>, dense<0> : tensor<1xi64>, dense<0> : tensor<1xi64>, 1, true, true, @stablehlo_scatter_lambda_0], emitc.pure, template_args = [tensor<4xi32>]} : (tensor<4xi32>, tensor<2x1xi64>, tensor<2xi32>) -> tensor<4xi32>
+  %1 = "stablehlo.scatter"(%arg3, %arg4, %arg5) ({
+    ^bb0(%arg6: tensor<i32>, %arg7: tensor<i32>):
+      "stablehlo.return"(%arg7) : (tensor<i32>) -> ()
+    }) {scatter_dimension_numbers = #stablehlo.scatter<update_window_dims = [], inserted_window_dims = [0], scatter_dims_to_operand_dims = [0], index_vector_dim = 1>, indices_are_sorted = true, unique_indices = true} : (tensor<4xi32>, tensor<2x1xi64>, tensor<2xi32>) -> tensor<4xi32>
+
+  return %0, %1 : tensor<1000x64xf32>, tensor<4xi32>
+}
+
+func.func @stablehlo_sort(%arg0 : tensor<2x8xf32>, %arg1 : tensor<2x8xi32>) -> (tensor<2x8xf32>, tensor<2x8xf32>, tensor<2x8xi32>) {
+  // CHECK: emitc.call_opaque "emitc::stablehlo::sort"(%arg0) {args = [0 : index, 1, false, #emitc.opaque<"emitc::stablehlo::SortDirection::Ascending">], emitc.pure, template_args = [tensor<2x8xf32>]} : (tensor<2x8xf32>) -> tensor<2x8xf32>
+  %0 = "stablehlo.sort"(%arg0) ({
+    ^bb0(%arg2: tensor<f32>, %arg3: tensor<f32>):
+      %1 = stablehlo.compare LT, %arg2, %arg3 : (tensor<f32>, tensor<f32>) -> tensor<i1>
+      "stablehlo.return"(%1) : (tensor<i1>) -> ()
+    }) {dimension = 1 : i64, is_stable = false} : (tensor<2x8xf32>) -> tensor<2x8xf32>
+
+  // CHECK: emitc.call_opaque "emitc::stablehlo::sort"(%arg0, %arg1) {args = [0 : index, 1 : index, 1, true, #emitc.opaque<"emitc::stablehlo::SortDirection::Descending">], emitc.pure, template_args = [tensor<2x8xf32>, tensor<2x8xi32>]} : (tensor<2x8xf32>, tensor<2x8xi32>) -> (tensor<2x8xf32>, tensor<2x8xi32>)
+  %1:2 = "stablehlo.sort"(%arg0, %arg1) ({
+    ^bb0(%arg2: tensor<f32>, %arg3: tensor<f32>, %arg4: tensor<i32>, %arg5: tensor<i32>):
+      %2 = stablehlo.compare LT, %arg3, %arg2 : (tensor<f32>, tensor<f32>) -> tensor<i1>
+      "stablehlo.return"(%2) : (tensor<i1>) -> ()
+    }) {dimension = 1 : i64, is_stable = true} : (tensor<2x8xf32>, tensor<2x8xi32>) -> (tensor<2x8xf32>, tensor<2x8xi32>)
+
+  return %0, %1#0, %1#1 : tensor<2x8xf32>, tensor<2x8xf32>, tensor<2x8xi32>
+}
+
+func.func @stablehlo_sort_top_k(%arg0 : tensor<2x8xf32>, %arg1 : tensor<2x8xi32>) -> (tensor<2x3xf32>, tensor<2x3xi32>) {
+  // CHECK-NOT: stablehlo.slice
+  // CHECK: emitc.call_opaque "emitc::stablehlo::top_k"(%arg0, %arg1) {args = [0 : index, 1 : index, 1, #emitc.opaque<"emitc::stablehlo::SortDirection::Descending">], emitc.pure, template_args = [tensor<2x3xf32>, tensor<2x3xi32>]} : (tensor<2x8xf32>, tensor<2x8xi32>) -> (tensor<2x3xf32>, tensor<2x3xi32>)
+  %0:2 = "stablehlo.sort"(%arg0, %arg1) ({
+    ^bb0(%arg2: tensor<f32>, %arg3: tensor<f32>, %arg4: tensor<i32>, %arg5: tensor<i32>):
+      %1 = stablehlo.compare GT, %arg2, %arg3 : (tensor<f32>, tensor<f32>) -> tensor<i1>
+      "stablehlo.return"(%1) : (tensor<i1>) -> ()
+    }) {dimension = 1 : i64, is_stable = true} : (tensor<2x8xf32>, tensor<2x8xi32>) -> (tensor<2x8xf32>, tensor<2x8xi32>)
+  %2 = "stablehlo.slice"(%0#0) {start_indices = array<i64: 0, 0>, limit_indices = array<i64: 2, 3>, strides = array<i64: 1, 1>} : (tensor<2x8xf32>) -> tensor<2x3xf32>
+  %3 = "stablehlo.slice"(%0#1) {start_indices = array<i64: 0, 0>, limit_indices = array<i64: 2, 3>, strides = array<i64: 1, 1>} : (tensor<2x8xi32>) -> tensor<2x3xi32>
+  return %2, %3 : tensor<2x3xf32>, tensor<2x3xi32>
+}
+
+func.func @stablehlo_sort_comparator(%arg0 : tensor<8xi32>) -> tensor<8xi32> {
+  // CHECK: func private @stablehlo_sort_comparator_lambda_0(%arg0: tensor<i32>, %arg1: tensor<i32>) -> tensor<i1>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::sort"(%arg0) {args = [0 : index, 0, true, @stablehlo_sort_comparator_lambda_0], emitc.pure, template_args = [tensor<8xi32>]} : (tensor<8xi32>) -> tensor<8xi32>
+  %0 = "stablehlo.sort"(%arg0) ({
+    ^bb0(%arg1: tensor<i32>, %arg2: tensor<i32>):
+      %1 = stablehlo.abs %arg1 : tensor<i32>
+      %2 = stablehlo.abs %arg2 : tensor<i32>
+      %3 = stablehlo.compare LT, %1, %2 : (tensor<i32>, tensor<i32>) -> tensor<i1>
+      "stablehlo.return"(%3) : (tensor<i1>) -> ()
+    }) {dimension = 0 : i64, is_stable = true} : (tensor<8xi32>) -> tensor<8xi32>
+  return %0 : tensor<8xi32>
+}
+
 func.func @stablehlo_reshape(%arg0: tensor<12xf32>) -> tensor<2x3x2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::reshape"(%arg0) {template_args = [tensor<2x3x2xf32>]} : (tensor<12xf32>) -> tensor<2x3x2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::reshape"(%arg0) {emitc.pure, template_args = [tensor<2x3x2xf32>]} : (tensor<12xf32>) -> tensor<2x3x2xf32>
   %0 = "stablehlo.reshape"(%arg0) : (tensor<12xf32>) -> tensor<2x3x2xf32>
   return %0 : tensor<2x3x2xf32>
 }
 
 func.func @stablehlo_select(%arg0: tensor<2xf32>, %arg1: tensor<2xf32>, %arg2: tensor<2xi1>) -> tensor<2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::select"(%arg2, %arg0, %arg1) : (tensor<2xi1>, tensor<2xf32>, tensor<2xf32>) -> tensor<2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::select"(%arg2, %arg0, %arg1) {emitc.pure} : (tensor<2xi1>, tensor<2xf32>, tensor<2xf32>) -> tensor<2xf32>
   %1 = "stablehlo.select"(%arg2, %arg0, %arg1) : (tensor<2xi1>, tensor<2xf32>, tensor<2xf32>) -> tensor<2xf32>
   return %1 : tensor<2xf32>
 }
@@ -420,7 +523,8 @@ func.func @select_scalar_pred(%arg0: tensor<i1>, %arg1: tensor<2x3xi32>, %arg2:
 }
 
 func.func @stablehlo_transpose(%arg0: tensor<2x3x4xf32>) -> tensor<4x3x2xf32> {
-  // CHECK: emitc.call_opaque "emitc::stablehlo::transpose"(%arg0) {args = [0 : index, dense<[2, 1, 0]> : tensor<3xi64>], template_args = [tensor<4x3x2xf32>]} : (tensor<2x3x4xf32>) -> tensor<4x3x2xf32>
+  // CHECK: emitc.call_opaque "emitc::stablehlo::transpose"(%arg0) {args = [0 : index, dense<[2, 1, 0]> : tensor<3xi64>], emitc.pure, template_args = [tensor<4x3x2xf32>]} : (tensor<2x3x4xf32>) -> tensor<4x3x2xf32>
+  // TEMPLATE: emitc.call_opaque "emitc::stablehlo::transpose"(%arg0) {emitc.pure, template_args = [tensor<4x3x2xf32>, #emitc.opaque<"std::integer_sequence<int64_t, 2, 1, 0>">]} : (tensor<2x3x4xf32>) -> tensor<4x3x2xf32>
   %0 = "stablehlo.transpose"(%arg0) {permutation = array<i64: 2, 1, 0>} : (tensor<2x3x4xf32>) -> tensor<4x3x2xf32>
   return %0 : tensor<4x3x2xf32>
 }
@@ -0,0 +1,45 @@
+// RUN: emitc-opt -tosa-blocked-layout=block-size=4 %s | FileCheck %s
+
+// CHECK-LABEL: func @test_conv_chain
+func.func @test_conv_chain(%arg0: tensor<1x8x8x3xf32>, %arg1: tensor<6xf32>, %arg2: tensor<5x3x3x6xf32>, %arg3: tensor<5xf32>) -> tensor<1x4x4x5xf32> {
+  // CHECK: %[[W0:.*]] = "tosa.const"() {{.*}} : () -> tensor<2x1x1x3x4xf32>
+  // CHECK: %[[IN:.*]] = emitc.call_opaque "emitc::tosa::to_nchwc"(%arg0) {emitc.pure, template_args = [tensor<1x1x8x8x4xf32>]}
+  // CHECK: %[[C0:.*]] = emitc.call_opaque "emitc::tosa::conv2d_nchwc"(%[[IN]], %[[W0]], %arg1) {args = [0 : index, 1 : index, 2 : index, dense<0> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<1> : tensor<2xi64>], emitc.pure, template_args = [tensor<1x2x8x8x4xf32>, 1]}
+  // CHECK: %[[R0:.*]] = "tosa.clamp"(%[[C0]]) {{.*}} : (tensor<1x2x8x8x4xf32>) -> tensor<1x2x8x8x4xf32>
+  // CHECK: %[[P0:.*]] = emitc.call_opaque "emitc::tosa::max_pool2d_nchwc"(%[[R0]]) {{.*}}emitc.pure, template_args = [tensor<1x2x4x4x4xf32>]}
+  // CHECK: %[[W1:.*]] = emitc.call_opaque "emitc::tosa::pack_weights"(%arg2) {emitc.pure, template_args = [tensor<2x3x3x6x4xf32>]}
+  // CHECK: %[[C1:.*]] = emitc.call_opaque "emitc::tosa::conv2d_nchwc"(%[[P0]], %[[W1]], %arg3)
+  // CHECK: %[[OUT:.*]] = emitc.call_opaque "emitc::tosa::from_nchwc"(%[[C1]]) {emitc.pure, template_args = [tensor<1x4x4x5xf32>]}
+  // CHECK-NOT: tosa.conv2d
+  // CHECK-NOT: tosa.max_pool2d
+  // CHECK: return %[[OUT]]
+  %0 = "tosa.const"() {value = dense<1.0> : tensor<6x1x1x3xf32>} : () -> tensor<6x1x1x3xf32>
+  %1 = "tosa.conv2d"(%arg0, %0, %arg1) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x8x8x3xf32>, tensor<6x1x1x3xf32>, tensor<6xf32>) -> tensor<1x8x8x6xf32>
+  %2 = "tosa.clamp"(%1) {max_fp = 6.000000e+00 : f32, max_int = 6 : i64, min_fp = 0.000000e+00 : f32, min_int = 0 : i64} : (tensor<1x8x8x6xf32>) -> tensor<1x8x8x6xf32>
+  %3 = "tosa.max_pool2d"(%2) {kernel = array<i64: 2, 2>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 2, 2>} : (tensor<1x8x8x6xf32>) -> tensor<1x4x4x6xf32>
+  %4 = "tosa.conv2d"(%3, %arg2, %arg3) {dilation = array<i64: 1, 1>, pad = array<i64: 1, 1, 1, 1>, stride = array<i64: 1, 1>} : (tensor<1x4x4x6xf32>, tensor<5x3x3x6xf32>, tensor<5xf32>) -> tensor<1x4x4x5xf32>
+  return %4 : tensor<1x4x4x5xf32>
+}
+
+// CHECK-LABEL: func @test_residual
+func.func @test_residual(%arg0: tensor<1x2x2x4xf32>, %arg1: tensor<4x1x1x4xf32>, %arg2: tensor<4xf32>) -> (tensor<1x2x2x4xf32>, tensor<1x2x2x4xf32>) {
+  // CHECK: %[[IN:.*]] = emitc.call_opaque "emitc::tosa::to_nchwc"(%arg0)
+  // CHECK: %[[C0:.*]] = emitc.call_opaque "emitc::tosa::conv2d_nchwc"(%[[IN]]
+  // CHECK: %[[C0_NHWC:.*]] = emitc.call_opaque "emitc::tosa::from_nchwc"(%[[C0]])
+  // CHECK: %[[C1:.*]] = emitc.call_opaque "emitc::tosa::conv2d_nchwc"(%[[C0]]
+  // CHECK: %[[ADD:.*]] = "tosa.add"(%[[C1]], %[[IN]]) : (tensor<1x1x2x2x4xf32>, tensor<1x1x2x2x4xf32>) -> tensor<1x1x2x2x4xf32>
+  // CHECK: %[[OUT:.*]] = emitc.call_opaque "emitc::tosa::from_nchwc"(%[[ADD]])
+  // CHECK: return %[[OUT]], %[[C0_NHWC]]
+  %0 = "tosa.conv2d"(%arg0, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x2x2x4xf32>, tensor<4x1x1x4xf32>, tensor<4xf32>) -> tensor<1x2x2x4xf32>
+  %1 = "tosa.conv2d"(%0, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x2x2x4xf32>, tensor<4x1x1x4xf32>, tensor<4xf32>) -> tensor<1x2x2x4xf32>
+  %2 = "tosa.add"(%1, %arg0) : (tensor<1x2x2x4xf32>, tensor<1x2x2x4xf32>) -> tensor<1x2x2x4xf32>
+  return %2, %0 : tensor<1x2x2x4xf32>, tensor<1x2x2x4xf32>
+}
+
+// CHECK-LABEL: func @test_pool_without_chain
+func.func @test_pool_without_chain(%arg0: tensor<1x4x4x4xf32>) -> tensor<1x2x2x4xf32> {
+  // CHECK-NOT: emitc.call_opaque
+  // CHECK: tosa.max_pool2d
+  %0 = "tosa.max_pool2d"(%arg0) {kernel = array<i64: 2, 2>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 2, 2>} : (tensor<1x4x4x4xf32>) -> tensor<1x2x2x4xf32>
+  return %0 : tensor<1x2x2x4xf32>
+}
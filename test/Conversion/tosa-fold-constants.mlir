@@ -0,0 +1,88 @@
+// RUN: emitc-opt -fold-tosa-constants %s | FileCheck %s
+// RUN: emitc-opt -fold-tosa-constants -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+
+// STATS: FoldTosaConstants
+// STATS-DAG: 11 num-removed-ops
+// STATS-DAG: 156 num-removed-bytes
+
+// CHECK-LABEL: func @test_transpose
+func.func @test_transpose() -> tensor<3x2xi32> {
+  // CHECK-NEXT: %[[CST:.*]] = "tosa.const"(){{.*}}value = dense<{{\[}}[1, 4], [2, 5], [3, 6]]> : tensor<3x2xi32>
+  // CHECK-NEXT: return %[[CST]]
+  %0 = "tosa.const"() {value = dense<[[1, 2, 3], [4, 5, 6]]> : tensor<2x3xi32>} : () -> tensor<2x3xi32>
+  %1 = "tosa.const"() {value = dense<[1, 0]> : tensor<2xi32>} : () -> tensor<2xi32>
+  %2 = "tosa.transpose"(%0, %1) : (tensor<2x3xi32>, tensor<2xi32>) -> tensor<3x2xi32>
+  return %2 : tensor<3x2xi32>
+}
+
+// CHECK-LABEL: func @test_reshape
+func.func @test_reshape() -> tensor<3x2xf32> {
+  // CHECK-NEXT: %[[CST:.*]] = "tosa.const"(){{.*}}value = dense<{{\[}}[1.000000e+00, 2.000000e+00], [3.000000e+00, 4.000000e+00], [5.000000e+00, 6.000000e+00]]> : tensor<3x2xf32>
+  // CHECK-NEXT: return %[[CST]]
+  %0 = "tosa.const"() {value = dense<[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]]> : tensor<2x3xf32>} : () -> tensor<2x3xf32>
+  %1 = "tosa.reshape"(%0) {new_shape = array<i64: 3, 2>} : (tensor<2x3xf32>) -> tensor<3x2xf32>
+  return %1 : tensor<3x2xf32>
+}
+
+// CHECK-LABEL: func @test_cast
+func.func @test_cast() -> (tensor<3xi32>, tensor<3xf32>) {
+  // CHECK-NEXT: %[[CST0:.*]] = "tosa.const"(){{.*}}value = dense<[1, -2, 0]> : tensor<3xi32>
+  // CHECK-NEXT: %[[CST1:.*]] = "tosa.const"(){{.*}}value = dense<[1.000000e+00, -2.000000e+00, 0.000000e+00]> : tensor<3xf32>
+  // CHECK-NEXT: return %[[CST0]], %[[CST1]]
+  %0 = "tosa.const"() {value = dense<[1.5, -2.5, 0.0]> : tensor<3xf32>} : () -> tensor<3xf32>
+  %1 = "tosa.cast"(%0) : (tensor<3xf32>) -> tensor<3xi32>
+  %2 = "tosa.cast"(%1) : (tensor<3xi32>) -> tensor<3xf32>
+  return %1, %2 : tensor<3xi32>, tensor<3xf32>
+}
+
+// CHECK-LABEL: func @test_mul
+func.func @test_mul() -> (tensor<2x2xf32>, tensor<2xi32>) {
+  // CHECK-NEXT: %[[CST0:.*]] = "tosa.const"(){{.*}}value = dense<{{\[}}[2.000000e+00, 4.000000e+00], [9.000000e+00, 1.200000e+01]]> : tensor<2x2xf32>
+  // CHECK-NEXT: %[[CST1:.*]] = "tosa.const"(){{.*}}value = dense<[3, -1]> : tensor<2xi32>
+  // CHECK-NEXT: return %[[CST0]], %[[CST1]]
+  %0 = "tosa.const"() {value = dense<[[1.0, 2.0], [3.0, 4.0]]> : tensor<2x2xf32>} : () -> tensor<2x2xf32>
+  %1 = "tosa.const"() {value = dense<[[2.0], [3.0]]> : tensor<2x1xf32>} : () -> tensor<2x1xf32>
+  %2 = "tosa.mul"(%0, %1) {shift = 0 : i8} : (tensor<2x2xf32>, tensor<2x1xf32>) -> tensor<2x2xf32>
+  %3 = "tosa.const"() {value = dense<[5, -3]> : tensor<2xi32>} : () -> tensor<2xi32>
+  %4 = "tosa.const"() {value = dense<[1, 1]> : tensor<2xi32>} : () -> tensor<2xi32>
+  %5 = "tosa.mul"(%3, %4) {shift = 1 : i8} : (tensor<2xi32>, tensor<2xi32>) -> tensor<2xi32>
+  return %2, %5 : tensor<2x2xf32>, tensor<2xi32>
+}
+
+// CHECK-LABEL: func @test_reciprocal
+func.func @test_reciprocal() -> tensor<2xf32> {
+  // CHECK-NEXT: %[[CST:.*]] = "tosa.const"(){{.*}}value = dense<[5.000000e-01, -4.000000e+00]> : tensor<2xf32>
+  // CHECK-NEXT: return %[[CST]]
+  %0 = "tosa.const"() {value = dense<[2.0, -0.25]> : tensor<2xf32>} : () -> tensor<2xf32>
+  %1 = "tosa.reciprocal"(%0) : (tensor<2xf32>) -> tensor<2xf32>
+  return %1 : tensor<2xf32>
+}
+
+// CHECK-LABEL: func @test_rescale
+func.func @test_rescale() -> tensor<4xi8> {
+  // CHECK-NEXT: %[[CST:.*]] = "tosa.const"(){{.*}}value = dense<[1, 64, 127, -128]> : tensor<4xi8>
+  // CHECK-NEXT: return %[[CST]]
+  %0 = "tosa.const"() {value = dense<[2, 128, 1000, -1000]> : tensor<4xi32>} : () -> tensor<4xi32>
+  %1 = "tosa.rescale"(%0) {double_round = false, input_zp = 0 : i32, multiplier = array<i32: 1073741824>, output_zp = 0 : i32, per_channel = false, scale32 = true, shift = array<i32: 31>} : (tensor<4xi32>) -> tensor<4xi8>
+  return %1 : tensor<4xi8>
+}
+
+// CHECK-LABEL: func @test_chain
+func.func @test_chain() -> tensor<2x2xf32> {
+  // CHECK-NEXT: %[[CST:.*]] = "tosa.const"(){{.*}}value = dense<{{\[}}[1.000000e+00, 3.000000e+00], [2.000000e+00, 4.000000e+00]]> : tensor<2x2xf32>
+  // CHECK-NEXT: return %[[CST]]
+  %0 = "tosa.const"() {value = dense<[1, 2, 3, 4]> : tensor<4xi32>} : () -> tensor<4xi32>
+  %1 = "tosa.cast"(%0) : (tensor<4xi32>) -> tensor<4xf32>
+  %2 = "tosa.reshape"(%1) {new_shape = array<i64: 2, 2>} : (tensor<4xf32>) -> tensor<2x2xf32>
+  %3 = "tosa.const"() {value = dense<[1, 0]> : tensor<2xi32>} : () -> tensor<2xi32>
+  %4 = "tosa.transpose"(%2, %3) : (tensor<2x2xf32>, tensor<2xi32>) -> tensor<2x2xf32>
+  return %4 : tensor<2x2xf32>
+}
+
+// CHECK-LABEL: func @test_non_constant
+func.func @test_non_constant(%arg0: tensor<2x3xi32>) -> tensor<3x2xi32> {
+  // CHECK: tosa.transpose
+  %0 = "tosa.const"() {value = dense<[1, 0]> : tensor<2xi32>} : () -> tensor<2xi32>
+  %1 = "tosa.transpose"(%arg0, %0) : (tensor<2x3xi32>, tensor<2xi32>) -> tensor<3x2xi32>
+  return %1 : tensor<3x2xi32>
+}
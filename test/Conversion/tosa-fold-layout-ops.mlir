@@ -0,0 +1,95 @@
+// RUN: emitc-opt -fold-tosa-layout-ops %s | FileCheck %s
+// RUN: emitc-opt -fold-tosa-layout-ops -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+// RUN: emitc-opt -fold-tosa-layout-ops %S/../MobileNetV2_FakeWeights_tosa.mlir | FileCheck %s --check-prefix=MOBILENET-RESHAPE
+// RUN: emitc-opt -fold-tosa-layout-ops %S/../MobileNetV2_FakeWeights_tosa.mlir | FileCheck %s --check-prefix=MOBILENET-TRANSPOSE
+
+// STATS: FoldTosaLayoutOps
+// STATS: 8 num-removed-ops
+
+// The MobileNetV2 model reshapes and transposes the same weights several
+// times. 214 reshapes are merged into 71 and 35 transposes into 20.
+// MOBILENET-RESHAPE-COUNT-71: "tosa.reshape"
+// MOBILENET-RESHAPE-NOT: "tosa.reshape"
+// MOBILENET-TRANSPOSE-COUNT-20: "tosa.transpose"
+// MOBILENET-TRANSPOSE-NOT: "tosa.transpose"
+
+// CHECK-LABEL: func @test_reshape_chain
+func.func @test_reshape_chain(%arg0: tensor<2x3x4xf32>) -> tensor<4x6xf32> {
+  // CHECK-NEXT: %[[R:.*]] = "tosa.reshape"(%arg0) {{.*}}new_shape = array<i64: 4, 6>{{.*}} : (tensor<2x3x4xf32>) -> tensor<4x6xf32>
+  // CHECK-NEXT: return %[[R]]
+  %0 = "tosa.reshape"(%arg0) {new_shape = array<i64: 24>} : (tensor<2x3x4xf32>) -> tensor<24xf32>
+  %1 = "tosa.reshape"(%0) {new_shape = array<i64: 4, 6>} : (tensor<24xf32>) -> tensor<4x6xf32>
+  return %1 : tensor<4x6xf32>
+}
+
+// CHECK-LABEL: func @test_reshape_identity
+func.func @test_reshape_identity(%arg0: tensor<2x3xf32>) -> tensor<2x3xf32> {
+  // CHECK-NEXT: return %arg0
+  %0 = "tosa.reshape"(%arg0) {new_shape = array<i64: 6>} : (tensor<2x3xf32>) -> tensor<6xf32>
+  %1 = "tosa.reshape"(%0) {new_shape = array<i64: 2, 3>} : (tensor<6xf32>) -> tensor<2x3xf32>
+  return %1 : tensor<2x3xf32>
+}
+
+// CHECK-LABEL: func @test_reshape_shared
+func.func @test_reshape_shared(%arg0: tensor<2x3xf32>) -> (tensor<6xf32>, tensor<3x2xf32>) {
+  // CHECK-NEXT: %[[R0:.*]] = "tosa.reshape"(%arg0) {{.*}}new_shape = array<i64: 6>
+  // CHECK-NEXT: %[[R1:.*]] = "tosa.reshape"(%arg0) {{.*}}new_shape = array<i64: 3, 2>
+  // CHECK-NEXT: return %[[R0]], %[[R1]]
+  %0 = "tosa.reshape"(%arg0) {new_shape = array<i64: 6>} : (tensor<2x3xf32>) -> tensor<6xf32>
+  %1 = "tosa.reshape"(%0) {new_shape = array<i64: 3, 2>} : (tensor<6xf32>) -> tensor<3x2xf32>
+  return %0, %1 : tensor<6xf32>, tensor<3x2xf32>
+}
+
+// CHECK-LABEL: func @test_reshape_duplicate
+func.func @test_reshape_duplicate(%arg0: tensor<2x3xf32>) -> tensor<6xf32> {
+  // CHECK-NEXT: %[[R:.*]] = "tosa.reshape"(%arg0)
+  // CHECK-NEXT: %[[ADD:.*]] = "tosa.add"(%[[R]], %[[R]])
+  // CHECK-NEXT: return %[[ADD]]
+  %0 = "tosa.reshape"(%arg0) {new_shape = array<i64: 6>} : (tensor<2x3xf32>) -> tensor<6xf32>
+  %1 = "tosa.reshape"(%arg0) {new_shape = array<i64: 6>} : (tensor<2x3xf32>) -> tensor<6xf32>
+  %2 = "tosa.add"(%0, %1) : (tensor<6xf32>, tensor<6xf32>) -> tensor<6xf32>
+  return %2 : tensor<6xf32>
+}
+
+// CHECK-LABEL: func @test_transpose_chain
+func.func @test_transpose_chain(%arg0: tensor<2x3x4xf32>) -> tensor<4x2x3xf32> {
+  // CHECK-NEXT: %[[P:.*]] = "tosa.const"(){{.*}}value = dense<[2, 0, 1]> : tensor<3xi32>
+  // CHECK-NEXT: %[[T:.*]] = "tosa.transpose"(%arg0, %[[P]]) : (tensor<2x3x4xf32>, tensor<3xi32>) -> tensor<4x2x3xf32>
+  // CHECK-NEXT: return %[[T]]
+  %0 = "tosa.const"() {value = dense<[1, 0, 2]> : tensor<3xi32>} : () -> tensor<3xi32>
+  %1 = "tosa.transpose"(%arg0, %0) : (tensor<2x3x4xf32>, tensor<3xi32>) -> tensor<3x2x4xf32>
+  %2 = "tosa.const"() {value = dense<[2, 1, 0]> : tensor<3xi32>} : () -> tensor<3xi32>
+  %3 = "tosa.transpose"(%1, %2) : (tensor<3x2x4xf32>, tensor<3xi32>) -> tensor<4x2x3xf32>
+  return %3 : tensor<4x2x3xf32>
+}
+
+// CHECK-LABEL: func @test_transpose_identity
+func.func @test_transpose_identity(%arg0: tensor<2x3xf32>) -> tensor<2x3xf32> {
+  // CHECK-NEXT: return %arg0
+  %0 = "tosa.const"() {value = dense<[1, 0]> : tensor<2xi32>} : () -> tensor<2xi32>
+  %1 = "tosa.transpose"(%arg0, %0) : (tensor<2x3xf32>, tensor<2xi32>) -> tensor<3x2xf32>
+  %2 = "tosa.transpose"(%1, %0) : (tensor<3x2xf32>, tensor<2xi32>) -> tensor<2x3xf32>
+  return %2 : tensor<2x3xf32>
+}
+
+// CHECK-LABEL: func @test_transpose_as_reshape
+func.func @test_transpose_as_reshape(%arg0: tensor<1x1x3x4xf32>) -> tensor<3x1x4x1xf32> {
+  // CHECK-NEXT: %[[R:.*]] = "tosa.reshape"(%arg0) {{.*}}new_shape = array<i64: 3, 1, 4, 1>{{.*}} : (tensor<1x1x3x4xf32>) -> tensor<3x1x4x1xf32>
+  // CHECK-NEXT: return %[[R]]
+  %0 = "tosa.const"() {value = dense<[2, 0, 3, 1]> : tensor<4xi32>} : () -> tensor<4xi32>
+  %1 = "tosa.transpose"(%arg0, %0) : (tensor<1x1x3x4xf32>, tensor<4xi32>) -> tensor<3x1x4x1xf32>
+  return %1 : tensor<3x1x4x1xf32>
+}
+
+// CHECK-LABEL: func @test_transpose_duplicate
+func.func @test_transpose_duplicate(%arg0: tensor<2x3xf32>) -> tensor<3x2xf32> {
+  // CHECK-NEXT: %[[P:.*]] = "tosa.const"()
+  // CHECK-NEXT: %[[T:.*]] = "tosa.transpose"(%arg0, %[[P]])
+  // CHECK-NEXT: %[[ADD:.*]] = "tosa.add"(%[[T]], %[[T]])
+  // CHECK-NEXT: return %[[ADD]]
+  %0 = "tosa.const"() {value = dense<[1, 0]> : tensor<2xi32>} : () -> tensor<2xi32>
+  %1 = "tosa.transpose"(%arg0, %0) : (tensor<2x3xf32>, tensor<2xi32>) -> tensor<3x2xf32>
+  %2 = "tosa.transpose"(%arg0, %0) : (tensor<2x3xf32>, tensor<2xi32>) -> tensor<3x2xf32>
+  %3 = "tosa.add"(%1, %2) : (tensor<3x2xf32>, tensor<3x2xf32>) -> tensor<3x2xf32>
+  return %3 : tensor<3x2xf32>
+}
@@ -0,0 +1,74 @@
+// RUN: emitc-opt -fold-tosa-pad %s | FileCheck %s
+
+// CHECK-LABEL: func @test_conv2d
+func.func @test_conv2d(%arg0: tensor<1x4x4x4xf32>, %arg1: tensor<8x3x3x4xf32>, %arg2: tensor<8xf32>) -> tensor<1x4x4x8xf32> {
+  // CHECK-NOT: tosa.pad
+  // CHECK: tosa.conv2d{{.*}}%arg0, %arg1, %arg2{{.*}}pad = array<i64: 1, 1, 1, 1>
+  %0 = "tosa.const"() {value = dense<[[0, 0], [1, 1], [1, 1], [0, 0]]> : tensor<4x2xi32>} : () -> tensor<4x2xi32>
+  %1 = "tosa.pad"(%arg0, %0) : (tensor<1x4x4x4xf32>, tensor<4x2xi32>) -> tensor<1x6x6x4xf32>
+  %2 = "tosa.conv2d"(%1, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x6x6x4xf32>, tensor<8x3x3x4xf32>, tensor<8xf32>) -> tensor<1x4x4x8xf32>
+  return %2 : tensor<1x4x4x8xf32>
+}
+
+// CHECK-LABEL: func @test_depthwise_conv2d
+func.func @test_depthwise_conv2d(%arg0: tensor<1x4x4x2xf32>, %arg1: tensor<3x3x2x1xf32>, %arg2: tensor<2xf32>) -> tensor<1x2x2x2xf32> {
+  // CHECK-NOT: tosa.pad
+  // CHECK: tosa.depthwise_conv2d{{.*}}%arg0, %arg1, %arg2{{.*}}pad = array<i64: 0, 1, 0, 1>
+  %0 = "tosa.const"() {value = dense<[[0, 0], [0, 1], [0, 1], [0, 0]]> : tensor<4x2xi32>} : () -> tensor<4x2xi32>
+  %1 = "tosa.const"() {value = dense<0.0> : tensor<f32>} : () -> tensor<f32>
+  %2 = "tosa.pad"(%arg0, %0, %1) : (tensor<1x4x4x2xf32>, tensor<4x2xi32>, tensor<f32>) -> tensor<1x5x5x2xf32>
+  %3 = "tosa.depthwise_conv2d"(%2, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 2, 2>} : (tensor<1x5x5x2xf32>, tensor<3x3x2x1xf32>, tensor<2xf32>) -> tensor<1x2x2x2xf32>
+  return %3 : tensor<1x2x2x2xf32>
+}
+
+// CHECK-LABEL: func @test_conv2d_nonzero_pad
+func.func @test_conv2d_nonzero_pad(%arg0: tensor<1x4x4x4xf32>, %arg1: tensor<8x3x3x4xf32>, %arg2: tensor<8xf32>) -> tensor<1x4x4x8xf32> {
+  // CHECK: tosa.pad
+  // CHECK: tosa.conv2d{{.*}}pad = array<i64: 0, 0, 0, 0>
+  %0 = "tosa.const"() {value = dense<[[0, 0], [1, 1], [1, 1], [0, 0]]> : tensor<4x2xi32>} : () -> tensor<4x2xi32>
+  %1 = "tosa.const"() {value = dense<1.0> : tensor<f32>} : () -> tensor<f32>
+  %2 = "tosa.pad"(%arg0, %0, %1) : (tensor<1x4x4x4xf32>, tensor<4x2xi32>, tensor<f32>) -> tensor<1x6x6x4xf32>
+  %3 = "tosa.conv2d"(%2, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x6x6x4xf32>, tensor<8x3x3x4xf32>, tensor<8xf32>) -> tensor<1x4x4x8xf32>
+  return %3 : tensor<1x4x4x8xf32>
+}
+
+// CHECK-LABEL: func @test_conv2d_channel_pad
+func.func @test_conv2d_channel_pad(%arg0: tensor<1x4x4x3xf32>, %arg1: tensor<8x1x1x4xf32>, %arg2: tensor<8xf32>) -> tensor<1x4x4x8xf32> {
+  // CHECK: tosa.pad
+  // CHECK: tosa.conv2d
+  %0 = "tosa.const"() {value = dense<[[0, 0], [0, 0], [0, 0], [0, 1]]> : tensor<4x2xi32>} : () -> tensor<4x2xi32>
+  %1 = "tosa.pad"(%arg0, %0) : (tensor<1x4x4x3xf32>, tensor<4x2xi32>) -> tensor<1x4x4x4xf32>
+  %2 = "tosa.conv2d"(%1, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x4x4x4xf32>, tensor<8x1x1x4xf32>, tensor<8xf32>) -> tensor<1x4x4x8xf32>
+  return %2 : tensor<1x4x4x8xf32>
+}
+
+// CHECK-LABEL: func @test_max_pool2d
+func.func @test_max_pool2d(%arg0: tensor<1x4x4x8xf32>) -> tensor<1x2x2x8xf32> {
+  // CHECK-NOT: tosa.pad
+  // CHECK: tosa.max_pool2d{{.*}}%arg0{{.*}}pad = array<i64: 0, 1, 0, 1>
+  %0 = "tosa.const"() {value = dense<[[0, 0], [0, 1], [0, 1], [0, 0]]> : tensor<4x2xi32>} : () -> tensor<4x2xi32>
+  %1 = "tosa.const"() {value = dense<0xFF800000> : tensor<f32>} : () -> tensor<f32>
+  %2 = "tosa.pad"(%arg0, %0, %1) : (tensor<1x4x4x8xf32>, tensor<4x2xi32>, tensor<f32>) -> tensor<1x5x5x8xf32>
+  %3 = "tosa.max_pool2d"(%2) {kernel = array<i64: 3, 3>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 2, 2>} : (tensor<1x5x5x8xf32>) -> tensor<1x2x2x8xf32>
+  return %3 : tensor<1x2x2x8xf32>
+}
+
+// CHECK-LABEL: func @test_max_pool2d_zero_pad
+func.func @test_max_pool2d_zero_pad(%arg0: tensor<1x4x4x8xf32>) -> tensor<1x2x2x8xf32> {
+  // CHECK: tosa.pad
+  // CHECK: tosa.max_pool2d{{.*}}pad = array<i64: 0, 0, 0, 0>
+  %0 = "tosa.const"() {value = dense<[[0, 0], [0, 1], [0, 1], [0, 0]]> : tensor<4x2xi32>} : () -> tensor<4x2xi32>
+  %1 = "tosa.pad"(%arg0, %0) : (tensor<1x4x4x8xf32>, tensor<4x2xi32>) -> tensor<1x5x5x8xf32>
+  %2 = "tosa.max_pool2d"(%1) {kernel = array<i64: 3, 3>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 2, 2>} : (tensor<1x5x5x8xf32>) -> tensor<1x2x2x8xf32>
+  return %2 : tensor<1x2x2x8xf32>
+}
+
+// CHECK-LABEL: func @test_avg_pool2d
+func.func @test_avg_pool2d(%arg0: tensor<1x4x4x8xf32>) -> tensor<1x2x2x8xf32> {
+  // CHECK: tosa.pad
+  // CHECK: tosa.avg_pool2d{{.*}}pad = array<i64: 0, 0, 0, 0>
+  %0 = "tosa.const"() {value = dense<[[0, 0], [0, 1], [0, 1], [0, 0]]> : tensor<4x2xi32>} : () -> tensor<4x2xi32>
+  %1 = "tosa.pad"(%arg0, %0) : (tensor<1x4x4x8xf32>, tensor<4x2xi32>) -> tensor<1x5x5x8xf32>
+  %2 = "tosa.avg_pool2d"(%1) {acc_type = f32, kernel = array<i64: 3, 3>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 2, 2>} : (tensor<1x5x5x8xf32>) -> tensor<1x2x2x8xf32>
+  return %2 : tensor<1x2x2x8xf32>
+}
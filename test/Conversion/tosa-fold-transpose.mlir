@@ -0,0 +1,51 @@
+// RUN: emitc-opt -fold-tosa-transpose %s | FileCheck %s
+// RUN: emitc-opt -fold-tosa-transpose="kernel-backends=matmul:blas,fully_connected:eigen" %s | FileCheck %s --check-prefix=BACKEND
+// RUN: not emitc-opt -fold-tosa-transpose="kernel-backends=matmul:mkl" %s 2>&1 | FileCheck %s --check-prefix=ERROR
+
+// ERROR: error: no 'mkl' kernel for 'matmul'
+
+// CHECK-LABEL: func @test_matmul_tn
+// BACKEND-LABEL: func @test_matmul_tn
+func.func @test_matmul_tn(%arg0: tensor<1x2x3xf32>, %arg1: tensor<1x2x4xf32>) -> tensor<1x3x4xf32> {
+  // CHECK-NOT: tosa.transpose
+  // CHECK: emitc.call_opaque "emitc::tosa::matmul_transposed"(%arg0, %arg1) {emitc.pure, template_args = [tensor<1x3x4xf32>, true, false]} : (tensor<1x2x3xf32>, tensor<1x2x4xf32>) -> tensor<1x3x4xf32>
+  // BACKEND: emitc.call_opaque "emitc::tosa::blas::matmul_transposed"(%arg0, %arg1) {emitc.pure, template_args = [tensor<1x3x4xf32>, true, false]}
+  %0 = "tosa.const"() {value = dense<[0, 2, 1]> : tensor<3xi32>} : () -> tensor<3xi32>
+  %1 = "tosa.transpose"(%arg0, %0) : (tensor<1x2x3xf32>, tensor<3xi32>) -> tensor<1x3x2xf32>
+  %2 = "tosa.matmul"(%1, %arg1) : (tensor<1x3x2xf32>, tensor<1x2x4xf32>) -> tensor<1x3x4xf32>
+  return %2 : tensor<1x3x4xf32>
+}
+
+// CHECK-LABEL: func @test_matmul_tt
+func.func @test_matmul_tt(%arg0: tensor<1x2x3xf32>, %arg1: tensor<1x3x2xf32>) -> tensor<1x3x3xf32> {
+  // CHECK-NOT: tosa.transpose
+  // CHECK: emitc.call_opaque "emitc::tosa::matmul_transposed"(%arg0, %arg1) {emitc.pure, template_args = [tensor<1x3x3xf32>, true, true]}
+  %0 = "tosa.const"() {value = dense<[0, 2, 1]> : tensor<3xi32>} : () -> tensor<3xi32>
+  %1 = "tosa.transpose"(%arg0, %0) : (tensor<1x2x3xf32>, tensor<3xi32>) -> tensor<1x3x2xf32>
+  %2 = "tosa.transpose"(%arg1, %0) : (tensor<1x3x2xf32>, tensor<3xi32>) -> tensor<1x2x3xf32>
+  %3 = "tosa.matmul"(%1, %2) : (tensor<1x3x2xf32>, tensor<1x2x3xf32>) -> tensor<1x3x3xf32>
+  return %3 : tensor<1x3x3xf32>
+}
+
+// CHECK-LABEL: func @test_matmul_batch_transpose
+func.func @test_matmul_batch_transpose(%arg0: tensor<3x1x2xf32>, %arg1: tensor<1x2x4xf32>) -> tensor<1x3x4xf32> {
+  // CHECK: tosa.transpose
+  // CHECK: tosa.matmul
+  %0 = "tosa.const"() {value = dense<[1, 0, 2]> : tensor<3xi32>} : () -> tensor<3xi32>
+  %1 = "tosa.transpose"(%arg0, %0) : (tensor<3x1x2xf32>, tensor<3xi32>) -> tensor<1x3x2xf32>
+  %2 = "tosa.matmul"(%1, %arg1) : (tensor<1x3x2xf32>, tensor<1x2x4xf32>) -> tensor<1x3x4xf32>
+  return %2 : tensor<1x3x4xf32>
+}
+
+// CHECK-LABEL: func @test_fully_connected
+// BACKEND-LABEL: func @test_fully_connected
+func.func @test_fully_connected(%arg0: tensor<1x5xf32>, %arg1: tensor<5x2xf32>, %arg2: tensor<2xf32>) -> (tensor<1x2xf32>, tensor<2x5xf32>) {
+  // CHECK: %[[T:.*]] = "tosa.transpose"(%arg1
+  // CHECK: emitc.call_opaque "emitc::tosa::fully_connected_transposed"(%arg0, %arg1, %arg2) {emitc.pure, template_args = [tensor<1x2xf32>, false, true]}
+  // BACKEND: emitc.call_opaque "emitc::tosa::eigen::fully_connected_transposed"(%arg0, %arg1, %arg2)
+  // CHECK: return {{.*}}, %[[T]]
+  %0 = "tosa.const"() {value = dense<[1, 0]> : tensor<2xi32>} : () -> tensor<2xi32>
+  %1 = "tosa.transpose"(%arg1, %0) : (tensor<5x2xf32>, tensor<2xi32>) -> tensor<2x5xf32>
+  %2 = "tosa.fully_connected"(%arg0, %1, %arg2) : (tensor<1x5xf32>, tensor<2x5xf32>, tensor<2xf32>) -> tensor<1x2xf32>
+  return %2, %1 : tensor<1x2xf32>, tensor<2x5xf32>
+}
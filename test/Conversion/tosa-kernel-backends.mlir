@@ -0,0 +1,34 @@
+// RUN: emitc-opt -convert-tosa-to-emitc="kernel-backends=conv2d:eigen,matmul:blas,reduce_sum:naive" %s | FileCheck %s
+// RUN: emitc-opt -tosa-to-emitc-pipeline="kernel-backends=conv2d:eigen,matmul:blas,reduce_sum:naive" %s | FileCheck %s
+// RUN: emitc-opt -convert-tosa-to-emitc="attributes-as-template-args=true kernel-backends=conv2d:eigen" %s | FileCheck %s --check-prefix=TEMPLATE
+// RUN: not emitc-opt -convert-tosa-to-emitc="kernel-backends=max_pool2d:blas" %s 2>&1 | FileCheck %s --check-prefix=UNSUPPORTED
+// RUN: not emitc-opt -convert-tosa-to-emitc="kernel-backends=add:eigen" %s 2>&1 | FileCheck %s --check-prefix=UNKNOWN
+
+// UNSUPPORTED: error: no 'blas' kernel for 'max_pool2d'
+// UNKNOWN: error: no selectable kernels for 'add'
+
+func.func @test_conv2d(%arg0: tensor<1x4x4x4xf32>, %arg1: tensor<8x1x1x4xf32>, %arg2: tensor<8xf32>) -> tensor<1x4x4x8xf32> {
+  // CHECK: emitc.call_opaque "emitc::tosa::eigen::conv2d"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<0> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<1> : tensor<2xi64>], emitc.pure, template_args = [tensor<1x4x4x8xf32>]} : (tensor<1x4x4x4xf32>, tensor<8x1x1x4xf32>) -> tensor<1x4x4x8xf32>
+  // TEMPLATE: emitc.call_opaque "emitc::tosa::eigen::conv2d"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<0> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<1> : tensor<2xi64>], emitc.pure, template_args = [tensor<1x4x4x8xf32>]} : (tensor<1x4x4x4xf32>, tensor<8x1x1x4xf32>) -> tensor<1x4x4x8xf32>
+  %0 = "tosa.conv2d"(%arg0, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x4x4x4xf32>, tensor<8x1x1x4xf32>, tensor<8xf32>) -> tensor<1x4x4x8xf32>
+  return %0 : tensor<1x4x4x8xf32>
+}
+
+func.func @test_depthwise_conv2d(%arg0: tensor<1x4x5x2xf32>, %arg1: tensor<2x2x2x2xf32>, %arg2: tensor<4xf32>) -> tensor<1x3x4x4xf32> {
+  // CHECK: emitc.call_opaque "emitc::tosa::depthwise_conv2d"
+  // TEMPLATE: emitc.call_opaque "emitc::tosa::depthwise_conv2d"(%arg0, %arg1) {emitc.pure, template_args = [tensor<1x3x4x4xf32>, #emitc.opaque<"std::integer_sequence<int64_t, 0, 0, 0, 0>">, #emitc.opaque<"std::integer_sequence<int64_t, 1, 1>">, #emitc.opaque<"std::integer_sequence<int64_t, 1, 1>">]} : (tensor<1x4x5x2xf32>, tensor<2x2x2x2xf32>) -> tensor<1x3x4x4xf32>
+  %0 = "tosa.depthwise_conv2d"(%arg0, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x4x5x2xf32>, tensor<2x2x2x2xf32>, tensor<4xf32>) -> tensor<1x3x4x4xf32>
+  return %0 : tensor<1x3x4x4xf32>
+}
+
+func.func @test_matmul(%arg0: tensor<1x14x19xf32>, %arg1: tensor<1x19x28xf32>) -> tensor<1x14x28xf32> {
+  // CHECK: emitc.call_opaque "emitc::tosa::blas::matmul"(%arg0, %arg1) {emitc.pure} : (tensor<1x14x19xf32>, tensor<1x19x28xf32>) -> tensor<1x14x28xf32>
+  %0 = "tosa.matmul"(%arg0, %arg1) : (tensor<1x14x19xf32>, tensor<1x19x28xf32>) -> tensor<1x14x28xf32>
+  return %0 : tensor<1x14x28xf32>
+}
+
+func.func @test_reduce_sum(%arg0: tensor<13x21x3xf32>) -> tensor<13x1x3xf32> {
+  // CHECK: emitc.call_opaque "emitc::tosa::naive::reduce_sum"(%arg0) {args = [0 : index, 1 : i32], emitc.pure, template_args = [tensor<13x3xf32>, tensor<13x21x3xf32>]} : (tensor<13x21x3xf32>) -> tensor<13x3xf32>
+  %0 = "tosa.reduce_sum"(%arg0) {axis = 1 : i32} : (tensor<13x21x3xf32>) -> tensor<13x1x3xf32>
+  return %0 : tensor<13x1x3xf32>
+}
@@ -0,0 +1,60 @@
+// RUN: emitc-opt -pack-tosa-weights=block-size=2 %s | FileCheck %s
+// RUN: emitc-opt -pack-tosa-weights="block-size=2 weight-type=f16 min-compressed-elements=6" %s | FileCheck %s --check-prefix=F16
+// RUN: emitc-opt -pack-tosa-weights="block-size=2 weight-type=i8 min-compressed-elements=6" %s | FileCheck %s --check-prefix=I8
+// RUN: emitc-opt -pack-tosa-weights="block-size=2 weight-type=i8 min-compressed-elements=6" -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+
+// STATS: PackTosaWeights
+// STATS-DAG: 2 num-compressed-weights
+// STATS-DAG: 14 num-saved-bytes
+
+// CHECK-LABEL: func @test_conv2d
+func.func @test_conv2d(%arg0: tensor<1x4x4x2xf32>, %arg1: tensor<4xf32>) -> tensor<1x4x4x4xf32> {
+  // CHECK-NOT: tosa.conv2d
+  // CHECK: %[[W:.*]] = "tosa.const"() {{.*}}tensor<2x1x1x2x2xf32>
+  // CHECK: emitc.call_opaque "emitc::tosa::conv2d_prepacked"(%arg0, %[[W]], %arg1) {args = [0 : index, 1 : index, 2 : index, dense<0> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<1> : tensor<2xi64>], emitc.pure, template_args = [tensor<1x4x4x4xf32>, 1]}
+  %0 = "tosa.const"() {value = dense<[[[[1.0, 2.0]]], [[[3.0, 4.0]]], [[[5.0, 6.0]]], [[[7.0, 8.0]]]]> : tensor<4x1x1x2xf32>} : () -> tensor<4x1x1x2xf32>
+  %1 = "tosa.conv2d"(%arg0, %0, %arg1) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x4x4x2xf32>, tensor<4x1x1x2xf32>, tensor<4xf32>) -> tensor<1x4x4x4xf32>
+  return %1 : tensor<1x4x4x4xf32>
+}
+
+// F16-LABEL: func @test_conv2d
+// F16: %[[W:.*]] = "tosa.const"() {{.*}}tensor<2x1x1x2x2xf16>
+// F16: emitc.call_opaque "emitc::tosa::conv2d_prepacked"(%arg0, %[[W]], %arg1)
+
+// I8-LABEL: func @test_conv2d
+// I8: %[[W:.*]] = "tosa.const"() {{.*}}tensor<2x1x1x2x2xi8>
+// I8: %[[S:.*]] = "tosa.const"() {{.*}}tensor<4xf32>
+// I8: emitc.call_opaque "emitc::tosa::conv2d_prepacked"(%arg0, %[[W]], %[[S]], %arg1) {args = [0 : index, 1 : index, 2 : index, 3 : index, dense<0> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<1> : tensor<2xi64>], emitc.pure, template_args = [tensor<1x4x4x4xf32>, 1]}
+
+// CHECK-LABEL: func @test_fully_connected
+func.func @test_fully_connected(%arg0: tensor<1x2xf32>, %arg1: tensor<3xf32>) -> tensor<1x3xf32> {
+  // CHECK-NOT: tosa.fully_connected
+  // CHECK: %[[W:.*]] = "tosa.const"()
+  // CHECK-SAME{LITERAL}: dense<[[[1.000000e+00, 3.000000e+00], [2.000000e+00, 4.000000e+00]], [[5.000000e+00, 0.000000e+00], [6.000000e+00, 0.000000e+00]]]> : tensor<2x2x2xf32>
+  // CHECK: emitc.call_opaque "emitc::tosa::fully_connected_prepacked"(%arg0, %[[W]], %arg1) {emitc.pure, template_args = [tensor<1x3xf32>, 1]}
+  %0 = "tosa.const"() {value = dense<[[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]]> : tensor<3x2xf32>} : () -> tensor<3x2xf32>
+  %1 = "tosa.fully_connected"(%arg0, %0, %arg1) : (tensor<1x2xf32>, tensor<3x2xf32>, tensor<3xf32>) -> tensor<1x3xf32>
+  return %1 : tensor<1x3xf32>
+}
+
+// F16-LABEL: func @test_fully_connected
+// F16: %[[W:.*]] = "tosa.const"()
+// F16-SAME{LITERAL}: dense<[[[1.000000e+00, 3.000000e+00], [2.000000e+00, 4.000000e+00]], [[5.000000e+00, 0.000000e+00], [6.000000e+00, 0.000000e+00]]]> : tensor<2x2x2xf16>
+// F16: emitc.call_opaque "emitc::tosa::fully_connected_prepacked"(%arg0, %[[W]], %arg1) {emitc.pure, template_args = [tensor<1x3xf32>, 1]}
+
+// Weights are quantized with the scale max(abs(w)) / 127 of their output
+// channel.
+// I8-LABEL: func @test_fully_connected
+// I8: %[[W:.*]] = "tosa.const"()
+// I8-SAME{LITERAL}: dense<[[[64, 95], [127, 127]], [[106, 0], [127, 0]]]> : tensor<2x2x2xi8>
+// I8: %[[S:.*]] = "tosa.const"()
+// I8-SAME: tensor<3xf32>
+// I8: emitc.call_opaque "emitc::tosa::fully_connected_prepacked"(%arg0, %[[W]], %[[S]], %arg1) {emitc.pure, template_args = [tensor<1x3xf32>, 1]}
+
+// CHECK-LABEL: func @test_conv2d_dynamic_weights
+func.func @test_conv2d_dynamic_weights(%arg0: tensor<1x4x4x2xf32>, %arg1: tensor<4x1x1x2xf32>, %arg2: tensor<4xf32>) -> tensor<1x4x4x4xf32> {
+  // CHECK: tosa.conv2d
+  // CHECK-NOT: emitc.call_opaque
+  %0 = "tosa.conv2d"(%arg0, %arg1, %arg2) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x4x4x2xf32>, tensor<4x1x1x2xf32>, tensor<4xf32>) -> tensor<1x4x4x4xf32>
+  return %0 : tensor<1x4x4x4xf32>
+}
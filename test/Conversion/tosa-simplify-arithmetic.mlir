@@ -0,0 +1,67 @@
+// RUN: emitc-opt -simplify-tosa-arithmetic %s | FileCheck %s --check-prefixes=CHECK,STRICT
+// RUN: emitc-opt -simplify-tosa-arithmetic=fast-math=true %s | FileCheck %s --check-prefixes=CHECK,FAST
+
+// CHECK-LABEL: func @test_pow
+func.func @test_pow(%arg0: tensor<2x3xf32>) -> (tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>) {
+  // CHECK-NOT: tosa.const
+  // CHECK-NOT: tosa.pow
+  // CHECK: %[[MUL:.*]] = "tosa.mul"(%arg0, %arg0) {{.*}}shift = 0 : i8
+  // STRICT: %[[SQRT:.*]] = "tosa.pow"(%arg0
+  // FAST: %[[SQRT:.*]] = emitc.call_opaque "emitc::sqrt"(%arg0) {emitc.pure} : (tensor<2x3xf32>) -> tensor<2x3xf32>
+  // CHECK: %[[RECIPROCAL:.*]] = "tosa.reciprocal"(%arg0)
+  // STRICT: %[[RSQRT:.*]] = "tosa.pow"(%arg0
+  // FAST: %[[RSQRT:.*]] = "tosa.rsqrt"(%arg0)
+  // CHECK: return %arg0, %[[MUL]], %[[SQRT]], %[[RECIPROCAL]], %[[RSQRT]]
+  %0 = "tosa.const"() {value = dense<1.0> : tensor<1x1xf32>} : () -> tensor<1x1xf32>
+  %1 = "tosa.pow"(%arg0, %0) : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  %2 = "tosa.const"() {value = dense<2.0> : tensor<1x1xf32>} : () -> tensor<1x1xf32>
+  %3 = "tosa.pow"(%arg0, %2) : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  %4 = "tosa.const"() {value = dense<0.5> : tensor<1x1xf32>} : () -> tensor<1x1xf32>
+  %5 = "tosa.pow"(%arg0, %4) : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  %6 = "tosa.const"() {value = dense<-1.0> : tensor<1x1xf32>} : () -> tensor<1x1xf32>
+  %7 = "tosa.pow"(%arg0, %6) : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  %8 = "tosa.const"() {value = dense<-0.5> : tensor<1x1xf32>} : () -> tensor<1x1xf32>
+  %9 = "tosa.pow"(%arg0, %8) : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  return %1, %3, %5, %7, %9 : tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>
+}
+
+// CHECK-LABEL: func @test_pow_unsupported
+func.func @test_pow_unsupported(%arg0: tensor<2x3xf32>, %arg1: tensor<1x1xf32>) -> (tensor<2x3xf32>, tensor<2x3xf32>) {
+  // CHECK: "tosa.pow"(%arg0
+  // CHECK: "tosa.pow"(%arg0, %arg1)
+  %0 = "tosa.const"() {value = dense<3.0> : tensor<1x1xf32>} : () -> tensor<1x1xf32>
+  %1 = "tosa.pow"(%arg0, %0) : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  %2 = "tosa.pow"(%arg0, %arg1) : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  return %1, %2 : tensor<2x3xf32>, tensor<2x3xf32>
+}
+
+// Without fast-math, only -0.0 is removed from additions and +0.0 from
+// subtractions, as -0.0 + 0.0 is +0.0.
+// CHECK-LABEL: func @test_identities
+func.func @test_identities(%arg0: tensor<2x3xf32>, %arg1: tensor<2x3xi32>) -> (tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xi32>, tensor<2x3xf32>) {
+  // STRICT-NEXT: %[[ZERO:.*]] = "tosa.const"() {{.*}}dense<0.000000e+00> : tensor<1x1xf32>
+  // STRICT-NEXT: %[[ADD:.*]] = "tosa.add"(%[[ZERO]], %arg0)
+  // STRICT-NEXT: return %[[ADD]], %[[ADD]], %arg0, %arg1, %arg0
+  // FAST-NEXT: return %arg0, %arg0, %arg0, %arg1, %arg0
+  %0 = "tosa.const"() {value = dense<0.0> : tensor<1x1xf32>} : () -> tensor<1x1xf32>
+  %1 = "tosa.add"(%0, %arg0) : (tensor<1x1xf32>, tensor<2x3xf32>) -> tensor<2x3xf32>
+  %2 = "tosa.sub"(%1, %0) : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  %3 = "tosa.const"() {value = dense<1.0> : tensor<1x1xf32>} : () -> tensor<1x1xf32>
+  %4 = "tosa.mul"(%arg0, %3) {shift = 0 : i8} : (tensor<2x3xf32>, tensor<1x1xf32>) -> tensor<2x3xf32>
+  %5 = "tosa.const"() {value = dense<1> : tensor<2x3xi32>} : () -> tensor<2x3xi32>
+  %6 = "tosa.mul"(%5, %arg1) {shift = 0 : i8} : (tensor<2x3xi32>, tensor<2x3xi32>) -> tensor<2x3xi32>
+  %7 = "tosa.const"() {value = dense<-0.0> : tensor<2x3xf32>} : () -> tensor<2x3xf32>
+  %8 = "tosa.add"(%arg0, %7) : (tensor<2x3xf32>, tensor<2x3xf32>) -> tensor<2x3xf32>
+  return %1, %2, %4, %6, %8 : tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xf32>, tensor<2x3xi32>, tensor<2x3xf32>
+}
+
+// CHECK-LABEL: func @test_no_identities
+func.func @test_no_identities(%arg0: tensor<2x3xf32>, %arg1: tensor<2x3xi32>) -> (tensor<2x3xf32>, tensor<2x3xi32>) {
+  // CHECK: "tosa.sub"
+  // CHECK: "tosa.mul"
+  %0 = "tosa.const"() {value = dense<0.0> : tensor<2x3xf32>} : () -> tensor<2x3xf32>
+  %1 = "tosa.sub"(%0, %arg0) : (tensor<2x3xf32>, tensor<2x3xf32>) -> tensor<2x3xf32>
+  %2 = "tosa.const"() {value = dense<1> : tensor<2x3xi32>} : () -> tensor<2x3xi32>
+  %3 = "tosa.mul"(%arg1, %2) {shift = 1 : i8} : (tensor<2x3xi32>, tensor<2x3xi32>) -> tensor<2x3xi32>
+  return %1, %3 : tensor<2x3xf32>, tensor<2x3xi32>
+}
@@ -0,0 +1,78 @@
+// RUN: emitc-opt -sparsify-tosa-weights="min-sparsity=0.7 min-elements=1" %s | FileCheck %s
+// RUN: emitc-opt -sparsify-tosa-weights="min-sparsity=0.7 min-elements=1" -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+// RUN: emitc-opt -sparsify-tosa-weights="min-elements=1" %s | FileCheck %s --check-prefix=NAIVE
+// RUN: emitc-opt -sparsify-tosa-weights="min-elements=1 kernel-backends=fully_connected:eigen" %s | FileCheck %s --check-prefix=EIGEN
+// RUN: emitc-opt -sparsify-tosa-weights="min-elements=1 default-backend=eigen" %s | FileCheck %s --check-prefix=EIGEN
+// RUN: emitc-opt -sparsify-tosa-weights="min-elements=1 default-backend=eigen kernel-backends=fully_connected:naive" %s | FileCheck %s --check-prefix=NAIVE
+
+// STATS: SparsifyTosaWeights
+// STATS-DAG: 3 num-sparsified-ops
+// STATS-DAG: 20 num-saved-bytes
+
+// CHECK-LABEL: func @test_conv2d
+func.func @test_conv2d(%arg0: tensor<1x4x4x2xf32>, %arg1: tensor<4xf32>) -> tensor<1x2x2x4xf32> {
+  // CHECK-NOT: tosa.conv2d
+  // CHECK-DAG: %[[V:.*]] = "tosa.const"() {{.*}}dense<[1.000000e+00, 2.000000e+00]> : tensor<2xf32>
+  // CHECK-DAG: %[[C:.*]] = "tosa.const"() {{.*}}dense<[1, 0]> : tensor<2xi32>
+  // CHECK-DAG: %[[R:.*]] = "tosa.const"() {{.*}}dense<[0, 1, 1, 2, 2]> : tensor<5xi32>
+  // CHECK: emitc.call_opaque "emitc::tosa::conv2d_1x1_sparse"(%arg0, %[[V]], %[[C]], %[[R]], %arg1) {args = [0 : index, 1 : index, 2 : index, 3 : index, 4 : index, dense<2> : tensor<2xi64>], emitc.pure, template_args = [tensor<1x2x2x4xf32>]}
+  %0 = "tosa.const"() {value = dense<[[[[0.0, 1.0]]], [[[0.0, 0.0]]], [[[2.0, 0.0]]], [[[0.0, 0.0]]]]> : tensor<4x1x1x2xf32>} : () -> tensor<4x1x1x2xf32>
+  %1 = "tosa.conv2d"(%arg0, %0, %arg1) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 2, 2>} : (tensor<1x4x4x2xf32>, tensor<4x1x1x2xf32>, tensor<4xf32>) -> tensor<1x2x2x4xf32>
+  return %1 : tensor<1x2x2x4xf32>
+}
+
+// Convolutions with larger kernels or padding are kept.
+// CHECK-LABEL: func @test_conv2d_3x3
+func.func @test_conv2d_3x3(%arg0: tensor<1x4x4x1xf32>, %arg1: tensor<1xf32>) -> tensor<1x2x2x1xf32> {
+  // CHECK: tosa.conv2d
+  // CHECK-NOT: emitc.call_opaque
+  %0 = "tosa.const"() {value = dense<[[[[0.0], [0.0], [0.0]], [[0.0], [1.0], [0.0]], [[0.0], [0.0], [0.0]]]]> : tensor<1x3x3x1xf32>} : () -> tensor<1x3x3x1xf32>
+  %1 = "tosa.conv2d"(%arg0, %0, %arg1) {dilation = array<i64: 1, 1>, pad = array<i64: 0, 0, 0, 0>, stride = array<i64: 1, 1>} : (tensor<1x4x4x1xf32>, tensor<1x3x3x1xf32>, tensor<1xf32>) -> tensor<1x2x2x1xf32>
+  return %1 : tensor<1x2x2x1xf32>
+}
+
+// CHECK-LABEL: func @test_conv2d_pad
+func.func @test_conv2d_pad(%arg0: tensor<1x4x4x2xf32>, %arg1: tensor<4xf32>) -> tensor<1x6x6x4xf32> {
+  // CHECK: tosa.conv2d
+  // CHECK-NOT: emitc.call_opaque
+  %0 = "tosa.const"() {value = dense<[[[[0.0, 1.0]]], [[[0.0, 0.0]]], [[[2.0, 0.0]]], [[[0.0, 0.0]]]]> : tensor<4x1x1x2xf32>} : () -> tensor<4x1x1x2xf32>
+  %1 = "tosa.conv2d"(%arg0, %0, %arg1) {dilation = array<i64: 1, 1>, pad = array<i64: 1, 1, 1, 1>, stride = array<i64: 1, 1>} : (tensor<1x4x4x2xf32>, tensor<4x1x1x2xf32>, tensor<4xf32>) -> tensor<1x6x6x4xf32>
+  return %1 : tensor<1x6x6x4xf32>
+}
+
+// CHECK-LABEL: func @test_fully_connected
+func.func @test_fully_connected(%arg0: tensor<2x4xf32>, %arg1: tensor<3xf32>) -> tensor<2x3xf32> {
+  // CHECK-NOT: tosa.fully_connected
+  // CHECK-DAG: %[[V:.*]] = "tosa.const"() {{.*}}dense<[2.000000e+00, 1.000000e+00, 3.000000e+00]> : tensor<3xf32>
+  // CHECK-DAG: %[[C:.*]] = "tosa.const"() {{.*}}dense<[1, 0, 3]> : tensor<3xi32>
+  // CHECK-DAG: %[[R:.*]] = "tosa.const"() {{.*}}dense<[0, 1, 1, 3]> : tensor<4xi32>
+  // CHECK: emitc.call_opaque "emitc::tosa::fully_connected_sparse"(%arg0, %[[V]], %[[C]], %[[R]], %arg1) {emitc.pure, template_args = [tensor<2x3xf32>]}
+  %0 = "tosa.const"() {value = dense<[[0.0, 2.0, 0.0, 0.0], [0.0, 0.0, 0.0, 0.0], [1.0, 0.0, 0.0, 3.0]]> : tensor<3x4xf32>} : () -> tensor<3x4xf32>
+  %1 = "tosa.fully_connected"(%arg0, %0, %arg1) : (tensor<2x4xf32>, tensor<3x4xf32>, tensor<3xf32>) -> tensor<2x3xf32>
+  return %1 : tensor<2x3xf32>
+}
+
+// Weights below the sparsity threshold are kept.
+// CHECK-LABEL: func @test_fully_connected_dense
+func.func @test_fully_connected_dense(%arg0: tensor<1x2xf32>, %arg1: tensor<2xf32>) -> tensor<1x2xf32> {
+  // CHECK: tosa.fully_connected
+  // CHECK-NOT: emitc.call_opaque
+  %0 = "tosa.const"() {value = dense<[[1.0, 0.0], [3.0, 4.0]]> : tensor<2x2xf32>} : () -> tensor<2x2xf32>
+  %1 = "tosa.fully_connected"(%arg0, %0, %arg1) : (tensor<1x2xf32>, tensor<2x2xf32>, tensor<2xf32>) -> tensor<1x2xf32>
+  return %1 : tensor<1x2xf32>
+}
+
+// The default threshold depends on the backend of the dense kernel, which is
+// selected by kernel-backends or default-backend.
+// CHECK-LABEL: func @test_fully_connected_backend
+// NAIVE-LABEL: func @test_fully_connected_backend
+// EIGEN-LABEL: func @test_fully_connected_backend
+func.func @test_fully_connected_backend(%arg0: tensor<1x4xf32>, %arg1: tensor<2xf32>) -> tensor<1x2xf32> {
+  // CHECK: emitc.call_opaque "emitc::tosa::fully_connected_sparse"
+  // NAIVE: emitc.call_opaque "emitc::tosa::fully_connected_sparse"
+  // EIGEN: tosa.fully_connected
+  // EIGEN-NOT: emitc.call_opaque
+  %0 = "tosa.const"() {value = dense<[[0.0, 0.0, 5.0, 0.0], [0.0, 0.0, 0.0, 0.0]]> : tensor<2x4xf32>} : () -> tensor<2x4xf32>
+  %1 = "tosa.fully_connected"(%arg0, %0, %arg1) : (tensor<1x4xf32>, tensor<2x4xf32>, tensor<2xf32>) -> tensor<1x2xf32>
+  return %1 : tensor<1x2xf32>
+}
@@ -0,0 +1,31 @@
+// RUN: emitc-opt -apply-emitc-kernel-tuning=database=%S/Inputs/kernel-tuning.json %s | FileCheck %s
+// RUN: emitc-opt -apply-emitc-kernel-tuning=database=%S/Inputs/kernel-tuning.json -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+// RUN: not emitc-opt -apply-emitc-kernel-tuning=database=%S/Inputs/kernel-tuning-unavailable.json %s 2>&1 | FileCheck %s --check-prefix=UNAVAILABLE
+// RUN: not emitc-opt -apply-emitc-kernel-tuning=database=%S/Inputs/missing.json %s 2>&1 | FileCheck %s --check-prefix=MISSING
+
+// STATS: ApplyEmitCKernelTuning
+// STATS-DAG: 4 num-tuned-calls
+// STATS-DAG: 1 num-untuned-calls
+
+// UNAVAILABLE: error: tuning database selects unavailable 'blas' kernel
+
+// MISSING: error: cannot open tuning database
+
+// CHECK-LABEL: func @model
+func.func @model(%arg0: tensor<1x2x3xf32>, %arg1: tensor<1x3x4xf32>, %arg2: tensor<1x8x8x4xf32>, %arg3: tensor<1x4x3xf32>, %arg4: tensor<1x3x2xf32>) -> (tensor<1x2x4xf32>, tensor<1x2x4xf32>, tensor<1x8x8x4xf32>, tensor<1x4x4xf32>, tensor<1x2x4xf32>, tensor<1x2x4xf32>) {
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::blas::matmul"(%arg0, %arg1)
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::blas::matmul"(%arg0, %arg1)
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::eigen::avg_pool2d"(%arg2)
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::matmul"(%arg3, %arg1)
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::naive::matmul"(%arg0, %arg1)
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::eigen::matmul_transposed"(%arg4, %arg1) {template_args = [tensor<1x2x4xf32>, true, false]}
+  %0 = emitc.call_opaque "emitc::tosa::matmul"(%arg0, %arg1) : (tensor<1x2x3xf32>, tensor<1x3x4xf32>) -> tensor<1x2x4xf32>
+  %1 = emitc.call_opaque "emitc::tosa::matmul"(%arg0, %arg1) : (tensor<1x2x3xf32>, tensor<1x3x4xf32>) -> tensor<1x2x4xf32>
+  %2 = emitc.call_opaque "emitc::tosa::avg_pool2d"(%arg2) {args = [0 : index, dense<[0, 1, 0, 1]> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<2> : tensor<2xi64>], template_args = [tensor<1x8x8x4xf32>]} : (tensor<1x8x8x4xf32>) -> tensor<1x8x8x4xf32>
+  %3 = emitc.call_opaque "emitc::tosa::matmul"(%arg3, %arg1) : (tensor<1x4x3xf32>, tensor<1x3x4xf32>) -> tensor<1x4x4xf32>
+  // Kernels selected explicitly are kept.
+  %4 = emitc.call_opaque "emitc::tosa::naive::matmul"(%arg0, %arg1) : (tensor<1x2x3xf32>, tensor<1x3x4xf32>) -> tensor<1x2x4xf32>
+  // Transposed kernels are tuned with the transpose flags.
+  %5 = emitc.call_opaque "emitc::tosa::matmul_transposed"(%arg4, %arg1) {template_args = [tensor<1x2x4xf32>, true, false]} : (tensor<1x3x2xf32>, tensor<1x3x4xf32>) -> tensor<1x2x4xf32>
+  return %0, %1, %2, %3, %4, %5 : tensor<1x2x4xf32>, tensor<1x2x4xf32>, tensor<1x8x8x4xf32>, tensor<1x4x4xf32>, tensor<1x2x4xf32>, tensor<1x2x4xf32>
+}
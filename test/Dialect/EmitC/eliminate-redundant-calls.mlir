@@ -0,0 +1,56 @@
+// RUN: emitc-opt -eliminate-redundant-emitc-calls %s | FileCheck %s
+// RUN: emitc-opt -eliminate-redundant-emitc-calls -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+
+// STATS: EliminateRedundantEmitCCalls
+// STATS-DAG: 2 num-erased-calls
+// STATS-DAG: 1 num-replaced-calls
+
+// CHECK-LABEL: func @broadcast_operands
+func.func @broadcast_operands(%arg0: tensor<1x3xf32>, %arg1: tensor<2x3xf32>) -> tensor<2x3xf32> {
+  // CHECK-NEXT: %[[B:.*]] = emitc.call_opaque "emitc::broadcast_in_dim"(%arg0)
+  // CHECK-NEXT: %[[ADD:.*]] = emitc.call_opaque "emitc::tosa::add"(%[[B]], %arg1)
+  // CHECK-NEXT: %[[SUB:.*]] = emitc.call_opaque "emitc::tosa::sub"(%[[B]], %[[ADD]])
+  // CHECK-NEXT: return %[[SUB]]
+  %0 = emitc.call_opaque "emitc::broadcast_in_dim"(%arg0) {args = [0 : index, dense<[0, 1]> : tensor<2xi64>], emitc.pure, template_args = [tensor<2x3xf32>]} : (tensor<1x3xf32>) -> tensor<2x3xf32>
+  %1 = emitc.call_opaque "emitc::tosa::add"(%0, %arg1) {emitc.pure} : (tensor<2x3xf32>, tensor<2x3xf32>) -> tensor<2x3xf32>
+  %2 = emitc.call_opaque "emitc::broadcast_in_dim"(%arg0) {args = [0 : index, dense<[0, 1]> : tensor<2xi64>], emitc.pure, template_args = [tensor<2x3xf32>]} : (tensor<1x3xf32>) -> tensor<2x3xf32>
+  %3 = emitc.call_opaque "emitc::tosa::sub"(%2, %1) {emitc.pure} : (tensor<2x3xf32>, tensor<2x3xf32>) -> tensor<2x3xf32>
+  return %3 : tensor<2x3xf32>
+}
+
+// CHECK-LABEL: func @different_attributes
+func.func @different_attributes(%arg0: tensor<3xf32>) -> (tensor<2x3xf32>, tensor<3x3xf32>) {
+  // CHECK-NEXT: emitc.call_opaque "emitc::broadcast_in_dim"(%arg0)
+  // CHECK-NEXT: emitc.call_opaque "emitc::broadcast_in_dim"(%arg0)
+  %0 = emitc.call_opaque "emitc::broadcast_in_dim"(%arg0) {args = [0 : index, dense<1> : tensor<1xi64>], emitc.pure, template_args = [tensor<2x3xf32>]} : (tensor<3xf32>) -> tensor<2x3xf32>
+  %1 = emitc.call_opaque "emitc::broadcast_in_dim"(%arg0) {args = [0 : index, dense<1> : tensor<1xi64>], emitc.pure, template_args = [tensor<3x3xf32>]} : (tensor<3xf32>) -> tensor<3x3xf32>
+  return %0, %1 : tensor<2x3xf32>, tensor<3x3xf32>
+}
+
+// CHECK-LABEL: func @unused_results
+func.func @unused_results(%arg0: tensor<2xf32>) -> tensor<2xf32> {
+  // CHECK-NEXT: %[[ABS:.*]] = emitc.call_opaque "emitc::tosa::abs"(%arg0)
+  // CHECK-NEXT: return %[[ABS]]
+  %0 = emitc.call_opaque "emitc::tosa::exp"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
+  %1 = emitc.call_opaque "emitc::tosa::log"(%0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
+  %2 = emitc.call_opaque "emitc::tosa::abs"(%arg0) {emitc.pure} : (tensor<2xf32>) -> tensor<2xf32>
+  return %2 : tensor<2xf32>
+}
+
+// Calls not marked as pure are kept, regardless of the callee.
+// CHECK-LABEL: func @impure_calls
+func.func @impure_calls(%arg0: tensor<i32>, %arg1: tensor<i32>, %arg2: tensor<1xi64>) -> () {
+  // CHECK-NEXT: emitc.call_opaque "emitc::stablehlo::rng_uniform"
+  // CHECK-NEXT: emitc.call_opaque "emitc::stablehlo::rng_uniform"
+  // CHECK-NEXT: emitc.call_opaque "printf"
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::custom"
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::abs"
+  // CHECK-NEXT: emitc.call_opaque "emitc::tosa::abs"
+  %0 = emitc.call_opaque "emitc::stablehlo::rng_uniform"(%arg0, %arg1, %arg2) {template_args = [tensor<2xi32>]} : (tensor<i32>, tensor<i32>, tensor<1xi64>) -> tensor<2xi32>
+  %1 = emitc.call_opaque "emitc::stablehlo::rng_uniform"(%arg0, %arg1, %arg2) {template_args = [tensor<2xi32>]} : (tensor<i32>, tensor<i32>, tensor<1xi64>) -> tensor<2xi32>
+  %2 = emitc.call_opaque "printf"(%arg0) : (tensor<i32>) -> i32
+  %3 = emitc.call_opaque "emitc::tosa::custom"(%arg0) : (tensor<i32>) -> tensor<i32>
+  %4 = emitc.call_opaque "emitc::tosa::abs"(%arg0) : (tensor<i32>) -> tensor<i32>
+  %5 = emitc.call_opaque "emitc::tosa::abs"(%arg0) : (tensor<i32>) -> tensor<i32>
+  return
+}
@@ -0,0 +1,47 @@
+// RUN: emitc-opt -extract-emitc-kernels %s | FileCheck %s
+// RUN: emitc-opt -extract-emitc-kernels=backend=blas %s | FileCheck %s --check-prefix=BLAS
+// RUN: not emitc-opt -extract-emitc-kernels=backend=mkl %s 2>&1 | FileCheck %s --check-prefix=ERROR
+
+// CHECK: emitc.include "emitc/tosa.h"
+// CHECK-NOT: func.func @model
+emitc.include "emitc/tosa.h"
+
+// CHECK-LABEL: func.func @kernel_0
+// CHECK-SAME: (%arg0: tensor<1x2x3xf32>, %arg1: tensor<1x3x4xf32>) -> tensor<1x2x4xf32>
+// CHECK-SAME: emitc.kernel_backends = ["naive", "eigen", "blas"]
+// CHECK-SAME: emitc.kernel_signature = "emitc::tosa::matmul : (tensor<1x2x3xf32>, tensor<1x3x4xf32>) -> tensor<1x2x4xf32>"
+// CHECK-NEXT: %[[R:.*]] = emitc.call_opaque "emitc::tosa::matmul"(%arg0, %arg1)
+// CHECK-NEXT: return %[[R]]
+
+// CHECK-LABEL: func.func @kernel_1
+// CHECK-SAME: (%arg0: tensor<1x8x8x4xf32>) -> tensor<1x8x8x4xf32>
+// CHECK-SAME: emitc.kernel_backends = ["naive", "eigen"]
+// CHECK-SAME: emitc.kernel_signature = "emitc::tosa::avg_pool2d args [0 : index, dense<[0, 1, 0, 1]> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<2> : tensor<2xi64>] template_args [tensor<1x8x8x4xf32>] : (tensor<1x8x8x4xf32>) -> tensor<1x8x8x4xf32>"
+// CHECK-NEXT: emitc.call_opaque "emitc::tosa::avg_pool2d"(%arg0) {args = [0 : index, dense<[0, 1, 0, 1]> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<2> : tensor<2xi64>], template_args = [tensor<1x8x8x4xf32>]}
+
+// CHECK-LABEL: func.func @kernel_2
+// CHECK-SAME: (%arg0: tensor<1x4x3xf32>, %arg1: tensor<1x3x4xf32>) -> tensor<1x4x4xf32>
+// CHECK-NOT: func.func
+
+// BLAS-NOT: func.func @kernel_1
+// BLAS-LABEL: func.func @kernel_0
+// BLAS: emitc.call_opaque "emitc::tosa::blas::matmul"(%arg0, %arg1)
+// BLAS-NOT: func.func @kernel_1
+// BLAS-LABEL: func.func @kernel_2
+// BLAS: emitc.call_opaque "emitc::tosa::blas::matmul"(%arg0, %arg1)
+// BLAS-NOT: func.func
+
+// ERROR: error: unknown kernel backend 'mkl'
+
+func.func @model(%arg0: tensor<1x2x3xf32>, %arg1: tensor<1x3x4xf32>, %arg2: tensor<1x8x8x4xf32>, %arg3: tensor<1x4x3xf32>, %arg4: tensor<8x1x1x4xf32>) -> (tensor<1x2x4xf32>, tensor<1x2x4xf32>, tensor<1x8x8x4xf32>, tensor<1x4x4xf32>, tensor<1x8x8x8xf32>, tensor<1x2x4xf32>, tensor<1x2x4xf32>) {
+  %0 = emitc.call_opaque "emitc::tosa::matmul"(%arg0, %arg1) : (tensor<1x2x3xf32>, tensor<1x3x4xf32>) -> tensor<1x2x4xf32>
+  %1 = emitc.call_opaque "emitc::tosa::matmul"(%arg0, %arg1) : (tensor<1x2x3xf32>, tensor<1x3x4xf32>) -> tensor<1x2x4xf32>
+  %2 = emitc.call_opaque "emitc::tosa::avg_pool2d"(%arg2) {args = [0 : index, dense<[0, 1, 0, 1]> : tensor<4xi64>, dense<1> : tensor<2xi64>, dense<2> : tensor<2xi64>], template_args = [tensor<1x8x8x4xf32>]} : (tensor<1x8x8x4xf32>) -> tensor<1x8x8x4xf32>
+  %3 = emitc.call_opaque "emitc::tosa::matmul"(%arg3, %arg1) : (tensor<1x4x3xf32>, tensor<1x3x4xf32>) -> tensor<1x4x4xf32>
+  // Calls with attributes as template arguments, already selected kernels and
+  // ops without selectable kernels are not extracted.
+  %4 = emitc.call_opaque "emitc::tosa::conv2d"(%arg2, %arg4) {template_args = [tensor<1x8x8x8xf32>, #emitc.opaque<"std::integer_sequence<int64_t, 0, 0, 0, 0>">, #emitc.opaque<"std::integer_sequence<int64_t, 1, 1>">, #emitc.opaque<"std::integer_sequence<int64_t, 1, 1>">]} : (tensor<1x8x8x4xf32>, tensor<8x1x1x4xf32>) -> tensor<1x8x8x8xf32>
+  %5 = emitc.call_opaque "emitc::tosa::eigen::matmul"(%arg0, %arg1) : (tensor<1x2x3xf32>, tensor<1x3x4xf32>) -> tensor<1x2x4xf32>
+  %6 = emitc.call_opaque "emitc::tosa::add"(%0, %1) : (tensor<1x2x4xf32>, tensor<1x2x4xf32>) -> tensor<1x2x4xf32>
+  return %0, %1, %2, %3, %4, %5, %6 : tensor<1x2x4xf32>, tensor<1x2x4xf32>, tensor<1x8x8x4xf32>, tensor<1x4x4xf32>, tensor<1x8x8x8xf32>, tensor<1x2x4xf32>, tensor<1x2x4xf32>
+}
@@ -0,0 +1,33 @@
+// RUN: emitc-opt -lower-emitc-half-types %s | FileCheck %s
+
+// CHECK-LABEL: func @half(%arg0: tensor<2x!emitc.opaque<"emitc::half">>) -> tensor<2x!emitc.opaque<"emitc::half">>
+func.func @half(%arg0: tensor<2xf16>) -> tensor<2xf16> {
+  // CHECK-NEXT: %[[C:.*]] = "emitc.constant"() <{value = #emitc.opaque<"{(float)1.5{{0*}}e+00, (float)-2.0{{0*}}e+00}">}> : () -> tensor<2x!emitc.opaque<"emitc::half">>
+  // CHECK-NEXT: %[[ADD:.*]] = emitc.call_opaque "emitc::stablehlo::add"(%arg0, %[[C]]) : (tensor<2x!emitc.opaque<"emitc::half">>, tensor<2x!emitc.opaque<"emitc::half">>) -> tensor<2x!emitc.opaque<"emitc::half">>
+  // CHECK-NEXT: return %[[ADD]]
+  %0 = "emitc.constant"() <{value = dense<[1.5, -2.0]> : tensor<2xf16>}> : () -> tensor<2xf16>
+  %1 = emitc.call_opaque "emitc::stablehlo::add"(%arg0, %0) : (tensor<2xf16>, tensor<2xf16>) -> tensor<2xf16>
+  return %1 : tensor<2xf16>
+}
+
+// Splat constants list each element. Special values use the macros of the
+// C++ emitter.
+// CHECK-LABEL: func @bfloat16
+func.func @bfloat16() -> (tensor<2xbf16>, tensor<3xbf16>, bf16) {
+  // CHECK-NEXT: "emitc.constant"() <{value = #emitc.opaque<"{(float)2.5{{0*}}e-01, (float)2.5{{0*}}e-01}">}> : () -> tensor<2x!emitc.opaque<"emitc::bfloat16">>
+  // CHECK-NEXT: "emitc.constant"() <{value = #emitc.opaque<"{NAN, INFINITY, -INFINITY}">}> : () -> tensor<3x!emitc.opaque<"emitc::bfloat16">>
+  // CHECK-NEXT: "emitc.constant"() <{value = #emitc.opaque<"(float)3.0{{0*}}e+00">}> : () -> !emitc.opaque<"emitc::bfloat16">
+  %0 = "emitc.constant"() <{value = dense<0.25> : tensor<2xbf16>}> : () -> tensor<2xbf16>
+  %1 = "emitc.constant"() <{value = dense<[0x7FC0, 0x7F80, 0xFF80]> : tensor<3xbf16>}> : () -> tensor<3xbf16>
+  %2 = "emitc.constant"() <{value = 3.0 : bf16}> : () -> bf16
+  return %0, %1, %2 : tensor<2xbf16>, tensor<3xbf16>, bf16
+}
+
+// Other types are kept.
+// CHECK-LABEL: func @float(%arg0: tensor<2xf32>) -> tensor<2xf32>
+func.func @float(%arg0: tensor<2xf32>) -> tensor<2xf32> {
+  // CHECK-NEXT: "emitc.constant"() <{value = dense<1.000000e+00> : tensor<2xf32>}>
+  %0 = "emitc.constant"() <{value = dense<1.0> : tensor<2xf32>}> : () -> tensor<2xf32>
+  %1 = emitc.call_opaque "emitc::stablehlo::add"(%arg0, %0) : (tensor<2xf32>, tensor<2xf32>) -> tensor<2xf32>
+  return %1 : tensor<2xf32>
+}
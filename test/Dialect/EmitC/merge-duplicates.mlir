@@ -0,0 +1,103 @@
+// RUN: emitc-opt -merge-emitc-duplicates %s | FileCheck %s
+// RUN: emitc-opt -merge-emitc-duplicates -mlir-pass-statistics %s 2>&1 | FileCheck %s --check-prefix=STATS
+
+// STATS: MergeEmitCDuplicates
+// STATS-DAG: 1 num-merged-constants
+// STATS-DAG: 3 num-merged-functions
+// STATS-DAG: 24 num-saved-bytes
+
+// CHECK-LABEL: func @constants
+func.func @constants(%arg0: tensor<2x3xf32>) -> (tensor<2x3xf32>, tensor<2x3xf32>) {
+  // CHECK-NEXT: %[[C0:.*]] = "emitc.constant"() <{value = dense<1.000000e+00> : tensor<2x3xf32>}>
+  // CHECK-NEXT: %[[C1:.*]] = "emitc.constant"() <{value = dense<2.000000e+00> : tensor<2x3xf32>}>
+  // CHECK-NEXT: %[[ADD:.*]] = emitc.call_opaque "emitc::tosa::add"(%arg0, %[[C0]])
+  // CHECK-NEXT: %[[MUL:.*]] = emitc.call_opaque "emitc::tosa::mul"(%[[ADD]], %[[C0]])
+  // CHECK-NEXT: %[[SUB:.*]] = emitc.call_opaque "emitc::tosa::sub"(%[[MUL]], %[[C1]])
+  // CHECK-NEXT: return %[[MUL]], %[[SUB]]
+  %0 = "emitc.constant"() <{value = dense<1.000000e+00> : tensor<2x3xf32>}> : () -> tensor<2x3xf32>
+  %1 = "emitc.constant"() <{value = dense<2.000000e+00> : tensor<2x3xf32>}> : () -> tensor<2x3xf32>
+  %2 = emitc.call_opaque "emitc::tosa::add"(%arg0, %0) : (tensor<2x3xf32>, tensor<2x3xf32>) -> tensor<2x3xf32>
+  %3 = "emitc.constant"() <{value = dense<1.000000e+00> : tensor<2x3xf32>}> : () -> tensor<2x3xf32>
+  %4 = emitc.call_opaque "emitc::tosa::mul"(%2, %3) : (tensor<2x3xf32>, tensor<2x3xf32>) -> tensor<2x3xf32>
+  %5 = emitc.call_opaque "emitc::tosa::sub"(%4, %1) : (tensor<2x3xf32>, tensor<2x3xf32>) -> tensor<2x3xf32>
+  return %4, %5 : tensor<2x3xf32>, tensor<2x3xf32>
+}
+
+// Constants are only merged within a function.
+// CHECK-LABEL: func @other_function
+func.func @other_function() -> tensor<2x3xf32> {
+  // CHECK-NEXT: "emitc.constant"() <{value = dense<1.000000e+00> : tensor<2x3xf32>}>
+  %0 = "emitc.constant"() <{value = dense<1.000000e+00> : tensor<2x3xf32>}> : () -> tensor<2x3xf32>
+  return %0 : tensor<2x3xf32>
+}
+
+// CHECK: func private @reduce_lambda_0
+// CHECK-NOT: func private @reduce_lambda_1
+// CHECK: func private @reduce_lambda_2
+func.func private @reduce_lambda_0(%arg0: tensor<f32>, %arg1: tensor<f32>) -> tensor<f32> {
+  %0 = emitc.call_opaque "emitc::stablehlo::add"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+func.func private @reduce_lambda_1(%arg0: tensor<f32>, %arg1: tensor<f32>) -> tensor<f32> {
+  %0 = emitc.call_opaque "emitc::stablehlo::add"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+func.func private @reduce_lambda_2(%arg0: tensor<f32>, %arg1: tensor<f32>) -> tensor<f32> {
+  %0 = emitc.call_opaque "emitc::stablehlo::max"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+// CHECK-LABEL: func @reduce
+func.func @reduce(%arg0: tensor<2x1000xf32>, %arg1: tensor<f32>) -> (tensor<2xf32>, tensor<2xf32>, tensor<2xf32>) {
+  // CHECK-NEXT: emitc.call_opaque "emitc::stablehlo::reduce"{{.*}}@reduce_lambda_0]
+  // CHECK-NEXT: emitc.call_opaque "emitc::stablehlo::reduce"{{.*}}@reduce_lambda_0]
+  // CHECK-NEXT: emitc.call_opaque "emitc::stablehlo::reduce"{{.*}}@reduce_lambda_2]
+  %0 = emitc.call_opaque "emitc::stablehlo::reduce"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<1> : tensor<1xi64>, @reduce_lambda_0], template_args = [tensor<2xf32>, 1]} : (tensor<2x1000xf32>, tensor<f32>) -> tensor<2xf32>
+  %1 = emitc.call_opaque "emitc::stablehlo::reduce"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<1> : tensor<1xi64>, @reduce_lambda_1], template_args = [tensor<2xf32>, 1]} : (tensor<2x1000xf32>, tensor<f32>) -> tensor<2xf32>
+  %2 = emitc.call_opaque "emitc::stablehlo::reduce"(%arg0, %arg1) {args = [0 : index, 1 : index, dense<1> : tensor<1xi64>, @reduce_lambda_2], template_args = [tensor<2xf32>, 1]} : (tensor<2x1000xf32>, tensor<f32>) -> tensor<2xf32>
+  return %0, %1, %2 : tensor<2xf32>, tensor<2xf32>, tensor<2xf32>
+}
+
+// Public functions are part of the interface and are kept.
+// CHECK: func @public_lambda
+func.func @public_lambda(%arg0: tensor<f32>, %arg1: tensor<f32>) -> tensor<f32> {
+  %0 = emitc.call_opaque "emitc::stablehlo::add"(%arg0, %arg1) : (tensor<f32>, tensor<f32>) -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+// Merging @callee_1 into @callee_0 makes @caller_1 identical to @caller_0.
+// CHECK: func private @callee_0
+// CHECK-NOT: func private @callee_1
+// CHECK: func private @caller_0
+// CHECK-NEXT: call @callee_0
+// CHECK-NOT: func private @caller_1
+// CHECK-LABEL: func @callers
+// CHECK-NEXT: call @caller_0
+// CHECK-NEXT: call @caller_0
+func.func private @callee_0(%arg0: tensor<f32>) -> tensor<f32> {
+  %0 = emitc.call_opaque "emitc::stablehlo::exponential"(%arg0) : (tensor<f32>) -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+func.func private @callee_1(%arg0: tensor<f32>) -> tensor<f32> {
+  %0 = emitc.call_opaque "emitc::stablehlo::exponential"(%arg0) : (tensor<f32>) -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+func.func private @caller_0(%arg0: tensor<f32>) -> tensor<f32> {
+  %0 = call @callee_0(%arg0) : (tensor<f32>) -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+func.func private @caller_1(%arg0: tensor<f32>) -> tensor<f32> {
+  %0 = call @callee_1(%arg0) : (tensor<f32>) -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+func.func @callers(%arg0: tensor<f32>) -> (tensor<f32>, tensor<f32>) {
+  %0 = call @caller_0(%arg0) : (tensor<f32>) -> tensor<f32>
+  %1 = call @caller_1(%arg0) : (tensor<f32>) -> tensor<f32>
+  return %0, %1 : tensor<f32>, tensor<f32>
+}
@@ -1,4 +1,10 @@
 // RUN: emitc-opt %s --convert-stablehlo-region-ops-to-emitc --convert-stablehlo-to-emitc | emitc-translate --mlir-to-cpp
+// RUN: emitc-opt %s --convert-stablehlo-region-ops-to-emitc --convert-stablehlo-to-emitc --merge-emitc-duplicates | emitc-translate --mlir-to-cpp
+// RUN: emitc-opt %s --convert-stablehlo-region-ops-to-emitc --convert-stablehlo-to-emitc --merge-emitc-duplicates -mlir-pass-statistics -o /dev/null 2>&1 | FileCheck %s --check-prefix=STATS
+
+// The two global reductions share their outlined add function.
+// STATS: MergeEmitCDuplicates
+// STATS: 1 num-merged-functions
 module attributes {tf.versions = {bad_consumers = [], min_consumer = 12 : i32, producer = 716 : i32}, tf_saved_model.semantics}  {
   func.func @predict(%arg0: tensor<1x224x224x3xf32> {tf._user_specified_name = "args_0", tf_saved_model.index_path = [0]}) -> (tensor<1x1000xf32> {tf_saved_model.index_path = []}) attributes {tf._construction_context = "kEagerRuntime"} {
     %0 = stablehlo.constant dense<5.000000e-01> : tensor<1x1000xf32>
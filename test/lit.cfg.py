@@ -45,6 +45,12 @@ if not config.emitc_enable_hlo:
     config.excludes.extend(
         [
             "MobileNetV2_FakeWeights_stablehlo.mlir",
+            "stablehlo-fold-constants.mlir",
+            "stablehlo-fold-layout-ops.mlir",
+            "stablehlo-fold-pad.mlir",
+            "stablehlo-fold-transpose.mlir",
+            "stablehlo-kernel-backends.mlir",
+            "stablehlo-simplify-arithmetic.mlir",
             "stablehlo-to-emitc.mlir",
         ]
     )